@@ -0,0 +1,305 @@
+using System.Numerics;
+using System.Runtime.CompilerServices;
+using System.Runtime.Intrinsics.X86;
+
+namespace IR2IL.Runtime;
+
+/// <summary>
+/// Implementations of LLVM's atomicrmw, cmpxchg and fence instructions.
+/// </summary>
+/// <remarks>
+/// Every read-modify-write returns the value that was in memory before the operation,
+/// like LLVM does. Operations that map onto a single <see cref="Interlocked"/> method use it,
+/// and everything else is a compare-and-swap loop.
+///
+/// .NET doesn't have relaxed read-modify-write operations, so every ordering gets the
+/// full fence that <see cref="Interlocked"/> implies. That's what native code gets on x64 anyway.
+/// </remarks>
+public static unsafe class Atomics
+{
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static T CompareExchange<T>(T* location, T value, T comparand)
+        where T : unmanaged
+    {
+        if (sizeof(T) == sizeof(byte))
+        {
+            var result = Interlocked.CompareExchange(ref *(byte*)location, Unsafe.BitCast<T, byte>(value), Unsafe.BitCast<T, byte>(comparand));
+            return Unsafe.BitCast<byte, T>(result);
+        }
+        else if (sizeof(T) == sizeof(ushort))
+        {
+            var result = Interlocked.CompareExchange(ref *(ushort*)location, Unsafe.BitCast<T, ushort>(value), Unsafe.BitCast<T, ushort>(comparand));
+            return Unsafe.BitCast<ushort, T>(result);
+        }
+        else if (sizeof(T) == sizeof(int))
+        {
+            var result = Interlocked.CompareExchange(ref *(int*)location, Unsafe.BitCast<T, int>(value), Unsafe.BitCast<T, int>(comparand));
+            return Unsafe.BitCast<int, T>(result);
+        }
+        else if (sizeof(T) == sizeof(long))
+        {
+            var result = Interlocked.CompareExchange(ref *(long*)location, Unsafe.BitCast<T, long>(value), Unsafe.BitCast<T, long>(comparand));
+            return Unsafe.BitCast<long, T>(result);
+        }
+        else
+        {
+            throw new NotSupportedException();
+        }
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static T Exchange<T>(T* location, T value)
+        where T : unmanaged
+    {
+        if (sizeof(T) == sizeof(byte))
+        {
+            return Unsafe.BitCast<byte, T>(Interlocked.Exchange(ref *(byte*)location, Unsafe.BitCast<T, byte>(value)));
+        }
+        else if (sizeof(T) == sizeof(ushort))
+        {
+            return Unsafe.BitCast<ushort, T>(Interlocked.Exchange(ref *(ushort*)location, Unsafe.BitCast<T, ushort>(value)));
+        }
+        else if (sizeof(T) == sizeof(int))
+        {
+            return Unsafe.BitCast<int, T>(Interlocked.Exchange(ref *(int*)location, Unsafe.BitCast<T, int>(value)));
+        }
+        else if (sizeof(T) == sizeof(long))
+        {
+            return Unsafe.BitCast<long, T>(Interlocked.Exchange(ref *(long*)location, Unsafe.BitCast<T, long>(value)));
+        }
+        else
+        {
+            throw new NotSupportedException();
+        }
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static T Add<T>(T* location, T value)
+        where T : unmanaged, INumberBase<T>
+    {
+        if (typeof(T) == typeof(int) || typeof(T) == typeof(uint))
+        {
+            var addend = Unsafe.BitCast<T, int>(value);
+            return Unsafe.BitCast<int, T>(Interlocked.Add(ref *(int*)location, addend) - addend);
+        }
+        else if (typeof(T) == typeof(long) || typeof(T) == typeof(ulong))
+        {
+            var addend = Unsafe.BitCast<T, long>(value);
+            return Unsafe.BitCast<long, T>(Interlocked.Add(ref *(long*)location, addend) - addend);
+        }
+
+        return Update<T, AddOperation<T>>(location, value);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static T Subtract<T>(T* location, T value)
+        where T : unmanaged, INumberBase<T>
+    {
+        if (typeof(T) == typeof(int) || typeof(T) == typeof(uint))
+        {
+            var subtrahend = Unsafe.BitCast<T, int>(value);
+            return Unsafe.BitCast<int, T>(Interlocked.Add(ref *(int*)location, -subtrahend) + subtrahend);
+        }
+        else if (typeof(T) == typeof(long) || typeof(T) == typeof(ulong))
+        {
+            var subtrahend = Unsafe.BitCast<T, long>(value);
+            return Unsafe.BitCast<long, T>(Interlocked.Add(ref *(long*)location, -subtrahend) + subtrahend);
+        }
+
+        return Update<T, SubtractOperation<T>>(location, value);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static T And<T>(T* location, T value)
+        where T : unmanaged, IBinaryInteger<T>
+    {
+        if (sizeof(T) == sizeof(int))
+        {
+            return Unsafe.BitCast<int, T>(Interlocked.And(ref *(int*)location, Unsafe.BitCast<T, int>(value)));
+        }
+        else if (sizeof(T) == sizeof(long))
+        {
+            return Unsafe.BitCast<long, T>(Interlocked.And(ref *(long*)location, Unsafe.BitCast<T, long>(value)));
+        }
+
+        return Update<T, AndOperation<T>>(location, value);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static T Or<T>(T* location, T value)
+        where T : unmanaged, IBinaryInteger<T>
+    {
+        if (sizeof(T) == sizeof(int))
+        {
+            return Unsafe.BitCast<int, T>(Interlocked.Or(ref *(int*)location, Unsafe.BitCast<T, int>(value)));
+        }
+        else if (sizeof(T) == sizeof(long))
+        {
+            return Unsafe.BitCast<long, T>(Interlocked.Or(ref *(long*)location, Unsafe.BitCast<T, long>(value)));
+        }
+
+        return Update<T, OrOperation<T>>(location, value);
+    }
+
+    public static T Xor<T>(T* location, T value)
+        where T : unmanaged, IBinaryInteger<T> => Update<T, XorOperation<T>>(location, value);
+
+    public static T Nand<T>(T* location, T value)
+        where T : unmanaged, IBinaryInteger<T> => Update<T, NandOperation<T>>(location, value);
+
+    /// <summary>
+    /// Signed or unsigned integer maximum, depending on <typeparamref name="T"/>.
+    /// </summary>
+    public static T Max<T>(T* location, T value)
+        where T : unmanaged, IBinaryInteger<T> => Update<T, MaxOperation<T>>(location, value);
+
+    /// <summary>
+    /// Signed or unsigned integer minimum, depending on <typeparamref name="T"/>.
+    /// </summary>
+    public static T Min<T>(T* location, T value)
+        where T : unmanaged, IBinaryInteger<T> => Update<T, MinOperation<T>>(location, value);
+
+    public static T MaxNumber<T>(T* location, T value)
+        where T : unmanaged, IFloatingPointIeee754<T> => Update<T, MaxNumberOperation<T>>(location, value);
+
+    public static T MinNumber<T>(T* location, T value)
+        where T : unmanaged, IFloatingPointIeee754<T> => Update<T, MinNumberOperation<T>>(location, value);
+
+    /// <summary>
+    /// fence seq_cst
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static void SequentiallyConsistentFence() => Interlocked.MemoryBarrier();
+
+    /// <summary>
+    /// fence acquire, fence release and fence acq_rel
+    /// </summary>
+    /// <remarks>
+    /// x86 only reorders stores after later loads, which these fences allow, so all we need
+    /// there is to stop the JIT moving memory accesses across the fence. A call that can't be
+    /// inlined does that. Elsewhere we need a real barrier.
+    /// </remarks>
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    public static void AcquireReleaseFence()
+    {
+        if (!X86Base.IsSupported)
+        {
+            Interlocked.MemoryBarrier();
+        }
+    }
+
+    /// <summary>
+    /// fence syncscope("singlethread"), which only needs to stop the JIT reordering memory accesses.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    public static void SingleThreadFence()
+    {
+    }
+
+    private static T Update<T, TOperation>(T* location, T operand)
+        where T : unmanaged
+        where TOperation : IUpdateOperation<T>
+    {
+        var original = *location;
+
+        while (true)
+        {
+            var result = CompareExchange(location, TOperation.Apply(original, operand), original);
+
+            // Compare bits rather than values, so that floating-point -0.0 and NaN work.
+            if (BitwiseEquals(result, original))
+            {
+                return original;
+            }
+
+            original = result;
+        }
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static bool BitwiseEquals<T>(T left, T right)
+        where T : unmanaged
+    {
+        if (sizeof(T) == sizeof(byte))
+        {
+            return Unsafe.BitCast<T, byte>(left) == Unsafe.BitCast<T, byte>(right);
+        }
+        else if (sizeof(T) == sizeof(ushort))
+        {
+            return Unsafe.BitCast<T, ushort>(left) == Unsafe.BitCast<T, ushort>(right);
+        }
+        else if (sizeof(T) == sizeof(int))
+        {
+            return Unsafe.BitCast<T, int>(left) == Unsafe.BitCast<T, int>(right);
+        }
+        else
+        {
+            return Unsafe.BitCast<T, long>(left) == Unsafe.BitCast<T, long>(right);
+        }
+    }
+
+    private interface IUpdateOperation<T>
+    {
+        static abstract T Apply(T current, T operand);
+    }
+
+    private readonly struct AddOperation<T> : IUpdateOperation<T>
+        where T : INumberBase<T>
+    {
+        public static T Apply(T current, T operand) => current + operand;
+    }
+
+    private readonly struct SubtractOperation<T> : IUpdateOperation<T>
+        where T : INumberBase<T>
+    {
+        public static T Apply(T current, T operand) => current - operand;
+    }
+
+    private readonly struct AndOperation<T> : IUpdateOperation<T>
+        where T : IBinaryInteger<T>
+    {
+        public static T Apply(T current, T operand) => current & operand;
+    }
+
+    private readonly struct OrOperation<T> : IUpdateOperation<T>
+        where T : IBinaryInteger<T>
+    {
+        public static T Apply(T current, T operand) => current | operand;
+    }
+
+    private readonly struct XorOperation<T> : IUpdateOperation<T>
+        where T : IBinaryInteger<T>
+    {
+        public static T Apply(T current, T operand) => current ^ operand;
+    }
+
+    private readonly struct NandOperation<T> : IUpdateOperation<T>
+        where T : IBinaryInteger<T>
+    {
+        public static T Apply(T current, T operand) => ~(current & operand);
+    }
+
+    private readonly struct MaxOperation<T> : IUpdateOperation<T>
+        where T : IBinaryInteger<T>
+    {
+        public static T Apply(T current, T operand) => T.Max(current, operand);
+    }
+
+    private readonly struct MinOperation<T> : IUpdateOperation<T>
+        where T : IBinaryInteger<T>
+    {
+        public static T Apply(T current, T operand) => T.Min(current, operand);
+    }
+
+    private readonly struct MaxNumberOperation<T> : IUpdateOperation<T>
+        where T : IFloatingPointIeee754<T>
+    {
+        public static T Apply(T current, T operand) => T.MaxNumber(current, operand);
+    }
+
+    private readonly struct MinNumberOperation<T> : IUpdateOperation<T>
+        where T : IFloatingPointIeee754<T>
+    {
+        public static T Apply(T current, T operand) => T.MinNumber(current, operand);
+    }
+}
@@ -0,0 +1,52 @@
+namespace IR2IL.Runtime;
+
+/// <summary>
+/// LLVM's bfloat type: the upper 16 bits of a float.
+/// </summary>
+/// <remarks>
+/// .NET 9 has no bfloat16 type. Like <see cref="Half"/>, arithmetic happens in float.
+/// </remarks>
+public readonly struct BFloat16
+{
+    private readonly ushort _value;
+
+    private BFloat16(ushort value) => _value = value;
+
+    public static explicit operator float(BFloat16 value) => BitConverter.Int32BitsToSingle(value._value << 16);
+
+    public static explicit operator double(BFloat16 value) => (float)value;
+
+    public static explicit operator BFloat16(float value)
+    {
+        var bits = BitConverter.SingleToUInt32Bits(value);
+
+        if (float.IsNaN(value))
+        {
+            return new BFloat16((ushort)((bits >> 16) | 0x40));
+        }
+
+        // Round to nearest, ties to even.
+        bits += 0x7FFF + ((bits >> 16) & 1);
+        return new BFloat16((ushort)(bits >> 16));
+    }
+
+    public static explicit operator BFloat16(double value)
+    {
+        var single = (float)value;
+
+        // Rounding to float and then to bfloat could round twice. Rounding towards zero and
+        // setting the lowest bit when the result is inexact ("round to odd") keeps enough
+        // information for the second rounding to be correct.
+        if (double.IsFinite(value) && single != value)
+        {
+            var bits = BitConverter.SingleToUInt32Bits(single);
+            if (Math.Abs((double)single) > Math.Abs(value))
+            {
+                bits--;
+            }
+            single = BitConverter.UInt32BitsToSingle(bits | 1);
+        }
+
+        return (BFloat16)single;
+    }
+}
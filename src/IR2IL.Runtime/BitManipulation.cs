@@ -0,0 +1,346 @@
+using System.Buffers.Binary;
+using System.Numerics;
+using System.Runtime.CompilerServices;
+using System.Runtime.Intrinsics;
+using System.Runtime.Intrinsics.X86;
+
+namespace IR2IL.Runtime;
+
+/// <summary>
+/// Implementations of LLVM's bit manipulation intrinsics (llvm.ctpop, llvm.ctlz, llvm.cttz,
+/// llvm.bswap, llvm.bitreverse, llvm.fshl and llvm.fshr) that the BCL doesn't provide.
+/// </summary>
+/// <remarks>
+/// Scalar population and zero counts use the BCL methods directly, which the JIT turns into
+/// popcnt, lzcnt and tzcnt. The vector versions work on unsigned elements. Vector64 is widened
+/// to Vector128, and Vector512 is done in two halves.
+/// </remarks>
+public static class BitManipulation
+{
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static byte BitReverse(byte value) => (byte)(BitReverse((ulong)value) >> 56);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static ushort BitReverse(ushort value) => (ushort)(BitReverse((ulong)value) >> 48);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static uint BitReverse(uint value) => (uint)(BitReverse((ulong)value) >> 32);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static ulong BitReverse(ulong value) => BinaryPrimitives.ReverseEndianness(ReverseBitsInBytes(value));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static UInt128 BitReverse(UInt128 value) => new(BitReverse((ulong)value), BitReverse((ulong)(value >> 64)));
+
+    /// <summary>
+    /// llvm.fshl: concatenates <paramref name="high"/> and <paramref name="low"/>, shifts left by
+    /// <paramref name="shiftAmount"/> modulo the bit width, and returns the upper half.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static T FunnelShiftLeft<T>(T high, T low, T shiftAmount)
+        where T : unmanaged, IBinaryInteger<T>, IUnsignedNumber<T>
+    {
+        var bitCount = GetBitCount<T>();
+        var shift = int.CreateTruncating(shiftAmount) & (bitCount - 1);
+
+        // Shifting the low half in two steps avoids shifting by the full bit width when shift is zero.
+        return (high << shift) | ((low >>> 1) >>> (bitCount - 1 - shift));
+    }
+
+    /// <summary>
+    /// llvm.fshr: concatenates <paramref name="high"/> and <paramref name="low"/>, shifts right by
+    /// <paramref name="shiftAmount"/> modulo the bit width, and returns the lower half.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static T FunnelShiftRight<T>(T high, T low, T shiftAmount)
+        where T : unmanaged, IBinaryInteger<T>, IUnsignedNumber<T>
+    {
+        var bitCount = GetBitCount<T>();
+        var shift = int.CreateTruncating(shiftAmount) & (bitCount - 1);
+
+        return (low >>> shift) | ((high << 1) << (bitCount - 1 - shift));
+    }
+
+    // Vector64
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> PopCount<T>(Vector64<T> vector)
+        where T : unmanaged, IBinaryInteger<T>, IUnsignedNumber<T> => PopCount(vector.ToVector128Unsafe()).GetLower();
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> LeadingZeroCount<T>(Vector64<T> vector)
+        where T : unmanaged, IBinaryInteger<T>, IUnsignedNumber<T> => LeadingZeroCount(vector.ToVector128Unsafe()).GetLower();
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> TrailingZeroCount<T>(Vector64<T> vector)
+        where T : unmanaged, IBinaryInteger<T>, IUnsignedNumber<T> => TrailingZeroCount(vector.ToVector128Unsafe()).GetLower();
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> ReverseEndianness<T>(Vector64<T> vector)
+        where T : unmanaged, IBinaryInteger<T>, IUnsignedNumber<T> => ReverseEndianness(vector.ToVector128Unsafe()).GetLower();
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> BitReverse<T>(Vector64<T> vector)
+        where T : unmanaged, IBinaryInteger<T>, IUnsignedNumber<T> => BitReverse(vector.ToVector128Unsafe()).GetLower();
+
+    // Vector128
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> PopCount<T>(Vector128<T> vector)
+        where T : unmanaged, IBinaryInteger<T>, IUnsignedNumber<T>
+    {
+        // Count the bits in each byte, and then add the bytes of each element together.
+        vector -= (vector >>> 1) & Vector128.Create(T.CreateTruncating(0x5555555555555555UL));
+        vector = (vector & Vector128.Create(T.CreateTruncating(0x3333333333333333UL)))
+            + ((vector >>> 2) & Vector128.Create(T.CreateTruncating(0x3333333333333333UL)));
+        vector = (vector + (vector >>> 4)) & Vector128.Create(T.CreateTruncating(0x0F0F0F0F0F0F0F0FUL));
+
+        if (Unsafe.SizeOf<T>() >= 2)
+        {
+            vector += vector >>> 8;
+        }
+        if (Unsafe.SizeOf<T>() >= 4)
+        {
+            vector += vector >>> 16;
+        }
+        if (Unsafe.SizeOf<T>() >= 8)
+        {
+            vector += vector >>> 32;
+        }
+
+        return vector & Vector128.Create(T.CreateTruncating(GetBitCount<T>() * 2 - 1));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> LeadingZeroCount<T>(Vector128<T> vector)
+        where T : unmanaged, IBinaryInteger<T>, IUnsignedNumber<T>
+    {
+        if (Avx512CD.VL.IsSupported)
+        {
+            if (typeof(T) == typeof(uint))
+            {
+                return Avx512CD.VL.LeadingZeroCount(vector.AsUInt32()).As<uint, T>();
+            }
+            else if (typeof(T) == typeof(ulong))
+            {
+                return Avx512CD.VL.LeadingZeroCount(vector.AsUInt64()).As<ulong, T>();
+            }
+        }
+
+        // Smear the highest set bit into all the bits below it, and count the bits that are still clear.
+        vector |= vector >>> 1;
+        vector |= vector >>> 2;
+        vector |= vector >>> 4;
+        if (Unsafe.SizeOf<T>() >= 2)
+        {
+            vector |= vector >>> 8;
+        }
+        if (Unsafe.SizeOf<T>() >= 4)
+        {
+            vector |= vector >>> 16;
+        }
+        if (Unsafe.SizeOf<T>() >= 8)
+        {
+            vector |= vector >>> 32;
+        }
+
+        return PopCount(~vector);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> TrailingZeroCount<T>(Vector128<T> vector)
+        where T : unmanaged, IBinaryInteger<T>, IUnsignedNumber<T>
+    {
+        // The trailing zeros become the only set bits.
+        return PopCount(~vector & (vector - Vector128<T>.One));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> ReverseEndianness<T>(Vector128<T> vector)
+        where T : unmanaged, IBinaryInteger<T>, IUnsignedNumber<T>
+    {
+        // Constant byte shuffles become pshufb.
+        if (Unsafe.SizeOf<T>() == 2)
+        {
+            return Vector128.Shuffle(vector.AsByte(), Vector128.Create((byte)1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14)).As<byte, T>();
+        }
+        else if (Unsafe.SizeOf<T>() == 4)
+        {
+            return Vector128.Shuffle(vector.AsByte(), Vector128.Create((byte)3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)).As<byte, T>();
+        }
+        else if (Unsafe.SizeOf<T>() == 8)
+        {
+            return Vector128.Shuffle(vector.AsByte(), Vector128.Create((byte)7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8)).As<byte, T>();
+        }
+
+        return vector;
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> BitReverse<T>(Vector128<T> vector)
+        where T : unmanaged, IBinaryInteger<T>, IUnsignedNumber<T>
+    {
+        vector = ReverseEndianness(vector);
+
+        var mask1 = Vector128.Create(T.CreateTruncating(0x5555555555555555UL));
+        var mask2 = Vector128.Create(T.CreateTruncating(0x3333333333333333UL));
+        var mask4 = Vector128.Create(T.CreateTruncating(0x0F0F0F0F0F0F0F0FUL));
+
+        vector = ((vector >>> 1) & mask1) | ((vector & mask1) << 1);
+        vector = ((vector >>> 2) & mask2) | ((vector & mask2) << 2);
+        return ((vector >>> 4) & mask4) | ((vector & mask4) << 4);
+    }
+
+    // Vector256
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> PopCount<T>(Vector256<T> vector)
+        where T : unmanaged, IBinaryInteger<T>, IUnsignedNumber<T>
+    {
+        vector -= (vector >>> 1) & Vector256.Create(T.CreateTruncating(0x5555555555555555UL));
+        vector = (vector & Vector256.Create(T.CreateTruncating(0x3333333333333333UL)))
+            + ((vector >>> 2) & Vector256.Create(T.CreateTruncating(0x3333333333333333UL)));
+        vector = (vector + (vector >>> 4)) & Vector256.Create(T.CreateTruncating(0x0F0F0F0F0F0F0F0FUL));
+
+        if (Unsafe.SizeOf<T>() >= 2)
+        {
+            vector += vector >>> 8;
+        }
+        if (Unsafe.SizeOf<T>() >= 4)
+        {
+            vector += vector >>> 16;
+        }
+        if (Unsafe.SizeOf<T>() >= 8)
+        {
+            vector += vector >>> 32;
+        }
+
+        return vector & Vector256.Create(T.CreateTruncating(GetBitCount<T>() * 2 - 1));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> LeadingZeroCount<T>(Vector256<T> vector)
+        where T : unmanaged, IBinaryInteger<T>, IUnsignedNumber<T>
+    {
+        if (Avx512CD.VL.IsSupported)
+        {
+            if (typeof(T) == typeof(uint))
+            {
+                return Avx512CD.VL.LeadingZeroCount(vector.AsUInt32()).As<uint, T>();
+            }
+            else if (typeof(T) == typeof(ulong))
+            {
+                return Avx512CD.VL.LeadingZeroCount(vector.AsUInt64()).As<ulong, T>();
+            }
+        }
+
+        vector |= vector >>> 1;
+        vector |= vector >>> 2;
+        vector |= vector >>> 4;
+        if (Unsafe.SizeOf<T>() >= 2)
+        {
+            vector |= vector >>> 8;
+        }
+        if (Unsafe.SizeOf<T>() >= 4)
+        {
+            vector |= vector >>> 16;
+        }
+        if (Unsafe.SizeOf<T>() >= 8)
+        {
+            vector |= vector >>> 32;
+        }
+
+        return PopCount(~vector);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> TrailingZeroCount<T>(Vector256<T> vector)
+        where T : unmanaged, IBinaryInteger<T>, IUnsignedNumber<T>
+    {
+        return PopCount(~vector & (vector - Vector256<T>.One));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> ReverseEndianness<T>(Vector256<T> vector)
+        where T : unmanaged, IBinaryInteger<T>, IUnsignedNumber<T>
+    {
+        // Each 128-bit half is shuffled the same way, which vpshufb can do.
+        if (Unsafe.SizeOf<T>() == 2)
+        {
+            return Vector256.Shuffle(vector.AsByte(), Vector256.Create((byte)1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 17, 16, 19, 18, 21, 20, 23, 22, 25, 24, 27, 26, 29, 28, 31, 30)).As<byte, T>();
+        }
+        else if (Unsafe.SizeOf<T>() == 4)
+        {
+            return Vector256.Shuffle(vector.AsByte(), Vector256.Create((byte)3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 19, 18, 17, 16, 23, 22, 21, 20, 27, 26, 25, 24, 31, 30, 29, 28)).As<byte, T>();
+        }
+        else if (Unsafe.SizeOf<T>() == 8)
+        {
+            return Vector256.Shuffle(vector.AsByte(), Vector256.Create((byte)7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 23, 22, 21, 20, 19, 18, 17, 16, 31, 30, 29, 28, 27, 26, 25, 24)).As<byte, T>();
+        }
+
+        return vector;
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> BitReverse<T>(Vector256<T> vector)
+        where T : unmanaged, IBinaryInteger<T>, IUnsignedNumber<T>
+    {
+        vector = ReverseEndianness(vector);
+
+        var mask1 = Vector256.Create(T.CreateTruncating(0x5555555555555555UL));
+        var mask2 = Vector256.Create(T.CreateTruncating(0x3333333333333333UL));
+        var mask4 = Vector256.Create(T.CreateTruncating(0x0F0F0F0F0F0F0F0FUL));
+
+        vector = ((vector >>> 1) & mask1) | ((vector & mask1) << 1);
+        vector = ((vector >>> 2) & mask2) | ((vector & mask2) << 2);
+        return ((vector >>> 4) & mask4) | ((vector & mask4) << 4);
+    }
+
+    // Vector512
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> PopCount<T>(Vector512<T> vector)
+        where T : unmanaged, IBinaryInteger<T>, IUnsignedNumber<T> => Vector512.Create(PopCount(vector.GetLower()), PopCount(vector.GetUpper()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> LeadingZeroCount<T>(Vector512<T> vector)
+        where T : unmanaged, IBinaryInteger<T>, IUnsignedNumber<T>
+    {
+        if (Avx512CD.IsSupported)
+        {
+            if (typeof(T) == typeof(uint))
+            {
+                return Avx512CD.LeadingZeroCount(vector.AsUInt32()).As<uint, T>();
+            }
+            else if (typeof(T) == typeof(ulong))
+            {
+                return Avx512CD.LeadingZeroCount(vector.AsUInt64()).As<ulong, T>();
+            }
+        }
+
+        return Vector512.Create(LeadingZeroCount(vector.GetLower()), LeadingZeroCount(vector.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> TrailingZeroCount<T>(Vector512<T> vector)
+        where T : unmanaged, IBinaryInteger<T>, IUnsignedNumber<T> => Vector512.Create(TrailingZeroCount(vector.GetLower()), TrailingZeroCount(vector.GetUpper()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> ReverseEndianness<T>(Vector512<T> vector)
+        where T : unmanaged, IBinaryInteger<T>, IUnsignedNumber<T> => Vector512.Create(ReverseEndianness(vector.GetLower()), ReverseEndianness(vector.GetUpper()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> BitReverse<T>(Vector512<T> vector)
+        where T : unmanaged, IBinaryInteger<T>, IUnsignedNumber<T> => Vector512.Create(BitReverse(vector.GetLower()), BitReverse(vector.GetUpper()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static ulong ReverseBitsInBytes(ulong value)
+    {
+        value = ((value >> 1) & 0x5555555555555555UL) | ((value & 0x5555555555555555UL) << 1);
+        value = ((value >> 2) & 0x3333333333333333UL) | ((value & 0x3333333333333333UL) << 2);
+        return ((value >> 4) & 0x0F0F0F0F0F0F0F0FUL) | ((value & 0x0F0F0F0F0F0F0F0FUL) << 4);
+    }
+
+    private static unsafe int GetBitCount<T>()
+        where T : unmanaged => sizeof(T) * 8;
+}
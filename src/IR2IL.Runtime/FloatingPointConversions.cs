@@ -0,0 +1,205 @@
+using System.Runtime.CompilerServices;
+using System.Runtime.Intrinsics;
+using System.Runtime.Intrinsics.X86;
+
+namespace IR2IL.Runtime;
+
+/// <summary>
+/// Scalar fptosi and fptoui, and llvm.fptosi.sat and llvm.fptoui.sat.
+/// </summary>
+/// <remarks>
+/// Since .NET 9, conv.i4, conv.i8 and the others saturate values that are out of range and turn NaN into 0,
+/// which on x64 takes a compare and a fixup after the conversion instruction. fptosi and fptoui are poison
+/// when the truncated value doesn't fit, and C makes that undefined, so they use the truncating instructions
+/// on their own. Arm64's conversion instructions saturate anyway, so there the casts cost nothing extra.
+///
+/// llvm.fptosi.sat and llvm.fptoui.sat do need the saturation, and work for any width up to 64 bits.
+/// On vectors, whose elements are 8, 16, 32 or 64 bits, they're done one lane at a time.
+/// </remarks>
+public static class FloatingPointConversions
+{
+    // fptosi and fptoui. Narrower integers are converted to int32 and truncated, and u32 is converted to i64,
+    // because every value they can hold is in range.
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static int ConvertToInt32(float value) => Sse.IsSupported
+        ? Sse.ConvertToInt32WithTruncation(Vector128.CreateScalarUnsafe(value))
+        : (int)value;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static int ConvertToInt32(double value) => Sse2.IsSupported
+        ? Sse2.ConvertToInt32WithTruncation(Vector128.CreateScalarUnsafe(value))
+        : (int)value;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static long ConvertToInt64(float value) => Sse.X64.IsSupported
+        ? Sse.X64.ConvertToInt64WithTruncation(Vector128.CreateScalarUnsafe(value))
+        : (long)value;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static long ConvertToInt64(double value) => Sse2.X64.IsSupported
+        ? Sse2.X64.ConvertToInt64WithTruncation(Vector128.CreateScalarUnsafe(value))
+        : (long)value;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static uint ConvertToUInt32(float value)
+    {
+        if (Avx512F.IsSupported)
+        {
+            return Avx512F.ConvertToUInt32WithTruncation(Vector128.CreateScalarUnsafe(value));
+        }
+
+        return Sse.X64.IsSupported
+            ? (uint)Sse.X64.ConvertToInt64WithTruncation(Vector128.CreateScalarUnsafe(value))
+            : (uint)value;
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static uint ConvertToUInt32(double value)
+    {
+        if (Avx512F.IsSupported)
+        {
+            return Avx512F.ConvertToUInt32WithTruncation(Vector128.CreateScalarUnsafe(value));
+        }
+
+        return Sse2.X64.IsSupported
+            ? (uint)Sse2.X64.ConvertToInt64WithTruncation(Vector128.CreateScalarUnsafe(value))
+            : (uint)value;
+    }
+
+    /// <remarks>
+    /// Without AVX-512, values of 2^63 and above don't fit a signed conversion, which gives 0x8000000000000000
+    /// for them. In that case the sign bit of that result selects the conversion of the value minus 2^63,
+    /// and ORing in the sign bit adds the 2^63 back.
+    /// </remarks>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static ulong ConvertToUInt64(float value)
+    {
+        if (Avx512F.X64.IsSupported)
+        {
+            return Avx512F.X64.ConvertToUInt64WithTruncation(Vector128.CreateScalarUnsafe(value));
+        }
+
+        if (Sse.X64.IsSupported)
+        {
+            var lower = Sse.X64.ConvertToInt64WithTruncation(Vector128.CreateScalarUnsafe(value));
+            var upper = Sse.X64.ConvertToInt64WithTruncation(Vector128.CreateScalarUnsafe(value - 9223372036854775808f));
+            return (ulong)(lower | (upper & (lower >> 63)));
+        }
+
+        return (ulong)value;
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static ulong ConvertToUInt64(double value)
+    {
+        if (Avx512F.X64.IsSupported)
+        {
+            return Avx512F.X64.ConvertToUInt64WithTruncation(Vector128.CreateScalarUnsafe(value));
+        }
+
+        if (Sse2.X64.IsSupported)
+        {
+            var lower = Sse2.X64.ConvertToInt64WithTruncation(Vector128.CreateScalarUnsafe(value));
+            var upper = Sse2.X64.ConvertToInt64WithTruncation(Vector128.CreateScalarUnsafe(value - 9223372036854775808.0));
+            return (ulong)(lower | (upper & (lower >> 63)));
+        }
+
+        return (ulong)value;
+    }
+
+    // llvm.fptosi.sat and llvm.fptoui.sat. Floats are widened to double first, which is exact.
+
+    /// <summary>
+    /// Converts <paramref name="value"/> to a signed <paramref name="bitCount"/>-bit integer,
+    /// clamping it to that integer's range, with NaN becoming 0.
+    /// </summary>
+    public static long ConvertToSignedSaturating(double value, int bitCount)
+    {
+        var max = long.MaxValue >> (64 - bitCount);
+        var min = -max - 1;
+
+        if (double.IsNaN(value))
+        {
+            return 0;
+        }
+        else if (value <= min)
+        {
+            return min;
+        }
+        else if (value >= max)
+        {
+            return max;
+        }
+
+        return ConvertToInt64(value);
+    }
+
+    /// <summary>
+    /// Converts <paramref name="value"/> to an unsigned <paramref name="bitCount"/>-bit integer,
+    /// clamping it to that integer's range, with NaN becoming 0.
+    /// </summary>
+    public static ulong ConvertToUnsignedSaturating(double value, int bitCount)
+    {
+        var max = ulong.MaxValue >> (64 - bitCount);
+
+        // This is false for NaN.
+        if (!(value > 0))
+        {
+            return 0;
+        }
+        else if (value >= max)
+        {
+            return max;
+        }
+
+        return ConvertToUInt64(value);
+    }
+
+    // Vector llvm.fptosi.sat and llvm.fptoui.sat, where TFrom is float or double, TTo is the integer element type,
+    // and TVector and TResult are the vector types. Padded vectors have the same number of lanes on both sides,
+    // except that the smallest vectors can have more lanes of narrow elements than of wide ones.
+
+    public static TResult ConvertToSignedSaturating<TFrom, TTo, TVector, TResult>(TVector vector)
+        where TFrom : unmanaged
+        where TTo : unmanaged
+        where TVector : unmanaged
+        where TResult : unmanaged
+    {
+        var result = default(TResult);
+        var laneCount = Math.Min(Unsafe.SizeOf<TVector>() / Unsafe.SizeOf<TFrom>(), Unsafe.SizeOf<TResult>() / Unsafe.SizeOf<TTo>());
+
+        for (var lane = 0; lane < laneCount; lane++)
+        {
+            var converted = ConvertToSignedSaturating(GetLane<TFrom, TVector>(ref vector, lane), Unsafe.SizeOf<TTo>() * 8);
+            Unsafe.Add(ref Unsafe.As<TResult, TTo>(ref result), lane) = Unsafe.As<long, TTo>(ref converted);
+        }
+
+        return result;
+    }
+
+    public static TResult ConvertToUnsignedSaturating<TFrom, TTo, TVector, TResult>(TVector vector)
+        where TFrom : unmanaged
+        where TTo : unmanaged
+        where TVector : unmanaged
+        where TResult : unmanaged
+    {
+        var result = default(TResult);
+        var laneCount = Math.Min(Unsafe.SizeOf<TVector>() / Unsafe.SizeOf<TFrom>(), Unsafe.SizeOf<TResult>() / Unsafe.SizeOf<TTo>());
+
+        for (var lane = 0; lane < laneCount; lane++)
+        {
+            var converted = ConvertToUnsignedSaturating(GetLane<TFrom, TVector>(ref vector, lane), Unsafe.SizeOf<TTo>() * 8);
+            Unsafe.Add(ref Unsafe.As<TResult, TTo>(ref result), lane) = Unsafe.As<ulong, TTo>(ref converted);
+        }
+
+        return result;
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static double GetLane<TFrom, TVector>(ref TVector vector, int lane)
+        where TFrom : unmanaged
+        where TVector : unmanaged => typeof(TFrom) == typeof(float)
+        ? Unsafe.Add(ref Unsafe.As<TVector, float>(ref vector), lane)
+        : Unsafe.Add(ref Unsafe.As<TVector, double>(ref vector), lane);
+}
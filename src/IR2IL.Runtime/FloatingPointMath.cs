@@ -0,0 +1,374 @@
+using System.Numerics;
+using System.Runtime.CompilerServices;
+using System.Runtime.Intrinsics;
+using System.Runtime.Intrinsics.X86;
+
+namespace IR2IL.Runtime;
+
+/// <summary>
+/// Implementations of LLVM's floating-point intrinsics that have no exact equivalent in
+/// <see cref="Math"/>, <see cref="MathF"/> or the VectorN classes: llvm.round, llvm.powi,
+/// and vector versions of llvm.trunc, llvm.roundeven, llvm.minnum, llvm.maxnum,
+/// llvm.minimum and llvm.maximum.
+/// </summary>
+/// <remarks>
+/// Vector methods are only called with float and double elements.
+/// <list type="bullet">
+/// <item>Max and Min are llvm.maximum and llvm.minimum: NaN if either operand is NaN, and -0 is less than +0,
+/// the same as <see cref="Math.Max(double, double)"/>.</item>
+/// <item>MaxNumber and MinNumber are llvm.maxnum and llvm.minnum: if one operand is NaN, the result is the other.</item>
+/// </list>
+/// </remarks>
+public static class FloatingPointMath
+{
+    /// <summary>
+    /// llvm.round rounds halfway cases away from zero, unlike <see cref="Math.Round(double)"/>.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static T RoundAwayFromZero<T>(T value)
+        where T : IFloatingPointIeee754<T> => T.Round(value, MidpointRounding.AwayFromZero);
+
+    /// <summary>
+    /// llvm.powi multiplies by repeated squaring, like compiler-rt's __powidf2,
+    /// which doesn't always give the same result as <see cref="Math.Pow(double, double)"/>.
+    /// </summary>
+    public static T PowInteger<T>(T value, int exponent)
+        where T : IFloatingPointIeee754<T>
+    {
+        var isReciprocal = exponent < 0;
+        var result = T.One;
+
+        while (true)
+        {
+            if ((exponent & 1) != 0)
+            {
+                result *= value;
+            }
+            exponent /= 2;
+            if (exponent == 0)
+            {
+                break;
+            }
+            value *= value;
+        }
+
+        return isReciprocal ? T.One / result : result;
+    }
+
+    // Vector64
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> Truncate<T>(Vector64<T> vector)
+        where T : unmanaged, IFloatingPointIeee754<T> => Truncate(vector.ToVector128Unsafe()).GetLower();
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> Round<T>(Vector64<T> vector)
+        where T : unmanaged, IFloatingPointIeee754<T> => Round(vector.ToVector128Unsafe()).GetLower();
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> RoundAwayFromZero<T>(Vector64<T> vector)
+        where T : unmanaged, IFloatingPointIeee754<T> => RoundAwayFromZero(vector.ToVector128Unsafe()).GetLower();
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> Max<T>(Vector64<T> left, Vector64<T> right)
+        where T : unmanaged, IFloatingPointIeee754<T> => Max(left.ToVector128Unsafe(), right.ToVector128Unsafe()).GetLower();
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> Min<T>(Vector64<T> left, Vector64<T> right)
+        where T : unmanaged, IFloatingPointIeee754<T> => Min(left.ToVector128Unsafe(), right.ToVector128Unsafe()).GetLower();
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> MaxNumber<T>(Vector64<T> left, Vector64<T> right)
+        where T : unmanaged, IFloatingPointIeee754<T> => MaxNumber(left.ToVector128Unsafe(), right.ToVector128Unsafe()).GetLower();
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> MinNumber<T>(Vector64<T> left, Vector64<T> right)
+        where T : unmanaged, IFloatingPointIeee754<T> => MinNumber(left.ToVector128Unsafe(), right.ToVector128Unsafe()).GetLower();
+
+    public static Vector64<T> PowInteger<T>(Vector64<T> vector, int exponent)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        for (var i = 0; i < Vector64<T>.Count; i++)
+        {
+            vector = vector.WithElement(i, PowInteger(vector.GetElement(i), exponent));
+        }
+        return vector;
+    }
+
+    // Vector128
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> Truncate<T>(Vector128<T> vector)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        if (Sse41.IsSupported)
+        {
+            if (typeof(T) == typeof(float))
+            {
+                return Sse41.RoundToZero(vector.AsSingle()).As<float, T>();
+            }
+            else if (typeof(T) == typeof(double))
+            {
+                return Sse41.RoundToZero(vector.AsDouble()).As<double, T>();
+            }
+        }
+
+        // Round the magnitude to the nearest integer, and step back if that went up.
+        var magnitude = Vector128.Abs(vector);
+        var rounded = RoundMagnitude(magnitude);
+        rounded -= Vector128.GreaterThan(rounded, magnitude) & Vector128<T>.One;
+        return CopySign(rounded, vector);
+    }
+
+    /// <summary>
+    /// llvm.roundeven, llvm.rint and llvm.nearbyint, which round halfway cases to even.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> Round<T>(Vector128<T> vector)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        if (Sse41.IsSupported)
+        {
+            if (typeof(T) == typeof(float))
+            {
+                return Sse41.RoundToNearestInteger(vector.AsSingle()).As<float, T>();
+            }
+            else if (typeof(T) == typeof(double))
+            {
+                return Sse41.RoundToNearestInteger(vector.AsDouble()).As<double, T>();
+            }
+        }
+
+        return CopySign(RoundMagnitude(Vector128.Abs(vector)), vector);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> RoundAwayFromZero<T>(Vector128<T> vector)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        var truncated = Truncate(vector);
+        var fraction = Vector128.Abs(vector - truncated);
+        var adjustment = Vector128.GreaterThanOrEqual(fraction, Vector128.Create(T.One / (T.One + T.One))) & Vector128<T>.One;
+        return CopySign(Vector128.Abs(truncated) + adjustment, vector);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> Max<T>(Vector128<T> left, Vector128<T> right)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        // When the operands are equal, ANDing them picks +0 over -0.
+        var result = Vector128.ConditionalSelect(Vector128.GreaterThan(left, right), left, right);
+        result = Vector128.ConditionalSelect(Vector128.Equals(left, right), left & right, result);
+        return Vector128.ConditionalSelect(Vector128.Equals(left, left), result, left);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> Min<T>(Vector128<T> left, Vector128<T> right)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        // When the operands are equal, ORing them picks -0 over +0.
+        var result = Vector128.ConditionalSelect(Vector128.LessThan(left, right), left, right);
+        result = Vector128.ConditionalSelect(Vector128.Equals(left, right), left | right, result);
+        return Vector128.ConditionalSelect(Vector128.Equals(left, left), result, left);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> MaxNumber<T>(Vector128<T> left, Vector128<T> right)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        var result = Vector128.ConditionalSelect(Vector128.GreaterThan(left, right), left, right);
+        result = Vector128.ConditionalSelect(Vector128.Equals(left, right), left & right, result);
+        return Vector128.ConditionalSelect(Vector128.Equals(right, right), result, left);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> MinNumber<T>(Vector128<T> left, Vector128<T> right)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        var result = Vector128.ConditionalSelect(Vector128.LessThan(left, right), left, right);
+        result = Vector128.ConditionalSelect(Vector128.Equals(left, right), left | right, result);
+        return Vector128.ConditionalSelect(Vector128.Equals(right, right), result, left);
+    }
+
+    public static Vector128<T> PowInteger<T>(Vector128<T> vector, int exponent)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        for (var i = 0; i < Vector128<T>.Count; i++)
+        {
+            vector = vector.WithElement(i, PowInteger(vector.GetElement(i), exponent));
+        }
+        return vector;
+    }
+
+    // Vector256
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> Truncate<T>(Vector256<T> vector)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        if (Avx.IsSupported)
+        {
+            if (typeof(T) == typeof(float))
+            {
+                return Avx.RoundToZero(vector.AsSingle()).As<float, T>();
+            }
+            else if (typeof(T) == typeof(double))
+            {
+                return Avx.RoundToZero(vector.AsDouble()).As<double, T>();
+            }
+        }
+
+        return Vector256.Create(Truncate(vector.GetLower()), Truncate(vector.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> Round<T>(Vector256<T> vector)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        if (Avx.IsSupported)
+        {
+            if (typeof(T) == typeof(float))
+            {
+                return Avx.RoundToNearestInteger(vector.AsSingle()).As<float, T>();
+            }
+            else if (typeof(T) == typeof(double))
+            {
+                return Avx.RoundToNearestInteger(vector.AsDouble()).As<double, T>();
+            }
+        }
+
+        return Vector256.Create(Round(vector.GetLower()), Round(vector.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> RoundAwayFromZero<T>(Vector256<T> vector)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        var truncated = Truncate(vector);
+        var fraction = Vector256.Abs(vector - truncated);
+        var adjustment = Vector256.GreaterThanOrEqual(fraction, Vector256.Create(T.One / (T.One + T.One))) & Vector256<T>.One;
+        return CopySign(Vector256.Abs(truncated) + adjustment, vector);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> Max<T>(Vector256<T> left, Vector256<T> right)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        var result = Vector256.ConditionalSelect(Vector256.GreaterThan(left, right), left, right);
+        result = Vector256.ConditionalSelect(Vector256.Equals(left, right), left & right, result);
+        return Vector256.ConditionalSelect(Vector256.Equals(left, left), result, left);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> Min<T>(Vector256<T> left, Vector256<T> right)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        var result = Vector256.ConditionalSelect(Vector256.LessThan(left, right), left, right);
+        result = Vector256.ConditionalSelect(Vector256.Equals(left, right), left | right, result);
+        return Vector256.ConditionalSelect(Vector256.Equals(left, left), result, left);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> MaxNumber<T>(Vector256<T> left, Vector256<T> right)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        var result = Vector256.ConditionalSelect(Vector256.GreaterThan(left, right), left, right);
+        result = Vector256.ConditionalSelect(Vector256.Equals(left, right), left & right, result);
+        return Vector256.ConditionalSelect(Vector256.Equals(right, right), result, left);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> MinNumber<T>(Vector256<T> left, Vector256<T> right)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        var result = Vector256.ConditionalSelect(Vector256.LessThan(left, right), left, right);
+        result = Vector256.ConditionalSelect(Vector256.Equals(left, right), left | right, result);
+        return Vector256.ConditionalSelect(Vector256.Equals(right, right), result, left);
+    }
+
+    public static Vector256<T> PowInteger<T>(Vector256<T> vector, int exponent)
+        where T : unmanaged, IFloatingPointIeee754<T> => Vector256.Create(PowInteger(vector.GetLower(), exponent), PowInteger(vector.GetUpper(), exponent));
+
+    // Vector512
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> Truncate<T>(Vector512<T> vector)
+        where T : unmanaged, IFloatingPointIeee754<T> => Vector512.Create(Truncate(vector.GetLower()), Truncate(vector.GetUpper()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> Round<T>(Vector512<T> vector)
+        where T : unmanaged, IFloatingPointIeee754<T> => Vector512.Create(Round(vector.GetLower()), Round(vector.GetUpper()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> RoundAwayFromZero<T>(Vector512<T> vector)
+        where T : unmanaged, IFloatingPointIeee754<T> => Vector512.Create(RoundAwayFromZero(vector.GetLower()), RoundAwayFromZero(vector.GetUpper()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> Max<T>(Vector512<T> left, Vector512<T> right)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        var result = Vector512.ConditionalSelect(Vector512.GreaterThan(left, right), left, right);
+        result = Vector512.ConditionalSelect(Vector512.Equals(left, right), left & right, result);
+        return Vector512.ConditionalSelect(Vector512.Equals(left, left), result, left);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> Min<T>(Vector512<T> left, Vector512<T> right)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        var result = Vector512.ConditionalSelect(Vector512.LessThan(left, right), left, right);
+        result = Vector512.ConditionalSelect(Vector512.Equals(left, right), left | right, result);
+        return Vector512.ConditionalSelect(Vector512.Equals(left, left), result, left);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> MaxNumber<T>(Vector512<T> left, Vector512<T> right)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        var result = Vector512.ConditionalSelect(Vector512.GreaterThan(left, right), left, right);
+        result = Vector512.ConditionalSelect(Vector512.Equals(left, right), left & right, result);
+        return Vector512.ConditionalSelect(Vector512.Equals(right, right), result, left);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> MinNumber<T>(Vector512<T> left, Vector512<T> right)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        var result = Vector512.ConditionalSelect(Vector512.LessThan(left, right), left, right);
+        result = Vector512.ConditionalSelect(Vector512.Equals(left, right), left | right, result);
+        return Vector512.ConditionalSelect(Vector512.Equals(right, right), result, left);
+    }
+
+    public static Vector512<T> PowInteger<T>(Vector512<T> vector, int exponent)
+        where T : unmanaged, IFloatingPointIeee754<T> => Vector512.Create(PowInteger(vector.GetLower(), exponent), PowInteger(vector.GetUpper(), exponent));
+
+    /// <summary>
+    /// Rounds non-negative values to the nearest integer, with halfway cases going to even.
+    /// Adding 2^52 (or 2^23 for float) leaves no bits for a fraction, so the addition does the rounding.
+    /// Values at least that large, and NaN, are already integers or can't be rounded.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<T> RoundMagnitude<T>(Vector128<T> magnitude)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        var threshold = Vector128.Create(T.CreateTruncating(Unsafe.SizeOf<T>() == 8 ? 4503599627370496.0 : 8388608.0));
+        var rounded = (magnitude + threshold) - threshold;
+        return Vector128.ConditionalSelect(Vector128.LessThan(magnitude, threshold), rounded, magnitude);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<T> CopySign<T>(Vector128<T> magnitude, Vector128<T> sign)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        var signMask = Vector128.Create(T.NegativeZero);
+        return Vector128.ConditionalSelect(signMask, sign, magnitude);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector256<T> CopySign<T>(Vector256<T> magnitude, Vector256<T> sign)
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        var signMask = Vector256.Create(T.NegativeZero);
+        return Vector256.ConditionalSelect(signMask, sign, magnitude);
+    }
+}
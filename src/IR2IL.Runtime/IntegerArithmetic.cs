@@ -0,0 +1,371 @@
+using System.Numerics;
+using System.Runtime.CompilerServices;
+using System.Runtime.Intrinsics;
+using System.Runtime.Intrinsics.X86;
+
+namespace IR2IL.Runtime;
+
+/// <summary>
+/// Implementations of LLVM's integer arithmetic intrinsics: llvm.abs, the saturating
+/// llvm.[su]add.sat and llvm.[su]sub.sat, and the llvm.[su]{add,sub,mul}.with.overflow family.
+/// </summary>
+/// <remarks>
+/// Whether an operation is signed or unsigned depends on <c>T</c>. Overflow is worked out
+/// from the result's bits rather than with branches, so the JIT can use setcc and cmov.
+/// </remarks>
+public static class IntegerArithmetic
+{
+    /// <summary>
+    /// Unlike <see cref="Math.Abs(int)"/>, the absolute value of the minimum value is itself, rather than an exception.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static T Abs<T>(T value)
+        where T : unmanaged, IBinaryInteger<T>, ISignedNumber<T>
+    {
+        var sign = value >> (GetBitCount<T>() - 1);
+        return (value ^ sign) - sign;
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static T AddSaturate<T>(T left, T right)
+        where T : unmanaged, IBinaryInteger<T>, IMinMaxValue<T>
+    {
+        var result = AddWithOverflow(left, right, out var overflow);
+        return overflow ? GetSaturatedValue(left) : result;
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static T SubtractSaturate<T>(T left, T right)
+        where T : unmanaged, IBinaryInteger<T>, IMinMaxValue<T>
+    {
+        var result = SubtractWithOverflow(left, right, out var overflow);
+
+        // Unsigned subtraction can only overflow downwards.
+        return overflow
+            ? (IsSigned<T>() ? GetSaturatedValue(left) : T.Zero)
+            : result;
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static T AddWithOverflow<T>(T left, T right, out bool overflow)
+        where T : unmanaged, IBinaryInteger<T>, IMinMaxValue<T>
+    {
+        var result = left + right;
+
+        overflow = IsSigned<T>()
+            ? T.IsNegative((left ^ result) & (right ^ result)) // Both operands have a different sign to the result.
+            : result < left; // The carry out.
+
+        return result;
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static T SubtractWithOverflow<T>(T left, T right, out bool overflow)
+        where T : unmanaged, IBinaryInteger<T>, IMinMaxValue<T>
+    {
+        var result = left - right;
+
+        overflow = IsSigned<T>()
+            ? T.IsNegative((left ^ right) & (left ^ result)) // The operands' signs differ, and the result's sign isn't the left operand's.
+            : left < right; // The borrow.
+
+        return result;
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static unsafe T MultiplyWithOverflow<T>(T left, T right, out bool overflow)
+        where T : unmanaged, IBinaryInteger<T>, IMinMaxValue<T>
+    {
+        if (sizeof(T) < sizeof(long))
+        {
+            // The full product fits in 64 bits.
+            if (IsSigned<T>())
+            {
+                var product = long.CreateTruncating(left) * long.CreateTruncating(right);
+                overflow = product != long.CreateTruncating(T.CreateTruncating(product));
+                return T.CreateTruncating(product);
+            }
+            else
+            {
+                var product = ulong.CreateTruncating(left) * ulong.CreateTruncating(right);
+                overflow = product > ulong.CreateTruncating(T.MaxValue);
+                return T.CreateTruncating(product);
+            }
+        }
+        else if (sizeof(T) == sizeof(long))
+        {
+            if (IsSigned<T>())
+            {
+                var high = Math.BigMul(long.CreateTruncating(left), long.CreateTruncating(right), out var low);
+
+                // The upper half must be the sign extension of the lower half.
+                overflow = high != (low >> 63);
+                return T.CreateTruncating(low);
+            }
+            else
+            {
+                var high = Math.BigMul(ulong.CreateTruncating(left), ulong.CreateTruncating(right), out var low);
+                overflow = high != 0;
+                return T.CreateTruncating(low);
+            }
+        }
+        else
+        {
+            // 128-bit: check the product by dividing it back out. Rare enough not to be worth a wider multiply.
+            var result = left * right;
+            overflow = left != T.Zero
+                && ((IsSigned<T>() && left == -T.One && right == T.MinValue) || result / left != right);
+            return result;
+        }
+    }
+
+    // Vector64
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> AddSaturate<T>(Vector64<T> left, Vector64<T> right)
+        where T : unmanaged, IBinaryInteger<T>, IMinMaxValue<T> => AddSaturate(left.ToVector128Unsafe(), right.ToVector128Unsafe()).GetLower();
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> SubtractSaturate<T>(Vector64<T> left, Vector64<T> right)
+        where T : unmanaged, IBinaryInteger<T>, IMinMaxValue<T> => SubtractSaturate(left.ToVector128Unsafe(), right.ToVector128Unsafe()).GetLower();
+
+    // Vector128
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> AddSaturate<T>(Vector128<T> left, Vector128<T> right)
+        where T : unmanaged, IBinaryInteger<T>, IMinMaxValue<T>
+    {
+        if (Sse2.IsSupported)
+        {
+            if (typeof(T) == typeof(byte))
+            {
+                return Sse2.AddSaturate(left.AsByte(), right.AsByte()).As<byte, T>();
+            }
+            else if (typeof(T) == typeof(sbyte))
+            {
+                return Sse2.AddSaturate(left.AsSByte(), right.AsSByte()).As<sbyte, T>();
+            }
+            else if (typeof(T) == typeof(short))
+            {
+                return Sse2.AddSaturate(left.AsInt16(), right.AsInt16()).As<short, T>();
+            }
+            else if (typeof(T) == typeof(ushort))
+            {
+                return Sse2.AddSaturate(left.AsUInt16(), right.AsUInt16()).As<ushort, T>();
+            }
+        }
+
+        var result = left + right;
+
+        if (IsSigned<T>())
+        {
+            var overflow = Vector128.LessThan((left ^ result) & (right ^ result), Vector128<T>.Zero);
+            var saturated = Vector128.ConditionalSelect(
+                Vector128.LessThan(left, Vector128<T>.Zero),
+                Vector128.Create(T.MinValue),
+                Vector128.Create(T.MaxValue));
+            return Vector128.ConditionalSelect(overflow, saturated, result);
+        }
+
+        // Lanes that carried out become all ones.
+        return result | Vector128.LessThan(result, left);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> SubtractSaturate<T>(Vector128<T> left, Vector128<T> right)
+        where T : unmanaged, IBinaryInteger<T>, IMinMaxValue<T>
+    {
+        if (Sse2.IsSupported)
+        {
+            if (typeof(T) == typeof(byte))
+            {
+                return Sse2.SubtractSaturate(left.AsByte(), right.AsByte()).As<byte, T>();
+            }
+            else if (typeof(T) == typeof(sbyte))
+            {
+                return Sse2.SubtractSaturate(left.AsSByte(), right.AsSByte()).As<sbyte, T>();
+            }
+            else if (typeof(T) == typeof(short))
+            {
+                return Sse2.SubtractSaturate(left.AsInt16(), right.AsInt16()).As<short, T>();
+            }
+            else if (typeof(T) == typeof(ushort))
+            {
+                return Sse2.SubtractSaturate(left.AsUInt16(), right.AsUInt16()).As<ushort, T>();
+            }
+        }
+
+        var result = left - right;
+
+        if (IsSigned<T>())
+        {
+            var overflow = Vector128.LessThan((left ^ right) & (left ^ result), Vector128<T>.Zero);
+            var saturated = Vector128.ConditionalSelect(
+                Vector128.LessThan(left, Vector128<T>.Zero),
+                Vector128.Create(T.MinValue),
+                Vector128.Create(T.MaxValue));
+            return Vector128.ConditionalSelect(overflow, saturated, result);
+        }
+
+        // Lanes that borrowed become zero.
+        return Vector128.AndNot(result, Vector128.LessThan(left, right));
+    }
+
+    // Vector256
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> AddSaturate<T>(Vector256<T> left, Vector256<T> right)
+        where T : unmanaged, IBinaryInteger<T>, IMinMaxValue<T>
+    {
+        if (Avx2.IsSupported)
+        {
+            if (typeof(T) == typeof(byte))
+            {
+                return Avx2.AddSaturate(left.AsByte(), right.AsByte()).As<byte, T>();
+            }
+            else if (typeof(T) == typeof(sbyte))
+            {
+                return Avx2.AddSaturate(left.AsSByte(), right.AsSByte()).As<sbyte, T>();
+            }
+            else if (typeof(T) == typeof(short))
+            {
+                return Avx2.AddSaturate(left.AsInt16(), right.AsInt16()).As<short, T>();
+            }
+            else if (typeof(T) == typeof(ushort))
+            {
+                return Avx2.AddSaturate(left.AsUInt16(), right.AsUInt16()).As<ushort, T>();
+            }
+        }
+
+        var result = left + right;
+
+        if (IsSigned<T>())
+        {
+            var overflow = Vector256.LessThan((left ^ result) & (right ^ result), Vector256<T>.Zero);
+            var saturated = Vector256.ConditionalSelect(
+                Vector256.LessThan(left, Vector256<T>.Zero),
+                Vector256.Create(T.MinValue),
+                Vector256.Create(T.MaxValue));
+            return Vector256.ConditionalSelect(overflow, saturated, result);
+        }
+
+        return result | Vector256.LessThan(result, left);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> SubtractSaturate<T>(Vector256<T> left, Vector256<T> right)
+        where T : unmanaged, IBinaryInteger<T>, IMinMaxValue<T>
+    {
+        if (Avx2.IsSupported)
+        {
+            if (typeof(T) == typeof(byte))
+            {
+                return Avx2.SubtractSaturate(left.AsByte(), right.AsByte()).As<byte, T>();
+            }
+            else if (typeof(T) == typeof(sbyte))
+            {
+                return Avx2.SubtractSaturate(left.AsSByte(), right.AsSByte()).As<sbyte, T>();
+            }
+            else if (typeof(T) == typeof(short))
+            {
+                return Avx2.SubtractSaturate(left.AsInt16(), right.AsInt16()).As<short, T>();
+            }
+            else if (typeof(T) == typeof(ushort))
+            {
+                return Avx2.SubtractSaturate(left.AsUInt16(), right.AsUInt16()).As<ushort, T>();
+            }
+        }
+
+        var result = left - right;
+
+        if (IsSigned<T>())
+        {
+            var overflow = Vector256.LessThan((left ^ right) & (left ^ result), Vector256<T>.Zero);
+            var saturated = Vector256.ConditionalSelect(
+                Vector256.LessThan(left, Vector256<T>.Zero),
+                Vector256.Create(T.MinValue),
+                Vector256.Create(T.MaxValue));
+            return Vector256.ConditionalSelect(overflow, saturated, result);
+        }
+
+        return Vector256.AndNot(result, Vector256.LessThan(left, right));
+    }
+
+    // Vector512
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> AddSaturate<T>(Vector512<T> left, Vector512<T> right)
+        where T : unmanaged, IBinaryInteger<T>, IMinMaxValue<T>
+    {
+        if (Avx512BW.IsSupported)
+        {
+            if (typeof(T) == typeof(byte))
+            {
+                return Avx512BW.AddSaturate(left.AsByte(), right.AsByte()).As<byte, T>();
+            }
+            else if (typeof(T) == typeof(sbyte))
+            {
+                return Avx512BW.AddSaturate(left.AsSByte(), right.AsSByte()).As<sbyte, T>();
+            }
+            else if (typeof(T) == typeof(short))
+            {
+                return Avx512BW.AddSaturate(left.AsInt16(), right.AsInt16()).As<short, T>();
+            }
+            else if (typeof(T) == typeof(ushort))
+            {
+                return Avx512BW.AddSaturate(left.AsUInt16(), right.AsUInt16()).As<ushort, T>();
+            }
+        }
+
+        return Vector512.Create(
+            AddSaturate(left.GetLower(), right.GetLower()),
+            AddSaturate(left.GetUpper(), right.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> SubtractSaturate<T>(Vector512<T> left, Vector512<T> right)
+        where T : unmanaged, IBinaryInteger<T>, IMinMaxValue<T>
+    {
+        if (Avx512BW.IsSupported)
+        {
+            if (typeof(T) == typeof(byte))
+            {
+                return Avx512BW.SubtractSaturate(left.AsByte(), right.AsByte()).As<byte, T>();
+            }
+            else if (typeof(T) == typeof(sbyte))
+            {
+                return Avx512BW.SubtractSaturate(left.AsSByte(), right.AsSByte()).As<sbyte, T>();
+            }
+            else if (typeof(T) == typeof(short))
+            {
+                return Avx512BW.SubtractSaturate(left.AsInt16(), right.AsInt16()).As<short, T>();
+            }
+            else if (typeof(T) == typeof(ushort))
+            {
+                return Avx512BW.SubtractSaturate(left.AsUInt16(), right.AsUInt16()).As<ushort, T>();
+            }
+        }
+
+        return Vector512.Create(
+            SubtractSaturate(left.GetLower(), right.GetLower()),
+            SubtractSaturate(left.GetUpper(), right.GetUpper()));
+    }
+
+    /// <summary>
+    /// The value that a signed operation saturates to when it overflows, which has the sign of the left operand.
+    /// Unsigned additions always saturate to the maximum value.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static T GetSaturatedValue<T>(T left)
+        where T : unmanaged, IBinaryInteger<T>, IMinMaxValue<T>
+    {
+        return IsSigned<T>() && T.IsNegative(left) ? T.MinValue : T.MaxValue;
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static bool IsSigned<T>()
+        where T : unmanaged, IBinaryInteger<T>, IMinMaxValue<T> => T.MinValue != T.Zero;
+
+    private static unsafe int GetBitCount<T>()
+        where T : unmanaged => sizeof(T) * 8;
+}
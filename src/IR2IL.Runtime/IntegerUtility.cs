@@ -0,0 +1,199 @@
+using System.Runtime.CompilerServices;
+
+namespace IR2IL.Runtime;
+
+/// <summary>
+/// Support for integer types that don't map directly onto IL: i128, which is held in an
+/// <see cref="Int128"/> and reinterpreted as <see cref="UInt128"/> for unsigned operations,
+/// and odd widths like i24 and i48, which are held in the next native width up.
+/// </summary>
+public static unsafe class IntegerUtility
+{
+    /// <summary>
+    /// Loads an integer that is <paramref name="byteCount"/> bytes wide, such as an i24 or i48.
+    /// </summary>
+    /// <remarks>
+    /// Odd widths only occupy their store size in memory, so reading a whole int or long
+    /// could touch bytes that belong to something else. Assumes a little-endian target.
+    /// </remarks>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static ulong Load(void* address, int byteCount)
+    {
+        var p = (byte*)address;
+
+        return byteCount switch
+        {
+            1 => *p,
+            2 => Unsafe.ReadUnaligned<ushort>(p),
+            3 => Unsafe.ReadUnaligned<ushort>(p) | ((ulong)p[2] << 16),
+            4 => Unsafe.ReadUnaligned<uint>(p),
+            5 => Unsafe.ReadUnaligned<uint>(p) | ((ulong)p[4] << 32),
+            6 => Unsafe.ReadUnaligned<uint>(p) | ((ulong)Unsafe.ReadUnaligned<ushort>(p + 4) << 32),
+            7 => Unsafe.ReadUnaligned<uint>(p) | ((ulong)Unsafe.ReadUnaligned<ushort>(p + 4) << 32) | ((ulong)p[6] << 48),
+            _ => Unsafe.ReadUnaligned<ulong>(p),
+        };
+    }
+
+    /// <summary>
+    /// Stores the low <paramref name="byteCount"/> bytes of <paramref name="value"/>.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static void Store(void* address, ulong value, int byteCount)
+    {
+        var p = (byte*)address;
+
+        switch (byteCount)
+        {
+            case 1:
+                *p = (byte)value;
+                break;
+
+            case 2:
+                Unsafe.WriteUnaligned(p, (ushort)value);
+                break;
+
+            case 3:
+                Unsafe.WriteUnaligned(p, (ushort)value);
+                p[2] = (byte)(value >> 16);
+                break;
+
+            case 4:
+                Unsafe.WriteUnaligned(p, (uint)value);
+                break;
+
+            case 5:
+                Unsafe.WriteUnaligned(p, (uint)value);
+                p[4] = (byte)(value >> 32);
+                break;
+
+            case 6:
+                Unsafe.WriteUnaligned(p, (uint)value);
+                Unsafe.WriteUnaligned(p + 4, (ushort)(value >> 32));
+                break;
+
+            case 7:
+                Unsafe.WriteUnaligned(p, (uint)value);
+                Unsafe.WriteUnaligned(p + 4, (ushort)(value >> 32));
+                p[6] = (byte)(value >> 48);
+                break;
+
+            default:
+                Unsafe.WriteUnaligned(p, value);
+                break;
+        }
+    }
+
+    // 64 x 64 -> 128-bit multiplication, which clang emits as a mul of two extended i64s.
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Int128 MultiplyUnsigned(ulong left, ulong right)
+    {
+        var upper = Math.BigMul(left, right, out var lower);
+        return new Int128(upper, lower);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Int128 MultiplySigned(long left, long right)
+    {
+        var upper = Math.BigMul(left, right, out var lower);
+        return new Int128((ulong)upper, (ulong)lower);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Int128 Add(Int128 left, Int128 right) => left + right;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Int128 Subtract(Int128 left, Int128 right) => left - right;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Int128 Multiply(Int128 left, Int128 right) => left * right;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Int128 SignedDivide(Int128 left, Int128 right) => left / right;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Int128 UnsignedDivide(Int128 left, Int128 right) => (Int128)((UInt128)left / (UInt128)right);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Int128 SignedRemainder(Int128 left, Int128 right) => left % right;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Int128 UnsignedRemainder(Int128 left, Int128 right) => (Int128)((UInt128)left % (UInt128)right);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Int128 And(Int128 left, Int128 right) => left & right;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Int128 Or(Int128 left, Int128 right) => left | right;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Int128 Xor(Int128 left, Int128 right) => left ^ right;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Int128 ShiftLeft(Int128 value, Int128 shiftAmount) => value << (int)shiftAmount;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Int128 ShiftRightArithmetic(Int128 value, Int128 shiftAmount) => value >> (int)shiftAmount;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Int128 ShiftRightLogical(Int128 value, Int128 shiftAmount) => value >>> (int)shiftAmount;
+
+    // Named after the icmp predicates.
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static bool CompareEQ(Int128 left, Int128 right) => left == right;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static bool CompareNE(Int128 left, Int128 right) => left != right;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static bool CompareSGT(Int128 left, Int128 right) => left > right;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static bool CompareSGE(Int128 left, Int128 right) => left >= right;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static bool CompareSLT(Int128 left, Int128 right) => left < right;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static bool CompareSLE(Int128 left, Int128 right) => left <= right;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static bool CompareUGT(Int128 left, Int128 right) => (UInt128)left > (UInt128)right;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static bool CompareUGE(Int128 left, Int128 right) => (UInt128)left >= (UInt128)right;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static bool CompareULT(Int128 left, Int128 right) => (UInt128)left < (UInt128)right;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static bool CompareULE(Int128 left, Int128 right) => (UInt128)left <= (UInt128)right;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Int128 ZeroExtendI64ToI128(ulong value) => value;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Int128 SignExtendI64ToI128(long value) => value;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static long TruncateI128ToI64(Int128 value) => (long)value;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static double ConvertSignedI128ToF64(Int128 value) => (double)value;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static double ConvertUnsignedI128ToF64(Int128 value) => (double)(UInt128)value;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static float ConvertSignedI128ToF32(Int128 value) => (float)value;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static float ConvertUnsignedI128ToF32(Int128 value) => (float)(UInt128)value;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Int128 ConvertF64ToSignedI128(double value) => (Int128)value;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Int128 ConvertF64ToUnsignedI128(double value) => (Int128)(UInt128)value;
+}
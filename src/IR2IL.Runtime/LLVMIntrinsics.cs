@@ -1,45 +1,112 @@
 using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
 using System.Runtime.Intrinsics;
-using System.Runtime.Intrinsics.X86;
 
 namespace IR2IL.Runtime;
 
 public static unsafe class LLVMIntrinsics
 {
-    [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static int VectorReduceMulV4I32(Vector128<int> vector)
+    // Copies with a variable length, or a constant length too large to expand inline.
+    // Short copies use overlapping loads and stores; everything else goes to the BCL's memmove.
+    public static void MemCpy(void* destination, void* source, nuint byteCount) => MemMove(destination, source, byteCount);
+
+    public static void MemMove(void* destination, void* source, nuint byteCount)
     {
-        if (Sse41.IsSupported)
-        {
-            // Multiply pairs of elements
-            var temp = Sse41.MultiplyLow(vector, Sse41.Shuffle(vector, 0b_10_11_00_01));
-            temp = Sse41.MultiplyLow(temp, Sse41.Shuffle(temp, 0b_01_00_11_10));
+        var d = (byte*)destination;
+        var s = (byte*)source;
 
-            // Extract the scalar result
-            return Sse41.Extract(temp, 0);
+        // Every load happens before the corresponding stores, so these are safe for overlapping ranges.
+        if (byteCount <= 16)
+        {
+            if (byteCount >= 8)
+            {
+                var lower = Unsafe.ReadUnaligned<ulong>(s);
+                var upper = Unsafe.ReadUnaligned<ulong>(s + byteCount - 8);
+                Unsafe.WriteUnaligned(d, lower);
+                Unsafe.WriteUnaligned(d + byteCount - 8, upper);
+            }
+            else if (byteCount >= 4)
+            {
+                var lower = Unsafe.ReadUnaligned<uint>(s);
+                var upper = Unsafe.ReadUnaligned<uint>(s + byteCount - 4);
+                Unsafe.WriteUnaligned(d, lower);
+                Unsafe.WriteUnaligned(d + byteCount - 4, upper);
+            }
+            else if (byteCount >= 2)
+            {
+                var lower = Unsafe.ReadUnaligned<ushort>(s);
+                var upper = Unsafe.ReadUnaligned<ushort>(s + byteCount - 2);
+                Unsafe.WriteUnaligned(d, lower);
+                Unsafe.WriteUnaligned(d + byteCount - 2, upper);
+            }
+            else if (byteCount != 0)
+            {
+                *d = *s;
+            }
+        }
+        else if (byteCount <= 32)
+        {
+            var lower = Vector128.Load(s);
+            var upper = Vector128.Load(s + byteCount - 16);
+            lower.Store(d);
+            upper.Store(d + byteCount - 16);
+        }
+        else if (byteCount <= 64 && Vector256.IsHardwareAccelerated)
+        {
+            var lower = Vector256.Load(s);
+            var upper = Vector256.Load(s + byteCount - 32);
+            lower.Store(d);
+            upper.Store(d + byteCount - 32);
         }
         else
         {
-            throw new PlatformNotSupportedException();
+            NativeMemory.Copy(source, destination, byteCount);
         }
     }
 
-    [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static int VectorReduceSMaxV4I32(Vector128<int> vector)
+    public static void MemSet(void* destination, byte value, nuint byteCount)
     {
-        if (Sse41.IsSupported)
+        var d = (byte*)destination;
+
+        if (byteCount <= 16)
         {
-            // Perform horizontal max operations.
-            var temp = Sse41.Max(vector, Sse41.Shuffle(vector, 0b_10_11_00_01));
-            temp = Sse41.Max(temp, Sse41.Shuffle(temp, 0b_01_00_11_10));
-            temp = Sse41.Max(temp, Sse41.Shuffle(temp, 0b_00_01_10_11));
+            var pattern = value * 0x0101010101010101UL;
 
-            // Extract the maximum value.
-            return Sse2.ConvertToInt32(temp);
+            if (byteCount >= 8)
+            {
+                Unsafe.WriteUnaligned(d, pattern);
+                Unsafe.WriteUnaligned(d + byteCount - 8, pattern);
+            }
+            else if (byteCount >= 4)
+            {
+                Unsafe.WriteUnaligned(d, (uint)pattern);
+                Unsafe.WriteUnaligned(d + byteCount - 4, (uint)pattern);
+            }
+            else if (byteCount >= 2)
+            {
+                Unsafe.WriteUnaligned(d, (ushort)pattern);
+                Unsafe.WriteUnaligned(d + byteCount - 2, (ushort)pattern);
+            }
+            else if (byteCount != 0)
+            {
+                *d = value;
+            }
+        }
+        else if (byteCount <= 32)
+        {
+            var pattern = Vector128.Create(value);
+            pattern.Store(d);
+            pattern.Store(d + byteCount - 16);
+        }
+        else if (byteCount <= 64 && Vector256.IsHardwareAccelerated)
+        {
+            var pattern = Vector256.Create(value);
+            pattern.Store(d);
+            pattern.Store(d + byteCount - 32);
         }
         else
         {
-            throw new PlatformNotSupportedException();
+            NativeMemory.Fill(destination, byteCount, value);
         }
     }
 }
\ No newline at end of file
@@ -0,0 +1,278 @@
+using System.Runtime.CompilerServices;
+using System.Runtime.Intrinsics;
+using System.Runtime.Intrinsics.X86;
+
+namespace IR2IL.Runtime;
+
+/// <summary>
+/// Implementations of llvm.masked.load, llvm.masked.store, llvm.masked.gather, llvm.masked.scatter,
+/// llvm.masked.expandload and llvm.masked.compressstore.
+/// </summary>
+/// <remarks>
+/// <c>TVector</c> is the vector of data, with elements of type <c>T</c>. <c>TMask</c> is the vector of i1,
+/// which has an sbyte per lane that is non-zero when the lane is set, and <c>TPointers</c> is a vector of nint.
+/// <c>laneCount</c> is the number of lanes in the LLVM vector, which is fewer than the .NET vector has
+/// when it's padded.
+///
+/// Lanes that are masked off are never read or written, so a masked access can't fault where native code wouldn't.
+/// The AVX masked moves and the AVX2 gathers have the same guarantee, and are used for whole vectors of 32-bit
+/// and 64-bit elements. Everything else, including scatters, which need AVX-512 instructions that .NET doesn't
+/// expose yet, is done one lane at a time.
+/// </remarks>
+public static unsafe class MaskedMemory
+{
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static TVector Load<T, TMask, TVector>(void* address, TMask mask, TVector passthru, int laneCount)
+        where T : unmanaged
+        where TMask : unmanaged
+        where TVector : unmanaged
+    {
+        if (Avx.IsSupported && IsWholeVector<T, TVector>(laneCount))
+        {
+            if (sizeof(TVector) == 16)
+            {
+                var laneMask = GetLaneMask128<T, TMask>(mask);
+                var loaded = sizeof(T) == sizeof(float)
+                    ? Avx.MaskLoad((float*)address, laneMask.AsSingle()).As<float, T>()
+                    : Avx.MaskLoad((double*)address, laneMask.AsDouble()).As<double, T>();
+                return Unsafe.BitCast<Vector128<T>, TVector>(Vector128.ConditionalSelect(laneMask, loaded, Unsafe.BitCast<TVector, Vector128<T>>(passthru)));
+            }
+            else if (sizeof(TVector) == 32)
+            {
+                var laneMask = GetLaneMask256<T, TMask>(mask);
+                var loaded = sizeof(T) == sizeof(float)
+                    ? Avx.MaskLoad((float*)address, laneMask.AsSingle()).As<float, T>()
+                    : Avx.MaskLoad((double*)address, laneMask.AsDouble()).As<double, T>();
+                return Unsafe.BitCast<Vector256<T>, TVector>(Vector256.ConditionalSelect(laneMask, loaded, Unsafe.BitCast<TVector, Vector256<T>>(passthru)));
+            }
+        }
+
+        var result = passthru;
+        var resultLanes = (T*)&result;
+        var maskLanes = (sbyte*)&mask;
+        for (var i = 0; i < laneCount; i++)
+        {
+            if (maskLanes[i] != 0)
+            {
+                resultLanes[i] = ((T*)address)[i];
+            }
+        }
+        return result;
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static void Store<T, TVector, TMask>(TVector value, void* address, TMask mask, int laneCount)
+        where T : unmanaged
+        where TVector : unmanaged
+        where TMask : unmanaged
+    {
+        if (Avx.IsSupported && IsWholeVector<T, TVector>(laneCount))
+        {
+            if (sizeof(TVector) == 16)
+            {
+                var laneMask = GetLaneMask128<T, TMask>(mask);
+                if (sizeof(T) == sizeof(float))
+                {
+                    Avx.MaskStore((float*)address, laneMask.AsSingle(), Unsafe.BitCast<TVector, Vector128<float>>(value));
+                }
+                else
+                {
+                    Avx.MaskStore((double*)address, laneMask.AsDouble(), Unsafe.BitCast<TVector, Vector128<double>>(value));
+                }
+                return;
+            }
+            else if (sizeof(TVector) == 32)
+            {
+                var laneMask = GetLaneMask256<T, TMask>(mask);
+                if (sizeof(T) == sizeof(float))
+                {
+                    Avx.MaskStore((float*)address, laneMask.AsSingle(), Unsafe.BitCast<TVector, Vector256<float>>(value));
+                }
+                else
+                {
+                    Avx.MaskStore((double*)address, laneMask.AsDouble(), Unsafe.BitCast<TVector, Vector256<double>>(value));
+                }
+                return;
+            }
+        }
+
+        var valueLanes = (T*)&value;
+        var maskLanes = (sbyte*)&mask;
+        for (var i = 0; i < laneCount; i++)
+        {
+            if (maskLanes[i] != 0)
+            {
+                ((T*)address)[i] = valueLanes[i];
+            }
+        }
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static TVector Gather<T, TPointers, TMask, TVector>(TPointers pointers, TMask mask, TVector passthru, int laneCount)
+        where T : unmanaged
+        where TPointers : unmanaged
+        where TMask : unmanaged
+        where TVector : unmanaged
+    {
+        // The gathers add each lane's index to a base address, so with a base of zero the indices are the pointers.
+        if (Avx2.IsSupported && IsWholeVector<T, TVector>(laneCount))
+        {
+            if (sizeof(T) == sizeof(double) && sizeof(TVector) == 16)
+            {
+                return Unsafe.BitCast<Vector128<double>, TVector>(Avx2.GatherMaskVector128(
+                    Unsafe.BitCast<TVector, Vector128<double>>(passthru),
+                    null,
+                    Unsafe.BitCast<TPointers, Vector128<long>>(pointers),
+                    GetLaneMask128<T, TMask>(mask).AsDouble(),
+                    1));
+            }
+            else if (sizeof(T) == sizeof(double) && sizeof(TVector) == 32)
+            {
+                return Unsafe.BitCast<Vector256<double>, TVector>(Avx2.GatherMaskVector256(
+                    Unsafe.BitCast<TVector, Vector256<double>>(passthru),
+                    null,
+                    Unsafe.BitCast<TPointers, Vector256<long>>(pointers),
+                    GetLaneMask256<T, TMask>(mask).AsDouble(),
+                    1));
+            }
+            else if (sizeof(T) == sizeof(float) && sizeof(TVector) == 16)
+            {
+                return Unsafe.BitCast<Vector128<float>, TVector>(Avx2.GatherMaskVector128(
+                    Unsafe.BitCast<TVector, Vector128<float>>(passthru),
+                    null,
+                    Unsafe.BitCast<TPointers, Vector256<long>>(pointers),
+                    GetLaneMask128<T, TMask>(mask).AsSingle(),
+                    1));
+            }
+            else if (sizeof(T) == sizeof(float) && sizeof(TVector) == 32)
+            {
+                // There's no gather of eight lanes with 64-bit indices, so we do it in halves.
+                var passthru256 = Unsafe.BitCast<TVector, Vector256<float>>(passthru);
+                var pointers512 = Unsafe.BitCast<TPointers, Vector512<long>>(pointers);
+                var laneMask = GetLaneMask256<T, TMask>(mask).AsSingle();
+                var lower = Avx2.GatherMaskVector128(passthru256.GetLower(), null, pointers512.GetLower(), laneMask.GetLower(), 1);
+                var upper = Avx2.GatherMaskVector128(passthru256.GetUpper(), null, pointers512.GetUpper(), laneMask.GetUpper(), 1);
+                return Unsafe.BitCast<Vector256<float>, TVector>(Vector256.Create(lower, upper));
+            }
+        }
+
+        var result = passthru;
+        var resultLanes = (T*)&result;
+        var pointerLanes = (T**)&pointers;
+        var maskLanes = (sbyte*)&mask;
+        for (var i = 0; i < laneCount; i++)
+        {
+            if (maskLanes[i] != 0)
+            {
+                resultLanes[i] = *pointerLanes[i];
+            }
+        }
+        return result;
+    }
+
+    /// <remarks>
+    /// Lanes are stored in order, so when two lanes have the same pointer, the later one wins, like LLVM specifies.
+    /// </remarks>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static void Scatter<T, TVector, TPointers, TMask>(TVector value, TPointers pointers, TMask mask, int laneCount)
+        where T : unmanaged
+        where TVector : unmanaged
+        where TPointers : unmanaged
+        where TMask : unmanaged
+    {
+        var valueLanes = (T*)&value;
+        var pointerLanes = (T**)&pointers;
+        var maskLanes = (sbyte*)&mask;
+        for (var i = 0; i < laneCount; i++)
+        {
+            if (maskLanes[i] != 0)
+            {
+                *pointerLanes[i] = valueLanes[i];
+            }
+        }
+    }
+
+    /// <summary>
+    /// Loads consecutive elements into the lanes that are set.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static TVector ExpandLoad<T, TMask, TVector>(void* address, TMask mask, TVector passthru, int laneCount)
+        where T : unmanaged
+        where TMask : unmanaged
+        where TVector : unmanaged
+    {
+        var result = passthru;
+        var resultLanes = (T*)&result;
+        var maskLanes = (sbyte*)&mask;
+        var source = (T*)address;
+        for (var i = 0; i < laneCount; i++)
+        {
+            if (maskLanes[i] != 0)
+            {
+                resultLanes[i] = *source++;
+            }
+        }
+        return result;
+    }
+
+    /// <summary>
+    /// Stores the lanes that are set to consecutive elements.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static void CompressStore<T, TVector, TMask>(TVector value, void* address, TMask mask, int laneCount)
+        where T : unmanaged
+        where TVector : unmanaged
+        where TMask : unmanaged
+    {
+        var valueLanes = (T*)&value;
+        var maskLanes = (sbyte*)&mask;
+        var destination = (T*)address;
+        for (var i = 0; i < laneCount; i++)
+        {
+            if (maskLanes[i] != 0)
+            {
+                *destination++ = valueLanes[i];
+            }
+        }
+    }
+
+    private static bool IsWholeVector<T, TVector>(int laneCount)
+        where T : unmanaged
+        where TVector : unmanaged =>
+        (sizeof(T) == sizeof(float) || sizeof(T) == sizeof(double)) && laneCount * sizeof(T) == sizeof(TVector);
+
+    /// <summary>
+    /// Widens the sbyte lanes of a mask to lanes the size of <typeparamref name="T"/>, with all their bits set or clear.
+    /// </summary>
+    private static Vector128<T> GetLaneMask128<T, TMask>(TMask mask)
+        where T : unmanaged
+        where TMask : unmanaged
+    {
+        var bytes = GetByteMask(mask);
+        var shorts = Vector128.WidenLower(bytes);
+        var ints = Vector128.WidenLower(shorts);
+        return sizeof(T) == sizeof(int)
+            ? ints.As<int, T>()
+            : Vector128.WidenLower(ints).As<long, T>();
+    }
+
+    private static Vector256<T> GetLaneMask256<T, TMask>(TMask mask)
+        where T : unmanaged
+        where TMask : unmanaged
+    {
+        var bytes = GetByteMask(mask);
+        var shorts = Vector256.WidenLower(bytes.ToVector256Unsafe());
+        var ints = Vector256.WidenLower(shorts);
+        return sizeof(T) == sizeof(int)
+            ? ints.As<int, T>()
+            : Vector256.WidenLower(ints).As<long, T>();
+    }
+
+    private static Vector128<sbyte> GetByteMask<TMask>(TMask mask)
+        where TMask : unmanaged
+    {
+        var result = Vector128<sbyte>.Zero;
+        Unsafe.CopyBlockUnaligned(&result, &mask, (uint)Math.Min(sizeof(TMask), sizeof(Vector128<sbyte>)));
+        return ~Vector128.Equals(result, Vector128<sbyte>.Zero);
+    }
+}
@@ -0,0 +1,178 @@
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace IR2IL.Runtime;
+
+/// <summary>
+/// A per-thread bump-pointer stack for dynamic allocas, and llvm.stacksave and llvm.stackrestore.
+/// </summary>
+/// <remarks>
+/// localloc can't give memory back until the method returns, so a variable-length array declared in a loop
+/// grows the frame on every iteration until the stack overflows, and it zeroes the memory it allocates.
+///
+/// Instead, dynamic allocas come from chunks of native memory. The mark is the address of the next free byte:
+/// functions with dynamic allocas <see cref="Save"/> it when they're entered and <see cref="Restore"/> it when they
+/// return, and llvm.stacksave and llvm.stackrestore do the same within a function. Restoring a mark that's in an
+/// earlier chunk releases the chunks after it. One released chunk is kept, so that a loop that crosses the end
+/// of a chunk doesn't allocate and free native memory every time round.
+///
+/// Nothing restores the mark if a function is left with an exception, but the next function further up
+/// the stack that has dynamic allocas will when it returns.
+/// </remarks>
+public static unsafe class ShadowStack
+{
+    private const int ChunkSize = 1024 * 1024;
+
+    private struct ChunkHeader
+    {
+        public ChunkHeader* Previous;
+        public byte* End;
+    }
+
+    /// <summary>
+    /// The chunks that belong to a thread, which are freed when the thread exits.
+    /// </summary>
+    private sealed class Chunks
+    {
+        public ChunkHeader* Current;
+        public ChunkHeader* Spare;
+
+        ~Chunks()
+        {
+            while (Current != null)
+            {
+                var previous = Current->Previous;
+                NativeMemory.Free(Current);
+                Current = previous;
+            }
+
+            NativeMemory.Free(Spare);
+        }
+    }
+
+    [ThreadStatic]
+    private static Chunks? t_chunks;
+
+    // The free space in the current chunk is [t_top, t_end), and t_start is where that chunk's memory starts.
+    // These are all null until the first allocation.
+    [ThreadStatic]
+    private static byte* t_top;
+
+    [ThreadStatic]
+    private static byte* t_start;
+
+    [ThreadStatic]
+    private static byte* t_end;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static void* Save() => t_top;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static void Restore(void* mark)
+    {
+        if (mark >= t_start && mark <= t_end)
+        {
+            t_top = (byte*)mark;
+        }
+        else
+        {
+            RestoreToEarlierChunk((byte*)mark);
+        }
+    }
+
+    /// <summary>
+    /// Allocates <paramref name="byteCount"/> bytes, aligned to <paramref name="alignment"/>, which must be
+    /// a power of two. The memory isn't zeroed.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static void* Allocate(nuint byteCount, nuint alignment)
+    {
+        var top = (byte*)(((nuint)t_top + alignment - 1) & ~(alignment - 1));
+
+        // Zero-byte allocations before the first chunk exists go the slow way too, so that they aren't null.
+        if (top <= t_end && byteCount < (nuint)(t_end - top))
+        {
+            t_top = top + byteCount;
+            return top;
+        }
+
+        return AllocateInNewChunk(byteCount, alignment);
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    private static void* AllocateInNewChunk(nuint byteCount, nuint alignment)
+    {
+        var chunks = t_chunks ??= new Chunks();
+
+        // Room for the header, and for aligning the start.
+        var requiredSize = byteCount + alignment + (nuint)sizeof(ChunkHeader);
+        if (requiredSize < byteCount)
+        {
+            throw new OutOfMemoryException();
+        }
+
+        var chunk = chunks.Spare;
+        if (chunk != null && (nuint)(chunk->End - (byte*)chunk) >= requiredSize)
+        {
+            chunks.Spare = null;
+        }
+        else
+        {
+            var size = Math.Max(requiredSize, ChunkSize);
+            chunk = (ChunkHeader*)NativeMemory.Alloc(size);
+            chunk->End = (byte*)chunk + size;
+        }
+
+        chunk->Previous = chunks.Current;
+        chunks.Current = chunk;
+        SetCurrentChunk(chunk, (byte*)(chunk + 1));
+
+        return Allocate(byteCount, alignment);
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    private static void RestoreToEarlierChunk(byte* mark)
+    {
+        var chunks = t_chunks;
+        if (chunks == null)
+        {
+            return;
+        }
+
+        var chunk = chunks.Current;
+        while (chunk != null && !(mark >= (byte*)(chunk + 1) && mark <= chunk->End))
+        {
+            var previous = chunk->Previous;
+            Release(chunks, chunk);
+            chunk = previous;
+        }
+
+        // A mark from before the first chunk, such as the one a function saves before its first allocation,
+        // releases every chunk.
+        chunks.Current = chunk;
+        SetCurrentChunk(chunk, chunk != null ? mark : null);
+    }
+
+    /// <summary>
+    /// Keeps the larger of <paramref name="chunk"/> and the spare chunk for reuse, and frees the other.
+    /// </summary>
+    private static void Release(Chunks chunks, ChunkHeader* chunk)
+    {
+        var spare = chunks.Spare;
+        if (spare != null && spare->End - (byte*)spare >= chunk->End - (byte*)chunk)
+        {
+            NativeMemory.Free(chunk);
+            return;
+        }
+
+        NativeMemory.Free(spare);
+        chunks.Spare = chunk;
+    }
+
+    private static void SetCurrentChunk(ChunkHeader* chunk, byte* top)
+    {
+        t_start = chunk != null ? (byte*)(chunk + 1) : null;
+        t_end = chunk != null ? chunk->End : null;
+        t_top = top;
+    }
+}
@@ -1,12 +1,269 @@
 using System.Diagnostics;
 using System.Runtime.CompilerServices;
+using System.Runtime.Intrinsics;
 
 namespace IR2IL.Runtime;
 
+/// <summary>
+/// Operations on <see cref="Vector1024{T}"/>, which is stored as two <see cref="Vector512{T}"/> halves.
+/// Where AVX-512 isn't available, .NET splits each Vector512 operation into two Vector256 ones,
+/// so these run as four 256-bit operations instead.
+/// </summary>
 public static class Vector1024
 {
     internal const int Size = 128;
 
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> Abs<T>(Vector1024<T> vector)
+        where T : unmanaged
+    {
+        return Create(Vector512.Abs(vector.GetLower()), Vector512.Abs(vector.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> Add<T>(Vector1024<T> left, Vector1024<T> right)
+        where T : unmanaged
+    {
+        return Create(
+            Vector512.Add(left.GetLower(), right.GetLower()),
+            Vector512.Add(left.GetUpper(), right.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<TTo> As<TFrom, TTo>(this Vector1024<TFrom> vector)
+        where TFrom : unmanaged
+        where TTo : unmanaged
+    {
+        return Unsafe.BitCast<Vector1024<TFrom>, Vector1024<TTo>>(vector);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<byte> AsByte<T>(this Vector1024<T> vector)
+        where T : unmanaged
+    {
+        return vector.As<T, byte>();
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<double> AsDouble<T>(this Vector1024<T> vector)
+        where T : unmanaged
+    {
+        return vector.As<T, double>();
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<short> AsInt16<T>(this Vector1024<T> vector)
+        where T : unmanaged
+    {
+        return vector.As<T, short>();
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<int> AsInt32<T>(this Vector1024<T> vector)
+        where T : unmanaged
+    {
+        return vector.As<T, int>();
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<long> AsInt64<T>(this Vector1024<T> vector)
+        where T : unmanaged
+    {
+        return vector.As<T, long>();
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<sbyte> AsSByte<T>(this Vector1024<T> vector)
+        where T : unmanaged
+    {
+        return vector.As<T, sbyte>();
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<float> AsSingle<T>(this Vector1024<T> vector)
+        where T : unmanaged
+    {
+        return vector.As<T, float>();
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<ushort> AsUInt16<T>(this Vector1024<T> vector)
+        where T : unmanaged
+    {
+        return vector.As<T, ushort>();
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<uint> AsUInt32<T>(this Vector1024<T> vector)
+        where T : unmanaged
+    {
+        return vector.As<T, uint>();
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<ulong> AsUInt64<T>(this Vector1024<T> vector)
+        where T : unmanaged
+    {
+        return vector.As<T, ulong>();
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> BitwiseAnd<T>(Vector1024<T> left, Vector1024<T> right)
+        where T : unmanaged
+    {
+        return Create(
+            Vector512.BitwiseAnd(left.GetLower(), right.GetLower()),
+            Vector512.BitwiseAnd(left.GetUpper(), right.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> BitwiseOr<T>(Vector1024<T> left, Vector1024<T> right)
+        where T : unmanaged
+    {
+        return Create(
+            Vector512.BitwiseOr(left.GetLower(), right.GetLower()),
+            Vector512.BitwiseOr(left.GetUpper(), right.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<double> Ceiling(Vector1024<double> vector)
+    {
+        return Create(Vector512.Ceiling(vector.GetLower()), Vector512.Ceiling(vector.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<float> Ceiling(Vector1024<float> vector)
+    {
+        return Create(Vector512.Ceiling(vector.GetLower()), Vector512.Ceiling(vector.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> ConditionalSelect<T>(Vector1024<T> condition, Vector1024<T> left, Vector1024<T> right)
+        where T : unmanaged
+    {
+        return Create(
+            Vector512.ConditionalSelect(condition.GetLower(), left.GetLower(), right.GetLower()),
+            Vector512.ConditionalSelect(condition.GetUpper(), left.GetUpper(), right.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<byte> Create(byte value)
+    {
+        var half = Vector512.Create(value);
+        return Create(half, half);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<sbyte> Create(sbyte value)
+    {
+        var half = Vector512.Create(value);
+        return Create(half, half);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<short> Create(short value)
+    {
+        var half = Vector512.Create(value);
+        return Create(half, half);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<ushort> Create(ushort value)
+    {
+        var half = Vector512.Create(value);
+        return Create(half, half);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<int> Create(int value)
+    {
+        var half = Vector512.Create(value);
+        return Create(half, half);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<uint> Create(uint value)
+    {
+        var half = Vector512.Create(value);
+        return Create(half, half);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<long> Create(long value)
+    {
+        var half = Vector512.Create(value);
+        return Create(half, half);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<ulong> Create(ulong value)
+    {
+        var half = Vector512.Create(value);
+        return Create(half, half);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<nint> Create(nint value)
+    {
+        var half = Vector512.Create(value);
+        return Create(half, half);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<float> Create(float value)
+    {
+        var half = Vector512.Create(value);
+        return Create(half, half);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<double> Create(double value)
+    {
+        var half = Vector512.Create(value);
+        return Create(half, half);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> Create<T>(Vector512<T> lower, Vector512<T> upper)
+        where T : unmanaged
+    {
+        Unsafe.SkipInit(out Vector1024<T> result);
+        ref var halves = ref Unsafe.As<Vector1024<T>, Vector512<T>>(ref result);
+        halves = lower;
+        Unsafe.Add(ref halves, 1) = upper;
+        return result;
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> Divide<T>(Vector1024<T> left, Vector1024<T> right)
+        where T : unmanaged
+    {
+        return Create(
+            Vector512.Divide(left.GetLower(), right.GetLower()),
+            Vector512.Divide(left.GetUpper(), right.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> Equals<T>(Vector1024<T> left, Vector1024<T> right)
+        where T : unmanaged
+    {
+        return Create(
+            Vector512.Equals(left.GetLower(), right.GetLower()),
+            Vector512.Equals(left.GetUpper(), right.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<double> Floor(Vector1024<double> vector)
+    {
+        return Create(Vector512.Floor(vector.GetLower()), Vector512.Floor(vector.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<float> Floor(Vector1024<float> vector)
+    {
+        return Create(Vector512.Floor(vector.GetLower()), Vector512.Floor(vector.GetUpper()));
+    }
+
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     public static T GetElement<T>(this Vector1024<T> vector, int index)
         where T : unmanaged
@@ -19,6 +276,235 @@ public static class Vector1024
         return vector.GetElementUnsafe(index);
     }
 
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> GetLower<T>(this Vector1024<T> vector)
+        where T : unmanaged
+    {
+        ref var halves = ref Unsafe.As<Vector1024<T>, Vector512<T>>(ref Unsafe.AsRef(in vector));
+        return halves;
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> GetUpper<T>(this Vector1024<T> vector)
+        where T : unmanaged
+    {
+        ref var halves = ref Unsafe.As<Vector1024<T>, Vector512<T>>(ref Unsafe.AsRef(in vector));
+        return Unsafe.Add(ref halves, 1);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> GreaterThan<T>(Vector1024<T> left, Vector1024<T> right)
+        where T : unmanaged
+    {
+        return Create(
+            Vector512.GreaterThan(left.GetLower(), right.GetLower()),
+            Vector512.GreaterThan(left.GetUpper(), right.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> GreaterThanOrEqual<T>(Vector1024<T> left, Vector1024<T> right)
+        where T : unmanaged
+    {
+        return Create(
+            Vector512.GreaterThanOrEqual(left.GetLower(), right.GetLower()),
+            Vector512.GreaterThanOrEqual(left.GetUpper(), right.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> LessThan<T>(Vector1024<T> left, Vector1024<T> right)
+        where T : unmanaged
+    {
+        return Create(
+            Vector512.LessThan(left.GetLower(), right.GetLower()),
+            Vector512.LessThan(left.GetUpper(), right.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> LessThanOrEqual<T>(Vector1024<T> left, Vector1024<T> right)
+        where T : unmanaged
+    {
+        return Create(
+            Vector512.LessThanOrEqual(left.GetLower(), right.GetLower()),
+            Vector512.LessThanOrEqual(left.GetUpper(), right.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> Max<T>(Vector1024<T> left, Vector1024<T> right)
+        where T : unmanaged
+    {
+        return Create(
+            Vector512.Max(left.GetLower(), right.GetLower()),
+            Vector512.Max(left.GetUpper(), right.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> Min<T>(Vector1024<T> left, Vector1024<T> right)
+        where T : unmanaged
+    {
+        return Create(
+            Vector512.Min(left.GetLower(), right.GetLower()),
+            Vector512.Min(left.GetUpper(), right.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> Multiply<T>(Vector1024<T> left, Vector1024<T> right)
+        where T : unmanaged
+    {
+        return Create(
+            Vector512.Multiply(left.GetLower(), right.GetLower()),
+            Vector512.Multiply(left.GetUpper(), right.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> Negate<T>(Vector1024<T> vector)
+        where T : unmanaged
+    {
+        return Create(Vector512.Negate(vector.GetLower()), Vector512.Negate(vector.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> OnesComplement<T>(Vector1024<T> vector)
+        where T : unmanaged
+    {
+        return Create(Vector512.OnesComplement(vector.GetLower()), Vector512.OnesComplement(vector.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<byte> ShiftLeft(Vector1024<byte> vector, int shiftCount)
+    {
+        return Create(Vector512.ShiftLeft(vector.GetLower(), shiftCount), Vector512.ShiftLeft(vector.GetUpper(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<sbyte> ShiftLeft(Vector1024<sbyte> vector, int shiftCount)
+    {
+        return Create(Vector512.ShiftLeft(vector.GetLower(), shiftCount), Vector512.ShiftLeft(vector.GetUpper(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<short> ShiftLeft(Vector1024<short> vector, int shiftCount)
+    {
+        return Create(Vector512.ShiftLeft(vector.GetLower(), shiftCount), Vector512.ShiftLeft(vector.GetUpper(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<ushort> ShiftLeft(Vector1024<ushort> vector, int shiftCount)
+    {
+        return Create(Vector512.ShiftLeft(vector.GetLower(), shiftCount), Vector512.ShiftLeft(vector.GetUpper(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<int> ShiftLeft(Vector1024<int> vector, int shiftCount)
+    {
+        return Create(Vector512.ShiftLeft(vector.GetLower(), shiftCount), Vector512.ShiftLeft(vector.GetUpper(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<uint> ShiftLeft(Vector1024<uint> vector, int shiftCount)
+    {
+        return Create(Vector512.ShiftLeft(vector.GetLower(), shiftCount), Vector512.ShiftLeft(vector.GetUpper(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<long> ShiftLeft(Vector1024<long> vector, int shiftCount)
+    {
+        return Create(Vector512.ShiftLeft(vector.GetLower(), shiftCount), Vector512.ShiftLeft(vector.GetUpper(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<ulong> ShiftLeft(Vector1024<ulong> vector, int shiftCount)
+    {
+        return Create(Vector512.ShiftLeft(vector.GetLower(), shiftCount), Vector512.ShiftLeft(vector.GetUpper(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<sbyte> ShiftRightArithmetic(Vector1024<sbyte> vector, int shiftCount)
+    {
+        return Create(Vector512.ShiftRightArithmetic(vector.GetLower(), shiftCount), Vector512.ShiftRightArithmetic(vector.GetUpper(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<short> ShiftRightArithmetic(Vector1024<short> vector, int shiftCount)
+    {
+        return Create(Vector512.ShiftRightArithmetic(vector.GetLower(), shiftCount), Vector512.ShiftRightArithmetic(vector.GetUpper(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<int> ShiftRightArithmetic(Vector1024<int> vector, int shiftCount)
+    {
+        return Create(Vector512.ShiftRightArithmetic(vector.GetLower(), shiftCount), Vector512.ShiftRightArithmetic(vector.GetUpper(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<long> ShiftRightArithmetic(Vector1024<long> vector, int shiftCount)
+    {
+        return Create(Vector512.ShiftRightArithmetic(vector.GetLower(), shiftCount), Vector512.ShiftRightArithmetic(vector.GetUpper(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<byte> ShiftRightLogical(Vector1024<byte> vector, int shiftCount)
+    {
+        return Create(Vector512.ShiftRightLogical(vector.GetLower(), shiftCount), Vector512.ShiftRightLogical(vector.GetUpper(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<sbyte> ShiftRightLogical(Vector1024<sbyte> vector, int shiftCount)
+    {
+        return Create(Vector512.ShiftRightLogical(vector.GetLower(), shiftCount), Vector512.ShiftRightLogical(vector.GetUpper(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<short> ShiftRightLogical(Vector1024<short> vector, int shiftCount)
+    {
+        return Create(Vector512.ShiftRightLogical(vector.GetLower(), shiftCount), Vector512.ShiftRightLogical(vector.GetUpper(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<ushort> ShiftRightLogical(Vector1024<ushort> vector, int shiftCount)
+    {
+        return Create(Vector512.ShiftRightLogical(vector.GetLower(), shiftCount), Vector512.ShiftRightLogical(vector.GetUpper(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<int> ShiftRightLogical(Vector1024<int> vector, int shiftCount)
+    {
+        return Create(Vector512.ShiftRightLogical(vector.GetLower(), shiftCount), Vector512.ShiftRightLogical(vector.GetUpper(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<uint> ShiftRightLogical(Vector1024<uint> vector, int shiftCount)
+    {
+        return Create(Vector512.ShiftRightLogical(vector.GetLower(), shiftCount), Vector512.ShiftRightLogical(vector.GetUpper(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<long> ShiftRightLogical(Vector1024<long> vector, int shiftCount)
+    {
+        return Create(Vector512.ShiftRightLogical(vector.GetLower(), shiftCount), Vector512.ShiftRightLogical(vector.GetUpper(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<ulong> ShiftRightLogical(Vector1024<ulong> vector, int shiftCount)
+    {
+        return Create(Vector512.ShiftRightLogical(vector.GetLower(), shiftCount), Vector512.ShiftRightLogical(vector.GetUpper(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> Sqrt<T>(Vector1024<T> vector)
+        where T : unmanaged
+    {
+        return Create(Vector512.Sqrt(vector.GetLower()), Vector512.Sqrt(vector.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> Subtract<T>(Vector1024<T> left, Vector1024<T> right)
+        where T : unmanaged
+    {
+        return Create(
+            Vector512.Subtract(left.GetLower(), right.GetLower()),
+            Vector512.Subtract(left.GetUpper(), right.GetUpper()));
+    }
+
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     public static Vector1024<T> WithElement<T>(this Vector1024<T> vector, int index, T value)
         where T : unmanaged
@@ -28,6 +514,15 @@ public static class Vector1024
         return result;
     }
 
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> Xor<T>(Vector1024<T> left, Vector1024<T> right)
+        where T : unmanaged
+    {
+        return Create(
+            Vector512.Xor(left.GetLower(), right.GetLower()),
+            Vector512.Xor(left.GetUpper(), right.GetUpper()));
+    }
+
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     internal static T GetElementUnsafe<T>(in this Vector1024<T> vector, int index)
         where T : unmanaged
@@ -8,7 +8,7 @@ public readonly struct Vector1024<T>
 {
     public static unsafe int Count => Vector1024.Size / sizeof(T);
 
-    public static Vector32<T> Zero => default;
+    public static Vector1024<T> Zero => default;
 
     public T this[int index] => this.GetElementUnsafe(index);
 }
\ No newline at end of file
@@ -1,27 +1,29 @@
 using System.Diagnostics;
-using System.Numerics;
 using System.Runtime.CompilerServices;
 using System.Runtime.Intrinsics;
 
 namespace IR2IL.Runtime;
 
+/// <summary>
+/// Operations on <see cref="Vector16{T}"/>. Most of them copy the vector into the low lanes of a
+/// <see cref="Vector128{T}"/>, so that they're hardware-accelerated, and take the low 16 bits of the result.
+/// </summary>
 public static class Vector16
 {
     internal const int Size = 2;
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector16<T> Add<T>(Vector16<T> left, Vector16<T> right)
-        where T : unmanaged, INumber<T>
+    public static Vector16<T> Abs<T>(Vector16<T> vector)
+        where T : unmanaged
     {
-        Unsafe.SkipInit(out Vector16<T> result);
-
-        for (var index = 0; index < Vector16<T>.Count; index++)
-        {
-            T value = left.GetElementUnsafe(index) + right.GetElementUnsafe(index);
-            result.SetElementUnsafe(index, value);
-        }
+        return FromVector128(Vector128.Abs(vector.ToVector128Unsafe()));
+    }
 
-        return result;
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<T> Add<T>(Vector16<T> left, Vector16<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.Add(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
     }
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
@@ -39,6 +41,13 @@ public static class Vector16
         return vector.As<T, byte>();
     }
 
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<short> AsInt16<T>(this Vector16<T> vector)
+        where T : unmanaged
+    {
+        return vector.As<T, short>();
+    }
+
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     public static Vector16<sbyte> AsSByte<T>(this Vector16<T> vector)
         where T : unmanaged
@@ -47,11 +56,62 @@ public static class Vector16
     }
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static unsafe Vector64<float> ConvertToSingle(Vector16<byte> vector)
+    public static Vector16<ushort> AsUInt16<T>(this Vector16<T> vector)
+        where T : unmanaged
+    {
+        return vector.As<T, ushort>();
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<T> BitwiseAnd<T>(Vector16<T> left, Vector16<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.BitwiseAnd(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<T> BitwiseOr<T>(Vector16<T> left, Vector16<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.BitwiseOr(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<T> ConditionalSelect<T>(Vector16<T> condition, Vector16<T> left, Vector16<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.ConditionalSelect(condition.ToVector128Unsafe(), left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<float> ConvertToSingle(Vector16<byte> vector)
+    {
+        var widened = Vector128.WidenLower(Vector128.WidenLower(vector.ToVector128Unsafe()));
+        return Vector128.ConvertToSingle(widened).GetLower();
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<byte> Create(byte value)
+    {
+        return FromVector128(Vector128.Create(value));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<sbyte> Create(sbyte value)
     {
-        return Vector64.Create(
-            (float)vector.GetElementUnsafe(0),
-            (float)vector.GetElementUnsafe(1));
+        return FromVector128(Vector128.Create(value));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<short> Create(short value)
+    {
+        return FromVector128(Vector128.Create(value));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<ushort> Create(ushort value)
+    {
+        return FromVector128(Vector128.Create(value));
     }
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
@@ -73,20 +133,19 @@ public static class Vector16
     }
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector16<T> Equals<T>(Vector16<T> left, Vector16<T> right)
-        where T : unmanaged, INumber<T>
+    public static Vector16<T> Divide<T>(Vector16<T> left, Vector16<T> right)
+        where T : unmanaged
     {
-        Unsafe.SkipInit(out Vector16<T> result);
-
-        for (int index = 0; index < Vector16<T>.Count; index++)
-        {
-            T value = left.GetElementUnsafe(index) == right.GetElementUnsafe(index)
-                ? Scalar<T>.AllBitsSet
-                : default!;
-            result.SetElementUnsafe(index, value);
-        }
+        // The unused lanes of the divisor are ones, so that integer division doesn't throw for them.
+        var divisor = Vector128<T>.One.AsUInt16().WithElement(0, Unsafe.BitCast<Vector16<T>, ushort>(right)).As<ushort, T>();
+        return FromVector128(Vector128.Divide(left.ToVector128Unsafe(), divisor));
+    }
 
-        return result;
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<T> Equals<T>(Vector16<T> left, Vector16<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.Equals(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
     }
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
@@ -101,6 +160,156 @@ public static class Vector16
         return vector.GetElementUnsafe(index);
     }
 
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<T> GreaterThan<T>(Vector16<T> left, Vector16<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.GreaterThan(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<T> GreaterThanOrEqual<T>(Vector16<T> left, Vector16<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.GreaterThanOrEqual(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<T> LessThan<T>(Vector16<T> left, Vector16<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.LessThan(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<T> LessThanOrEqual<T>(Vector16<T> left, Vector16<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.LessThanOrEqual(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<T> Max<T>(Vector16<T> left, Vector16<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.Max(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<T> Min<T>(Vector16<T> left, Vector16<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.Min(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<T> Multiply<T>(Vector16<T> left, Vector16<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.Multiply(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<T> Negate<T>(Vector16<T> vector)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.Negate(vector.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<T> OnesComplement<T>(Vector16<T> vector)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.OnesComplement(vector.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<byte> ShiftLeft(Vector16<byte> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftLeft(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<sbyte> ShiftLeft(Vector16<sbyte> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftLeft(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<short> ShiftLeft(Vector16<short> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftLeft(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<ushort> ShiftLeft(Vector16<ushort> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftLeft(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<sbyte> ShiftRightArithmetic(Vector16<sbyte> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftRightArithmetic(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<short> ShiftRightArithmetic(Vector16<short> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftRightArithmetic(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<byte> ShiftRightLogical(Vector16<byte> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftRightLogical(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<sbyte> ShiftRightLogical(Vector16<sbyte> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftRightLogical(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<short> ShiftRightLogical(Vector16<short> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftRightLogical(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<ushort> ShiftRightLogical(Vector16<ushort> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftRightLogical(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<T> Subtract<T>(Vector16<T> left, Vector16<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.Subtract(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
+    /// <summary>
+    /// Copies the elements into the low lanes of a <see cref="Vector128{T}"/>, and zeroes the others.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> ToVector128<T>(this Vector16<T> vector)
+        where T : unmanaged
+    {
+        return Vector128.CreateScalar(Unsafe.BitCast<Vector16<T>, ushort>(vector)).As<ushort, T>();
+    }
+
+    /// <summary>
+    /// Copies the elements into the low lanes of a <see cref="Vector128{T}"/>, leaving the others undefined.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> ToVector128Unsafe<T>(this Vector16<T> vector)
+        where T : unmanaged
+    {
+        return Vector128.CreateScalarUnsafe(Unsafe.BitCast<Vector16<T>, ushort>(vector)).As<ushort, T>();
+    }
+
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     public static Vector16<T> WithElement<T>(this Vector16<T> vector, int index, T value)
         where T : unmanaged
@@ -110,6 +319,23 @@ public static class Vector16
         return result;
     }
 
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<T> Xor<T>(Vector16<T> left, Vector16<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.Xor(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
+    /// <summary>
+    /// The elements in the low 2 bytes of <paramref name="vector"/>.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    internal static Vector16<T> FromVector128<T>(Vector128<T> vector)
+        where T : unmanaged
+    {
+        return Unsafe.BitCast<ushort, Vector16<T>>(vector.AsUInt16().ToScalar());
+    }
+
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     internal static T GetElementUnsafe<T>(in this Vector16<T> vector, int index)
         where T : unmanaged
@@ -1,27 +1,29 @@
 using System.Diagnostics;
-using System.Numerics;
 using System.Runtime.CompilerServices;
 using System.Runtime.Intrinsics;
 
 namespace IR2IL.Runtime;
 
+/// <summary>
+/// Operations on <see cref="Vector32{T}"/>. Most of them copy the vector into the low lanes of a
+/// <see cref="Vector128{T}"/>, so that they're hardware-accelerated, and take the low 32 bits of the result.
+/// </summary>
 public static class Vector32
 {
     internal const int Size = 4;
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector32<T> Add<T>(Vector32<T> left, Vector32<T> right)
-        where T : unmanaged, INumber<T>
+    public static Vector32<T> Abs<T>(Vector32<T> vector)
+        where T : unmanaged
     {
-        Unsafe.SkipInit(out Vector32<T> result);
-
-        for (var index = 0; index < Vector32<T>.Count; index++)
-        {
-            T value = left.GetElementUnsafe(index) + right.GetElementUnsafe(index);
-            result.SetElementUnsafe(index, value);
-        }
+        return FromVector128(Vector128.Abs(vector.ToVector128Unsafe()));
+    }
 
-        return result;
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<T> Add<T>(Vector32<T> left, Vector32<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.Add(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
     }
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
@@ -32,6 +34,13 @@ public static class Vector32
         return Unsafe.BitCast<Vector32<TFrom>, Vector32<TTo>>(vector);
     }
 
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<byte> AsByte<T>(this Vector32<T> vector)
+        where T : unmanaged
+    {
+        return vector.As<T, byte>();
+    }
+
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     public static Vector32<short> AsInt16<T>(this Vector32<T> vector)
         where T : unmanaged
@@ -39,6 +48,27 @@ public static class Vector32
         return vector.As<T, short>();
     }
 
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<int> AsInt32<T>(this Vector32<T> vector)
+        where T : unmanaged
+    {
+        return vector.As<T, int>();
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<sbyte> AsSByte<T>(this Vector32<T> vector)
+        where T : unmanaged
+    {
+        return vector.As<T, sbyte>();
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<float> AsSingle<T>(this Vector32<T> vector)
+        where T : unmanaged
+    {
+        return vector.As<T, float>();
+    }
+
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     public static Vector32<ushort> AsUInt16<T>(this Vector32<T> vector)
         where T : unmanaged
@@ -46,6 +76,82 @@ public static class Vector32
         return vector.As<T, ushort>();
     }
 
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<uint> AsUInt32<T>(this Vector32<T> vector)
+        where T : unmanaged
+    {
+        return vector.As<T, uint>();
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<T> BitwiseAnd<T>(Vector32<T> left, Vector32<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.BitwiseAnd(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<T> BitwiseOr<T>(Vector32<T> left, Vector32<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.BitwiseOr(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<float> Ceiling(Vector32<float> vector)
+    {
+        return FromVector128(Vector128.Ceiling(vector.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<T> ConditionalSelect<T>(Vector32<T> condition, Vector32<T> left, Vector32<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.ConditionalSelect(condition.ToVector128Unsafe(), left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<byte> Create(byte value)
+    {
+        return FromVector128(Vector128.Create(value));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<float> Create(float value)
+    {
+        return FromVector128(Vector128.Create(value));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<int> Create(int value)
+    {
+        return FromVector128(Vector128.Create(value));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<sbyte> Create(sbyte value)
+    {
+        return FromVector128(Vector128.Create(value));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<short> Create(short value)
+    {
+        return FromVector128(Vector128.Create(value));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<uint> Create(uint value)
+    {
+        return FromVector128(Vector128.Create(value));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<ushort> Create(ushort value)
+    {
+        return FromVector128(Vector128.Create(value));
+    }
+
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     public static Vector32<short> Create(short e0, short e1)
     {
@@ -64,6 +170,28 @@ public static class Vector32
         return result;
     }
 
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<T> Divide<T>(Vector32<T> left, Vector32<T> right)
+        where T : unmanaged
+    {
+        // The unused lanes of the divisor are ones, so that integer division doesn't throw for them.
+        var divisor = Vector128<T>.One.AsUInt32().WithElement(0, Unsafe.BitCast<Vector32<T>, uint>(right)).As<uint, T>();
+        return FromVector128(Vector128.Divide(left.ToVector128Unsafe(), divisor));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<T> Equals<T>(Vector32<T> left, Vector32<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.Equals(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<float> Floor(Vector32<float> vector)
+    {
+        return FromVector128(Vector128.Floor(vector.ToVector128Unsafe()));
+    }
+
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     public static T GetElement<T>(this Vector32<T> vector, int index)
         where T : unmanaged
@@ -76,40 +204,191 @@ public static class Vector32
         return vector.GetElementUnsafe(index);
     }
 
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<T> GreaterThan<T>(Vector32<T> left, Vector32<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.GreaterThan(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<T> GreaterThanOrEqual<T>(Vector32<T> left, Vector32<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.GreaterThanOrEqual(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<T> LessThan<T>(Vector32<T> left, Vector32<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.LessThan(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<T> LessThanOrEqual<T>(Vector32<T> left, Vector32<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.LessThanOrEqual(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<T> Max<T>(Vector32<T> left, Vector32<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.Max(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<T> Min<T>(Vector32<T> left, Vector32<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.Min(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     public static Vector32<T> Multiply<T>(Vector32<T> left, Vector32<T> right)
-        where T : unmanaged, INumber<T>
+        where T : unmanaged
     {
-        Unsafe.SkipInit(out Vector32<T> result);
+        return FromVector128(Vector128.Multiply(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
 
-        for (var index = 0; index < Vector32<T>.Count; index++)
-        {
-            T value = left.GetElementUnsafe(index) * right.GetElementUnsafe(index);
-            result.SetElementUnsafe(index, value);
-        }
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<T> Negate<T>(Vector32<T> vector)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.Negate(vector.ToVector128Unsafe()));
+    }
 
-        return result;
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<T> OnesComplement<T>(Vector32<T> vector)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.OnesComplement(vector.ToVector128Unsafe()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<byte> ShiftLeft(Vector32<byte> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftLeft(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<int> ShiftLeft(Vector32<int> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftLeft(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<sbyte> ShiftLeft(Vector32<sbyte> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftLeft(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<short> ShiftLeft(Vector32<short> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftLeft(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<uint> ShiftLeft(Vector32<uint> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftLeft(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<ushort> ShiftLeft(Vector32<ushort> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftLeft(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<int> ShiftRightArithmetic(Vector32<int> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftRightArithmetic(vector.ToVector128Unsafe(), shiftCount));
     }
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector32<short> ShiftLeft(Vector32<short> value, int shiftCount)
+    public static Vector32<sbyte> ShiftRightArithmetic(Vector32<sbyte> vector, int shiftCount)
     {
-        return Create((short)(value[0] << shiftCount), (short)(value[1] << shiftCount));
+        return FromVector128(Vector128.ShiftRightArithmetic(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<short> ShiftRightArithmetic(Vector32<short> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftRightArithmetic(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<byte> ShiftRightLogical(Vector32<byte> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftRightLogical(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<int> ShiftRightLogical(Vector32<int> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftRightLogical(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<sbyte> ShiftRightLogical(Vector32<sbyte> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftRightLogical(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<short> ShiftRightLogical(Vector32<short> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftRightLogical(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<uint> ShiftRightLogical(Vector32<uint> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftRightLogical(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<ushort> ShiftRightLogical(Vector32<ushort> vector, int shiftCount)
+    {
+        return FromVector128(Vector128.ShiftRightLogical(vector.ToVector128Unsafe(), shiftCount));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<T> Sqrt<T>(Vector32<T> vector)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.Sqrt(vector.ToVector128Unsafe()));
     }
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     public static Vector32<T> Subtract<T>(Vector32<T> left, Vector32<T> right)
-        where T : unmanaged, INumber<T>
+        where T : unmanaged
     {
-        Unsafe.SkipInit(out Vector32<T> result);
+        return FromVector128(Vector128.Subtract(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
 
-        for (var index = 0; index < Vector32<T>.Count; index++)
-        {
-            T value = left.GetElementUnsafe(index) - right.GetElementUnsafe(index);
-            result.SetElementUnsafe(index, value);
-        }
+    /// <summary>
+    /// Copies the elements into the low lanes of a <see cref="Vector128{T}"/>, and zeroes the others.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> ToVector128<T>(this Vector32<T> vector)
+        where T : unmanaged
+    {
+        return Vector128.CreateScalar(Unsafe.BitCast<Vector32<T>, uint>(vector)).As<uint, T>();
+    }
 
-        return result;
+    /// <summary>
+    /// Copies the elements into the low lanes of a <see cref="Vector128{T}"/>, leaving the others undefined.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> ToVector128Unsafe<T>(this Vector32<T> vector)
+        where T : unmanaged
+    {
+        return Vector128.CreateScalarUnsafe(Unsafe.BitCast<Vector32<T>, uint>(vector)).As<uint, T>();
     }
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
@@ -121,6 +400,23 @@ public static class Vector32
         return result;
     }
 
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<T> Xor<T>(Vector32<T> left, Vector32<T> right)
+        where T : unmanaged
+    {
+        return FromVector128(Vector128.Xor(left.ToVector128Unsafe(), right.ToVector128Unsafe()));
+    }
+
+    /// <summary>
+    /// The elements in the low 4 bytes of <paramref name="vector"/>.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    internal static Vector32<T> FromVector128<T>(Vector128<T> vector)
+        where T : unmanaged
+    {
+        return Unsafe.BitCast<uint, Vector32<T>>(vector.AsUInt32().ToScalar());
+    }
+
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     internal static T GetElementUnsafe<T>(in this Vector32<T> vector, int index)
         where T : unmanaged
@@ -0,0 +1,585 @@
+using System.Runtime.CompilerServices;
+using System.Runtime.Intrinsics;
+using System.Runtime.Intrinsics.X86;
+
+namespace IR2IL.Runtime;
+
+/// <summary>
+/// Implementations of sext, zext, trunc, sitofp, uitofp, fptosi, fptoui, fpext and fptrunc on vectors of any shape.
+/// </summary>
+/// <remarks>
+/// <c>TFrom</c> and <c>TTo</c> are the element types, and <c>TVector</c> and <c>TResult</c> the vector types.
+/// The element types say what the lanes hold: <see cref="bool"/> for i1, whose lanes are sbytes that are 0 or -1,
+/// and <see cref="Half"/> and <see cref="BFloat16"/> for half and bfloat, whose lanes are ushorts.
+///
+/// The vector is converted a block at a time, where a block is as many lanes as fit in a <see cref="Vector128{T}"/>
+/// of the widest type involved. Each block is converted by a chain of hardware steps: widening, narrowing (with
+/// the AVX-512 down-converts, which go straight to the destination width, when they're available), and conversions
+/// between integers and floating point. Half and bfloat go through float, which holds them exactly.
+/// The few conversions that have no vector instructions, such as from i64 to float before AVX-512, are done one lane
+/// at a time within the block. 256-bit conversions that keep the lane width, such as from i32 to float, don't need
+/// blocks, and go straight to the AVX or AVX-512 instruction when there is one.
+/// </remarks>
+public static unsafe class VectorConversions
+{
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static TResult SignExtend<TFrom, TTo, TVector, TResult>(TVector vector)
+        where TFrom : unmanaged
+        where TTo : unmanaged
+        where TVector : unmanaged
+        where TResult : unmanaged => Convert<TFrom, TTo, TVector, TResult>(vector, isSigned: true);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static TResult ZeroExtend<TFrom, TTo, TVector, TResult>(TVector vector)
+        where TFrom : unmanaged
+        where TTo : unmanaged
+        where TVector : unmanaged
+        where TResult : unmanaged => Convert<TFrom, TTo, TVector, TResult>(vector, isSigned: false);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static TResult Truncate<TFrom, TTo, TVector, TResult>(TVector vector)
+        where TFrom : unmanaged
+        where TTo : unmanaged
+        where TVector : unmanaged
+        where TResult : unmanaged => Convert<TFrom, TTo, TVector, TResult>(vector, isSigned: false);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static TResult ConvertSignedToFloat<TFrom, TTo, TVector, TResult>(TVector vector)
+        where TFrom : unmanaged
+        where TTo : unmanaged
+        where TVector : unmanaged
+        where TResult : unmanaged => Convert<TFrom, TTo, TVector, TResult>(vector, isSigned: true);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static TResult ConvertUnsignedToFloat<TFrom, TTo, TVector, TResult>(TVector vector)
+        where TFrom : unmanaged
+        where TTo : unmanaged
+        where TVector : unmanaged
+        where TResult : unmanaged => Convert<TFrom, TTo, TVector, TResult>(vector, isSigned: false);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static TResult ConvertFloatToSigned<TFrom, TTo, TVector, TResult>(TVector vector)
+        where TFrom : unmanaged
+        where TTo : unmanaged
+        where TVector : unmanaged
+        where TResult : unmanaged => Convert<TFrom, TTo, TVector, TResult>(vector, isSigned: true);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static TResult ConvertFloatToUnsigned<TFrom, TTo, TVector, TResult>(TVector vector)
+        where TFrom : unmanaged
+        where TTo : unmanaged
+        where TVector : unmanaged
+        where TResult : unmanaged => Convert<TFrom, TTo, TVector, TResult>(vector, isSigned: false);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static TResult FloatExtend<TFrom, TTo, TVector, TResult>(TVector vector)
+        where TFrom : unmanaged
+        where TTo : unmanaged
+        where TVector : unmanaged
+        where TResult : unmanaged => Convert<TFrom, TTo, TVector, TResult>(vector, isSigned: false);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static TResult FloatTruncate<TFrom, TTo, TVector, TResult>(TVector vector)
+        where TFrom : unmanaged
+        where TTo : unmanaged
+        where TVector : unmanaged
+        where TResult : unmanaged => Convert<TFrom, TTo, TVector, TResult>(vector, isSigned: false);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static TResult Convert<TFrom, TTo, TVector, TResult>(TVector vector, bool isSigned)
+        where TFrom : unmanaged
+        where TTo : unmanaged
+        where TVector : unmanaged
+        where TResult : unmanaged
+    {
+        if (sizeof(TVector) == sizeof(Vector256<byte>)
+            && sizeof(TResult) == sizeof(Vector256<byte>)
+            && TryConvertSameWidth<TFrom, TTo>(*(Vector256<byte>*)&vector, isSigned, out var sameWidthResult))
+        {
+            return *(TResult*)&sameWidthResult;
+        }
+
+        // Padded vectors have the same number of lanes on both sides, except that the smallest vectors
+        // can have more lanes of narrow elements than of wide ones.
+        var laneCount = Math.Min(sizeof(TVector) / sizeof(TFrom), sizeof(TResult) / sizeof(TTo));
+        var lanesPerBlock = sizeof(Vector128<byte>) / GetWorkingSize<TFrom, TTo>();
+
+        // Each block is loaded and stored as a whole Vector128, which can go past the end of the vectors.
+        var source = new Padded<TVector> { Vector = vector, Padding = default };
+        var result = default(Padded<TResult>);
+
+        for (var lane = 0; lane < laneCount; lane += lanesPerBlock)
+        {
+            var block = Vector128.Load((byte*)&source + lane * sizeof(TFrom));
+            ConvertBlock<TFrom, TTo>(block, isSigned).Store((byte*)&result + lane * sizeof(TTo));
+        }
+
+        return result.Vector;
+    }
+
+    /// <summary>
+    /// Converts a whole Vector256 between 32-bit integers and float, or 64-bit integers and double, when there's an
+    /// instruction for it, rather than a block at a time through memory.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static bool TryConvertSameWidth<TFrom, TTo>(Vector256<byte> value, bool isSigned, out Vector256<byte> result)
+        where TFrom : unmanaged
+        where TTo : unmanaged
+    {
+        if (typeof(TTo) == typeof(float) && sizeof(TFrom) == sizeof(int))
+        {
+            if (isSigned && Avx.IsSupported)
+            {
+                result = Avx.ConvertToVector256Single(value.AsInt32()).AsByte();
+                return true;
+            }
+            else if (!isSigned && Avx512F.VL.IsSupported)
+            {
+                result = Avx512F.VL.ConvertToVector256Single(value.AsUInt32()).AsByte();
+                return true;
+            }
+        }
+        else if (typeof(TFrom) == typeof(float) && sizeof(TTo) == sizeof(int))
+        {
+            if (isSigned && Avx.IsSupported)
+            {
+                result = Avx.ConvertToVector256Int32WithTruncation(value.AsSingle()).AsByte();
+                return true;
+            }
+            else if (!isSigned && Avx512F.VL.IsSupported)
+            {
+                result = Avx512F.VL.ConvertToVector256UInt32WithTruncation(value.AsSingle()).AsByte();
+                return true;
+            }
+        }
+        else if (typeof(TTo) == typeof(double) && sizeof(TFrom) == sizeof(long) && Avx512DQ.VL.IsSupported)
+        {
+            result = (isSigned
+                ? Avx512DQ.VL.ConvertToVector256Double(value.AsInt64())
+                : Avx512DQ.VL.ConvertToVector256Double(value.AsUInt64())).AsByte();
+            return true;
+        }
+        else if (typeof(TFrom) == typeof(double) && sizeof(TTo) == sizeof(long) && Avx512DQ.VL.IsSupported)
+        {
+            result = (isSigned
+                ? Avx512DQ.VL.ConvertToVector256Int64WithTruncation(value.AsDouble()).AsByte()
+                : Avx512DQ.VL.ConvertToVector256UInt64WithTruncation(value.AsDouble()).AsByte());
+            return true;
+        }
+
+        result = default;
+        return false;
+    }
+
+    /// <summary>
+    /// The size of the widest lanes that a block is held in on its way from <typeparamref name="TFrom"/>
+    /// to <typeparamref name="TTo"/>. That's at least float for half and bfloat.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static int GetWorkingSize<TFrom, TTo>()
+        where TFrom : unmanaged
+        where TTo : unmanaged
+    {
+        var result = Math.Max(sizeof(TFrom), sizeof(TTo));
+        return IsReducedPrecision<TFrom>() || IsReducedPrecision<TTo>()
+            ? Math.Max(result, sizeof(float))
+            : result;
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<byte> ConvertBlock<TFrom, TTo>(Vector128<byte> value, bool isSigned)
+        where TFrom : unmanaged
+        where TTo : unmanaged
+    {
+        if (IsReducedPrecision<TFrom>())
+        {
+            var widened = Vector128.WidenLower(value.AsUInt16());
+            var single = typeof(TFrom) == typeof(Half)
+                ? HalfToSingle(widened)
+                : (widened << 16).AsSingle();
+            return ConvertFloatBlock<float, TTo>(single.AsByte(), isSigned);
+        }
+        else if (typeof(TFrom) == typeof(float) || typeof(TFrom) == typeof(double))
+        {
+            return ConvertFloatBlock<TFrom, TTo>(value, isSigned);
+        }
+
+        // i1 lanes are already sign-extended.
+        if (typeof(TFrom) == typeof(bool) && !isSigned)
+        {
+            value &= Vector128<byte>.One;
+        }
+
+        return ConvertIntegerBlock<TFrom, TTo>(value, isSigned);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<byte> ConvertIntegerBlock<TFrom, TTo>(Vector128<byte> value, bool isSigned)
+        where TFrom : unmanaged
+        where TTo : unmanaged
+    {
+        var fromSize = sizeof(TFrom);
+
+        if (typeof(TTo) == typeof(float))
+        {
+            if (fromSize == sizeof(long))
+            {
+                if (Avx512DQ.VL.IsSupported)
+                {
+                    return (isSigned
+                        ? Avx512DQ.VL.ConvertToVector128Single(value.AsInt64())
+                        : Avx512DQ.VL.ConvertToVector128Single(value.AsUInt64())).AsByte();
+                }
+
+                return ConvertLanes<TFrom, TTo>(value, isSigned);
+            }
+            else if (fromSize == sizeof(int) && !isSigned)
+            {
+                return Vector128.ConvertToSingle(value.AsUInt32()).AsByte();
+            }
+
+            return Vector128.ConvertToSingle(ResizeInteger(value, fromSize, sizeof(int), isSigned).AsInt32()).AsByte();
+        }
+        else if (typeof(TTo) == typeof(double))
+        {
+            if (fromSize == sizeof(long))
+            {
+                return ConvertInt64ToDouble(value.AsUInt64(), isSigned).AsByte();
+            }
+            else if (fromSize == sizeof(int) && !isSigned)
+            {
+                // Biased into the range of int, and back again in double, where it's exact.
+                var biased = ConvertInt32ToDouble(value.AsInt32() ^ Vector128.Create(int.MinValue));
+                return (biased + Vector128.Create(-(double)int.MinValue)).AsByte();
+            }
+
+            return ConvertInt32ToDouble(ResizeInteger(value, fromSize, sizeof(int), isSigned).AsInt32()).AsByte();
+        }
+        else if (IsReducedPrecision<TTo>())
+        {
+            // Integers of up to 16 bits are exact in float, so going through float only rounds once.
+            if (fromSize <= sizeof(short))
+            {
+                return ConvertFloatBlock<float, TTo>(ConvertIntegerBlock<TFrom, float>(value, isSigned), isSigned);
+            }
+
+            return ConvertLanes<TFrom, TTo>(value, isSigned);
+        }
+
+        var result = ResizeInteger(value, fromSize, sizeof(TTo), isSigned);
+        return typeof(TTo) == typeof(bool) ? ToBooleanLanes(result) : result;
+    }
+
+    /// <remarks>
+    /// <typeparamref name="TFrom"/> is float or double.
+    /// </remarks>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<byte> ConvertFloatBlock<TFrom, TTo>(Vector128<byte> value, bool isSigned)
+        where TFrom : unmanaged
+        where TTo : unmanaged
+    {
+        // From half or bfloat, which are already in float.
+        if (typeof(TTo) == typeof(TFrom))
+        {
+            return value;
+        }
+        else if (typeof(TTo) == typeof(double))
+        {
+            return Vector128.WidenLower(value.AsSingle()).AsByte();
+        }
+        else if (typeof(TTo) == typeof(float))
+        {
+            return Vector128.Narrow(value.AsDouble(), value.AsDouble()).AsByte();
+        }
+        else if (IsReducedPrecision<TTo>())
+        {
+            // Going through float would round twice.
+            if (typeof(TFrom) == typeof(double))
+            {
+                return ConvertLanes<TFrom, TTo>(value, isSigned);
+            }
+
+            var bits = typeof(TTo) == typeof(Half)
+                ? SingleToHalf(value.AsSingle())
+                : SingleToBFloat16(value.AsSingle());
+            return Vector128.Narrow(bits, bits).AsByte();
+        }
+
+        // Out-of-range values are poison, so it doesn't matter what they convert to. Narrower integers are converted
+        // to int first, which holds every value that's in range for them, signed or unsigned.
+        var toSize = sizeof(TTo);
+        Vector128<byte> result;
+        if (typeof(TFrom) == typeof(float))
+        {
+            if (toSize == sizeof(long))
+            {
+                return ConvertFloatBlock<double, TTo>(Vector128.WidenLower(value.AsSingle()).AsByte(), isSigned);
+            }
+
+            result = toSize == sizeof(uint) && !isSigned
+                ? Vector128.ConvertToUInt32(value.AsSingle()).AsByte()
+                : ResizeInteger(ConvertSingleToInt32(value.AsSingle()).AsByte(), sizeof(int), toSize, isSigned: true);
+        }
+        else if (toSize == sizeof(long))
+        {
+            result = isSigned
+                ? ConvertDoubleToInt64(value.AsDouble()).AsByte()
+                : Vector128.ConvertToUInt64(value.AsDouble()).AsByte();
+        }
+        else if (toSize == sizeof(uint) && !isSigned)
+        {
+            var converted = Vector128.ConvertToInt64(value.AsDouble());
+            result = Vector128.Narrow(converted, converted).AsByte();
+        }
+        else
+        {
+            result = ResizeInteger(ConvertDoubleToInt32(value.AsDouble()).AsByte(), sizeof(int), toSize, isSigned: true);
+        }
+
+        return typeof(TTo) == typeof(bool) ? ToBooleanLanes(result) : result;
+    }
+
+    /// <summary>
+    /// Sign-extends, zero-extends or truncates the integer lanes of a block from <paramref name="fromSize"/> bytes
+    /// to <paramref name="toSize"/> bytes.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<byte> ResizeInteger(Vector128<byte> value, int fromSize, int toSize, bool isSigned)
+    {
+        // Written out rather than as loops, so that once the sizes are constants, the JIT is left with just the steps.
+        if (fromSize < toSize)
+        {
+            value = WidenLower(value, fromSize, isSigned);
+            if (fromSize * 2 < toSize)
+            {
+                value = WidenLower(value, fromSize * 2, isSigned);
+            }
+            if (fromSize * 4 < toSize)
+            {
+                value = WidenLower(value, fromSize * 4, isSigned);
+            }
+            return value;
+        }
+        else if (fromSize > toSize)
+        {
+            if (Avx512F.VL.IsSupported && fromSize >= sizeof(int))
+            {
+                return (fromSize, toSize) switch
+                {
+                    (sizeof(int), sizeof(byte)) => Avx512F.VL.ConvertToVector128Byte(value.AsInt32()),
+                    (sizeof(int), _) => Avx512F.VL.ConvertToVector128Int16(value.AsInt32()).AsByte(),
+                    (_, sizeof(byte)) => Avx512F.VL.ConvertToVector128Byte(value.AsInt64()),
+                    (_, sizeof(short)) => Avx512F.VL.ConvertToVector128Int16(value.AsInt64()).AsByte(),
+                    _ => Avx512F.VL.ConvertToVector128Int32(value.AsInt64()).AsByte(),
+                };
+            }
+            else if (Avx512BW.VL.IsSupported && fromSize == sizeof(short))
+            {
+                return Avx512BW.VL.ConvertToVector128Byte(value.AsInt16());
+            }
+
+            value = NarrowLower(value, fromSize);
+            if (fromSize / 2 > toSize)
+            {
+                value = NarrowLower(value, fromSize / 2);
+            }
+            if (fromSize / 4 > toSize)
+            {
+                value = NarrowLower(value, fromSize / 4);
+            }
+            return value;
+        }
+
+        return value;
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<byte> WidenLower(Vector128<byte> value, int size, bool isSigned) => (size, isSigned) switch
+    {
+        (sizeof(byte), true) => Vector128.WidenLower(value.AsSByte()).AsByte(),
+        (sizeof(byte), false) => Vector128.WidenLower(value).AsByte(),
+        (sizeof(short), true) => Vector128.WidenLower(value.AsInt16()).AsByte(),
+        (sizeof(short), false) => Vector128.WidenLower(value.AsUInt16()).AsByte(),
+        (_, true) => Vector128.WidenLower(value.AsInt32()).AsByte(),
+        (_, false) => Vector128.WidenLower(value.AsUInt32()).AsByte(),
+    };
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<byte> NarrowLower(Vector128<byte> value, int size) => size switch
+    {
+        sizeof(short) => Vector128.Narrow(value.AsUInt16(), value.AsUInt16()),
+        sizeof(int) => Vector128.Narrow(value.AsUInt32(), value.AsUInt32()).AsByte(),
+        _ => Vector128.Narrow(value.AsUInt64(), value.AsUInt64()).AsByte(),
+    };
+
+    /// <summary>
+    /// Converts the lower two lanes.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<double> ConvertInt32ToDouble(Vector128<int> value) =>
+        Sse2.IsSupported
+            ? Sse2.ConvertToVector128Double(value)
+            : Vector128.ConvertToDouble(Vector128.WidenLower(value));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<double> ConvertInt64ToDouble(Vector128<ulong> value, bool isSigned)
+    {
+        if (Avx512DQ.VL.IsSupported)
+        {
+            return isSigned
+                ? Avx512DQ.VL.ConvertToVector128Double(value.AsInt64())
+                : Avx512DQ.VL.ConvertToVector128Double(value);
+        }
+
+        // Each 32-bit half is exact in double, so adding them rounds only once. The halves are put in the mantissas
+        // of 2^84 and 2^52, which are then subtracted. A signed upper half is biased by 2^31 to make it unsigned.
+        var upper = value >>> 32;
+        var upperBias = 0x4530000000000000UL;
+        if (isSigned)
+        {
+            upper ^= Vector128.Create(0x80000000UL);
+            upperBias |= 0x80000000UL;
+        }
+        var upperDouble = (upper | Vector128.Create(0x4530000000000000UL)).AsDouble() - Vector128.Create(BitConverter.UInt64BitsToDouble(upperBias));
+        var lowerDouble = ((value & Vector128.Create(0xFFFFFFFFUL)) | Vector128.Create(0x4330000000000000UL)).AsDouble()
+            - Vector128.Create(BitConverter.UInt64BitsToDouble(0x4330000000000000UL));
+        return upperDouble + lowerDouble;
+    }
+
+    // Since .NET 9, Vector128.ConvertToInt32 and ConvertToInt64 saturate, which takes a few more instructions
+    // on x86. The lanes this is used for are poison when they're out of range, so plain truncation will do.
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<int> ConvertSingleToInt32(Vector128<float> value) => Sse2.IsSupported
+        ? Sse2.ConvertToVector128Int32WithTruncation(value)
+        : Vector128.ConvertToInt32(value);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<long> ConvertDoubleToInt64(Vector128<double> value) => Avx512DQ.VL.IsSupported
+        ? Avx512DQ.VL.ConvertToVector128Int64WithTruncation(value)
+        : Vector128.ConvertToInt64(value);
+
+    /// <summary>
+    /// Converts two lanes into the lower two lanes.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<int> ConvertDoubleToInt32(Vector128<double> value)
+    {
+        if (Sse2.IsSupported)
+        {
+            return Sse2.ConvertToVector128Int32WithTruncation(value);
+        }
+
+        var converted = Vector128.ConvertToInt64(value);
+        return Vector128.Narrow(converted, converted);
+    }
+
+    /// <summary>
+    /// i1 lanes are set when the low bit is.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<byte> ToBooleanLanes(Vector128<byte> value) => Vector128<byte>.Zero - (value & Vector128<byte>.One);
+
+    /// <summary>
+    /// Converts a block of 32-bit or 64-bit integers, or doubles, to half or bfloat, or 64-bit integers to float,
+    /// one lane at a time, in the same way as scalar conversions.
+    /// </summary>
+    private static Vector128<byte> ConvertLanes<TFrom, TTo>(Vector128<byte> value, bool isSigned)
+        where TFrom : unmanaged
+        where TTo : unmanaged
+    {
+        var result = Vector128<byte>.Zero;
+        var resultLanes = (TTo*)&result;
+        var valueLanes = (byte*)&value;
+        for (var i = 0; i < sizeof(Vector128<byte>) / GetWorkingSize<TFrom, TTo>(); i++)
+        {
+            var lane = valueLanes + i * sizeof(TFrom);
+            if (typeof(TTo) == typeof(float))
+            {
+                *(float*)(resultLanes + i) = isSigned ? *(long*)lane : *(ulong*)lane;
+                continue;
+            }
+
+            double converted = typeof(TFrom) == typeof(double) ? *(double*)lane
+                : sizeof(TFrom) == sizeof(int) ? (isSigned ? *(int*)lane : *(uint*)lane)
+                : (isSigned ? *(long*)lane : *(ulong*)lane);
+            if (typeof(TTo) == typeof(Half))
+            {
+                *(Half*)(resultLanes + i) = (Half)converted;
+            }
+            else
+            {
+                *(BFloat16*)(resultLanes + i) = (BFloat16)converted;
+            }
+        }
+        return result;
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static bool IsReducedPrecision<T>() => typeof(T) == typeof(Half) || typeof(T) == typeof(BFloat16);
+
+    private struct Padded<TVector>
+        where TVector : unmanaged
+    {
+        public TVector Vector;
+        public Vector128<byte> Padding;
+    }
+
+    // .NET doesn't expose F16C, so half conversions are done with integer and float arithmetic.
+    // Based on "half <-> float conversions" by Fabian Giesen.
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<float> HalfToSingle(Vector128<uint> value)
+    {
+        var sign = (value & Vector128.Create(0x8000u)) << 16;
+        var bits = (value & Vector128.Create(0x7FFFu)) << 13;
+        var exponent = bits & Vector128.Create(0x0F800000u);
+
+        // Rebias the exponent, and then once more for infinity and NaN so they keep the maximum exponent.
+        bits += Vector128.Create(0x38000000u);
+        bits += Vector128.Equals(exponent, Vector128.Create(0x0F800000u)) & Vector128.Create(0x38000000u);
+
+        // Subnormals (and zero) need renormalizing, which a float subtraction does for us.
+        var subnormal = (bits + Vector128.Create(0x00800000u)).AsSingle() - Vector128.Create(0x38800000u).AsSingle();
+        bits = Vector128.ConditionalSelect(Vector128.Equals(exponent, Vector128<uint>.Zero), subnormal.AsUInt32(), bits);
+
+        return (bits | sign).AsSingle();
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<uint> SingleToHalf(Vector128<float> value)
+    {
+        var bits = value.AsUInt32();
+        var sign = bits & Vector128.Create(0x80000000u);
+        var magnitude = (bits ^ sign).AsInt32();
+
+        // Results that are subnormal halves: adding this makes the FPU round the mantissa into place.
+        var subnormalMagic = Vector128.Create(((127 - 15) + (23 - 10) + 1) << 23);
+        var subnormal = (magnitude.AsSingle() + subnormalMagic.AsSingle()).AsInt32() - subnormalMagic;
+
+        // Normal results: rebias the exponent and round to nearest even by hand.
+        var mantissaOdd = (magnitude >>> 13) & Vector128<int>.One;
+        var normal = (magnitude + Vector128.Create(((15 - 127) << 23) + 0xFFF) + mantissaOdd) >>> 13;
+
+        // Anything too large becomes infinity, and NaNs stay NaN with the quiet bit set.
+        var infinityOrNaN = Vector128.ConditionalSelect(
+            Vector128.GreaterThan(magnitude, Vector128.Create(0x7F800000)),
+            Vector128.Create(0x7E00) | ((magnitude >>> 13) & Vector128.Create(0x3FF)),
+            Vector128.Create(0x7C00));
+
+        var result = Vector128.ConditionalSelect(Vector128.LessThan(magnitude, Vector128.Create(113 << 23)), subnormal, normal);
+        result = Vector128.ConditionalSelect(Vector128.GreaterThanOrEqual(magnitude, Vector128.Create((127 + 16) << 23)), infinityOrNaN, result);
+
+        return result.AsUInt32() | (sign >>> 16);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<uint> SingleToBFloat16(Vector128<float> value)
+    {
+        // Round to nearest even, except for NaNs, which are quietened instead.
+        var bits = value.AsUInt32();
+        var rounded = (bits + Vector128.Create(0x7FFFu) + ((bits >>> 16) & Vector128<uint>.One)) >>> 16;
+        var nan = (bits >>> 16) | Vector128.Create(0x40u);
+        return Vector128.ConditionalSelect(Vector128.Equals(value, value).AsUInt32(), rounded, nan);
+    }
+}
@@ -0,0 +1,544 @@
+using System.Numerics;
+using System.Runtime.CompilerServices;
+using System.Runtime.Intrinsics;
+using System.Runtime.Intrinsics.X86;
+
+namespace IR2IL.Runtime;
+
+/// <summary>
+/// Implementations of the llvm.vector.reduce.* intrinsics, which combine the elements of a vector into a scalar.
+/// </summary>
+/// <remarks>
+/// Reductions take log2(N) steps. Vectors wider than 128 bits are halved by combining their upper and lower halves,
+/// and then each step combines every element with its neighbour in a shifted or shuffled copy of the vector.
+/// Vectors narrower than 128 bits take the same steps in the lower part of a 128-bit vector.
+/// Whether Min and Max are signed or unsigned depends on <c>T</c>.
+///
+/// Which instructions each step uses depends on the hardware, from the widest tier down:
+/// <list type="bullet">
+/// <item>With AVX-512, 1024-bit vectors are halved with one 512-bit operation. 512-bit vectors are halved with
+/// a 256-bit operation on the extracted upper half, since a 512-bit shuffle to line the halves up costs the same.</item>
+/// <item>With AVX2, 1024-bit vectors are halved with a pair of 256-bit operations, and 512-bit vectors with one.</item>
+/// <item>Without AVX2, they're quartered with 128-bit operations instead, which SSE can do.</item>
+/// <item>The steps within a 128-bit vector only need SSE2. 8-bit and 16-bit neighbours are lined up with shifts,
+/// because the byte shuffle (pshufb) needs SSSE3, and without it .NET shuffles one element at a time.</item>
+/// <item>Without any SIMD, the elements are combined one at a time.</item>
+/// </list>
+/// </remarks>
+public static class VectorReductions
+{
+    // Vector16
+
+    public static T Add<T>(Vector16<T> vector) where T : unmanaged, INumberBase<T> => Reduce<T, AddOperator<T>>(vector);
+
+    public static T Multiply<T>(Vector16<T> vector) where T : unmanaged, INumberBase<T> => Reduce<T, MultiplyOperator<T>>(vector);
+
+    public static T And<T>(Vector16<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, AndOperator<T>>(vector);
+
+    public static T Or<T>(Vector16<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, OrOperator<T>>(vector);
+
+    public static T Xor<T>(Vector16<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, XorOperator<T>>(vector);
+
+    public static T Max<T>(Vector16<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, MaxOperator<T>>(vector);
+
+    public static T Min<T>(Vector16<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, MinOperator<T>>(vector);
+
+    public static T MaxNumber<T>(Vector16<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MaxNumberOperator<T>>(vector);
+
+    public static T MinNumber<T>(Vector16<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MinNumberOperator<T>>(vector);
+
+    public static T Maximum<T>(Vector16<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MaximumOperator<T>>(vector);
+
+    public static T Minimum<T>(Vector16<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MinimumOperator<T>>(vector);
+
+    // Vector32
+
+    public static T Add<T>(Vector32<T> vector) where T : unmanaged, INumberBase<T> => Reduce<T, AddOperator<T>>(vector);
+
+    public static T Multiply<T>(Vector32<T> vector) where T : unmanaged, INumberBase<T> => Reduce<T, MultiplyOperator<T>>(vector);
+
+    public static T And<T>(Vector32<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, AndOperator<T>>(vector);
+
+    public static T Or<T>(Vector32<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, OrOperator<T>>(vector);
+
+    public static T Xor<T>(Vector32<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, XorOperator<T>>(vector);
+
+    public static T Max<T>(Vector32<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, MaxOperator<T>>(vector);
+
+    public static T Min<T>(Vector32<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, MinOperator<T>>(vector);
+
+    public static T MaxNumber<T>(Vector32<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MaxNumberOperator<T>>(vector);
+
+    public static T MinNumber<T>(Vector32<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MinNumberOperator<T>>(vector);
+
+    public static T Maximum<T>(Vector32<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MaximumOperator<T>>(vector);
+
+    public static T Minimum<T>(Vector32<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MinimumOperator<T>>(vector);
+
+    // Vector64
+
+    public static T Add<T>(Vector64<T> vector) where T : unmanaged, INumberBase<T> => Reduce<T, AddOperator<T>>(vector);
+
+    public static T Multiply<T>(Vector64<T> vector) where T : unmanaged, INumberBase<T> => Reduce<T, MultiplyOperator<T>>(vector);
+
+    public static T And<T>(Vector64<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, AndOperator<T>>(vector);
+
+    public static T Or<T>(Vector64<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, OrOperator<T>>(vector);
+
+    public static T Xor<T>(Vector64<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, XorOperator<T>>(vector);
+
+    public static T Max<T>(Vector64<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, MaxOperator<T>>(vector);
+
+    public static T Min<T>(Vector64<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, MinOperator<T>>(vector);
+
+    public static T MaxNumber<T>(Vector64<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MaxNumberOperator<T>>(vector);
+
+    public static T MinNumber<T>(Vector64<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MinNumberOperator<T>>(vector);
+
+    public static T Maximum<T>(Vector64<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MaximumOperator<T>>(vector);
+
+    public static T Minimum<T>(Vector64<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MinimumOperator<T>>(vector);
+
+    // Vector128
+
+    public static T Add<T>(Vector128<T> vector) where T : unmanaged, INumberBase<T> => Reduce<T, AddOperator<T>>(vector);
+
+    public static T Multiply<T>(Vector128<T> vector) where T : unmanaged, INumberBase<T> => Reduce<T, MultiplyOperator<T>>(vector);
+
+    public static T And<T>(Vector128<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, AndOperator<T>>(vector);
+
+    public static T Or<T>(Vector128<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, OrOperator<T>>(vector);
+
+    public static T Xor<T>(Vector128<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, XorOperator<T>>(vector);
+
+    public static T Max<T>(Vector128<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, MaxOperator<T>>(vector);
+
+    public static T Min<T>(Vector128<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, MinOperator<T>>(vector);
+
+    public static T MaxNumber<T>(Vector128<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MaxNumberOperator<T>>(vector);
+
+    public static T MinNumber<T>(Vector128<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MinNumberOperator<T>>(vector);
+
+    public static T Maximum<T>(Vector128<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MaximumOperator<T>>(vector);
+
+    public static T Minimum<T>(Vector128<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MinimumOperator<T>>(vector);
+
+    // Vector256
+
+    public static T Add<T>(Vector256<T> vector) where T : unmanaged, INumberBase<T> => Reduce<T, AddOperator<T>>(vector);
+
+    public static T Multiply<T>(Vector256<T> vector) where T : unmanaged, INumberBase<T> => Reduce<T, MultiplyOperator<T>>(vector);
+
+    public static T And<T>(Vector256<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, AndOperator<T>>(vector);
+
+    public static T Or<T>(Vector256<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, OrOperator<T>>(vector);
+
+    public static T Xor<T>(Vector256<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, XorOperator<T>>(vector);
+
+    public static T Max<T>(Vector256<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, MaxOperator<T>>(vector);
+
+    public static T Min<T>(Vector256<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, MinOperator<T>>(vector);
+
+    public static T MaxNumber<T>(Vector256<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MaxNumberOperator<T>>(vector);
+
+    public static T MinNumber<T>(Vector256<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MinNumberOperator<T>>(vector);
+
+    public static T Maximum<T>(Vector256<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MaximumOperator<T>>(vector);
+
+    public static T Minimum<T>(Vector256<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MinimumOperator<T>>(vector);
+
+    // Vector512
+
+    public static T Add<T>(Vector512<T> vector) where T : unmanaged, INumberBase<T> => Reduce<T, AddOperator<T>>(vector);
+
+    public static T Multiply<T>(Vector512<T> vector) where T : unmanaged, INumberBase<T> => Reduce<T, MultiplyOperator<T>>(vector);
+
+    public static T And<T>(Vector512<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, AndOperator<T>>(vector);
+
+    public static T Or<T>(Vector512<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, OrOperator<T>>(vector);
+
+    public static T Xor<T>(Vector512<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, XorOperator<T>>(vector);
+
+    public static T Max<T>(Vector512<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, MaxOperator<T>>(vector);
+
+    public static T Min<T>(Vector512<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, MinOperator<T>>(vector);
+
+    public static T MaxNumber<T>(Vector512<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MaxNumberOperator<T>>(vector);
+
+    public static T MinNumber<T>(Vector512<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MinNumberOperator<T>>(vector);
+
+    public static T Maximum<T>(Vector512<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MaximumOperator<T>>(vector);
+
+    public static T Minimum<T>(Vector512<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MinimumOperator<T>>(vector);
+
+    // Masks. Vectors of i1 have 0 or -1 in each element, so llvm.vector.reduce.and is whether every element is set,
+    // llvm.vector.reduce.or is whether any element is set, and llvm.vector.reduce.xor is whether an odd number are.
+    // Each set element of a Vector16 or Vector32 adds 8 to the population count.
+
+    // Vector1024
+
+    public static T Add<T>(Vector1024<T> vector) where T : unmanaged, INumberBase<T> => Reduce<T, AddOperator<T>>(vector);
+
+    public static T Multiply<T>(Vector1024<T> vector) where T : unmanaged, INumberBase<T> => Reduce<T, MultiplyOperator<T>>(vector);
+
+    public static T And<T>(Vector1024<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, AndOperator<T>>(vector);
+
+    public static T Or<T>(Vector1024<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, OrOperator<T>>(vector);
+
+    public static T Xor<T>(Vector1024<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, XorOperator<T>>(vector);
+
+    public static T Max<T>(Vector1024<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, MaxOperator<T>>(vector);
+
+    public static T Min<T>(Vector1024<T> vector) where T : unmanaged, IBinaryInteger<T> => Reduce<T, MinOperator<T>>(vector);
+
+    public static T MaxNumber<T>(Vector1024<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MaxNumberOperator<T>>(vector);
+
+    public static T MinNumber<T>(Vector1024<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MinNumberOperator<T>>(vector);
+
+    public static T Maximum<T>(Vector1024<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MaximumOperator<T>>(vector);
+
+    public static T Minimum<T>(Vector1024<T> vector) where T : unmanaged, IFloatingPointIeee754<T> => Reduce<T, MinimumOperator<T>>(vector);
+
+    public static bool All(Vector16<sbyte> mask) => Unsafe.BitCast<Vector16<sbyte>, ushort>(mask) == ushort.MaxValue;
+
+    public static bool Any(Vector16<sbyte> mask) => Unsafe.BitCast<Vector16<sbyte>, ushort>(mask) != 0;
+
+    public static bool Parity(Vector16<sbyte> mask) => (BitOperations.PopCount(Unsafe.BitCast<Vector16<sbyte>, ushort>(mask)) & 8) != 0;
+
+    public static bool All(Vector32<sbyte> mask) => Unsafe.BitCast<Vector32<sbyte>, uint>(mask) == uint.MaxValue;
+
+    public static bool Any(Vector32<sbyte> mask) => Unsafe.BitCast<Vector32<sbyte>, uint>(mask) != 0;
+
+    public static bool Parity(Vector32<sbyte> mask) => (BitOperations.PopCount(Unsafe.BitCast<Vector32<sbyte>, uint>(mask)) & 8) != 0;
+
+    public static bool All(Vector64<sbyte> mask) => Vector64.EqualsAll(mask, Vector64<sbyte>.AllBitsSet);
+
+    public static bool Any(Vector64<sbyte> mask) => Vector64.ExtractMostSignificantBits(mask) != 0;
+
+    public static bool Parity(Vector64<sbyte> mask) => (BitOperations.PopCount(Vector64.ExtractMostSignificantBits(mask)) & 1) != 0;
+
+    public static bool All(Vector128<sbyte> mask) => Vector128.EqualsAll(mask, Vector128<sbyte>.AllBitsSet);
+
+    public static bool Any(Vector128<sbyte> mask) => Vector128.ExtractMostSignificantBits(mask) != 0;
+
+    public static bool Parity(Vector128<sbyte> mask) => (BitOperations.PopCount(Vector128.ExtractMostSignificantBits(mask)) & 1) != 0;
+
+    public static bool All(Vector256<sbyte> mask) => Vector256.EqualsAll(mask, Vector256<sbyte>.AllBitsSet);
+
+    public static bool Any(Vector256<sbyte> mask) => Vector256.ExtractMostSignificantBits(mask) != 0;
+
+    public static bool Parity(Vector256<sbyte> mask) => (BitOperations.PopCount(Vector256.ExtractMostSignificantBits(mask)) & 1) != 0;
+
+    public static bool All(Vector512<sbyte> mask) => Vector512.EqualsAll(mask, Vector512<sbyte>.AllBitsSet);
+
+    public static bool Any(Vector512<sbyte> mask) => Vector512.ExtractMostSignificantBits(mask) != 0;
+
+    public static bool Parity(Vector512<sbyte> mask) => (BitOperations.PopCount(Vector512.ExtractMostSignificantBits(mask)) & 1) != 0;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static T Reduce<T, TOperator>(Vector1024<T> vector)
+        where T : unmanaged
+        where TOperator : IReductionOperator<T>
+    {
+        if (!Vector128.IsHardwareAccelerated)
+        {
+            return ReduceScalar<T, TOperator, Vector1024<T>>(vector);
+        }
+
+        if (Avx512F.IsSupported)
+        {
+            return Reduce<T, TOperator>(TOperator.Invoke(vector.GetLower(), vector.GetUpper()));
+        }
+
+        var lower = vector.GetLower();
+        var upper = vector.GetUpper();
+        return Reduce<T, TOperator>(Vector512.Create(
+            TOperator.Invoke(lower.GetLower(), upper.GetLower()),
+            TOperator.Invoke(lower.GetUpper(), upper.GetUpper())));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static T Reduce<T, TOperator>(Vector512<T> vector)
+        where T : unmanaged
+        where TOperator : IReductionOperator<T>
+    {
+        if (!Vector128.IsHardwareAccelerated)
+        {
+            return ReduceScalar<T, TOperator, Vector512<T>>(vector);
+        }
+
+        if (Vector256.IsHardwareAccelerated)
+        {
+            return Reduce<T, TOperator>(TOperator.Invoke(vector.GetLower(), vector.GetUpper()));
+        }
+
+        var lower = TOperator.Invoke(vector.GetLower().GetLower(), vector.GetLower().GetUpper());
+        var upper = TOperator.Invoke(vector.GetUpper().GetLower(), vector.GetUpper().GetUpper());
+        return Reduce<T, TOperator>(TOperator.Invoke(lower, upper), byteCount: 16);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static T Reduce<T, TOperator>(Vector256<T> vector)
+        where T : unmanaged
+        where TOperator : IReductionOperator<T> => Vector128.IsHardwareAccelerated
+        ? Reduce<T, TOperator>(TOperator.Invoke(vector.GetLower(), vector.GetUpper()), byteCount: 16)
+        : ReduceScalar<T, TOperator, Vector256<T>>(vector);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static T Reduce<T, TOperator>(Vector16<T> vector)
+        where T : unmanaged
+        where TOperator : IReductionOperator<T> => Vector128.IsHardwareAccelerated
+        ? Reduce<T, TOperator>(vector.ToVector128Unsafe(), byteCount: 2)
+        : ReduceScalar<T, TOperator, Vector16<T>>(vector);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static T Reduce<T, TOperator>(Vector32<T> vector)
+        where T : unmanaged
+        where TOperator : IReductionOperator<T> => Vector128.IsHardwareAccelerated
+        ? Reduce<T, TOperator>(vector.ToVector128Unsafe(), byteCount: 4)
+        : ReduceScalar<T, TOperator, Vector32<T>>(vector);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static T Reduce<T, TOperator>(Vector64<T> vector)
+        where T : unmanaged
+        where TOperator : IReductionOperator<T> => Vector128.IsHardwareAccelerated
+        ? Reduce<T, TOperator>(vector.ToVector128Unsafe(), byteCount: 8)
+        : ReduceScalar<T, TOperator, Vector64<T>>(vector);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static T Reduce<T, TOperator>(Vector128<T> vector)
+        where T : unmanaged
+        where TOperator : IReductionOperator<T> => Vector128.IsHardwareAccelerated
+        ? Reduce<T, TOperator>(vector, byteCount: 16)
+        : ReduceScalar<T, TOperator, Vector128<T>>(vector);
+
+    /// <summary>
+    /// Reduces the elements in the lowest <paramref name="byteCount"/> bytes of <paramref name="vector"/>.
+    /// Each step only combines elements within the same 16, 32 or 64-bit part of the vector, so the steps for
+    /// parts wider than <paramref name="byteCount"/> are left out, and what's in the rest doesn't matter.
+    /// </summary>
+    /// <remarks>
+    /// Only the first element of each pair has to be right after a step, so shifting the second element down
+    /// onto it is as good as swapping them.
+    /// </remarks>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static T Reduce<T, TOperator>(Vector128<T> vector, int byteCount)
+        where T : unmanaged
+        where TOperator : IReductionOperator<T>
+    {
+        if (Unsafe.SizeOf<T>() <= 4 && byteCount > 4)
+        {
+            vector = TOperator.Invoke(vector, Vector128.Shuffle(vector.AsUInt32(), Vector128.Create(1u, 0u, 3u, 2u)).As<uint, T>());
+        }
+        if (Unsafe.SizeOf<T>() <= 2 && byteCount > 2)
+        {
+            vector = TOperator.Invoke(vector, (vector.AsUInt32() >>> 16).As<uint, T>());
+        }
+        if (Unsafe.SizeOf<T>() == 1 && byteCount > 1)
+        {
+            vector = TOperator.Invoke(vector, (vector.AsUInt16() >>> 8).As<ushort, T>());
+        }
+        if (byteCount > 8)
+        {
+            vector = TOperator.Invoke(vector, Vector128.Shuffle(vector.AsUInt64(), Vector128.Create(1ul, 0ul)).As<ulong, T>());
+        }
+
+        return vector.ToScalar();
+    }
+
+    /// <summary>
+    /// Without SIMD, the VectorN operations are done one element at a time anyway, so it's quicker not to use them.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static T ReduceScalar<T, TOperator, TVector>(TVector vector)
+        where T : unmanaged
+        where TOperator : IReductionOperator<T>
+        where TVector : unmanaged
+    {
+        ref var elements = ref Unsafe.As<TVector, T>(ref vector);
+        var result = elements;
+        for (var i = 1; i < Unsafe.SizeOf<TVector>() / Unsafe.SizeOf<T>(); i++)
+        {
+            result = TOperator.Invoke(result, Unsafe.Add(ref elements, i));
+        }
+        return result;
+    }
+
+    private interface IReductionOperator<T>
+        where T : unmanaged
+    {
+        static abstract T Invoke(T left, T right);
+
+        static abstract Vector128<T> Invoke(Vector128<T> left, Vector128<T> right);
+
+        static abstract Vector256<T> Invoke(Vector256<T> left, Vector256<T> right);
+
+        static abstract Vector512<T> Invoke(Vector512<T> left, Vector512<T> right);
+    }
+
+    private readonly struct AddOperator<T> : IReductionOperator<T>
+        where T : unmanaged, INumberBase<T>
+    {
+        public static T Invoke(T left, T right) => left + right;
+
+        public static Vector128<T> Invoke(Vector128<T> left, Vector128<T> right) => left + right;
+
+        public static Vector256<T> Invoke(Vector256<T> left, Vector256<T> right) => left + right;
+
+        public static Vector512<T> Invoke(Vector512<T> left, Vector512<T> right) => left + right;
+    }
+
+    private readonly struct MultiplyOperator<T> : IReductionOperator<T>
+        where T : unmanaged, INumberBase<T>
+    {
+        public static T Invoke(T left, T right) => left * right;
+
+        /// <remarks>
+        /// There's no instruction that multiplies bytes, and .NET does it one element at a time, so we multiply
+        /// the even and odd bytes with 16-bit multiplies instead, whose low bytes are the same.
+        /// </remarks>
+        public static Vector128<T> Invoke(Vector128<T> left, Vector128<T> right)
+        {
+            if (Unsafe.SizeOf<T>() == 1 && Vector128.IsHardwareAccelerated)
+            {
+                var even = (left.AsUInt16() * right.AsUInt16()) & Vector128.Create((ushort)0xFF);
+                var odd = (left.AsUInt16() >>> 8) * (right.AsUInt16() & Vector128.Create((ushort)0xFF00));
+                return (even | odd).As<ushort, T>();
+            }
+
+            return left * right;
+        }
+
+        public static Vector256<T> Invoke(Vector256<T> left, Vector256<T> right)
+        {
+            if (Unsafe.SizeOf<T>() == 1 && Vector256.IsHardwareAccelerated)
+            {
+                var even = (left.AsUInt16() * right.AsUInt16()) & Vector256.Create((ushort)0xFF);
+                var odd = (left.AsUInt16() >>> 8) * (right.AsUInt16() & Vector256.Create((ushort)0xFF00));
+                return (even | odd).As<ushort, T>();
+            }
+
+            return left * right;
+        }
+
+        public static Vector512<T> Invoke(Vector512<T> left, Vector512<T> right)
+        {
+            if (Unsafe.SizeOf<T>() == 1 && Avx512BW.IsSupported)
+            {
+                var even = (left.AsUInt16() * right.AsUInt16()) & Vector512.Create((ushort)0xFF);
+                var odd = (left.AsUInt16() >>> 8) * (right.AsUInt16() & Vector512.Create((ushort)0xFF00));
+                return (even | odd).As<ushort, T>();
+            }
+
+            return left * right;
+        }
+    }
+
+    private readonly struct AndOperator<T> : IReductionOperator<T>
+        where T : unmanaged, IBinaryInteger<T>
+    {
+        public static T Invoke(T left, T right) => left & right;
+
+        public static Vector128<T> Invoke(Vector128<T> left, Vector128<T> right) => left & right;
+
+        public static Vector256<T> Invoke(Vector256<T> left, Vector256<T> right) => left & right;
+
+        public static Vector512<T> Invoke(Vector512<T> left, Vector512<T> right) => left & right;
+    }
+
+    private readonly struct OrOperator<T> : IReductionOperator<T>
+        where T : unmanaged, IBinaryInteger<T>
+    {
+        public static T Invoke(T left, T right) => left | right;
+
+        public static Vector128<T> Invoke(Vector128<T> left, Vector128<T> right) => left | right;
+
+        public static Vector256<T> Invoke(Vector256<T> left, Vector256<T> right) => left | right;
+
+        public static Vector512<T> Invoke(Vector512<T> left, Vector512<T> right) => left | right;
+    }
+
+    private readonly struct XorOperator<T> : IReductionOperator<T>
+        where T : unmanaged, IBinaryInteger<T>
+    {
+        public static T Invoke(T left, T right) => left ^ right;
+
+        public static Vector128<T> Invoke(Vector128<T> left, Vector128<T> right) => left ^ right;
+
+        public static Vector256<T> Invoke(Vector256<T> left, Vector256<T> right) => left ^ right;
+
+        public static Vector512<T> Invoke(Vector512<T> left, Vector512<T> right) => left ^ right;
+    }
+
+    private readonly struct MaxOperator<T> : IReductionOperator<T>
+        where T : unmanaged, IBinaryInteger<T>
+    {
+        public static T Invoke(T left, T right) => T.Max(left, right);
+
+        public static Vector128<T> Invoke(Vector128<T> left, Vector128<T> right) => Vector128.Max(left, right);
+
+        public static Vector256<T> Invoke(Vector256<T> left, Vector256<T> right) => Vector256.Max(left, right);
+
+        public static Vector512<T> Invoke(Vector512<T> left, Vector512<T> right) => Vector512.Max(left, right);
+    }
+
+    private readonly struct MinOperator<T> : IReductionOperator<T>
+        where T : unmanaged, IBinaryInteger<T>
+    {
+        public static T Invoke(T left, T right) => T.Min(left, right);
+
+        public static Vector128<T> Invoke(Vector128<T> left, Vector128<T> right) => Vector128.Min(left, right);
+
+        public static Vector256<T> Invoke(Vector256<T> left, Vector256<T> right) => Vector256.Min(left, right);
+
+        public static Vector512<T> Invoke(Vector512<T> left, Vector512<T> right) => Vector512.Min(left, right);
+    }
+
+    private readonly struct MaxNumberOperator<T> : IReductionOperator<T>
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        public static T Invoke(T left, T right) => T.MaxNumber(left, right);
+
+        public static Vector128<T> Invoke(Vector128<T> left, Vector128<T> right) => FloatingPointMath.MaxNumber(left, right);
+
+        public static Vector256<T> Invoke(Vector256<T> left, Vector256<T> right) => FloatingPointMath.MaxNumber(left, right);
+
+        public static Vector512<T> Invoke(Vector512<T> left, Vector512<T> right) => FloatingPointMath.MaxNumber(left, right);
+    }
+
+    private readonly struct MinNumberOperator<T> : IReductionOperator<T>
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        public static T Invoke(T left, T right) => T.MinNumber(left, right);
+
+        public static Vector128<T> Invoke(Vector128<T> left, Vector128<T> right) => FloatingPointMath.MinNumber(left, right);
+
+        public static Vector256<T> Invoke(Vector256<T> left, Vector256<T> right) => FloatingPointMath.MinNumber(left, right);
+
+        public static Vector512<T> Invoke(Vector512<T> left, Vector512<T> right) => FloatingPointMath.MinNumber(left, right);
+    }
+
+    private readonly struct MaximumOperator<T> : IReductionOperator<T>
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        public static T Invoke(T left, T right) => T.Max(left, right);
+
+        public static Vector128<T> Invoke(Vector128<T> left, Vector128<T> right) => FloatingPointMath.Max(left, right);
+
+        public static Vector256<T> Invoke(Vector256<T> left, Vector256<T> right) => FloatingPointMath.Max(left, right);
+
+        public static Vector512<T> Invoke(Vector512<T> left, Vector512<T> right) => FloatingPointMath.Max(left, right);
+    }
+
+    private readonly struct MinimumOperator<T> : IReductionOperator<T>
+        where T : unmanaged, IFloatingPointIeee754<T>
+    {
+        public static T Invoke(T left, T right) => T.Min(left, right);
+
+        public static Vector128<T> Invoke(Vector128<T> left, Vector128<T> right) => FloatingPointMath.Min(left, right);
+
+        public static Vector256<T> Invoke(Vector256<T> left, Vector256<T> right) => FloatingPointMath.Min(left, right);
+
+        public static Vector512<T> Invoke(Vector512<T> left, Vector512<T> right) => FloatingPointMath.Min(left, right);
+    }
+}
@@ -0,0 +1,572 @@
+using System.Numerics;
+using System.Runtime.CompilerServices;
+using System.Runtime.Intrinsics;
+using System.Runtime.Intrinsics.X86;
+
+namespace IR2IL.Runtime;
+
+/// <summary>
+/// Vector shl, lshr and ashr where each lane has its own shift amount, and ashr of 8-bit lanes,
+/// which the VectorN classes don't have because i8 vectors are held as vectors of byte.
+/// Also llvm.fshl and llvm.fshr, which are made of those shifts.
+/// </summary>
+/// <remarks>
+/// 32-bit and 64-bit lanes use the AVX2 variable shifts, and 16-bit lanes use the AVX-512BW ones, or are widened
+/// to 32-bit lanes for AVX2. There's no variable shift of 8-bit lanes, or of anything before AVX2, so those are
+/// shifted in log2(bits) steps: each step shifts every lane by a power of two, and keeps the result in the lanes
+/// whose shift amount has that bit set. A shift amount of the lane width or more is poison, so it doesn't matter
+/// that the steps only look at the low bits. Arithmetic shifts treat lanes as signed, whatever <c>T</c> is.
+/// </remarks>
+public static class VectorShifts
+{
+    // Vector16
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<T> ShiftLeft<T>(Vector16<T> value, Vector16<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Vector16.FromVector128(Shift<T, ShiftLeftOperator>(value.ToVector128Unsafe(), shiftAmount.ToVector128Unsafe()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<T> ShiftRightLogical<T>(Vector16<T> value, Vector16<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Vector16.FromVector128(Shift<T, ShiftRightLogicalOperator>(value.ToVector128Unsafe(), shiftAmount.ToVector128Unsafe()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<T> ShiftRightArithmetic<T>(Vector16<T> value, Vector16<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Vector16.FromVector128(Shift<T, ShiftRightArithmeticOperator>(value.ToVector128Unsafe(), shiftAmount.ToVector128Unsafe()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<T> ShiftRightArithmetic<T>(Vector16<T> value, int shiftCount)
+        where T : unmanaged, IBinaryInteger<T> => Vector16.FromVector128(ShiftRightArithmeticOperator.Invoke(value.ToVector128Unsafe(), shiftCount));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<T> FunnelShiftLeft<T>(Vector16<T> high, Vector16<T> low, Vector16<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Vector16.FromVector128(FunnelShift(high.ToVector128Unsafe(), low.ToVector128Unsafe(), shiftAmount.ToVector128Unsafe(), isLeft: true));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector16<T> FunnelShiftRight<T>(Vector16<T> high, Vector16<T> low, Vector16<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Vector16.FromVector128(FunnelShift(high.ToVector128Unsafe(), low.ToVector128Unsafe(), shiftAmount.ToVector128Unsafe(), isLeft: false));
+
+    // Vector32
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<T> ShiftLeft<T>(Vector32<T> value, Vector32<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Vector32.FromVector128(Shift<T, ShiftLeftOperator>(value.ToVector128Unsafe(), shiftAmount.ToVector128Unsafe()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<T> ShiftRightLogical<T>(Vector32<T> value, Vector32<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Vector32.FromVector128(Shift<T, ShiftRightLogicalOperator>(value.ToVector128Unsafe(), shiftAmount.ToVector128Unsafe()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<T> ShiftRightArithmetic<T>(Vector32<T> value, Vector32<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Vector32.FromVector128(Shift<T, ShiftRightArithmeticOperator>(value.ToVector128Unsafe(), shiftAmount.ToVector128Unsafe()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<T> ShiftRightArithmetic<T>(Vector32<T> value, int shiftCount)
+        where T : unmanaged, IBinaryInteger<T> => Vector32.FromVector128(ShiftRightArithmeticOperator.Invoke(value.ToVector128Unsafe(), shiftCount));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<T> FunnelShiftLeft<T>(Vector32<T> high, Vector32<T> low, Vector32<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Vector32.FromVector128(FunnelShift(high.ToVector128Unsafe(), low.ToVector128Unsafe(), shiftAmount.ToVector128Unsafe(), isLeft: true));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector32<T> FunnelShiftRight<T>(Vector32<T> high, Vector32<T> low, Vector32<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Vector32.FromVector128(FunnelShift(high.ToVector128Unsafe(), low.ToVector128Unsafe(), shiftAmount.ToVector128Unsafe(), isLeft: false));
+
+    // Vector64
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> ShiftLeft<T>(Vector64<T> value, Vector64<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Shift<T, ShiftLeftOperator>(value.ToVector128Unsafe(), shiftAmount.ToVector128Unsafe()).GetLower();
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> ShiftRightLogical<T>(Vector64<T> value, Vector64<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Shift<T, ShiftRightLogicalOperator>(value.ToVector128Unsafe(), shiftAmount.ToVector128Unsafe()).GetLower();
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> ShiftRightArithmetic<T>(Vector64<T> value, Vector64<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Shift<T, ShiftRightArithmeticOperator>(value.ToVector128Unsafe(), shiftAmount.ToVector128Unsafe()).GetLower();
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> ShiftRightArithmetic<T>(Vector64<T> value, int shiftCount)
+        where T : unmanaged, IBinaryInteger<T> => ShiftRightArithmeticOperator.Invoke(value.ToVector128Unsafe(), shiftCount).GetLower();
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> FunnelShiftLeft<T>(Vector64<T> high, Vector64<T> low, Vector64<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => FunnelShift(high.ToVector128Unsafe(), low.ToVector128Unsafe(), shiftAmount.ToVector128Unsafe(), isLeft: true).GetLower();
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> FunnelShiftRight<T>(Vector64<T> high, Vector64<T> low, Vector64<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => FunnelShift(high.ToVector128Unsafe(), low.ToVector128Unsafe(), shiftAmount.ToVector128Unsafe(), isLeft: false).GetLower();
+
+    // Vector128
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> ShiftLeft<T>(Vector128<T> value, Vector128<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Shift<T, ShiftLeftOperator>(value, shiftAmount);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> ShiftRightLogical<T>(Vector128<T> value, Vector128<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Shift<T, ShiftRightLogicalOperator>(value, shiftAmount);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> ShiftRightArithmetic<T>(Vector128<T> value, Vector128<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Shift<T, ShiftRightArithmeticOperator>(value, shiftAmount);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> ShiftRightArithmetic<T>(Vector128<T> value, int shiftCount)
+        where T : unmanaged, IBinaryInteger<T> => ShiftRightArithmeticOperator.Invoke(value, shiftCount);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> FunnelShiftLeft<T>(Vector128<T> high, Vector128<T> low, Vector128<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => FunnelShift(high, low, shiftAmount, isLeft: true);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> FunnelShiftRight<T>(Vector128<T> high, Vector128<T> low, Vector128<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => FunnelShift(high, low, shiftAmount, isLeft: false);
+
+    // Vector256
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> ShiftLeft<T>(Vector256<T> value, Vector256<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Shift<T, ShiftLeftOperator>(value, shiftAmount);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> ShiftRightLogical<T>(Vector256<T> value, Vector256<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Shift<T, ShiftRightLogicalOperator>(value, shiftAmount);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> ShiftRightArithmetic<T>(Vector256<T> value, Vector256<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Shift<T, ShiftRightArithmeticOperator>(value, shiftAmount);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> ShiftRightArithmetic<T>(Vector256<T> value, int shiftCount)
+        where T : unmanaged, IBinaryInteger<T> => ShiftRightArithmeticOperator.Invoke(value, shiftCount);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> FunnelShiftLeft<T>(Vector256<T> high, Vector256<T> low, Vector256<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => FunnelShift(high, low, shiftAmount, isLeft: true);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> FunnelShiftRight<T>(Vector256<T> high, Vector256<T> low, Vector256<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => FunnelShift(high, low, shiftAmount, isLeft: false);
+
+    // Vector512
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> ShiftLeft<T>(Vector512<T> value, Vector512<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Shift<T, ShiftLeftOperator>(value, shiftAmount);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> ShiftRightLogical<T>(Vector512<T> value, Vector512<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Shift<T, ShiftRightLogicalOperator>(value, shiftAmount);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> ShiftRightArithmetic<T>(Vector512<T> value, Vector512<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Shift<T, ShiftRightArithmeticOperator>(value, shiftAmount);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> ShiftRightArithmetic<T>(Vector512<T> value, int shiftCount)
+        where T : unmanaged, IBinaryInteger<T> => Vector512.Create(
+            ShiftRightArithmeticOperator.Invoke(value.GetLower(), shiftCount),
+            ShiftRightArithmeticOperator.Invoke(value.GetUpper(), shiftCount));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> FunnelShiftLeft<T>(Vector512<T> high, Vector512<T> low, Vector512<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => FunnelShift(high, low, shiftAmount, isLeft: true);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> FunnelShiftRight<T>(Vector512<T> high, Vector512<T> low, Vector512<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => FunnelShift(high, low, shiftAmount, isLeft: false);
+
+    // Vector1024
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> ShiftLeft<T>(Vector1024<T> value, Vector1024<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Vector1024.Create(
+            Shift<T, ShiftLeftOperator>(value.GetLower(), shiftAmount.GetLower()),
+            Shift<T, ShiftLeftOperator>(value.GetUpper(), shiftAmount.GetUpper()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> ShiftRightLogical<T>(Vector1024<T> value, Vector1024<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Vector1024.Create(
+            Shift<T, ShiftRightLogicalOperator>(value.GetLower(), shiftAmount.GetLower()),
+            Shift<T, ShiftRightLogicalOperator>(value.GetUpper(), shiftAmount.GetUpper()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> ShiftRightArithmetic<T>(Vector1024<T> value, Vector1024<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Vector1024.Create(
+            Shift<T, ShiftRightArithmeticOperator>(value.GetLower(), shiftAmount.GetLower()),
+            Shift<T, ShiftRightArithmeticOperator>(value.GetUpper(), shiftAmount.GetUpper()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> ShiftRightArithmetic<T>(Vector1024<T> value, int shiftCount)
+        where T : unmanaged, IBinaryInteger<T> => Vector1024.Create(
+            ShiftRightArithmetic(value.GetLower(), shiftCount),
+            ShiftRightArithmetic(value.GetUpper(), shiftCount));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> FunnelShiftLeft<T>(Vector1024<T> high, Vector1024<T> low, Vector1024<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Vector1024.Create(
+            FunnelShift(high.GetLower(), low.GetLower(), shiftAmount.GetLower(), isLeft: true),
+            FunnelShift(high.GetUpper(), low.GetUpper(), shiftAmount.GetUpper(), isLeft: true));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> FunnelShiftRight<T>(Vector1024<T> high, Vector1024<T> low, Vector1024<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T> => Vector1024.Create(
+            FunnelShift(high.GetLower(), low.GetLower(), shiftAmount.GetLower(), isLeft: false),
+            FunnelShift(high.GetUpper(), low.GetUpper(), shiftAmount.GetUpper(), isLeft: false));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<T> Shift<T, TOperator>(Vector128<T> value, Vector128<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T>
+        where TOperator : IShiftOperator
+    {
+        if (TOperator.TryInvoke(value, shiftAmount, out var result))
+        {
+            return result;
+        }
+
+        // Eight 16-bit lanes fit in a Vector256 once they're widened to 32 bits.
+        if (Avx2.IsSupported && Unsafe.SizeOf<T>() == 2)
+        {
+            var widenedValue = TOperator.IsSigned
+                ? Vector256.WidenLower(value.AsInt16().ToVector256Unsafe())
+                : Vector256.WidenLower(value.AsUInt16().ToVector256Unsafe()).AsInt32();
+            var widenedShiftAmount = Vector256.WidenLower(shiftAmount.AsUInt16().ToVector256Unsafe()).AsInt32();
+            TOperator.TryInvoke(widenedValue, widenedShiftAmount, out var widenedResult);
+            return Vector128.Narrow(widenedResult.GetLower(), widenedResult.GetUpper()).As<short, T>();
+        }
+
+        for (var step = 1; step < Unsafe.SizeOf<T>() * 8; step <<= 1)
+        {
+            var skipStep = Vector128.Equals(shiftAmount & Vector128.Create(T.CreateTruncating(step)), Vector128<T>.Zero);
+            value = Vector128.ConditionalSelect(skipStep, value, TOperator.Invoke(value, step));
+        }
+        return value;
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector256<T> Shift<T, TOperator>(Vector256<T> value, Vector256<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T>
+        where TOperator : IShiftOperator
+    {
+        if (TOperator.TryInvoke(value, shiftAmount, out var result))
+        {
+            return result;
+        }
+
+        return Vector256.Create(
+            Shift<T, TOperator>(value.GetLower(), shiftAmount.GetLower()),
+            Shift<T, TOperator>(value.GetUpper(), shiftAmount.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector512<T> Shift<T, TOperator>(Vector512<T> value, Vector512<T> shiftAmount)
+        where T : unmanaged, IBinaryInteger<T>
+        where TOperator : IShiftOperator
+    {
+        if (TOperator.TryInvoke(value, shiftAmount, out var result))
+        {
+            return result;
+        }
+
+        return Vector512.Create(
+            Shift<T, TOperator>(value.GetLower(), shiftAmount.GetLower()),
+            Shift<T, TOperator>(value.GetUpper(), shiftAmount.GetUpper()));
+    }
+
+    /// <summary>
+    /// fshl is (high << s) | (low >>> (bits - s)), and fshr is (high << (bits - s)) | (low >>> s), where s is the
+    /// shift amount modulo the lane width. A shift by bits is poison, so lanes where s is 0 are selected separately.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<T> FunnelShift<T>(Vector128<T> high, Vector128<T> low, Vector128<T> shiftAmount, bool isLeft)
+        where T : unmanaged, IBinaryInteger<T>
+    {
+        var bitCount = Vector128.Create(T.CreateTruncating(Unsafe.SizeOf<T>() * 8));
+        var shift = shiftAmount & (bitCount - Vector128<T>.One);
+        var result = Shift<T, ShiftLeftOperator>(high, isLeft ? shift : bitCount - shift)
+            | Shift<T, ShiftRightLogicalOperator>(low, isLeft ? bitCount - shift : shift);
+        return Vector128.ConditionalSelect(Vector128.Equals(shift, Vector128<T>.Zero), isLeft ? high : low, result);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector256<T> FunnelShift<T>(Vector256<T> high, Vector256<T> low, Vector256<T> shiftAmount, bool isLeft)
+        where T : unmanaged, IBinaryInteger<T>
+    {
+        var bitCount = Vector256.Create(T.CreateTruncating(Unsafe.SizeOf<T>() * 8));
+        var shift = shiftAmount & (bitCount - Vector256<T>.One);
+        var result = Shift<T, ShiftLeftOperator>(high, isLeft ? shift : bitCount - shift)
+            | Shift<T, ShiftRightLogicalOperator>(low, isLeft ? bitCount - shift : shift);
+        return Vector256.ConditionalSelect(Vector256.Equals(shift, Vector256<T>.Zero), isLeft ? high : low, result);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector512<T> FunnelShift<T>(Vector512<T> high, Vector512<T> low, Vector512<T> shiftAmount, bool isLeft)
+        where T : unmanaged, IBinaryInteger<T>
+    {
+        var bitCount = Vector512.Create(T.CreateTruncating(Unsafe.SizeOf<T>() * 8));
+        var shift = shiftAmount & (bitCount - Vector512<T>.One);
+        var result = Shift<T, ShiftLeftOperator>(high, isLeft ? shift : bitCount - shift)
+            | Shift<T, ShiftRightLogicalOperator>(low, isLeft ? bitCount - shift : shift);
+        return Vector512.ConditionalSelect(Vector512.Equals(shift, Vector512<T>.Zero), isLeft ? high : low, result);
+    }
+
+    private interface IShiftOperator
+    {
+        /// <summary>
+        /// Whether the shift needs lanes to be sign-extended when they're widened.
+        /// </summary>
+        static abstract bool IsSigned { get; }
+
+        /// <summary>
+        /// Shifts every lane by the same amount.
+        /// </summary>
+        static abstract Vector128<T> Invoke<T>(Vector128<T> value, int shiftCount) where T : unmanaged;
+
+        /// <summary>
+        /// Shifts each lane by its own amount, if there's an instruction that does that for lanes of <c>T</c>.
+        /// </summary>
+        static abstract bool TryInvoke<T>(Vector128<T> value, Vector128<T> shiftAmount, out Vector128<T> result) where T : unmanaged;
+
+        static abstract bool TryInvoke<T>(Vector256<T> value, Vector256<T> shiftAmount, out Vector256<T> result) where T : unmanaged;
+
+        static abstract bool TryInvoke<T>(Vector512<T> value, Vector512<T> shiftAmount, out Vector512<T> result) where T : unmanaged;
+    }
+
+    private readonly struct ShiftLeftOperator : IShiftOperator
+    {
+        public static bool IsSigned => false;
+
+        public static Vector128<T> Invoke<T>(Vector128<T> value, int shiftCount) where T : unmanaged => value << shiftCount;
+
+        public static bool TryInvoke<T>(Vector128<T> value, Vector128<T> shiftAmount, out Vector128<T> result) where T : unmanaged
+        {
+            if (Avx2.IsSupported && Unsafe.SizeOf<T>() == 4)
+            {
+                result = Avx2.ShiftLeftLogicalVariable(value.AsUInt32(), shiftAmount.AsUInt32()).As<uint, T>();
+                return true;
+            }
+            if (Avx2.IsSupported && Unsafe.SizeOf<T>() == 8)
+            {
+                result = Avx2.ShiftLeftLogicalVariable(value.AsUInt64(), shiftAmount.AsUInt64()).As<ulong, T>();
+                return true;
+            }
+            if (Avx512BW.VL.IsSupported && Unsafe.SizeOf<T>() == 2)
+            {
+                result = Avx512BW.VL.ShiftLeftLogicalVariable(value.AsUInt16(), shiftAmount.AsUInt16()).As<ushort, T>();
+                return true;
+            }
+            result = default;
+            return false;
+        }
+
+        public static bool TryInvoke<T>(Vector256<T> value, Vector256<T> shiftAmount, out Vector256<T> result) where T : unmanaged
+        {
+            if (Avx2.IsSupported && Unsafe.SizeOf<T>() == 4)
+            {
+                result = Avx2.ShiftLeftLogicalVariable(value.AsUInt32(), shiftAmount.AsUInt32()).As<uint, T>();
+                return true;
+            }
+            if (Avx2.IsSupported && Unsafe.SizeOf<T>() == 8)
+            {
+                result = Avx2.ShiftLeftLogicalVariable(value.AsUInt64(), shiftAmount.AsUInt64()).As<ulong, T>();
+                return true;
+            }
+            if (Avx512BW.VL.IsSupported && Unsafe.SizeOf<T>() == 2)
+            {
+                result = Avx512BW.VL.ShiftLeftLogicalVariable(value.AsUInt16(), shiftAmount.AsUInt16()).As<ushort, T>();
+                return true;
+            }
+            result = default;
+            return false;
+        }
+
+        public static bool TryInvoke<T>(Vector512<T> value, Vector512<T> shiftAmount, out Vector512<T> result) where T : unmanaged
+        {
+            if (Avx512F.IsSupported && Unsafe.SizeOf<T>() == 4)
+            {
+                result = Avx512F.ShiftLeftLogicalVariable(value.AsUInt32(), shiftAmount.AsUInt32()).As<uint, T>();
+                return true;
+            }
+            if (Avx512F.IsSupported && Unsafe.SizeOf<T>() == 8)
+            {
+                result = Avx512F.ShiftLeftLogicalVariable(value.AsUInt64(), shiftAmount.AsUInt64()).As<ulong, T>();
+                return true;
+            }
+            if (Avx512BW.IsSupported && Unsafe.SizeOf<T>() == 2)
+            {
+                result = Avx512BW.ShiftLeftLogicalVariable(value.AsUInt16(), shiftAmount.AsUInt16()).As<ushort, T>();
+                return true;
+            }
+            result = default;
+            return false;
+        }
+    }
+
+    private readonly struct ShiftRightLogicalOperator : IShiftOperator
+    {
+        public static bool IsSigned => false;
+
+        public static Vector128<T> Invoke<T>(Vector128<T> value, int shiftCount) where T : unmanaged => value >>> shiftCount;
+
+        public static bool TryInvoke<T>(Vector128<T> value, Vector128<T> shiftAmount, out Vector128<T> result) where T : unmanaged
+        {
+            if (Avx2.IsSupported && Unsafe.SizeOf<T>() == 4)
+            {
+                result = Avx2.ShiftRightLogicalVariable(value.AsUInt32(), shiftAmount.AsUInt32()).As<uint, T>();
+                return true;
+            }
+            if (Avx2.IsSupported && Unsafe.SizeOf<T>() == 8)
+            {
+                result = Avx2.ShiftRightLogicalVariable(value.AsUInt64(), shiftAmount.AsUInt64()).As<ulong, T>();
+                return true;
+            }
+            if (Avx512BW.VL.IsSupported && Unsafe.SizeOf<T>() == 2)
+            {
+                result = Avx512BW.VL.ShiftRightLogicalVariable(value.AsUInt16(), shiftAmount.AsUInt16()).As<ushort, T>();
+                return true;
+            }
+            result = default;
+            return false;
+        }
+
+        public static bool TryInvoke<T>(Vector256<T> value, Vector256<T> shiftAmount, out Vector256<T> result) where T : unmanaged
+        {
+            if (Avx2.IsSupported && Unsafe.SizeOf<T>() == 4)
+            {
+                result = Avx2.ShiftRightLogicalVariable(value.AsUInt32(), shiftAmount.AsUInt32()).As<uint, T>();
+                return true;
+            }
+            if (Avx2.IsSupported && Unsafe.SizeOf<T>() == 8)
+            {
+                result = Avx2.ShiftRightLogicalVariable(value.AsUInt64(), shiftAmount.AsUInt64()).As<ulong, T>();
+                return true;
+            }
+            if (Avx512BW.VL.IsSupported && Unsafe.SizeOf<T>() == 2)
+            {
+                result = Avx512BW.VL.ShiftRightLogicalVariable(value.AsUInt16(), shiftAmount.AsUInt16()).As<ushort, T>();
+                return true;
+            }
+            result = default;
+            return false;
+        }
+
+        public static bool TryInvoke<T>(Vector512<T> value, Vector512<T> shiftAmount, out Vector512<T> result) where T : unmanaged
+        {
+            if (Avx512F.IsSupported && Unsafe.SizeOf<T>() == 4)
+            {
+                result = Avx512F.ShiftRightLogicalVariable(value.AsUInt32(), shiftAmount.AsUInt32()).As<uint, T>();
+                return true;
+            }
+            if (Avx512F.IsSupported && Unsafe.SizeOf<T>() == 8)
+            {
+                result = Avx512F.ShiftRightLogicalVariable(value.AsUInt64(), shiftAmount.AsUInt64()).As<ulong, T>();
+                return true;
+            }
+            if (Avx512BW.IsSupported && Unsafe.SizeOf<T>() == 2)
+            {
+                result = Avx512BW.ShiftRightLogicalVariable(value.AsUInt16(), shiftAmount.AsUInt16()).As<ushort, T>();
+                return true;
+            }
+            result = default;
+            return false;
+        }
+    }
+
+    private readonly struct ShiftRightArithmeticOperator : IShiftOperator
+    {
+        public static bool IsSigned => true;
+
+        public static Vector128<T> Invoke<T>(Vector128<T> value, int shiftCount) where T : unmanaged => Unsafe.SizeOf<T>() switch
+        {
+            1 => Vector128.ShiftRightArithmetic(value.AsSByte(), shiftCount).As<sbyte, T>(),
+            2 => Vector128.ShiftRightArithmetic(value.AsInt16(), shiftCount).As<short, T>(),
+            4 => Vector128.ShiftRightArithmetic(value.AsInt32(), shiftCount).As<int, T>(),
+            _ => Vector128.ShiftRightArithmetic(value.AsInt64(), shiftCount).As<long, T>(),
+        };
+
+        public static Vector256<T> Invoke<T>(Vector256<T> value, int shiftCount) where T : unmanaged => Unsafe.SizeOf<T>() switch
+        {
+            1 => Vector256.ShiftRightArithmetic(value.AsSByte(), shiftCount).As<sbyte, T>(),
+            2 => Vector256.ShiftRightArithmetic(value.AsInt16(), shiftCount).As<short, T>(),
+            4 => Vector256.ShiftRightArithmetic(value.AsInt32(), shiftCount).As<int, T>(),
+            _ => Vector256.ShiftRightArithmetic(value.AsInt64(), shiftCount).As<long, T>(),
+        };
+
+        public static bool TryInvoke<T>(Vector128<T> value, Vector128<T> shiftAmount, out Vector128<T> result) where T : unmanaged
+        {
+            if (Avx2.IsSupported && Unsafe.SizeOf<T>() == 4)
+            {
+                result = Avx2.ShiftRightArithmeticVariable(value.AsInt32(), shiftAmount.AsUInt32()).As<int, T>();
+                return true;
+            }
+            if (Avx512F.VL.IsSupported && Unsafe.SizeOf<T>() == 8)
+            {
+                result = Avx512F.VL.ShiftRightArithmeticVariable(value.AsInt64(), shiftAmount.AsUInt64()).As<long, T>();
+                return true;
+            }
+            if (Avx2.IsSupported && Unsafe.SizeOf<T>() == 8)
+            {
+                // Flipping negative lanes makes the logical shift bring in ones, once they're flipped back.
+                var sign = Vector128.LessThan(value.AsInt64(), Vector128<long>.Zero).AsUInt64();
+                result = (Avx2.ShiftRightLogicalVariable(value.AsUInt64() ^ sign, shiftAmount.AsUInt64()) ^ sign).As<ulong, T>();
+                return true;
+            }
+            if (Avx512BW.VL.IsSupported && Unsafe.SizeOf<T>() == 2)
+            {
+                result = Avx512BW.VL.ShiftRightArithmeticVariable(value.AsInt16(), shiftAmount.AsUInt16()).As<short, T>();
+                return true;
+            }
+            result = default;
+            return false;
+        }
+
+        public static bool TryInvoke<T>(Vector256<T> value, Vector256<T> shiftAmount, out Vector256<T> result) where T : unmanaged
+        {
+            if (Avx2.IsSupported && Unsafe.SizeOf<T>() == 4)
+            {
+                result = Avx2.ShiftRightArithmeticVariable(value.AsInt32(), shiftAmount.AsUInt32()).As<int, T>();
+                return true;
+            }
+            if (Avx512F.VL.IsSupported && Unsafe.SizeOf<T>() == 8)
+            {
+                result = Avx512F.VL.ShiftRightArithmeticVariable(value.AsInt64(), shiftAmount.AsUInt64()).As<long, T>();
+                return true;
+            }
+            if (Avx2.IsSupported && Unsafe.SizeOf<T>() == 8)
+            {
+                var sign = Vector256.LessThan(value.AsInt64(), Vector256<long>.Zero).AsUInt64();
+                result = (Avx2.ShiftRightLogicalVariable(value.AsUInt64() ^ sign, shiftAmount.AsUInt64()) ^ sign).As<ulong, T>();
+                return true;
+            }
+            if (Avx512BW.VL.IsSupported && Unsafe.SizeOf<T>() == 2)
+            {
+                result = Avx512BW.VL.ShiftRightArithmeticVariable(value.AsInt16(), shiftAmount.AsUInt16()).As<short, T>();
+                return true;
+            }
+            result = default;
+            return false;
+        }
+
+        public static bool TryInvoke<T>(Vector512<T> value, Vector512<T> shiftAmount, out Vector512<T> result) where T : unmanaged
+        {
+            if (Avx512F.IsSupported && Unsafe.SizeOf<T>() == 4)
+            {
+                result = Avx512F.ShiftRightArithmeticVariable(value.AsInt32(), shiftAmount.AsUInt32()).As<int, T>();
+                return true;
+            }
+            if (Avx512F.IsSupported && Unsafe.SizeOf<T>() == 8)
+            {
+                result = Avx512F.ShiftRightArithmeticVariable(value.AsInt64(), shiftAmount.AsUInt64()).As<long, T>();
+                return true;
+            }
+            if (Avx512BW.IsSupported && Unsafe.SizeOf<T>() == 2)
+            {
+                result = Avx512BW.ShiftRightArithmeticVariable(value.AsInt16(), shiftAmount.AsUInt16()).As<short, T>();
+                return true;
+            }
+            result = default;
+            return false;
+        }
+    }
+}
@@ -1,186 +1,612 @@
+using System.Numerics;
 using System.Runtime.CompilerServices;
 using System.Runtime.Intrinsics;
+using System.Runtime.Intrinsics.X86;
 
 namespace IR2IL.Runtime;
 
 public static class VectorUtility
 {
+    /// <summary>
+    /// Loads a vector that is padded to a larger .NET vector, such as a &lt;3 x float&gt; held in a
+    /// <see cref="Vector128{T}"/>, reading only its first <paramref name="byteCount"/> bytes.
+    /// The padding lanes are zeroed.
+    /// </summary>
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector64<float> ConvertV2I8ToV2F32(Vector16<byte> vector) => Vector16.ConvertToSingle(vector);
+    public static unsafe TVector LoadPadded<TVector>(void* address, int byteCount)
+        where TVector : unmanaged
+    {
+        TVector result = default;
+        Unsafe.CopyBlockUnaligned(&result, address, (uint)byteCount);
+        return result;
+    }
 
+    /// <summary>
+    /// Stores the real lanes of a padded vector. The padding could overlap whatever follows the vector in memory,
+    /// such as the next field of a packed struct, so it mustn't be written.
+    /// </summary>
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector64<int> ConvertV2I16ToV2I32(Vector32<short> vector) => Vector64.Create(vector[0], vector[1]);
+    public static unsafe void StorePadded<TVector>(void* address, TVector value, int byteCount)
+        where TVector : unmanaged
+    {
+        Unsafe.CopyBlockUnaligned(address, &value, (uint)byteCount);
+    }
+
+    // Integer division and remainder, for sdiv, udiv, srem and urem. .NET divides integer vectors one lane at a time,
+    // so instead:
+    // - Division by a constant is a multiply-high by a magic number and shifts. The compiler works out the magic numbers,
+    //   and passes them as constants, so the JIT can fold away the cases that don't apply.
+    // - 8-bit and 16-bit lanes are converted to float, which holds them exactly in its 24-bit mantissa, and 32-bit lanes
+    //   to double. The quotient is close enough to the true one that truncating it gives the exact result.
+    // - 64-bit lanes, which x64 can't multiply-high or convert to double as vectors, are divided one at a time.
+    // Lanes are signed or unsigned according to the method, whatever T is. Vectors narrower than 128 bits are widened,
+    // and wider ones are done in halves. A Vector64 divisor is widened with ones, so the extra lane can't be zero and trap.
+
+    // Vector16
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector128<long> ConvertV2I16ToV2I64(Vector32<short> vector) => Vector128.Create(vector[0], vector[1]);
+    public static Vector16<T> SignedDivide<T>(Vector16<T> left, Vector16<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Vector16.FromVector128(Divide(left.ToVector128Unsafe(), right.ToVector128Unsafe(), isSigned: true));
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector64<float> ConvertV2I32ToV2F32(Vector64<int> vector) => Vector64.ConvertToSingle(vector);
+    public static Vector16<T> SignedDivide<T>(Vector16<T> left, T divisor, T multiplier, int shift)
+        where T : unmanaged, IBinaryInteger<T> => Vector16.FromVector128(DivideByConstant(left.ToVector128Unsafe(), divisor, multiplier, shift));
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector128<double> ConvertV2I32ToV2F64(Vector64<int> vector)
-    {
-        var (lower, upper) = Vector64.Widen(vector);
-        return Vector128.ConvertToDouble(Vector128.Create(lower, upper));
-    }
+    public static Vector16<T> UnsignedDivide<T>(Vector16<T> left, Vector16<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Vector16.FromVector128(Divide(left.ToVector128Unsafe(), right.ToVector128Unsafe(), isSigned: false));
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector32<short> ConvertV2I64ToV2I16(Vector128<long> vector) => Vector32.Create((short)vector[0], (short)vector[1]);
+    public static Vector16<T> UnsignedDivide<T>(Vector16<T> left, T divisor, T multiplier, int shift, bool isAdd)
+        where T : unmanaged, IBinaryInteger<T> => Vector16.FromVector128(DivideByConstant(left.ToVector128Unsafe(), divisor, multiplier, shift, isAdd));
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector64<int> ConvertV2I64ToV2I32(Vector128<long> vector) => Vector64.Narrow(vector.GetLower(), vector.GetUpper());
+    public static Vector16<T> SignedRemainder<T>(Vector16<T> left, Vector16<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Vector16.FromVector128(Remainder(left.ToVector128Unsafe(), right.ToVector128Unsafe(), isSigned: true));
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector256<double> ConvertV4F32ToV4F64(Vector128<float> vector)
-    {
-        var (lower, upper) = Vector128.Widen(vector);
-        return Vector256.Create(lower, upper);
-    }
+    public static Vector16<T> SignedRemainder<T>(Vector16<T> left, T divisor, T multiplier, int shift)
+        where T : unmanaged, IBinaryInteger<T> => Vector16.FromVector128(RemainderByConstant(left.ToVector128Unsafe(), divisor, multiplier, shift));
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector128<float> ConvertV4F64ToV4F32(Vector256<double> vector) => Vector128.Narrow(vector.GetLower(), vector.GetUpper());
+    public static Vector16<T> UnsignedRemainder<T>(Vector16<T> left, Vector16<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Vector16.FromVector128(Remainder(left.ToVector128Unsafe(), right.ToVector128Unsafe(), isSigned: false));
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector128<int> ConvertV4I16ToV4I32(Vector64<short> vector)
-    {
-        var (lower, upper) = Vector64.Widen(vector);
-        return Vector128.Create(lower, upper);
-    }
+    public static Vector16<T> UnsignedRemainder<T>(Vector16<T> left, T divisor, T multiplier, int shift, bool isAdd)
+        where T : unmanaged, IBinaryInteger<T> => Vector16.FromVector128(RemainderByConstant(left.ToVector128Unsafe(), divisor, multiplier, shift, isAdd));
+
+    // Vector32
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector128<float> ConvertV4I32ToV4F32(Vector128<int> vector) => Vector128.ConvertToSingle(vector);
+    public static Vector32<T> SignedDivide<T>(Vector32<T> left, Vector32<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Vector32.FromVector128(Divide(left.ToVector128Unsafe(), right.ToVector128Unsafe(), isSigned: true));
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector128<int> ConvertV4I64ToV4I32(Vector256<long> vector) => Vector128.Narrow(vector.GetLower(), vector.GetUpper());
+    public static Vector32<T> SignedDivide<T>(Vector32<T> left, T divisor, T multiplier, int shift)
+        where T : unmanaged, IBinaryInteger<T> => Vector32.FromVector128(DivideByConstant(left.ToVector128Unsafe(), divisor, multiplier, shift));
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector256<float> ConvertV8I32ToV8F32(Vector256<int> vector) => Vector256.ConvertToSingle(vector);
+    public static Vector32<T> UnsignedDivide<T>(Vector32<T> left, Vector32<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Vector32.FromVector128(Divide(left.ToVector128Unsafe(), right.ToVector128Unsafe(), isSigned: false));
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector512<float> ConvertV16I32ToV16F32(Vector512<int> vector) => Vector512.ConvertToSingle(vector);
+    public static Vector32<T> UnsignedDivide<T>(Vector32<T> left, T divisor, T multiplier, int shift, bool isAdd)
+        where T : unmanaged, IBinaryInteger<T> => Vector32.FromVector128(DivideByConstant(left.ToVector128Unsafe(), divisor, multiplier, shift, isAdd));
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector16<sbyte> SignedRemainderV2I8(Vector16<sbyte> left, Vector16<sbyte> right)
-    {
-        // TODO: Optimize this.
-        return Vector16.Create(
-            (sbyte)(left[0] % right[0]),
-            (sbyte)(left[1] % right[1]));
-    }
+    public static Vector32<T> SignedRemainder<T>(Vector32<T> left, Vector32<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Vector32.FromVector128(Remainder(left.ToVector128Unsafe(), right.ToVector128Unsafe(), isSigned: true));
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector32<short> SignedRemainderV2I16(Vector32<short> left, Vector32<short> right)
-    {
-        // TODO: Optimize this.
-        return Vector32.Create(
-            (short)(left[0] % right[0]),
-            (short)(left[1] % right[1]));
-    }
+    public static Vector32<T> SignedRemainder<T>(Vector32<T> left, T divisor, T multiplier, int shift)
+        where T : unmanaged, IBinaryInteger<T> => Vector32.FromVector128(RemainderByConstant(left.ToVector128Unsafe(), divisor, multiplier, shift));
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector64<short> SignedRemainderV4I16(Vector64<short> left, Vector64<short> right)
-    {
-        // TODO: Optimize this.
-        return Vector64.Create(
-            (short)(left[0] % right[0]),
-            (short)(left[1] % right[1]),
-            (short)(left[2] % right[2]),
-            (short)(left[3] % right[3]));
-    }
+    public static Vector32<T> UnsignedRemainder<T>(Vector32<T> left, Vector32<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Vector32.FromVector128(Remainder(left.ToVector128Unsafe(), right.ToVector128Unsafe(), isSigned: false));
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector128<int> SignedRemainderV4I32(Vector128<int> left, Vector128<int> right)
-    {
-        // TODO: Optimize this.
-        return Vector128.Create(
-            left[0] % right[0],
-            left[1] % right[1],
-            left[2] % right[2],
-            left[3] % right[3]);
-    }
+    public static Vector32<T> UnsignedRemainder<T>(Vector32<T> left, T divisor, T multiplier, int shift, bool isAdd)
+        where T : unmanaged, IBinaryInteger<T> => Vector32.FromVector128(RemainderByConstant(left.ToVector128Unsafe(), divisor, multiplier, shift, isAdd));
+
+    // Vector64
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector16<sbyte> UnsignedRemainderV2I8(Vector16<sbyte> left, Vector16<sbyte> right)
-    {
-        // TODO: Optimize this.
+    public static Vector64<T> SignedDivide<T>(Vector64<T> left, Vector64<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Divide(left.ToVector128Unsafe(), Vector128.Create(right, Vector64<T>.One), isSigned: true).GetLower();
 
-        var leftUnsigned = left.AsByte();
-        var rightUnsigned = right.AsByte();
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> SignedDivide<T>(Vector64<T> left, T divisor, T multiplier, int shift)
+        where T : unmanaged, IBinaryInteger<T> => DivideByConstant(left.ToVector128Unsafe(), divisor, multiplier, shift).GetLower();
 
-        var signedResult = Vector16.Create(
-            (byte)(leftUnsigned[0] % rightUnsigned[0]),
-            (byte)(leftUnsigned[1] % rightUnsigned[1]));
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> UnsignedDivide<T>(Vector64<T> left, Vector64<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Divide(left.ToVector128Unsafe(), Vector128.Create(right, Vector64<T>.One), isSigned: false).GetLower();
 
-        return signedResult.AsSByte();
-    }
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> UnsignedDivide<T>(Vector64<T> left, T divisor, T multiplier, int shift, bool isAdd)
+        where T : unmanaged, IBinaryInteger<T> => DivideByConstant(left.ToVector128Unsafe(), divisor, multiplier, shift, isAdd).GetLower();
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector32<short> UnsignedRemainderV2I16(Vector32<short> left, Vector32<int> right)
-    {
-        // TODO: Optimize this.
+    public static Vector64<T> SignedRemainder<T>(Vector64<T> left, Vector64<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Remainder(left.ToVector128Unsafe(), Vector128.Create(right, Vector64<T>.One), isSigned: true).GetLower();
 
-        var leftUnsigned = left.AsUInt16();
-        var rightUnsigned = right.AsUInt16();
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> SignedRemainder<T>(Vector64<T> left, T divisor, T multiplier, int shift)
+        where T : unmanaged, IBinaryInteger<T> => RemainderByConstant(left.ToVector128Unsafe(), divisor, multiplier, shift).GetLower();
 
-        var signedResult = Vector32.Create(
-            (ushort)(leftUnsigned[0] % rightUnsigned[0]),
-            (ushort)(leftUnsigned[1] % rightUnsigned[1]));
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> UnsignedRemainder<T>(Vector64<T> left, Vector64<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Remainder(left.ToVector128Unsafe(), Vector128.Create(right, Vector64<T>.One), isSigned: false).GetLower();
 
-        return signedResult.AsInt16();
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector64<T> UnsignedRemainder<T>(Vector64<T> left, T divisor, T multiplier, int shift, bool isAdd)
+        where T : unmanaged, IBinaryInteger<T> => RemainderByConstant(left.ToVector128Unsafe(), divisor, multiplier, shift, isAdd).GetLower();
+
+    // Vector128
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> SignedDivide<T>(Vector128<T> left, Vector128<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Divide(left, right, isSigned: true);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> SignedDivide<T>(Vector128<T> left, T divisor, T multiplier, int shift)
+        where T : unmanaged, IBinaryInteger<T> => DivideByConstant(left, divisor, multiplier, shift);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> UnsignedDivide<T>(Vector128<T> left, Vector128<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Divide(left, right, isSigned: false);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> UnsignedDivide<T>(Vector128<T> left, T divisor, T multiplier, int shift, bool isAdd)
+        where T : unmanaged, IBinaryInteger<T> => DivideByConstant(left, divisor, multiplier, shift, isAdd);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> SignedRemainder<T>(Vector128<T> left, Vector128<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Remainder(left, right, isSigned: true);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> SignedRemainder<T>(Vector128<T> left, T divisor, T multiplier, int shift)
+        where T : unmanaged, IBinaryInteger<T> => RemainderByConstant(left, divisor, multiplier, shift);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> UnsignedRemainder<T>(Vector128<T> left, Vector128<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Remainder(left, right, isSigned: false);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector128<T> UnsignedRemainder<T>(Vector128<T> left, T divisor, T multiplier, int shift, bool isAdd)
+        where T : unmanaged, IBinaryInteger<T> => RemainderByConstant(left, divisor, multiplier, shift, isAdd);
+
+    // Vector256
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> SignedDivide<T>(Vector256<T> left, Vector256<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Vector256.Create(
+            SignedDivide(left.GetLower(), right.GetLower()),
+            SignedDivide(left.GetUpper(), right.GetUpper()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> SignedDivide<T>(Vector256<T> left, T divisor, T multiplier, int shift)
+        where T : unmanaged, IBinaryInteger<T> => Vector256.Create(
+            SignedDivide(left.GetLower(), divisor, multiplier, shift),
+            SignedDivide(left.GetUpper(), divisor, multiplier, shift));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> UnsignedDivide<T>(Vector256<T> left, Vector256<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Vector256.Create(
+            UnsignedDivide(left.GetLower(), right.GetLower()),
+            UnsignedDivide(left.GetUpper(), right.GetUpper()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> UnsignedDivide<T>(Vector256<T> left, T divisor, T multiplier, int shift, bool isAdd)
+        where T : unmanaged, IBinaryInteger<T> => Vector256.Create(
+            UnsignedDivide(left.GetLower(), divisor, multiplier, shift, isAdd),
+            UnsignedDivide(left.GetUpper(), divisor, multiplier, shift, isAdd));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> SignedRemainder<T>(Vector256<T> left, Vector256<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Vector256.Create(
+            SignedRemainder(left.GetLower(), right.GetLower()),
+            SignedRemainder(left.GetUpper(), right.GetUpper()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> SignedRemainder<T>(Vector256<T> left, T divisor, T multiplier, int shift)
+        where T : unmanaged, IBinaryInteger<T> => Vector256.Create(
+            SignedRemainder(left.GetLower(), divisor, multiplier, shift),
+            SignedRemainder(left.GetUpper(), divisor, multiplier, shift));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> UnsignedRemainder<T>(Vector256<T> left, Vector256<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Vector256.Create(
+            UnsignedRemainder(left.GetLower(), right.GetLower()),
+            UnsignedRemainder(left.GetUpper(), right.GetUpper()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector256<T> UnsignedRemainder<T>(Vector256<T> left, T divisor, T multiplier, int shift, bool isAdd)
+        where T : unmanaged, IBinaryInteger<T> => Vector256.Create(
+            UnsignedRemainder(left.GetLower(), divisor, multiplier, shift, isAdd),
+            UnsignedRemainder(left.GetUpper(), divisor, multiplier, shift, isAdd));
+
+    // Vector512
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> SignedDivide<T>(Vector512<T> left, Vector512<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Vector512.Create(
+            SignedDivide(left.GetLower(), right.GetLower()),
+            SignedDivide(left.GetUpper(), right.GetUpper()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> SignedDivide<T>(Vector512<T> left, T divisor, T multiplier, int shift)
+        where T : unmanaged, IBinaryInteger<T> => Vector512.Create(
+            SignedDivide(left.GetLower(), divisor, multiplier, shift),
+            SignedDivide(left.GetUpper(), divisor, multiplier, shift));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> UnsignedDivide<T>(Vector512<T> left, Vector512<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Vector512.Create(
+            UnsignedDivide(left.GetLower(), right.GetLower()),
+            UnsignedDivide(left.GetUpper(), right.GetUpper()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> UnsignedDivide<T>(Vector512<T> left, T divisor, T multiplier, int shift, bool isAdd)
+        where T : unmanaged, IBinaryInteger<T> => Vector512.Create(
+            UnsignedDivide(left.GetLower(), divisor, multiplier, shift, isAdd),
+            UnsignedDivide(left.GetUpper(), divisor, multiplier, shift, isAdd));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> SignedRemainder<T>(Vector512<T> left, Vector512<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Vector512.Create(
+            SignedRemainder(left.GetLower(), right.GetLower()),
+            SignedRemainder(left.GetUpper(), right.GetUpper()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> SignedRemainder<T>(Vector512<T> left, T divisor, T multiplier, int shift)
+        where T : unmanaged, IBinaryInteger<T> => Vector512.Create(
+            SignedRemainder(left.GetLower(), divisor, multiplier, shift),
+            SignedRemainder(left.GetUpper(), divisor, multiplier, shift));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> UnsignedRemainder<T>(Vector512<T> left, Vector512<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Vector512.Create(
+            UnsignedRemainder(left.GetLower(), right.GetLower()),
+            UnsignedRemainder(left.GetUpper(), right.GetUpper()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector512<T> UnsignedRemainder<T>(Vector512<T> left, T divisor, T multiplier, int shift, bool isAdd)
+        where T : unmanaged, IBinaryInteger<T> => Vector512.Create(
+            UnsignedRemainder(left.GetLower(), divisor, multiplier, shift, isAdd),
+            UnsignedRemainder(left.GetUpper(), divisor, multiplier, shift, isAdd));
+
+    // Vector1024
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> SignedDivide<T>(Vector1024<T> left, Vector1024<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Vector1024.Create(
+            SignedDivide(left.GetLower(), right.GetLower()),
+            SignedDivide(left.GetUpper(), right.GetUpper()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> SignedDivide<T>(Vector1024<T> left, T divisor, T multiplier, int shift)
+        where T : unmanaged, IBinaryInteger<T> => Vector1024.Create(
+            SignedDivide(left.GetLower(), divisor, multiplier, shift),
+            SignedDivide(left.GetUpper(), divisor, multiplier, shift));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> UnsignedDivide<T>(Vector1024<T> left, Vector1024<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Vector1024.Create(
+            UnsignedDivide(left.GetLower(), right.GetLower()),
+            UnsignedDivide(left.GetUpper(), right.GetUpper()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> UnsignedDivide<T>(Vector1024<T> left, T divisor, T multiplier, int shift, bool isAdd)
+        where T : unmanaged, IBinaryInteger<T> => Vector1024.Create(
+            UnsignedDivide(left.GetLower(), divisor, multiplier, shift, isAdd),
+            UnsignedDivide(left.GetUpper(), divisor, multiplier, shift, isAdd));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> SignedRemainder<T>(Vector1024<T> left, Vector1024<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Vector1024.Create(
+            SignedRemainder(left.GetLower(), right.GetLower()),
+            SignedRemainder(left.GetUpper(), right.GetUpper()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> SignedRemainder<T>(Vector1024<T> left, T divisor, T multiplier, int shift)
+        where T : unmanaged, IBinaryInteger<T> => Vector1024.Create(
+            SignedRemainder(left.GetLower(), divisor, multiplier, shift),
+            SignedRemainder(left.GetUpper(), divisor, multiplier, shift));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> UnsignedRemainder<T>(Vector1024<T> left, Vector1024<T> right)
+        where T : unmanaged, IBinaryInteger<T> => Vector1024.Create(
+            UnsignedRemainder(left.GetLower(), right.GetLower()),
+            UnsignedRemainder(left.GetUpper(), right.GetUpper()));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static Vector1024<T> UnsignedRemainder<T>(Vector1024<T> left, T divisor, T multiplier, int shift, bool isAdd)
+        where T : unmanaged, IBinaryInteger<T> => Vector1024.Create(
+            UnsignedRemainder(left.GetLower(), divisor, multiplier, shift, isAdd),
+            UnsignedRemainder(left.GetUpper(), divisor, multiplier, shift, isAdd));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<T> Divide<T>(Vector128<T> left, Vector128<T> right, bool isSigned)
+        where T : unmanaged, IBinaryInteger<T>
+    {
+        if (Unsafe.SizeOf<T>() == 1)
+        {
+            if (isSigned)
+            {
+                var (leftLower, leftUpper) = Vector128.Widen(left.AsSByte());
+                var (rightLower, rightUpper) = Vector128.Widen(right.AsSByte());
+                return Vector128.Narrow(Divide(leftLower, rightLower, isSigned), Divide(leftUpper, rightUpper, isSigned)).As<sbyte, T>();
+            }
+            else
+            {
+                var (leftLower, leftUpper) = Vector128.Widen(left.AsByte());
+                var (rightLower, rightUpper) = Vector128.Widen(right.AsByte());
+                return Vector128.Narrow(Divide(leftLower, rightLower, isSigned), Divide(leftUpper, rightUpper, isSigned)).As<byte, T>();
+            }
+        }
+        else if (Unsafe.SizeOf<T>() == 2)
+        {
+            if (isSigned)
+            {
+                var (leftLower, leftUpper) = Vector128.Widen(left.AsInt16());
+                var (rightLower, rightUpper) = Vector128.Widen(right.AsInt16());
+                return Vector128.Narrow(DivideInSingle(leftLower, rightLower), DivideInSingle(leftUpper, rightUpper)).As<short, T>();
+            }
+            else
+            {
+                var (leftLower, leftUpper) = Vector128.Widen(left.AsUInt16());
+                var (rightLower, rightUpper) = Vector128.Widen(right.AsUInt16());
+                return Vector128.Narrow(
+                    DivideInSingle(leftLower.AsInt32(), rightLower.AsInt32()),
+                    DivideInSingle(leftUpper.AsInt32(), rightUpper.AsInt32())).As<short, T>();
+            }
+        }
+        else if (Unsafe.SizeOf<T>() == 4)
+        {
+            if (isSigned)
+            {
+                var (leftLower, leftUpper) = ConvertToDouble(left.AsInt32());
+                var (rightLower, rightUpper) = ConvertToDouble(right.AsInt32());
+                return ConvertToInt32WithTruncation(leftLower / rightLower, leftUpper / rightUpper).As<int, T>();
+            }
+            else
+            {
+                // Unsigned lanes are biased into the range of int for the conversions, and back again afterwards.
+                // The quotient is never negative, so flooring it is the same as truncating it.
+                var bias = Vector128.Create(int.MinValue);
+                var doubleBias = Vector128.Create(-(double)int.MinValue);
+                var (leftLower, leftUpper) = ConvertToDouble(left.AsInt32() ^ bias);
+                var (rightLower, rightUpper) = ConvertToDouble(right.AsInt32() ^ bias);
+                var quotientLower = Vector128.Floor((leftLower + doubleBias) / (rightLower + doubleBias)) - doubleBias;
+                var quotientUpper = Vector128.Floor((leftUpper + doubleBias) / (rightUpper + doubleBias)) - doubleBias;
+                return (ConvertToInt32WithTruncation(quotientLower, quotientUpper) ^ bias).As<int, T>();
+            }
+        }
+        else if (isSigned)
+        {
+            var leftLanes = left.AsInt64();
+            var rightLanes = right.AsInt64();
+            return Vector128.Create(leftLanes[0] / rightLanes[0], leftLanes[1] / rightLanes[1]).As<long, T>();
+        }
+        else
+        {
+            var leftLanes = left.AsUInt64();
+            var rightLanes = right.AsUInt64();
+            return Vector128.Create(leftLanes[0] / rightLanes[0], leftLanes[1] / rightLanes[1]).As<ulong, T>();
+        }
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<T> Remainder<T>(Vector128<T> left, Vector128<T> right, bool isSigned)
+        where T : unmanaged, IBinaryInteger<T>
+    {
+        if (Unsafe.SizeOf<T>() == 8)
+        {
+            if (isSigned)
+            {
+                var leftLanes = left.AsInt64();
+                var rightLanes = right.AsInt64();
+                return Vector128.Create(leftLanes[0] % rightLanes[0], leftLanes[1] % rightLanes[1]).As<long, T>();
+            }
+            else
+            {
+                var leftLanes = left.AsUInt64();
+                var rightLanes = right.AsUInt64();
+                return Vector128.Create(leftLanes[0] % rightLanes[0], leftLanes[1] % rightLanes[1]).As<ulong, T>();
+            }
+        }
+
+        return left - Divide(left, right, isSigned) * right;
     }
 
+    /// <summary>
+    /// Unsigned division by a constant. See <c>DivisionMagic.GetUnsigned</c> in the compiler.
+    /// </summary>
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector64<short> UnsignedRemainderV4I16(Vector64<short> left, Vector64<int> right)
+    private static Vector128<T> DivideByConstant<T>(Vector128<T> left, T divisor, T multiplier, int shift, bool isAdd)
+        where T : unmanaged, IBinaryInteger<T>
     {
-        // TODO: Optimize this.
+        // Powers of two, including one.
+        if (multiplier == T.Zero)
+        {
+            return left >>> shift;
+        }
+
+        var high = MultiplyHighUnsigned(left, multiplier);
+        return isAdd
+            ? (((left - high) >>> 1) + high) >>> (shift - 1)
+            : high >>> shift;
+    }
+
+    /// <summary>
+    /// Signed division by a constant. See <c>DivisionMagic.GetSigned</c> in the compiler.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<T> DivideByConstant<T>(Vector128<T> left, T divisor, T multiplier, int shift)
+        where T : unmanaged, IBinaryInteger<T>
+    {
+        if (divisor == T.One)
+        {
+            return left;
+        }
+        else if (divisor == T.AllBitsSet)
+        {
+            return -left;
+        }
+
+        var quotient = MultiplyHighSigned(left, multiplier);
+        if (!IsNegative(divisor) && IsNegative(multiplier))
+        {
+            quotient += left;
+        }
+        else if (IsNegative(divisor) && !IsNegative(multiplier))
+        {
+            quotient -= left;
+        }
+        quotient = VectorShifts.ShiftRightArithmetic(quotient, shift);
+
+        // Round towards zero.
+        return quotient + (quotient >>> (Unsafe.SizeOf<T>() * 8 - 1));
+    }
 
-        var leftUnsigned = left.AsUInt16();
-        var rightUnsigned = right.AsUInt16();
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<T> RemainderByConstant<T>(Vector128<T> left, T divisor, T multiplier, int shift, bool isAdd)
+        where T : unmanaged, IBinaryInteger<T> => left - DivideByConstant(left, divisor, multiplier, shift, isAdd) * divisor;
 
-        var signedResult = Vector64.Create(
-            (ushort)(leftUnsigned[0] % rightUnsigned[0]),
-            (ushort)(leftUnsigned[1] % rightUnsigned[1]),
-            (ushort)(leftUnsigned[2] % rightUnsigned[2]),
-            (ushort)(leftUnsigned[3] % rightUnsigned[3]));
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<T> RemainderByConstant<T>(Vector128<T> left, T divisor, T multiplier, int shift)
+        where T : unmanaged, IBinaryInteger<T> => left - DivideByConstant(left, divisor, multiplier, shift) * divisor;
 
-        return signedResult.AsInt16();
+    /// <summary>
+    /// The high half of the full product of each lane and <paramref name="right"/>, treating both as unsigned.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<T> MultiplyHighUnsigned<T>(Vector128<T> left, T right)
+        where T : unmanaged, IBinaryInteger<T>
+    {
+        if (Unsafe.SizeOf<T>() == 1)
+        {
+            var (lower, upper) = Vector128.Widen(left.AsByte());
+            var multiplier = Vector128.Create((ushort)byte.CreateTruncating(right));
+            return Vector128.Narrow((lower * multiplier) >>> 8, (upper * multiplier) >>> 8).As<byte, T>();
+        }
+        else if (Unsafe.SizeOf<T>() == 2)
+        {
+            var multiplier = ushort.CreateTruncating(right);
+            if (Sse2.IsSupported)
+            {
+                return Sse2.MultiplyHigh(left.AsUInt16(), Vector128.Create(multiplier)).As<ushort, T>();
+            }
+
+            var (lower, upper) = Vector128.Widen(left.AsUInt16());
+            var wideMultiplier = Vector128.Create((uint)multiplier);
+            return Vector128.Narrow((lower * wideMultiplier) >>> 16, (upper * wideMultiplier) >>> 16).As<ushort, T>();
+        }
+        else if (Unsafe.SizeOf<T>() == 4)
+        {
+            var multiplier = uint.CreateTruncating(right);
+            if (Sse2.IsSupported)
+            {
+                // pmuludq multiplies the even lanes, so the odd lanes are shifted down for a second one.
+                var multiplierVector = Vector128.Create(multiplier);
+                var even = Sse2.Multiply(left.AsUInt32(), multiplierVector);
+                var odd = Sse2.Multiply((left.AsUInt64() >>> 32).AsUInt32(), multiplierVector);
+                return ((even >>> 32) | (odd & Vector128.Create(0xFFFFFFFF00000000UL))).As<ulong, T>();
+            }
+
+            var (lower, upper) = Vector128.Widen(left.AsUInt32());
+            var wideMultiplier = Vector128.Create((ulong)multiplier);
+            return Vector128.Narrow((lower * wideMultiplier) >>> 32, (upper * wideMultiplier) >>> 32).As<uint, T>();
+        }
+        else
+        {
+            var multiplier = ulong.CreateTruncating(right);
+            var lanes = left.AsUInt64();
+            return Vector128.Create(Math.BigMul(lanes[0], multiplier, out _), Math.BigMul(lanes[1], multiplier, out _)).As<ulong, T>();
+        }
     }
 
+    /// <summary>
+    /// The high half of the full product of each lane and <paramref name="right"/>, treating both as signed.
+    /// </summary>
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector128<int> UnsignedRemainderV4I32(Vector128<int> left, Vector128<int> right)
+    private static Vector128<T> MultiplyHighSigned<T>(Vector128<T> left, T right)
+        where T : unmanaged, IBinaryInteger<T>
     {
-        // TODO: Optimize this.
+        if (Unsafe.SizeOf<T>() == 1)
+        {
+            var (lower, upper) = Vector128.Widen(left.AsSByte());
+            var multiplier = Vector128.Create((short)sbyte.CreateTruncating(right));
+            return Vector128.Narrow((lower * multiplier) >> 8, (upper * multiplier) >> 8).As<sbyte, T>();
+        }
+        else if (Unsafe.SizeOf<T>() == 2)
+        {
+            var multiplier = short.CreateTruncating(right);
+            if (Sse2.IsSupported)
+            {
+                return Sse2.MultiplyHigh(left.AsInt16(), Vector128.Create(multiplier)).As<short, T>();
+            }
+
+            var (lower, upper) = Vector128.Widen(left.AsInt16());
+            var wideMultiplier = Vector128.Create((int)multiplier);
+            return Vector128.Narrow((lower * wideMultiplier) >> 16, (upper * wideMultiplier) >> 16).As<short, T>();
+        }
+        else if (Unsafe.SizeOf<T>() == 4)
+        {
+            var multiplier = int.CreateTruncating(right);
+            if (Sse41.IsSupported)
+            {
+                var multiplierVector = Vector128.Create(multiplier);
+                var even = Sse41.Multiply(left.AsInt32(), multiplierVector);
+                var odd = Sse41.Multiply((left.AsInt64() >>> 32).AsInt32(), multiplierVector);
+                return ((even.AsUInt64() >>> 32) | (odd.AsUInt64() & Vector128.Create(0xFFFFFFFF00000000UL))).As<ulong, T>();
+            }
+
+            var (lower, upper) = Vector128.Widen(left.AsInt32());
+            var wideMultiplier = Vector128.Create((long)multiplier);
+            return Vector128.Narrow((lower * wideMultiplier) >> 32, (upper * wideMultiplier) >> 32).As<int, T>();
+        }
+        else
+        {
+            var multiplier = long.CreateTruncating(right);
+            var lanes = left.AsInt64();
+            return Vector128.Create(Math.BigMul(lanes[0], multiplier, out _), Math.BigMul(lanes[1], multiplier, out _)).As<long, T>();
+        }
+    }
 
-        var leftUnsigned = left.AsUInt32();
-        var rightUnsigned = right.AsUInt32();
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static bool IsNegative<T>(T value)
+        where T : unmanaged, IBinaryInteger<T> => (value >>> (Unsafe.SizeOf<T>() * 8 - 1)) != T.Zero;
 
-        var signedResult = Vector128.Create(
-            leftUnsigned[0] % rightUnsigned[0],
-            leftUnsigned[1] % rightUnsigned[1],
-            leftUnsigned[2] % rightUnsigned[2],
-            leftUnsigned[3] % rightUnsigned[3]);
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<int> DivideInSingle(Vector128<int> left, Vector128<int> right) =>
+        Vector128.ConvertToInt32(Vector128.ConvertToSingle(left) / Vector128.ConvertToSingle(right));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static (Vector128<double> Lower, Vector128<double> Upper) ConvertToDouble(Vector128<int> value)
+    {
+        if (Sse2.IsSupported)
+        {
+            return (Sse2.ConvertToVector128Double(value), Sse2.ConvertToVector128Double(Sse2.Shuffle(value, 0b_11_10_11_10)));
+        }
 
-        return signedResult.AsInt32();
+        var (lower, upper) = Vector128.Widen(value);
+        return (Vector128.ConvertToDouble(lower), Vector128.ConvertToDouble(upper));
     }
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static Vector128<short> UnsignedRemainderV8I16(Vector128<short> left, Vector128<short> right)
+    private static Vector128<int> ConvertToInt32WithTruncation(Vector128<double> lower, Vector128<double> upper)
     {
-        // TODO: Optimize this.
-
-        var leftUnsigned = left.AsUInt16();
-        var rightUnsigned = right.AsUInt16();
-
-        var signedResult = Vector128.Create(
-            (ushort)(leftUnsigned[0] % rightUnsigned[0]),
-            (ushort)(leftUnsigned[1] % rightUnsigned[1]),
-            (ushort)(leftUnsigned[2] % rightUnsigned[2]),
-            (ushort)(leftUnsigned[3] % rightUnsigned[3]),
-            (ushort)(leftUnsigned[4] % rightUnsigned[4]),
-            (ushort)(leftUnsigned[5] % rightUnsigned[5]),
-            (ushort)(leftUnsigned[6] % rightUnsigned[6]),
-            (ushort)(leftUnsigned[7] % rightUnsigned[7]));
-
-        return signedResult.AsInt16();
+        if (Sse2.IsSupported)
+        {
+            return Sse2.UnpackLow(
+                Sse2.ConvertToVector128Int32WithTruncation(lower).AsInt64(),
+                Sse2.ConvertToVector128Int32WithTruncation(upper).AsInt64()).AsInt32();
+        }
+
+        return Vector128.Narrow(Vector128.ConvertToInt64(lower), Vector128.ConvertToInt64(upper));
     }
-}
\ No newline at end of file
+}
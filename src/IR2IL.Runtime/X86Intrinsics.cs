@@ -0,0 +1,1170 @@
+using System.Numerics;
+using System.Runtime.CompilerServices;
+using System.Runtime.Intrinsics;
+using System.Runtime.Intrinsics.X86;
+
+namespace IR2IL.Runtime;
+
+/// <summary>
+/// Implementations of the llvm.x86.* intrinsics that clang emits for &lt;immintrin.h&gt; functions
+/// without a target-independent equivalent, such as _mm_movemask_epi8 and _mm_shuffle_epi8.
+/// </summary>
+/// <remarks>
+/// Each method uses the matching System.Runtime.Intrinsics.X86 method when the hardware supports it,
+/// and otherwise computes the same result with Vector128 methods or one element at a time.
+/// Parameter and return types are the ones that LLVM's vector types map to, so i8 elements are
+/// <see cref="byte"/> and i16 elements are <see cref="short"/>, whatever the instruction's signedness.
+/// 256-bit instructions that work on each 128-bit lane separately fall back to the 128-bit methods.
+/// </remarks>
+public static class X86Intrinsics
+{
+    // Masks and tests
+
+    public static int MoveMask(Vector128<byte> vector) => (int)Vector128.ExtractMostSignificantBits(vector);
+
+    public static int MoveMask(Vector128<float> vector) => (int)Vector128.ExtractMostSignificantBits(vector);
+
+    public static int MoveMask(Vector128<double> vector) => (int)Vector128.ExtractMostSignificantBits(vector);
+
+    public static int MoveMask(Vector256<byte> vector) => (int)Vector256.ExtractMostSignificantBits(vector);
+
+    public static int MoveMask(Vector256<float> vector) => (int)Vector256.ExtractMostSignificantBits(vector);
+
+    public static int MoveMask(Vector256<double> vector) => (int)Vector256.ExtractMostSignificantBits(vector);
+
+    public static int TestZ(Vector128<long> left, Vector128<long> right) => Sse41.IsSupported
+        ? (Sse41.TestZ(left, right) ? 1 : 0)
+        : ((left & right) == Vector128<long>.Zero ? 1 : 0);
+
+    public static int TestC(Vector128<long> left, Vector128<long> right) => Sse41.IsSupported
+        ? (Sse41.TestC(left, right) ? 1 : 0)
+        : (Vector128.AndNot(right, left) == Vector128<long>.Zero ? 1 : 0);
+
+    public static int TestNotZAndNotC(Vector128<long> left, Vector128<long> right) => Sse41.IsSupported
+        ? (Sse41.TestNotZAndNotC(left, right) ? 1 : 0)
+        : (TestZ(left, right) | TestC(left, right)) ^ 1;
+
+    public static int TestZ(Vector256<long> left, Vector256<long> right) => Avx.IsSupported
+        ? (Avx.TestZ(left, right) ? 1 : 0)
+        : ((left & right) == Vector256<long>.Zero ? 1 : 0);
+
+    public static int TestC(Vector256<long> left, Vector256<long> right) => Avx.IsSupported
+        ? (Avx.TestC(left, right) ? 1 : 0)
+        : (Vector256.AndNot(right, left) == Vector256<long>.Zero ? 1 : 0);
+
+    public static int TestNotZAndNotC(Vector256<long> left, Vector256<long> right) => Avx.IsSupported
+        ? (Avx.TestNotZAndNotC(left, right) ? 1 : 0)
+        : (TestZ(left, right) | TestC(left, right)) ^ 1;
+
+    // Blends select from the right operand where the top bit of the mask element is set.
+
+    public static Vector128<byte> BlendVariable(Vector128<byte> left, Vector128<byte> right, Vector128<byte> mask) => Sse41.IsSupported
+        ? Sse41.BlendVariable(left, right, mask)
+        : Vector128.ConditionalSelect(Vector128.ShiftRightArithmetic(mask.AsSByte(), 7).AsByte(), right, left);
+
+    public static Vector128<float> BlendVariable(Vector128<float> left, Vector128<float> right, Vector128<float> mask) => Sse41.IsSupported
+        ? Sse41.BlendVariable(left, right, mask)
+        : Vector128.ConditionalSelect(Vector128.ShiftRightArithmetic(mask.AsInt32(), 31).AsSingle(), right, left);
+
+    public static Vector128<double> BlendVariable(Vector128<double> left, Vector128<double> right, Vector128<double> mask) => Sse41.IsSupported
+        ? Sse41.BlendVariable(left, right, mask)
+        : Vector128.ConditionalSelect(Vector128.ShiftRightArithmetic(mask.AsInt64(), 63).AsDouble(), right, left);
+
+    public static Vector256<byte> BlendVariable(Vector256<byte> left, Vector256<byte> right, Vector256<byte> mask) => Avx2.IsSupported
+        ? Avx2.BlendVariable(left, right, mask)
+        : Vector256.Create(BlendVariable(left.GetLower(), right.GetLower(), mask.GetLower()), BlendVariable(left.GetUpper(), right.GetUpper(), mask.GetUpper()));
+
+    public static Vector256<float> BlendVariable(Vector256<float> left, Vector256<float> right, Vector256<float> mask) => Avx.IsSupported
+        ? Avx.BlendVariable(left, right, mask)
+        : Vector256.Create(BlendVariable(left.GetLower(), right.GetLower(), mask.GetLower()), BlendVariable(left.GetUpper(), right.GetUpper(), mask.GetUpper()));
+
+    public static Vector256<double> BlendVariable(Vector256<double> left, Vector256<double> right, Vector256<double> mask) => Avx.IsSupported
+        ? Avx.BlendVariable(left, right, mask)
+        : Vector256.Create(BlendVariable(left.GetLower(), right.GetLower(), mask.GetLower()), BlendVariable(left.GetUpper(), right.GetUpper(), mask.GetUpper()));
+
+    // Shuffles and permutes
+
+    /// <summary>
+    /// pshufb: each index selects a byte with its low 4 bits, or zero if its top bit is set.
+    /// Vector128.Shuffle gives zero for indices over 15, so clearing bits 4 to 6 gives the same result.
+    /// </summary>
+    public static Vector128<byte> Shuffle(Vector128<byte> vector, Vector128<byte> indices) => Ssse3.IsSupported
+        ? Ssse3.Shuffle(vector, indices)
+        : Vector128.Shuffle(vector, indices & Vector128.Create((byte)0x8F));
+
+    public static Vector256<byte> Shuffle(Vector256<byte> vector, Vector256<byte> indices) => Avx2.IsSupported
+        ? Avx2.Shuffle(vector, indices)
+        : Vector256.Create(Shuffle(vector.GetLower(), indices.GetLower()), Shuffle(vector.GetUpper(), indices.GetUpper()));
+
+    public static Vector128<float> PermuteVar(Vector128<float> vector, Vector128<int> control) => Avx.IsSupported
+        ? Avx.PermuteVar(vector, control)
+        : Vector128.Shuffle(vector, control & Vector128.Create(3));
+
+    /// <summary>
+    /// vpermilpd uses bit 1 of each control element, not bit 0.
+    /// </summary>
+    public static Vector128<double> PermuteVar(Vector128<double> vector, Vector128<long> control) => Avx.IsSupported
+        ? Avx.PermuteVar(vector, control)
+        : Vector128.Shuffle(vector, (control >>> 1) & Vector128.Create(1L));
+
+    public static Vector256<float> PermuteVar(Vector256<float> vector, Vector256<int> control) => Avx.IsSupported
+        ? Avx.PermuteVar(vector, control)
+        : Vector256.Create(PermuteVar(vector.GetLower(), control.GetLower()), PermuteVar(vector.GetUpper(), control.GetUpper()));
+
+    public static Vector256<double> PermuteVar(Vector256<double> vector, Vector256<long> control) => Avx.IsSupported
+        ? Avx.PermuteVar(vector, control)
+        : Vector256.Create(PermuteVar(vector.GetLower(), control.GetLower()), PermuteVar(vector.GetUpper(), control.GetUpper()));
+
+    public static Vector256<int> PermuteVar8x32(Vector256<int> vector, Vector256<int> control) => Avx2.IsSupported
+        ? Avx2.PermuteVar8x32(vector, control)
+        : Vector256.Shuffle(vector, control & Vector256.Create(7));
+
+    public static Vector256<float> PermuteVar8x32(Vector256<float> vector, Vector256<int> control) => Avx2.IsSupported
+        ? Avx2.PermuteVar8x32(vector, control)
+        : Vector256.Shuffle(vector, control & Vector256.Create(7));
+
+    // Packs
+
+    public static Vector128<byte> PackSignedSaturate(Vector128<short> left, Vector128<short> right) => Sse2.IsSupported
+        ? Sse2.PackSignedSaturate(left, right).AsByte()
+        : Vector128.Narrow(Clamp(left, sbyte.MinValue, sbyte.MaxValue), Clamp(right, sbyte.MinValue, sbyte.MaxValue)).AsByte();
+
+    public static Vector128<byte> PackUnsignedSaturate(Vector128<short> left, Vector128<short> right) => Sse2.IsSupported
+        ? Sse2.PackUnsignedSaturate(left, right)
+        : Vector128.Narrow(Clamp(left, byte.MinValue, byte.MaxValue), Clamp(right, byte.MinValue, byte.MaxValue)).AsByte();
+
+    public static Vector128<short> PackSignedSaturate(Vector128<int> left, Vector128<int> right) => Sse2.IsSupported
+        ? Sse2.PackSignedSaturate(left, right)
+        : Vector128.Narrow(Clamp(left, short.MinValue, short.MaxValue), Clamp(right, short.MinValue, short.MaxValue));
+
+    public static Vector128<short> PackUnsignedSaturate(Vector128<int> left, Vector128<int> right) => Sse41.IsSupported
+        ? Sse41.PackUnsignedSaturate(left, right).AsInt16()
+        : Vector128.Narrow(Clamp(left, ushort.MinValue, ushort.MaxValue), Clamp(right, ushort.MinValue, ushort.MaxValue));
+
+    public static Vector256<byte> PackSignedSaturate(Vector256<short> left, Vector256<short> right) => Avx2.IsSupported
+        ? Avx2.PackSignedSaturate(left, right).AsByte()
+        : Vector256.Create(PackSignedSaturate(left.GetLower(), right.GetLower()), PackSignedSaturate(left.GetUpper(), right.GetUpper()));
+
+    public static Vector256<byte> PackUnsignedSaturate(Vector256<short> left, Vector256<short> right) => Avx2.IsSupported
+        ? Avx2.PackUnsignedSaturate(left, right)
+        : Vector256.Create(PackUnsignedSaturate(left.GetLower(), right.GetLower()), PackUnsignedSaturate(left.GetUpper(), right.GetUpper()));
+
+    public static Vector256<short> PackSignedSaturate(Vector256<int> left, Vector256<int> right) => Avx2.IsSupported
+        ? Avx2.PackSignedSaturate(left, right)
+        : Vector256.Create(PackSignedSaturate(left.GetLower(), right.GetLower()), PackSignedSaturate(left.GetUpper(), right.GetUpper()));
+
+    public static Vector256<short> PackUnsignedSaturate(Vector256<int> left, Vector256<int> right) => Avx2.IsSupported
+        ? Avx2.PackUnsignedSaturate(left, right).AsInt16()
+        : Vector256.Create(PackUnsignedSaturate(left.GetLower(), right.GetLower()), PackUnsignedSaturate(left.GetUpper(), right.GetUpper()));
+
+    // Multiplies
+
+    /// <summary>
+    /// pmaddwd: multiplies signed 16-bit elements, and adds adjacent pairs of the 32-bit products.
+    /// </summary>
+    public static Vector128<int> MultiplyAddAdjacent(Vector128<short> left, Vector128<short> right)
+    {
+        if (Sse2.IsSupported)
+        {
+            return Sse2.MultiplyAddAdjacent(left, right);
+        }
+
+        var (leftLower, leftUpper) = Vector128.Widen(left);
+        var (rightLower, rightUpper) = Vector128.Widen(right);
+        return AddAdjacent(leftLower * rightLower, leftUpper * rightUpper);
+    }
+
+    /// <summary>
+    /// pmaddubsw: multiplies unsigned bytes from the left by signed bytes from the right,
+    /// and adds adjacent pairs of the products with signed saturation.
+    /// </summary>
+    public static Vector128<short> MultiplyAddAdjacent(Vector128<byte> left, Vector128<byte> right)
+    {
+        if (Ssse3.IsSupported)
+        {
+            return Ssse3.MultiplyAddAdjacent(left, right.AsSByte());
+        }
+
+        var (leftLower, leftUpper) = Vector128.Widen(left);
+        var (rightLower, rightUpper) = Vector128.Widen(right.AsSByte());
+        var lower = leftLower.AsInt16() * rightLower;
+        var upper = leftUpper.AsInt16() * rightUpper;
+
+        // Each product fits in 16 bits, but their sum might not.
+        var (lowerLower, lowerUpper) = Vector128.Widen(lower);
+        var (upperLower, upperUpper) = Vector128.Widen(upper);
+        return PackSignedSaturate(AddAdjacent(lowerLower, lowerUpper), AddAdjacent(upperLower, upperUpper));
+    }
+
+    public static Vector256<int> MultiplyAddAdjacent(Vector256<short> left, Vector256<short> right) => Avx2.IsSupported
+        ? Avx2.MultiplyAddAdjacent(left, right)
+        : Vector256.Create(MultiplyAddAdjacent(left.GetLower(), right.GetLower()), MultiplyAddAdjacent(left.GetUpper(), right.GetUpper()));
+
+    public static Vector256<short> MultiplyAddAdjacent(Vector256<byte> left, Vector256<byte> right) => Avx2.IsSupported
+        ? Avx2.MultiplyAddAdjacent(left, right.AsSByte())
+        : Vector256.Create(MultiplyAddAdjacent(left.GetLower(), right.GetLower()), MultiplyAddAdjacent(left.GetUpper(), right.GetUpper()));
+
+    public static Vector128<short> MultiplyHigh(Vector128<short> left, Vector128<short> right)
+    {
+        if (Sse2.IsSupported)
+        {
+            return Sse2.MultiplyHigh(left, right);
+        }
+
+        var (leftLower, leftUpper) = Vector128.Widen(left);
+        var (rightLower, rightUpper) = Vector128.Widen(right);
+        return Vector128.Narrow((leftLower * rightLower) >> 16, (leftUpper * rightUpper) >> 16);
+    }
+
+    public static Vector128<short> MultiplyHighUnsigned(Vector128<short> left, Vector128<short> right)
+    {
+        if (Sse2.IsSupported)
+        {
+            return Sse2.MultiplyHigh(left.AsUInt16(), right.AsUInt16()).AsInt16();
+        }
+
+        var (leftLower, leftUpper) = Vector128.Widen(left.AsUInt16());
+        var (rightLower, rightUpper) = Vector128.Widen(right.AsUInt16());
+        return Vector128.Narrow((leftLower * rightLower) >>> 16, (leftUpper * rightUpper) >>> 16).AsInt16();
+    }
+
+    /// <summary>
+    /// pmulhrsw: the high 16 bits of each product, after doubling it and rounding.
+    /// </summary>
+    public static Vector128<short> MultiplyHighRoundScale(Vector128<short> left, Vector128<short> right)
+    {
+        if (Ssse3.IsSupported)
+        {
+            return Ssse3.MultiplyHighRoundScale(left, right);
+        }
+
+        var (leftLower, leftUpper) = Vector128.Widen(left);
+        var (rightLower, rightUpper) = Vector128.Widen(right);
+        var one = Vector128.Create(1);
+        return Vector128.Narrow(
+            (((leftLower * rightLower) >> 14) + one) >> 1,
+            (((leftUpper * rightUpper) >> 14) + one) >> 1);
+    }
+
+    public static Vector256<short> MultiplyHigh(Vector256<short> left, Vector256<short> right) => Avx2.IsSupported
+        ? Avx2.MultiplyHigh(left, right)
+        : Vector256.Create(MultiplyHigh(left.GetLower(), right.GetLower()), MultiplyHigh(left.GetUpper(), right.GetUpper()));
+
+    public static Vector256<short> MultiplyHighUnsigned(Vector256<short> left, Vector256<short> right) => Avx2.IsSupported
+        ? Avx2.MultiplyHigh(left.AsUInt16(), right.AsUInt16()).AsInt16()
+        : Vector256.Create(MultiplyHighUnsigned(left.GetLower(), right.GetLower()), MultiplyHighUnsigned(left.GetUpper(), right.GetUpper()));
+
+    public static Vector256<short> MultiplyHighRoundScale(Vector256<short> left, Vector256<short> right) => Avx2.IsSupported
+        ? Avx2.MultiplyHighRoundScale(left, right)
+        : Vector256.Create(MultiplyHighRoundScale(left.GetLower(), right.GetLower()), MultiplyHighRoundScale(left.GetUpper(), right.GetUpper()));
+
+    // Averages, sums of differences and horizontal operations
+
+    public static Vector128<byte> Average(Vector128<byte> left, Vector128<byte> right)
+    {
+        if (Sse2.IsSupported)
+        {
+            return Sse2.Average(left, right);
+        }
+
+        // (left + right + 1) / 2 without overflowing.
+        return (left | right) - ((left ^ right) >>> 1);
+    }
+
+    public static Vector128<short> Average(Vector128<short> left, Vector128<short> right)
+    {
+        if (Sse2.IsSupported)
+        {
+            return Sse2.Average(left.AsUInt16(), right.AsUInt16()).AsInt16();
+        }
+
+        return ((left | right).AsUInt16() - ((left ^ right).AsUInt16() >>> 1)).AsInt16();
+    }
+
+    public static Vector256<byte> Average(Vector256<byte> left, Vector256<byte> right) => Avx2.IsSupported
+        ? Avx2.Average(left, right)
+        : Vector256.Create(Average(left.GetLower(), right.GetLower()), Average(left.GetUpper(), right.GetUpper()));
+
+    public static Vector256<short> Average(Vector256<short> left, Vector256<short> right) => Avx2.IsSupported
+        ? Avx2.Average(left.AsUInt16(), right.AsUInt16()).AsInt16()
+        : Vector256.Create(Average(left.GetLower(), right.GetLower()), Average(left.GetUpper(), right.GetUpper()));
+
+    /// <summary>
+    /// psadbw: the sums of the absolute differences of each group of 8 bytes, in the low 16 bits of each 64-bit element.
+    /// </summary>
+    public static Vector128<long> SumAbsoluteDifferences(Vector128<byte> left, Vector128<byte> right)
+    {
+        if (Sse2.IsSupported)
+        {
+            return Sse2.SumAbsoluteDifferences(left, right).AsInt64();
+        }
+
+        var differences = Vector128.Max(left, right) - Vector128.Min(left, right);
+        var (lower, upper) = Vector128.Widen(differences);
+        return Vector128.Create((long)Vector128.Sum(lower), (long)Vector128.Sum(upper));
+    }
+
+    public static Vector256<long> SumAbsoluteDifferences(Vector256<byte> left, Vector256<byte> right) => Avx2.IsSupported
+        ? Avx2.SumAbsoluteDifferences(left, right).AsInt64()
+        : Vector256.Create(SumAbsoluteDifferences(left.GetLower(), right.GetLower()), SumAbsoluteDifferences(left.GetUpper(), right.GetUpper()));
+
+    public static Vector128<short> HorizontalAdd(Vector128<short> left, Vector128<short> right) => Ssse3.IsSupported
+        ? Ssse3.HorizontalAdd(left, right)
+        : Vector128.Narrow(AddAdjacent(Vector128.Widen(left)), AddAdjacent(Vector128.Widen(right)));
+
+    public static Vector128<int> HorizontalAdd(Vector128<int> left, Vector128<int> right) => Ssse3.IsSupported
+        ? Ssse3.HorizontalAdd(left, right)
+        : AddAdjacent(left, right);
+
+    public static Vector128<short> HorizontalAddSaturate(Vector128<short> left, Vector128<short> right) => Ssse3.IsSupported
+        ? Ssse3.HorizontalAddSaturate(left, right)
+        : PackSignedSaturate(AddAdjacent(Vector128.Widen(left)), AddAdjacent(Vector128.Widen(right)));
+
+    public static Vector128<short> HorizontalSubtract(Vector128<short> left, Vector128<short> right) => Ssse3.IsSupported
+        ? Ssse3.HorizontalSubtract(left, right)
+        : Vector128.Narrow(SubtractAdjacent(Vector128.Widen(left)), SubtractAdjacent(Vector128.Widen(right)));
+
+    public static Vector128<int> HorizontalSubtract(Vector128<int> left, Vector128<int> right) => Ssse3.IsSupported
+        ? Ssse3.HorizontalSubtract(left, right)
+        : SubtractAdjacent(left, right);
+
+    public static Vector128<short> HorizontalSubtractSaturate(Vector128<short> left, Vector128<short> right) => Ssse3.IsSupported
+        ? Ssse3.HorizontalSubtractSaturate(left, right)
+        : PackSignedSaturate(SubtractAdjacent(Vector128.Widen(left)), SubtractAdjacent(Vector128.Widen(right)));
+
+    public static Vector256<short> HorizontalAdd(Vector256<short> left, Vector256<short> right) => Avx2.IsSupported
+        ? Avx2.HorizontalAdd(left, right)
+        : Vector256.Create(HorizontalAdd(left.GetLower(), right.GetLower()), HorizontalAdd(left.GetUpper(), right.GetUpper()));
+
+    public static Vector256<int> HorizontalAdd(Vector256<int> left, Vector256<int> right) => Avx2.IsSupported
+        ? Avx2.HorizontalAdd(left, right)
+        : Vector256.Create(HorizontalAdd(left.GetLower(), right.GetLower()), HorizontalAdd(left.GetUpper(), right.GetUpper()));
+
+    public static Vector256<short> HorizontalAddSaturate(Vector256<short> left, Vector256<short> right) => Avx2.IsSupported
+        ? Avx2.HorizontalAddSaturate(left, right)
+        : Vector256.Create(HorizontalAddSaturate(left.GetLower(), right.GetLower()), HorizontalAddSaturate(left.GetUpper(), right.GetUpper()));
+
+    public static Vector256<short> HorizontalSubtract(Vector256<short> left, Vector256<short> right) => Avx2.IsSupported
+        ? Avx2.HorizontalSubtract(left, right)
+        : Vector256.Create(HorizontalSubtract(left.GetLower(), right.GetLower()), HorizontalSubtract(left.GetUpper(), right.GetUpper()));
+
+    public static Vector256<int> HorizontalSubtract(Vector256<int> left, Vector256<int> right) => Avx2.IsSupported
+        ? Avx2.HorizontalSubtract(left, right)
+        : Vector256.Create(HorizontalSubtract(left.GetLower(), right.GetLower()), HorizontalSubtract(left.GetUpper(), right.GetUpper()));
+
+    public static Vector256<short> HorizontalSubtractSaturate(Vector256<short> left, Vector256<short> right) => Avx2.IsSupported
+        ? Avx2.HorizontalSubtractSaturate(left, right)
+        : Vector256.Create(HorizontalSubtractSaturate(left.GetLower(), right.GetLower()), HorizontalSubtractSaturate(left.GetUpper(), right.GetUpper()));
+
+    /// <summary>
+    /// phminposuw: the minimum unsigned 16-bit element in element 0, its index in element 1, and zero elsewhere.
+    /// </summary>
+    public static Vector128<short> MinHorizontal(Vector128<short> vector)
+    {
+        if (Sse41.IsSupported)
+        {
+            return Sse41.MinHorizontal(vector.AsUInt16()).AsInt16();
+        }
+
+        var elements = vector.AsUInt16();
+        var minimum = elements.GetElement(0);
+        var index = 0;
+        for (var i = 1; i < Vector128<ushort>.Count; i++)
+        {
+            if (elements.GetElement(i) < minimum)
+            {
+                minimum = elements.GetElement(i);
+                index = i;
+            }
+        }
+
+        return Vector128.Create(minimum, (ushort)index, 0, 0, 0, 0, 0, 0).AsInt16();
+    }
+
+    /// <summary>
+    /// psign: negates elements of the left operand where the right one is negative, and zeroes them where it's zero.
+    /// </summary>
+    public static Vector128<byte> Sign(Vector128<byte> left, Vector128<byte> right) => Ssse3.IsSupported
+        ? Ssse3.Sign(left.AsSByte(), right.AsSByte()).AsByte()
+        : Sign(left.AsSByte(), right.AsSByte()).AsByte();
+
+    public static Vector128<short> Sign(Vector128<short> left, Vector128<short> right) => Ssse3.IsSupported
+        ? Ssse3.Sign(left, right)
+        : Sign<short>(left, right);
+
+    public static Vector128<int> Sign(Vector128<int> left, Vector128<int> right) => Ssse3.IsSupported
+        ? Ssse3.Sign(left, right)
+        : Sign<int>(left, right);
+
+    public static Vector256<byte> Sign(Vector256<byte> left, Vector256<byte> right) => Avx2.IsSupported
+        ? Avx2.Sign(left.AsSByte(), right.AsSByte()).AsByte()
+        : Vector256.Create(Sign(left.GetLower(), right.GetLower()), Sign(left.GetUpper(), right.GetUpper()));
+
+    public static Vector256<short> Sign(Vector256<short> left, Vector256<short> right) => Avx2.IsSupported
+        ? Avx2.Sign(left, right)
+        : Vector256.Create(Sign(left.GetLower(), right.GetLower()), Sign(left.GetUpper(), right.GetUpper()));
+
+    public static Vector256<int> Sign(Vector256<int> left, Vector256<int> right) => Avx2.IsSupported
+        ? Avx2.Sign(left, right)
+        : Vector256.Create(Sign(left.GetLower(), right.GetLower()), Sign(left.GetUpper(), right.GetUpper()));
+
+    // Shifts by an immediate count. Counts of at least the element width give zero,
+    // or the sign bit for arithmetic shifts, rather than being masked like C# shifts.
+
+    public static Vector128<short> ShiftLeftLogical(Vector128<short> vector, int count) => (uint)count < 16 ? vector << count : Vector128<short>.Zero;
+
+    public static Vector128<int> ShiftLeftLogical(Vector128<int> vector, int count) => (uint)count < 32 ? vector << count : Vector128<int>.Zero;
+
+    public static Vector128<long> ShiftLeftLogical(Vector128<long> vector, int count) => (uint)count < 64 ? vector << count : Vector128<long>.Zero;
+
+    public static Vector128<short> ShiftRightLogical(Vector128<short> vector, int count) => (uint)count < 16 ? vector >>> count : Vector128<short>.Zero;
+
+    public static Vector128<int> ShiftRightLogical(Vector128<int> vector, int count) => (uint)count < 32 ? vector >>> count : Vector128<int>.Zero;
+
+    public static Vector128<long> ShiftRightLogical(Vector128<long> vector, int count) => (uint)count < 64 ? vector >>> count : Vector128<long>.Zero;
+
+    public static Vector128<short> ShiftRightArithmetic(Vector128<short> vector, int count) => vector >> (int)Math.Min((uint)count, 15);
+
+    public static Vector128<int> ShiftRightArithmetic(Vector128<int> vector, int count) => vector >> (int)Math.Min((uint)count, 31);
+
+    public static Vector256<short> ShiftLeftLogical(Vector256<short> vector, int count) => (uint)count < 16 ? vector << count : Vector256<short>.Zero;
+
+    public static Vector256<int> ShiftLeftLogical(Vector256<int> vector, int count) => (uint)count < 32 ? vector << count : Vector256<int>.Zero;
+
+    public static Vector256<long> ShiftLeftLogical(Vector256<long> vector, int count) => (uint)count < 64 ? vector << count : Vector256<long>.Zero;
+
+    public static Vector256<short> ShiftRightLogical(Vector256<short> vector, int count) => (uint)count < 16 ? vector >>> count : Vector256<short>.Zero;
+
+    public static Vector256<int> ShiftRightLogical(Vector256<int> vector, int count) => (uint)count < 32 ? vector >>> count : Vector256<int>.Zero;
+
+    public static Vector256<long> ShiftRightLogical(Vector256<long> vector, int count) => (uint)count < 64 ? vector >>> count : Vector256<long>.Zero;
+
+    public static Vector256<short> ShiftRightArithmetic(Vector256<short> vector, int count) => vector >> (int)Math.Min((uint)count, 15);
+
+    public static Vector256<int> ShiftRightArithmetic(Vector256<int> vector, int count) => vector >> (int)Math.Min((uint)count, 31);
+
+    // Shifts by the count in the low 64 bits of a vector.
+
+    public static Vector128<short> ShiftLeftLogical(Vector128<short> vector, Vector128<short> count) => ShiftLeftLogical(vector, GetShiftCount(count));
+
+    public static Vector128<int> ShiftLeftLogical(Vector128<int> vector, Vector128<int> count) => ShiftLeftLogical(vector, GetShiftCount(count));
+
+    public static Vector128<long> ShiftLeftLogical(Vector128<long> vector, Vector128<long> count) => ShiftLeftLogical(vector, GetShiftCount(count));
+
+    public static Vector128<short> ShiftRightLogical(Vector128<short> vector, Vector128<short> count) => ShiftRightLogical(vector, GetShiftCount(count));
+
+    public static Vector128<int> ShiftRightLogical(Vector128<int> vector, Vector128<int> count) => ShiftRightLogical(vector, GetShiftCount(count));
+
+    public static Vector128<long> ShiftRightLogical(Vector128<long> vector, Vector128<long> count) => ShiftRightLogical(vector, GetShiftCount(count));
+
+    public static Vector128<short> ShiftRightArithmetic(Vector128<short> vector, Vector128<short> count) => ShiftRightArithmetic(vector, GetShiftCount(count));
+
+    public static Vector128<int> ShiftRightArithmetic(Vector128<int> vector, Vector128<int> count) => ShiftRightArithmetic(vector, GetShiftCount(count));
+
+    public static Vector256<short> ShiftLeftLogical(Vector256<short> vector, Vector128<short> count) => ShiftLeftLogical(vector, GetShiftCount(count));
+
+    public static Vector256<int> ShiftLeftLogical(Vector256<int> vector, Vector128<int> count) => ShiftLeftLogical(vector, GetShiftCount(count));
+
+    public static Vector256<long> ShiftLeftLogical(Vector256<long> vector, Vector128<long> count) => ShiftLeftLogical(vector, GetShiftCount(count));
+
+    public static Vector256<short> ShiftRightLogical(Vector256<short> vector, Vector128<short> count) => ShiftRightLogical(vector, GetShiftCount(count));
+
+    public static Vector256<int> ShiftRightLogical(Vector256<int> vector, Vector128<int> count) => ShiftRightLogical(vector, GetShiftCount(count));
+
+    public static Vector256<long> ShiftRightLogical(Vector256<long> vector, Vector128<long> count) => ShiftRightLogical(vector, GetShiftCount(count));
+
+    public static Vector256<short> ShiftRightArithmetic(Vector256<short> vector, Vector128<short> count) => ShiftRightArithmetic(vector, GetShiftCount(count));
+
+    public static Vector256<int> ShiftRightArithmetic(Vector256<int> vector, Vector128<int> count) => ShiftRightArithmetic(vector, GetShiftCount(count));
+
+    // Shifts by a count for each element. Unlike LLVM's shifts, counts of the element width or more are defined:
+    // they give 0 for logical shifts and fill with the sign bit for arithmetic ones. The VectorShifts fallbacks only
+    // look at the low bits of the count, so the logical shifts clear those lanes, and the arithmetic one clamps them.
+
+    public static Vector128<int> ShiftLeftLogicalVariable(Vector128<int> vector, Vector128<int> count)
+    {
+        if (Avx2.IsSupported)
+        {
+            return Avx2.ShiftLeftLogicalVariable(vector, count.AsUInt32());
+        }
+
+        var isInRange = Vector128.LessThan(count.AsUInt32(), Vector128.Create(32u)).AsInt32();
+        return VectorShifts.ShiftLeft(vector, count) & isInRange;
+    }
+
+    public static Vector128<long> ShiftLeftLogicalVariable(Vector128<long> vector, Vector128<long> count)
+    {
+        if (Avx2.IsSupported)
+        {
+            return Avx2.ShiftLeftLogicalVariable(vector, count.AsUInt64());
+        }
+
+        var isInRange = Vector128.LessThan(count.AsUInt64(), Vector128.Create(64UL)).AsInt64();
+        return VectorShifts.ShiftLeft(vector, count) & isInRange;
+    }
+
+    public static Vector128<int> ShiftRightLogicalVariable(Vector128<int> vector, Vector128<int> count)
+    {
+        if (Avx2.IsSupported)
+        {
+            return Avx2.ShiftRightLogicalVariable(vector, count.AsUInt32());
+        }
+
+        var isInRange = Vector128.LessThan(count.AsUInt32(), Vector128.Create(32u)).AsInt32();
+        return VectorShifts.ShiftRightLogical(vector, count) & isInRange;
+    }
+
+    public static Vector128<long> ShiftRightLogicalVariable(Vector128<long> vector, Vector128<long> count)
+    {
+        if (Avx2.IsSupported)
+        {
+            return Avx2.ShiftRightLogicalVariable(vector, count.AsUInt64());
+        }
+
+        var isInRange = Vector128.LessThan(count.AsUInt64(), Vector128.Create(64UL)).AsInt64();
+        return VectorShifts.ShiftRightLogical(vector, count) & isInRange;
+    }
+
+    public static Vector128<int> ShiftRightArithmeticVariable(Vector128<int> vector, Vector128<int> count)
+    {
+        if (Avx2.IsSupported)
+        {
+            return Avx2.ShiftRightArithmeticVariable(vector, count.AsUInt32());
+        }
+
+        return VectorShifts.ShiftRightArithmetic(vector, Vector128.Min(count.AsUInt32(), Vector128.Create(31u)).AsInt32());
+    }
+
+    public static Vector256<int> ShiftLeftLogicalVariable(Vector256<int> vector, Vector256<int> count) => Avx2.IsSupported
+        ? Avx2.ShiftLeftLogicalVariable(vector, count.AsUInt32())
+        : Vector256.Create(ShiftLeftLogicalVariable(vector.GetLower(), count.GetLower()), ShiftLeftLogicalVariable(vector.GetUpper(), count.GetUpper()));
+
+    public static Vector256<long> ShiftLeftLogicalVariable(Vector256<long> vector, Vector256<long> count) => Avx2.IsSupported
+        ? Avx2.ShiftLeftLogicalVariable(vector, count.AsUInt64())
+        : Vector256.Create(ShiftLeftLogicalVariable(vector.GetLower(), count.GetLower()), ShiftLeftLogicalVariable(vector.GetUpper(), count.GetUpper()));
+
+    public static Vector256<int> ShiftRightLogicalVariable(Vector256<int> vector, Vector256<int> count) => Avx2.IsSupported
+        ? Avx2.ShiftRightLogicalVariable(vector, count.AsUInt32())
+        : Vector256.Create(ShiftRightLogicalVariable(vector.GetLower(), count.GetLower()), ShiftRightLogicalVariable(vector.GetUpper(), count.GetUpper()));
+
+    public static Vector256<long> ShiftRightLogicalVariable(Vector256<long> vector, Vector256<long> count) => Avx2.IsSupported
+        ? Avx2.ShiftRightLogicalVariable(vector, count.AsUInt64())
+        : Vector256.Create(ShiftRightLogicalVariable(vector.GetLower(), count.GetLower()), ShiftRightLogicalVariable(vector.GetUpper(), count.GetUpper()));
+
+    public static Vector256<int> ShiftRightArithmeticVariable(Vector256<int> vector, Vector256<int> count) => Avx2.IsSupported
+        ? Avx2.ShiftRightArithmeticVariable(vector, count.AsUInt32())
+        : Vector256.Create(ShiftRightArithmeticVariable(vector.GetLower(), count.GetLower()), ShiftRightArithmeticVariable(vector.GetUpper(), count.GetUpper()));
+
+    // Floating-point. x86 min and max return the right operand if either is NaN, or if they're equal.
+
+    public static Vector128<float> Max(Vector128<float> left, Vector128<float> right) => Sse.IsSupported
+        ? Sse.Max(left, right)
+        : Vector128.ConditionalSelect(Vector128.GreaterThan(left, right), left, right);
+
+    public static Vector128<float> Min(Vector128<float> left, Vector128<float> right) => Sse.IsSupported
+        ? Sse.Min(left, right)
+        : Vector128.ConditionalSelect(Vector128.LessThan(left, right), left, right);
+
+    public static Vector128<double> Max(Vector128<double> left, Vector128<double> right) => Sse2.IsSupported
+        ? Sse2.Max(left, right)
+        : Vector128.ConditionalSelect(Vector128.GreaterThan(left, right), left, right);
+
+    public static Vector128<double> Min(Vector128<double> left, Vector128<double> right) => Sse2.IsSupported
+        ? Sse2.Min(left, right)
+        : Vector128.ConditionalSelect(Vector128.LessThan(left, right), left, right);
+
+    public static Vector256<float> Max(Vector256<float> left, Vector256<float> right) => Avx.IsSupported
+        ? Avx.Max(left, right)
+        : Vector256.ConditionalSelect(Vector256.GreaterThan(left, right), left, right);
+
+    public static Vector256<float> Min(Vector256<float> left, Vector256<float> right) => Avx.IsSupported
+        ? Avx.Min(left, right)
+        : Vector256.ConditionalSelect(Vector256.LessThan(left, right), left, right);
+
+    public static Vector256<double> Max(Vector256<double> left, Vector256<double> right) => Avx.IsSupported
+        ? Avx.Max(left, right)
+        : Vector256.ConditionalSelect(Vector256.GreaterThan(left, right), left, right);
+
+    public static Vector256<double> Min(Vector256<double> left, Vector256<double> right) => Avx.IsSupported
+        ? Avx.Min(left, right)
+        : Vector256.ConditionalSelect(Vector256.LessThan(left, right), left, right);
+
+    /// <summary>
+    /// rcpps and rsqrtps are approximations whose exact results vary between processors.
+    /// </summary>
+    public static Vector128<float> Reciprocal(Vector128<float> vector) => Sse.IsSupported
+        ? Sse.Reciprocal(vector)
+        : Vector128<float>.One / vector;
+
+    public static Vector128<float> ReciprocalSqrt(Vector128<float> vector) => Sse.IsSupported
+        ? Sse.ReciprocalSqrt(vector)
+        : Vector128<float>.One / Vector128.Sqrt(vector);
+
+    public static Vector256<float> Reciprocal(Vector256<float> vector) => Avx.IsSupported
+        ? Avx.Reciprocal(vector)
+        : Vector256<float>.One / vector;
+
+    public static Vector256<float> ReciprocalSqrt(Vector256<float> vector) => Avx.IsSupported
+        ? Avx.ReciprocalSqrt(vector)
+        : Vector256<float>.One / Vector256.Sqrt(vector);
+
+    /// <summary>
+    /// roundps and roundpd: bits 0 and 1 of the control choose the rounding direction,
+    /// unless bit 2 is set, which means the current direction, which is to nearest.
+    /// </summary>
+    public static Vector128<float> Round(Vector128<float> vector, int control) => ((control & 4) != 0 ? 0 : control & 3) switch
+    {
+        0 => FloatingPointMath.Round(vector),
+        1 => Vector128.Floor(vector),
+        2 => Vector128.Ceiling(vector),
+        _ => FloatingPointMath.Truncate(vector),
+    };
+
+    public static Vector128<double> Round(Vector128<double> vector, int control) => ((control & 4) != 0 ? 0 : control & 3) switch
+    {
+        0 => FloatingPointMath.Round(vector),
+        1 => Vector128.Floor(vector),
+        2 => Vector128.Ceiling(vector),
+        _ => FloatingPointMath.Truncate(vector),
+    };
+
+    public static Vector256<float> Round(Vector256<float> vector, int control) => ((control & 4) != 0 ? 0 : control & 3) switch
+    {
+        0 => FloatingPointMath.Round(vector),
+        1 => Vector256.Floor(vector),
+        2 => Vector256.Ceiling(vector),
+        _ => FloatingPointMath.Truncate(vector),
+    };
+
+    public static Vector256<double> Round(Vector256<double> vector, int control) => ((control & 4) != 0 ? 0 : control & 3) switch
+    {
+        0 => FloatingPointMath.Round(vector),
+        1 => Vector256.Floor(vector),
+        2 => Vector256.Ceiling(vector),
+        _ => FloatingPointMath.Truncate(vector),
+    };
+
+    // Conversions. Values that are out of range, or NaN, become the minimum value of the integer type.
+
+    public static int ConvertToInt32(Vector128<float> vector) => Sse.IsSupported
+        ? Sse.ConvertToInt32(vector)
+        : ConvertToInt32(MathF.Round(vector.ToScalar()));
+
+    public static int ConvertToInt32WithTruncation(Vector128<float> vector) => Sse.IsSupported
+        ? Sse.ConvertToInt32WithTruncation(vector)
+        : ConvertToInt32(MathF.Truncate(vector.ToScalar()));
+
+    public static long ConvertToInt64(Vector128<float> vector) => Sse.X64.IsSupported
+        ? Sse.X64.ConvertToInt64(vector)
+        : ConvertToInt64(MathF.Round(vector.ToScalar()));
+
+    public static long ConvertToInt64WithTruncation(Vector128<float> vector) => Sse.X64.IsSupported
+        ? Sse.X64.ConvertToInt64WithTruncation(vector)
+        : ConvertToInt64(MathF.Truncate(vector.ToScalar()));
+
+    public static int ConvertToInt32(Vector128<double> vector) => Sse2.IsSupported
+        ? Sse2.ConvertToInt32(vector)
+        : ConvertToInt32(Math.Round(vector.ToScalar()));
+
+    public static int ConvertToInt32WithTruncation(Vector128<double> vector) => Sse2.IsSupported
+        ? Sse2.ConvertToInt32WithTruncation(vector)
+        : ConvertToInt32(Math.Truncate(vector.ToScalar()));
+
+    public static long ConvertToInt64(Vector128<double> vector) => Sse2.X64.IsSupported
+        ? Sse2.X64.ConvertToInt64(vector)
+        : ConvertToInt64(Math.Round(vector.ToScalar()));
+
+    public static long ConvertToInt64WithTruncation(Vector128<double> vector) => Sse2.X64.IsSupported
+        ? Sse2.X64.ConvertToInt64WithTruncation(vector)
+        : ConvertToInt64(Math.Truncate(vector.ToScalar()));
+
+    public static Vector128<int> ConvertToVector128Int32(Vector128<float> vector)
+    {
+        if (Sse2.IsSupported)
+        {
+            return Sse2.ConvertToVector128Int32(vector);
+        }
+
+        var rounded = FloatingPointMath.Round(vector);
+        return Vector128.Create(
+            ConvertToInt32(rounded.GetElement(0)),
+            ConvertToInt32(rounded.GetElement(1)),
+            ConvertToInt32(rounded.GetElement(2)),
+            ConvertToInt32(rounded.GetElement(3)));
+    }
+
+    public static Vector128<int> ConvertToVector128Int32WithTruncation(Vector128<float> vector)
+    {
+        if (Sse2.IsSupported)
+        {
+            return Sse2.ConvertToVector128Int32WithTruncation(vector);
+        }
+
+        var truncated = FloatingPointMath.Truncate(vector);
+        return Vector128.Create(
+            ConvertToInt32(truncated.GetElement(0)),
+            ConvertToInt32(truncated.GetElement(1)),
+            ConvertToInt32(truncated.GetElement(2)),
+            ConvertToInt32(truncated.GetElement(3)));
+    }
+
+    /// <summary>
+    /// cvtpd2dq puts the two results in the low elements, and zeroes the high ones.
+    /// </summary>
+    public static Vector128<int> ConvertToVector128Int32(Vector128<double> vector) => Sse2.IsSupported
+        ? Sse2.ConvertToVector128Int32(vector)
+        : Vector128.Create(ConvertToInt32(Math.Round(vector.GetElement(0))), ConvertToInt32(Math.Round(vector.GetElement(1))), 0, 0);
+
+    public static Vector128<int> ConvertToVector128Int32WithTruncation(Vector128<double> vector) => Sse2.IsSupported
+        ? Sse2.ConvertToVector128Int32WithTruncation(vector)
+        : Vector128.Create(ConvertToInt32(Math.Truncate(vector.GetElement(0))), ConvertToInt32(Math.Truncate(vector.GetElement(1))), 0, 0);
+
+    public static Vector256<int> ConvertToVector256Int32(Vector256<float> vector) => Avx.IsSupported
+        ? Avx.ConvertToVector256Int32(vector)
+        : Vector256.Create(ConvertToVector128Int32(vector.GetLower()), ConvertToVector128Int32(vector.GetUpper()));
+
+    public static Vector256<int> ConvertToVector256Int32WithTruncation(Vector256<float> vector) => Avx.IsSupported
+        ? Avx.ConvertToVector256Int32WithTruncation(vector)
+        : Vector256.Create(ConvertToVector128Int32WithTruncation(vector.GetLower()), ConvertToVector128Int32WithTruncation(vector.GetUpper()));
+
+    // Bit manipulation
+
+    /// <summary>
+    /// bextr: extracts the number of bits in bits 8 to 15 of the control, starting at the bit in bits 0 to 7.
+    /// </summary>
+    public static int BitFieldExtract(int value, int control)
+    {
+        if (Bmi1.IsSupported)
+        {
+            return (int)Bmi1.BitFieldExtract((uint)value, (ushort)control);
+        }
+
+        var start = control & 0xFF;
+        var length = (control >> 8) & 0xFF;
+        var shifted = start < 32 ? (uint)value >> start : 0;
+        return (int)(length < 32 ? shifted & ((1u << length) - 1) : shifted);
+    }
+
+    public static long BitFieldExtract(long value, long control)
+    {
+        if (Bmi1.X64.IsSupported)
+        {
+            return (long)Bmi1.X64.BitFieldExtract((ulong)value, (ushort)control);
+        }
+
+        var start = (int)(control & 0xFF);
+        var length = (int)((control >> 8) & 0xFF);
+        var shifted = start < 64 ? (ulong)value >> start : 0;
+        return (long)(length < 64 ? shifted & ((1ul << length) - 1) : shifted);
+    }
+
+    /// <summary>
+    /// bzhi: clears the bits from the index in bits 0 to 7 upwards.
+    /// </summary>
+    public static int ZeroHighBits(int value, int index)
+    {
+        if (Bmi2.IsSupported)
+        {
+            return (int)Bmi2.ZeroHighBits((uint)value, (uint)index);
+        }
+
+        index &= 0xFF;
+        return index < 32 ? value & (int)((1u << index) - 1) : value;
+    }
+
+    public static long ZeroHighBits(long value, long index)
+    {
+        if (Bmi2.X64.IsSupported)
+        {
+            return (long)Bmi2.X64.ZeroHighBits((ulong)value, (ulong)index);
+        }
+
+        index &= 0xFF;
+        return index < 64 ? value & (long)((1ul << (int)index) - 1) : value;
+    }
+
+    /// <summary>
+    /// pdep: puts the low bits of the value in the positions of the set bits of the mask.
+    /// </summary>
+    public static int ParallelBitDeposit(int value, int mask) => Bmi2.IsSupported
+        ? (int)Bmi2.ParallelBitDeposit((uint)value, (uint)mask)
+        : (int)ParallelBitDeposit((ulong)(uint)value, (ulong)(uint)mask);
+
+    public static long ParallelBitDeposit(long value, long mask) => Bmi2.X64.IsSupported
+        ? (long)Bmi2.X64.ParallelBitDeposit((ulong)value, (ulong)mask)
+        : (long)ParallelBitDeposit((ulong)value, (ulong)mask);
+
+    /// <summary>
+    /// pext: gathers the bits of the value in the positions of the set bits of the mask into the low bits.
+    /// </summary>
+    public static int ParallelBitExtract(int value, int mask) => Bmi2.IsSupported
+        ? (int)Bmi2.ParallelBitExtract((uint)value, (uint)mask)
+        : (int)ParallelBitExtract((ulong)(uint)value, (ulong)(uint)mask);
+
+    public static long ParallelBitExtract(long value, long mask) => Bmi2.X64.IsSupported
+        ? (long)Bmi2.X64.ParallelBitExtract((ulong)value, (ulong)mask)
+        : (long)ParallelBitExtract((ulong)value, (ulong)mask);
+
+    // Cryptography
+
+    /// <summary>
+    /// crc32: accumulates a CRC-32C (Castagnoli) checksum, without inverting it before or after.
+    /// </summary>
+    public static int Crc32(int crc, byte data) => Sse42.IsSupported
+        ? (int)Sse42.Crc32((uint)crc, data)
+        : (int)Crc32((uint)crc, data, 1);
+
+    public static int Crc32(int crc, short data) => Sse42.IsSupported
+        ? (int)Sse42.Crc32((uint)crc, (ushort)data)
+        : (int)Crc32((uint)crc, (ushort)data, 2);
+
+    public static int Crc32(int crc, int data) => Sse42.IsSupported
+        ? (int)Sse42.Crc32((uint)crc, (uint)data)
+        : (int)Crc32((uint)crc, (uint)data, 4);
+
+    public static long Crc32(long crc, long data) => Sse42.X64.IsSupported
+        ? (long)Sse42.X64.Crc32((ulong)crc, (ulong)data)
+        : Crc32((uint)crc, (ulong)data, 8);
+
+    public static Vector128<long> AesEncrypt(Vector128<long> state, Vector128<long> roundKey) => Aes.IsSupported
+        ? Aes.Encrypt(state.AsByte(), roundKey.AsByte()).AsInt64()
+        : MixColumns(SubstituteBytes(ShiftRows(state.AsByte()), SBox)).AsInt64() ^ roundKey;
+
+    public static Vector128<long> AesEncryptLast(Vector128<long> state, Vector128<long> roundKey) => Aes.IsSupported
+        ? Aes.EncryptLast(state.AsByte(), roundKey.AsByte()).AsInt64()
+        : SubstituteBytes(ShiftRows(state.AsByte()), SBox).AsInt64() ^ roundKey;
+
+    public static Vector128<long> AesDecrypt(Vector128<long> state, Vector128<long> roundKey) => Aes.IsSupported
+        ? Aes.Decrypt(state.AsByte(), roundKey.AsByte()).AsInt64()
+        : InverseMixColumns(SubstituteBytes(InverseShiftRows(state.AsByte()), InverseSBox)).AsInt64() ^ roundKey;
+
+    public static Vector128<long> AesDecryptLast(Vector128<long> state, Vector128<long> roundKey) => Aes.IsSupported
+        ? Aes.DecryptLast(state.AsByte(), roundKey.AsByte()).AsInt64()
+        : SubstituteBytes(InverseShiftRows(state.AsByte()), InverseSBox).AsInt64() ^ roundKey;
+
+    public static Vector128<long> AesInverseMixColumns(Vector128<long> state) => Aes.IsSupported
+        ? Aes.InverseMixColumns(state.AsByte()).AsInt64()
+        : InverseMixColumns(state.AsByte()).AsInt64();
+
+    /// <summary>
+    /// aeskeygenassist: substitutes the bytes of elements 1 and 3, and combines them with the round constant.
+    /// </summary>
+    public static Vector128<long> AesKeygenAssist(Vector128<long> key, byte roundConstant)
+    {
+        // The round constant isn't known when this is compiled, so it's combined separately,
+        // which lets the hardware path use a constant operand.
+        var roundConstants = Vector128.Create(0, roundConstant, 0, roundConstant).AsInt64();
+
+        if (Aes.IsSupported)
+        {
+            return Aes.KeygenAssist(key.AsByte(), 0).AsInt64() ^ roundConstants;
+        }
+
+        var words = SubstituteBytes(key.AsByte(), SBox).AsUInt32();
+        var x1 = words.GetElement(1);
+        var x3 = words.GetElement(3);
+        return Vector128.Create(x1, BitOperations.RotateRight(x1, 8), x3, BitOperations.RotateRight(x3, 8)).AsInt64() ^ roundConstants;
+    }
+
+    /// <summary>
+    /// pclmulqdq: the carry-less product of the 64-bit elements chosen by bits 0 and 4 of the control.
+    /// </summary>
+    public static Vector128<long> CarrylessMultiply(Vector128<long> left, Vector128<long> right, byte control)
+    {
+        if (Pclmulqdq.IsSupported)
+        {
+            return (control & 0x11) switch
+            {
+                0x00 => Pclmulqdq.CarrylessMultiply(left, right, 0x00),
+                0x01 => Pclmulqdq.CarrylessMultiply(left, right, 0x01),
+                0x10 => Pclmulqdq.CarrylessMultiply(left, right, 0x10),
+                _ => Pclmulqdq.CarrylessMultiply(left, right, 0x11),
+            };
+        }
+
+        var multiplicand = (ulong)left.GetElement(control & 1);
+        var multiplier = (ulong)right.GetElement((control >> 4) & 1);
+
+        UInt128 product = 0;
+        for (var i = 0; multiplier != 0; i++, multiplier >>= 1)
+        {
+            if ((multiplier & 1) != 0)
+            {
+                product ^= (UInt128)multiplicand << i;
+            }
+        }
+
+        return Vector128.Create((long)(ulong)product, (long)(ulong)(product >> 64));
+    }
+
+    // Memory ordering
+
+    public static void LoadFence()
+    {
+        if (Sse2.IsSupported)
+        {
+            Sse2.LoadFence();
+        }
+        else
+        {
+            Interlocked.MemoryBarrier();
+        }
+    }
+
+    public static void MemoryFence()
+    {
+        if (Sse2.IsSupported)
+        {
+            Sse2.MemoryFence();
+        }
+        else
+        {
+            Interlocked.MemoryBarrier();
+        }
+    }
+
+    public static void StoreFence()
+    {
+        if (Sse.IsSupported)
+        {
+            Sse.StoreFence();
+        }
+        else
+        {
+            Interlocked.MemoryBarrier();
+        }
+    }
+
+    public static void Pause() => Thread.SpinWait(1);
+
+    // Helpers
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<T> Clamp<T>(Vector128<T> vector, T minimum, T maximum)
+        => Vector128.Min(Vector128.Max(vector, Vector128.Create(minimum)), Vector128.Create(maximum));
+
+    /// <summary>
+    /// Adds each pair of adjacent elements, with the sums from the left operand followed by those from the right.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<int> AddAdjacent(Vector128<int> left, Vector128<int> right)
+    {
+        var (evens, odds) = Deinterleave(left, right);
+        return evens + odds;
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<int> AddAdjacent((Vector128<int> Lower, Vector128<int> Upper) halves) => AddAdjacent(halves.Lower, halves.Upper);
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<int> SubtractAdjacent(Vector128<int> left, Vector128<int> right)
+    {
+        var (evens, odds) = Deinterleave(left, right);
+        return evens - odds;
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<int> SubtractAdjacent((Vector128<int> Lower, Vector128<int> Upper) halves) => SubtractAdjacent(halves.Lower, halves.Upper);
+
+    /// <summary>
+    /// Splits the elements of two vectors into the even-numbered ones and the odd-numbered ones.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static (Vector128<int> Evens, Vector128<int> Odds) Deinterleave(Vector128<int> left, Vector128<int> right)
+    {
+        var indices = Vector128.Create(0, 2, 1, 3);
+        var leftSorted = Vector128.Shuffle(left, indices);
+        var rightSorted = Vector128.Shuffle(right, indices);
+        return (
+            Vector128.Create(leftSorted.GetLower(), rightSorted.GetLower()),
+            Vector128.Create(leftSorted.GetUpper(), rightSorted.GetUpper()));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<T> Sign<T>(Vector128<T> left, Vector128<T> right)
+        where T : unmanaged
+    {
+        var result = Vector128.ConditionalSelect(Vector128.LessThan(right, Vector128<T>.Zero), -left, left);
+        return Vector128.AndNot(result, Vector128.Equals(right, Vector128<T>.Zero));
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static int GetShiftCount<T>(Vector128<T> count)
+        where T : unmanaged => (int)Math.Min(count.AsUInt64().ToScalar(), 255);
+
+    private static int ShiftLeftLogical(int value, int count) => (uint)count < 32 ? value << count : 0;
+
+    private static long ShiftLeftLogical(long value, long count) => (ulong)count < 64 ? value << (int)count : 0;
+
+    private static int ShiftRightLogical(int value, int count) => (uint)count < 32 ? value >>> count : 0;
+
+    private static long ShiftRightLogical(long value, long count) => (ulong)count < 64 ? value >>> (int)count : 0;
+
+    private static int ConvertToInt32(float value) => value >= -2147483648f && value < 2147483648f ? (int)value : int.MinValue;
+
+    private static int ConvertToInt32(double value) => value > -2147483649.0 && value < 2147483648.0 ? (int)value : int.MinValue;
+
+    private static long ConvertToInt64(double value) => value >= -9223372036854775808.0 && value < 9223372036854775808.0 ? (long)value : long.MinValue;
+
+    private static readonly uint[] Crc32Table = CreateCrc32Table();
+
+    private static uint[] CreateCrc32Table()
+    {
+        var table = new uint[256];
+        for (var i = 0u; i < 256; i++)
+        {
+            var crc = i;
+            for (var bit = 0; bit < 8; bit++)
+            {
+                crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1)));
+            }
+            table[i] = crc;
+        }
+        return table;
+    }
+
+    private static uint Crc32(uint crc, ulong data, int byteCount)
+    {
+        for (var i = 0; i < byteCount; i++, data >>= 8)
+        {
+            crc = (crc >> 8) ^ Crc32Table[(byte)(crc ^ data)];
+        }
+        return crc;
+    }
+
+    private static readonly byte[] SBox = CreateSBox();
+
+    private static readonly byte[] InverseSBox = CreateInverseSBox();
+
+    /// <summary>
+    /// Builds the S-box by stepping through the multiplicative group of GF(2^8) with generator 3,
+    /// tracking each element's inverse alongside it, and applying the affine transformation.
+    /// </summary>
+    private static byte[] CreateSBox()
+    {
+        var sbox = new byte[256];
+        sbox[0] = 0x63;
+
+        byte element = 1;
+        byte inverse = 1;
+        do
+        {
+            element = (byte)(element ^ (element << 1) ^ ((element & 0x80) != 0 ? 0x1B : 0));
+
+            inverse ^= (byte)(inverse << 1);
+            inverse ^= (byte)(inverse << 2);
+            inverse ^= (byte)(inverse << 4);
+            if ((inverse & 0x80) != 0)
+            {
+                inverse ^= 0x09;
+            }
+
+            sbox[element] = (byte)(inverse
+                ^ byte.RotateLeft(inverse, 1)
+                ^ byte.RotateLeft(inverse, 2)
+                ^ byte.RotateLeft(inverse, 3)
+                ^ byte.RotateLeft(inverse, 4)
+                ^ 0x63);
+        }
+        while (element != 1);
+
+        return sbox;
+    }
+
+    private static byte[] CreateInverseSBox()
+    {
+        var inverseSBox = new byte[256];
+        for (var i = 0; i < 256; i++)
+        {
+            inverseSBox[SBox[i]] = (byte)i;
+        }
+        return inverseSBox;
+    }
+
+    private static Vector128<byte> SubstituteBytes(Vector128<byte> state, byte[] sbox)
+    {
+        for (var i = 0; i < Vector128<byte>.Count; i++)
+        {
+            state = state.WithElement(i, sbox[state.GetElement(i)]);
+        }
+        return state;
+    }
+
+    // The state is stored column by column, so byte 4c + r is in row r and column c.
+    // Row r is rotated left by r columns.
+    private static Vector128<byte> ShiftRows(Vector128<byte> state)
+        => Vector128.Shuffle(state, Vector128.Create((byte)0, 5, 10, 15, 4, 9, 14, 3, 8, 13, 2, 7, 12, 1, 6, 11));
+
+    private static Vector128<byte> InverseShiftRows(Vector128<byte> state)
+        => Vector128.Shuffle(state, Vector128.Create((byte)0, 13, 10, 7, 4, 1, 14, 11, 8, 5, 2, 15, 12, 9, 6, 3));
+
+    private static Vector128<byte> MixColumns(Vector128<byte> state)
+        => MixColumns(state, 2, 3, 1, 1);
+
+    private static Vector128<byte> InverseMixColumns(Vector128<byte> state)
+        => MixColumns(state, 14, 11, 13, 9);
+
+    /// <summary>
+    /// Multiplies each column by the circulant matrix whose first row is the given coefficients.
+    /// </summary>
+    private static Vector128<byte> MixColumns(Vector128<byte> state, byte c0, byte c1, byte c2, byte c3)
+    {
+        var result = state;
+        for (var column = 0; column < 16; column += 4)
+        {
+            var a0 = state.GetElement(column);
+            var a1 = state.GetElement(column + 1);
+            var a2 = state.GetElement(column + 2);
+            var a3 = state.GetElement(column + 3);
+            result = result
+                .WithElement(column, (byte)(GaloisMultiply(a0, c0) ^ GaloisMultiply(a1, c1) ^ GaloisMultiply(a2, c2) ^ GaloisMultiply(a3, c3)))
+                .WithElement(column + 1, (byte)(GaloisMultiply(a0, c3) ^ GaloisMultiply(a1, c0) ^ GaloisMultiply(a2, c1) ^ GaloisMultiply(a3, c2)))
+                .WithElement(column + 2, (byte)(GaloisMultiply(a0, c2) ^ GaloisMultiply(a1, c3) ^ GaloisMultiply(a2, c0) ^ GaloisMultiply(a3, c1)))
+                .WithElement(column + 3, (byte)(GaloisMultiply(a0, c1) ^ GaloisMultiply(a1, c2) ^ GaloisMultiply(a2, c3) ^ GaloisMultiply(a3, c0)));
+        }
+        return result;
+    }
+
+    private static byte GaloisMultiply(byte left, byte right)
+    {
+        var result = 0;
+        int a = left;
+        for (int b = right; b != 0; b >>= 1)
+        {
+            if ((b & 1) != 0)
+            {
+                result ^= a;
+            }
+            a = (a << 1) ^ ((a & 0x80) != 0 ? 0x11B : 0);
+        }
+        return (byte)result;
+    }
+
+    private static ulong ParallelBitDeposit(ulong value, ulong mask)
+    {
+        var result = 0ul;
+        for (var bit = 1ul; mask != 0; bit <<= 1)
+        {
+            if ((value & bit) != 0)
+            {
+                result |= mask & (~mask + 1);
+            }
+            mask &= mask - 1;
+        }
+        return result;
+    }
+
+    private static ulong ParallelBitExtract(ulong value, ulong mask)
+    {
+        var result = 0ul;
+        for (var bit = 1ul; mask != 0; bit <<= 1)
+        {
+            if ((value & mask & (~mask + 1)) != 0)
+            {
+                result |= bit;
+            }
+            mask &= mask - 1;
+        }
+        return result;
+    }
+}
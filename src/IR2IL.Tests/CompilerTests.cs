@@ -4,6 +4,7 @@ using System.Diagnostics;
 using System.IO;
 using System.Linq;
 using System.Reflection;
+using System.Runtime.Loader;
 using System.Text;
 using System.Text.RegularExpressions;
 using Microsoft.VisualStudio.TestTools.UnitTesting;
@@ -17,6 +18,23 @@ public partial class CompilerTests
     private static readonly string TestProgramsPath = Path.Combine(RepoRoot, "tests");
     private static readonly string ClangPath = Path.Combine(RepoRoot, "lib", "clang", "win-x64", "clang.exe");
 
+    /// <summary>
+    /// The instruction set tiers that IR2IL.Runtime has separate code paths for, from the widest down, and the
+    /// runtime settings that select them, which are passed as <c>DOTNET_*</c> variables. The narrower tiers turn off
+    /// the instruction sets above them, which also turns off everything that depends on them, so one x64 machine
+    /// with AVX-512 can run them all. The AVX-512 tier also makes 512-bit vectors the preferred width, which
+    /// the runtime doesn't do by default on some processors that have AVX-512, and is the same as AVX2 on those
+    /// that don't have it.
+    /// </summary>
+    private static readonly (string Name, (string Name, string Value)[] RuntimeSettings)[] InstructionSetTiers =
+    [
+        ("AVX-512", [("EnableAVX512F", "1"), ("PreferredVectorBitWidth", "512")]),
+        ("AVX2", [("EnableAVX512F", "0")]),
+        ("SSE4.1", [("EnableAVX", "0"), ("EnableSSE42", "0")]),
+        ("Vector128", [("EnableSSE3", "0")]),
+        ("Scalar", [("EnableHWIntrinsic", "0")]),
+    ];
+
     private static IEnumerable<object[]> TestFiles(IEnumerable<string> testFiles)
     {
         var optimizationLevels = new string[]
@@ -35,20 +53,19 @@ public partial class CompilerTests
         return $"{methodInfo.Name}({Path.GetFileName((string)values[0])}, {values[1]})";
     }
 
+    /// <summary>
+    /// C and C++ programs, and hand-written LLVM IR for what clang doesn't emit, which clang compiles the same way.
+    /// </summary>
     private static IEnumerable<object[]> TestDataArbitrary() => TestFiles(
         Directory.GetFiles(Path.Combine(TestProgramsPath, "arbitrary"), "*.c", SearchOption.AllDirectories)
-        .Concat(Directory.GetFiles(Path.Combine(TestProgramsPath, "arbitrary"), "*.cpp", SearchOption.AllDirectories)));
+        .Concat(Directory.GetFiles(Path.Combine(TestProgramsPath, "arbitrary"), "*.cpp", SearchOption.AllDirectories))
+        .Concat(Directory.GetFiles(Path.Combine(TestProgramsPath, "arbitrary"), "*.ll", SearchOption.AllDirectories)));
 
     [TestMethod]
     [DynamicData(nameof(TestDataArbitrary), DynamicDataSourceType.Method, DynamicDataDisplayName = nameof(TestDataDisplayName))]
     public void Arbitrary(string testName, string optimizationLevel)
     {
-        CompileAndExecuteManaged(
-            testName,
-            optimizationLevel,
-            out var managedExitCode,
-            out var managedStandardOutput,
-            out var managedStandardError);
+        var managedExePath = CompileManaged(testName, optimizationLevel);
 
         // Compile to executable binary.
         var binaryPath = GetOutputPath(testName, optimizationLevel) + "_native.exe";
@@ -61,12 +78,70 @@ public partial class CompilerTests
             out var llvmStandardOutput,
             out var llvmStandardError);
 
-        Assert.AreEqual(llvmStandardError, managedStandardError);
-        Assert.AreEqual(llvmStandardOutput, managedStandardOutput);
-        Assert.AreEqual(llvmExitCode, managedExitCode);
+        // Every instruction set tier has to give the same results.
+        foreach (var (tierName, runtimeSettings) in InstructionSetTiers)
+        {
+            ExecuteManaged(
+                managedExePath,
+                runtimeSettings,
+                out var managedExitCode,
+                out var managedStandardOutput,
+                out var managedStandardError);
+
+            Assert.AreEqual(llvmStandardError, managedStandardError, tierName);
+            Assert.AreEqual(llvmStandardOutput, managedStandardOutput, tierName);
+            Assert.AreEqual(llvmExitCode, managedExitCode, tierName);
+
+            Console.WriteLine($"ExitCode ({tierName}): {managedExitCode}");
+        }
 
-        Console.WriteLine($"ExitCode: {managedExitCode}");
-        Console.WriteLine($"Stdout: {managedStandardOutput}");
+        Console.WriteLine($"Stdout: {llvmStandardOutput}");
+    }
+
+    [TestMethod]
+    public void FunctionAttributes()
+    {
+        var warnings = new List<string>();
+
+        var managedExePath = CompileManaged(
+            Path.Combine(TestProgramsPath, "arbitrary", "function_attributes.c"),
+            "O3",
+            new CompilerOptions { WarningHandler = warnings.Add });
+
+        CollectionAssert.AreEqual(Array.Empty<string>(), warnings);
+
+        var expectedAttributes = new Dictionary<string, MethodImplAttributes>
+        {
+            ["square"] = MethodImplAttributes.AggressiveInlining,
+            ["cube"] = MethodImplAttributes.AggressiveInlining,
+            ["sum_of_squares"] = MethodImplAttributes.NoInlining,
+            ["report_error"] = MethodImplAttributes.NoInlining,
+            ["sum_of_cubes"] = MethodImplAttributes.AggressiveOptimization,
+            ["smallest"] = 0,
+        };
+
+        // Loaded from a stream so that the file isn't locked afterwards.
+        var loadContext = new AssemblyLoadContext(nameof(FunctionAttributes), isCollectible: true);
+        try
+        {
+            using var stream = File.OpenRead(managedExePath);
+            var programType = loadContext.LoadFromStream(stream).GetType("Program", throwOnError: true)!;
+
+            foreach (var (name, expected) in expectedAttributes)
+            {
+                var method = programType.GetMethod(name, BindingFlags.Public | BindingFlags.Static)
+                    ?? throw new InvalidOperationException($"Method {name} not found");
+
+                var actual = method.MethodImplementationFlags
+                    & (MethodImplAttributes.AggressiveInlining | MethodImplAttributes.NoInlining | MethodImplAttributes.AggressiveOptimization);
+
+                Assert.AreEqual(expected, actual, name);
+            }
+        }
+        finally
+        {
+            loadContext.Unload();
+        }
     }
 
     private static IEnumerable<object[]> TestDataCTestSuite() => TestFiles(
@@ -200,38 +275,139 @@ public partial class CompilerTests
     [DynamicData(nameof(TestDataBenchmarks), DynamicDataSourceType.Method, DynamicDataDisplayName = nameof(TestDataDisplayName))]
     public void Benchmark(string testName, string optimizationLevel)
     {
-        var managedExePath = CompileManaged(testName, optimizationLevel);
-
         // Compile to executable binary.
         var binaryPath = GetOutputPath(testName, optimizationLevel) + "_native.exe";
         RunClang([GetSourceFilePath(testName), "-o", binaryPath, $"-{optimizationLevel}"]);
 
         var stopwatch = Stopwatch.StartNew();
 
-        RunProgram(
-            "dotnet",
-            [managedExePath],
-            out var managedExitCode,
-            out var managedStandardOutput,
-            out var managedStandardError);
-
-        Console.WriteLine($"Managed: {stopwatch.Elapsed}");
-
-        stopwatch.Restart();
-
         RunProgram(
             binaryPath,
             [],
             out var llvmExitCode,
             out var llvmStandardOutput,
-            out _);
+            out var llvmStandardError);
 
-        Console.WriteLine($"Native:  {stopwatch.Elapsed}");
+        Console.WriteLine($"Native:  {stopwatch.Elapsed} ({FormatBenchmarkRounds(llvmStandardError)})");
 
-        Assert.AreEqual(llvmExitCode, managedExitCode, managedStandardError);
-        Assert.AreEqual(llvmStandardOutput, managedStandardOutput);
+        // These are short-running programs, so the total time is dominated by
+        // how quickly the hot loops reach fully optimized code. The benchmarks run
+        // several rounds, so the first round shows that, and the later ones show the steady state.
+        var timesToSteadyState = new Dictionary<TieringPolicy, int>();
 
-        Console.WriteLine($"Stdout: {managedStandardOutput}");
+        foreach (var tieringPolicy in Enum.GetValues<TieringPolicy>())
+        {
+            var managedExePath = CompileManaged(
+                testName,
+                optimizationLevel,
+                new CompilerOptions { TieringPolicy = tieringPolicy });
+
+            stopwatch.Restart();
+
+            RunProgram(
+                "dotnet",
+                [managedExePath],
+                out var managedExitCode,
+                out var managedStandardOutput,
+                out var managedStandardError);
+
+            Console.WriteLine($"Managed ({tieringPolicy}): {stopwatch.Elapsed} ({FormatBenchmarkRounds(managedStandardError)})");
+
+            Assert.AreEqual(llvmExitCode, managedExitCode, managedStandardError);
+            Assert.AreEqual(llvmStandardOutput, managedStandardOutput);
+
+            timesToSteadyState[tieringPolicy] = GetTimeToSteadyState(managedStandardError);
+        }
+
+        foreach (var (tieringPolicy, time) in timesToSteadyState)
+        {
+            Console.WriteLine($"Time to steady state ({tieringPolicy}): {time} ms");
+        }
+
+        // Time the runtime's code paths for each instruction set tier too, with the default tiering policy.
+        var defaultManagedExePath = CompileManaged(testName, optimizationLevel);
+        var steadyStateTimes = new Dictionary<string, int>();
+
+        foreach (var (tierName, runtimeSettings) in InstructionSetTiers)
+        {
+            stopwatch.Restart();
+
+            ExecuteManaged(
+                defaultManagedExePath,
+                runtimeSettings,
+                out var managedExitCode,
+                out var managedStandardOutput,
+                out var managedStandardError);
+
+            Console.WriteLine($"Managed ({tierName}): {stopwatch.Elapsed} ({FormatBenchmarkRounds(managedStandardError)})");
+
+            Assert.AreEqual(llvmExitCode, managedExitCode, managedStandardError);
+            Assert.AreEqual(llvmStandardOutput, managedStandardOutput, tierName);
+
+            steadyStateTimes[tierName] = GetSteadyStateTime(managedStandardError);
+        }
+
+        // How much each tier's SIMD code paths are worth, compared to doing everything one element at a time.
+        var scalarTime = steadyStateTimes["Scalar"];
+        foreach (var (tierName, time) in steadyStateTimes)
+        {
+            var speedup = time > 0 ? $"{(double)scalarTime / time:F2}x" : "too fast to measure";
+            Console.WriteLine($"Speedup over Scalar ({tierName}): {speedup}");
+        }
+
+        Console.WriteLine($"Stdout: {llvmStandardOutput}");
+    }
+
+    [GeneratedRegex(@"round \d+: (\d+) ms")]
+    private static partial Regex BenchmarkRoundRegex();
+
+    /// <summary>
+    /// Summarizes the round times that the benchmarks write to stderr: the first round, which includes
+    /// JIT compilation, and the fastest of the others, which is the steady state.
+    /// </summary>
+    private static string FormatBenchmarkRounds(string standardError)
+    {
+        var roundTimes = GetBenchmarkRoundTimes(standardError);
+        return $"first round: {roundTimes[0]} ms, steady state: {GetSteadyStateTime(standardError)} ms";
+    }
+
+    private static int GetSteadyStateTime(string standardError) => GetBenchmarkRoundTimes(standardError).Skip(1).Min();
+
+    /// <summary>
+    /// How long the benchmark ran before a round first came within 10% of the steady state,
+    /// including that round, which is how long the tiering policy took to get the hot loops to optimized code.
+    /// </summary>
+    private static int GetTimeToSteadyState(string standardError)
+    {
+        var roundTimes = GetBenchmarkRoundTimes(standardError);
+        var steadyStateTime = GetSteadyStateTime(standardError);
+
+        var time = 0;
+        foreach (var roundTime in roundTimes)
+        {
+            time += roundTime;
+            if (roundTime <= steadyStateTime * 1.1)
+            {
+                break;
+            }
+        }
+
+        return time;
+    }
+
+    private static List<int> GetBenchmarkRoundTimes(string standardError)
+    {
+        var roundTimes = BenchmarkRoundRegex()
+            .Matches(standardError)
+            .Select(x => int.Parse(x.Groups[1].Value))
+            .ToList();
+
+        if (roundTimes.Count < 2)
+        {
+            throw new InvalidOperationException($"Expected at least two benchmark rounds: {standardError}");
+        }
+
+        return roundTimes;
     }
 
     private static string GetOutputPath(string testName, string optimizationLevel)
@@ -263,16 +439,26 @@ public partial class CompilerTests
     }
 
     private static string CompileManaged(string testName, string optimizationLevel)
+    {
+        return CompileManaged(testName, optimizationLevel, CompilerOptions.Default);
+    }
+
+    private static string CompileManaged(string testName, string optimizationLevel, CompilerOptions options)
     {
         var fullTestName = GetOutputPath(testName, optimizationLevel);
 
+        if (options.TieringPolicy != TieringPolicy.Default)
+        {
+            fullTestName += $"_{options.TieringPolicy}";
+        }
+
         var irPath = fullTestName + ".ll";
 
         // Compile to LLVM IR.
         RunClang([GetSourceFilePath(testName), "-g", "-o", irPath, "-emit-llvm", "-S", $"-{optimizationLevel}"]);
 
         var outputPath = $"{fullTestName}.exe";
-        Compiler.Compile(irPath, outputPath);
+        Compiler.Compile(irPath, outputPath, options);
 
         return outputPath;
     }
@@ -282,10 +468,26 @@ public partial class CompilerTests
         out int managedExitCode,
         out string managedStandardOutput,
         out string managedStandardError)
+    {
+        ExecuteManaged(
+            managedExePath,
+            [],
+            out managedExitCode,
+            out managedStandardOutput,
+            out managedStandardError);
+    }
+
+    private static void ExecuteManaged(
+        string managedExePath,
+        (string Name, string Value)[] runtimeSettings,
+        out int managedExitCode,
+        out string managedStandardOutput,
+        out string managedStandardError)
     {
         RunProgram(
             "dotnet",
             [managedExePath],
+            runtimeSettings.Select(x => new KeyValuePair<string, string>($"DOTNET_{x.Name}", x.Value)),
             out managedExitCode,
             out managedStandardOutput,
             out managedStandardError);
@@ -297,6 +499,23 @@ public partial class CompilerTests
         out int exitCode,
         out string standardOutput,
         out string standardError)
+    {
+        RunProgram(
+            executablePath,
+            arguments,
+            [],
+            out exitCode,
+            out standardOutput,
+            out standardError);
+    }
+
+    private static void RunProgram(
+        string executablePath,
+        string[] arguments,
+        IEnumerable<KeyValuePair<string, string>> environmentVariables,
+        out int exitCode,
+        out string standardOutput,
+        out string standardError)
     {
         var startInfo = new ProcessStartInfo
         {
@@ -310,6 +529,11 @@ public partial class CompilerTests
             startInfo.ArgumentList.Add(argument);
         }
 
+        foreach (var (name, value) in environmentVariables)
+        {
+            startInfo.Environment[name] = value;
+        }
+
         using var process = new Process
         {
             StartInfo = startInfo,
@@ -0,0 +1,227 @@
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using LLVMSharp.Interop;
+
+namespace IR2IL.Analysis;
+
+/// <summary>
+/// A basic block as it appears in the emitted method. A block only has more than one copy
+/// if it was split to make an irreducible loop reducible.
+/// </summary>
+internal sealed record BlockNode(LLVMBasicBlockRef Block, int Copy);
+
+/// <summary>
+/// Decides the order in which basic blocks are emitted.
+/// </summary>
+/// <remarks>
+/// RyuJIT only optimizes loops that it recognizes, so every loop is laid out as a contiguous
+/// run of blocks starting with its header, and the blocks of each loop are ordered so that
+/// most branches go forwards. Irreducible loops, which C can produce with goto, are made
+/// reducible by duplicating the blocks where they can be entered other than the header.
+/// </remarks>
+internal sealed class BlockLayout
+{
+    // Stop splitting nodes once the function has grown by this factor,
+    // and emit whatever irreducible loops are left as they are.
+    private const int MaxSplitGrowthFactor = 4;
+
+    private readonly Dictionary<BlockNode, Dictionary<LLVMBasicBlockRef, BlockNode>> _targets = [];
+    private readonly Dictionary<LLVMBasicBlockRef, int> _copyCounts = [];
+
+    public BlockLayout(LLVMValueRef function)
+    {
+        Entry = new BlockNode(function.EntryBasicBlock, 0);
+
+        foreach (var basicBlock in function.BasicBlocks)
+        {
+            _targets.Add(
+                new BlockNode(basicBlock, 0),
+                ControlFlowGraph.GetSuccessors(basicBlock)
+                    .Distinct()
+                    .ToDictionary(x => x, x => new BlockNode(x, 0)));
+
+            _copyCounts.Add(basicBlock, 1);
+        }
+
+        var graph = CreateGraph();
+
+        var maxNodeCount = _targets.Count * MaxSplitGrowthFactor;
+        while (_targets.Count < maxNodeCount && graph.TryGetIrreducibleEdge(out _, out var target))
+        {
+            SplitEntries(graph, target);
+            graph = CreateGraph();
+        }
+
+        var result = new List<BlockNode>();
+        var placed = new HashSet<BlockNode>();
+
+        LayOutRegion(graph, Entry, graph.ReversePostOrder.ToHashSet(), result, placed);
+
+        // Only reachable if loops overlap, which can happen if we gave up splitting nodes.
+        result.AddRange(graph.ReversePostOrder.Where(placed.Add));
+
+        Nodes = result;
+    }
+
+    public BlockNode Entry { get; }
+
+    /// <summary>
+    /// The reachable blocks in the order they should be emitted.
+    /// </summary>
+    public IReadOnlyList<BlockNode> Nodes { get; }
+
+    /// <summary>
+    /// Gets the node that the terminator of <paramref name="from"/> branches to for <paramref name="target"/>.
+    /// </summary>
+    public BlockNode GetTarget(BlockNode from, LLVMBasicBlockRef target) => _targets[from][target];
+
+    private ControlFlowGraph<BlockNode> CreateGraph()
+    {
+        return new ControlFlowGraph<BlockNode>(
+            Entry,
+            _targets.Keys,
+            x => _targets[x].Values);
+    }
+
+    private void SplitEntries(ControlFlowGraph<BlockNode> graph, BlockNode target)
+    {
+        // Find the strongly connected region containing the target, ignoring the target's
+        // dominators so that we don't pick up any reducible loops it's nested in.
+        bool IsCandidate(BlockNode node) => graph.IsReachable(node) && (node == target || !graph.Dominates(node, target));
+
+        var region = GetReachable(target, graph.GetSuccessors, IsCandidate);
+        region.IntersectWith(GetReachable(target, graph.GetPredecessors, IsCandidate));
+
+        var entries = region
+            .Where(x => graph.GetPredecessors(x).Any(p => graph.IsReachable(p) && !region.Contains(p)))
+            .OrderBy(graph.GetReversePostOrderIndex)
+            .ToList();
+
+        // Keep the first entry as the loop header, and give every other entry a copy
+        // that is only reachable from outside the region. That moves the extra entries
+        // one step further into the region, so repeating this eventually leaves just the header.
+        foreach (var entry in entries.Skip(1))
+        {
+            var copy = new BlockNode(entry.Block, _copyCounts[entry.Block]++);
+            _targets.Add(copy, new Dictionary<LLVMBasicBlockRef, BlockNode>(_targets[entry]));
+
+            foreach (var predecessor in graph.GetPredecessors(entry))
+            {
+                if (region.Contains(predecessor))
+                {
+                    continue;
+                }
+
+                _targets[predecessor][entry.Block] = copy;
+            }
+        }
+    }
+
+    private static HashSet<BlockNode> GetReachable(
+        BlockNode start,
+        Func<BlockNode, IReadOnlyList<BlockNode>> getNext,
+        Func<BlockNode, bool> filter)
+    {
+        var result = new HashSet<BlockNode> { start };
+        var worklist = new Stack<BlockNode>();
+        worklist.Push(start);
+
+        while (worklist.Count > 0)
+        {
+            foreach (var next in getNext(worklist.Pop()))
+            {
+                if (filter(next) && result.Add(next))
+                {
+                    worklist.Push(next);
+                }
+            }
+        }
+
+        return result;
+    }
+
+    private static void LayOutRegion(
+        ControlFlowGraph<BlockNode> graph,
+        BlockNode header,
+        IReadOnlySet<BlockNode> region,
+        List<BlockNode> result,
+        HashSet<BlockNode> placed)
+    {
+        // Collapse each loop directly inside this region into its header,
+        // so that it's laid out as one contiguous run of blocks.
+        var innerLoopHeaders = new HashSet<BlockNode>();
+        var representatives = new Dictionary<BlockNode, BlockNode>();
+
+        foreach (var loop in graph.Loops)
+        {
+            if (loop.Header == header || !region.Contains(loop.Header) || representatives.ContainsKey(loop.Header))
+            {
+                continue;
+            }
+
+            innerLoopHeaders.Add(loop.Header);
+
+            foreach (var node in loop.Nodes)
+            {
+                if (region.Contains(node))
+                {
+                    representatives.TryAdd(node, loop.Header);
+                }
+            }
+        }
+
+        BlockNode GetRepresentative(BlockNode node) => representatives.GetValueOrDefault(node, node);
+
+        var members = region
+            .Where(graph.IsReachable)
+            .GroupBy(GetRepresentative)
+            .ToDictionary(x => x.Key, x => x.ToList());
+
+        IEnumerable<BlockNode> GetSuccessors(BlockNode representative) => members[representative]
+            .SelectMany(x => graph.GetSuccessors(x).Reverse())
+            .Where(x => region.Contains(x) && x != header)
+            .Select(GetRepresentative)
+            .Where(x => x != representative);
+
+        // Reverse postorder over the collapsed graph. Successors are visited in reverse
+        // so that the first successor of a block is laid out straight after it.
+        var postOrder = new List<BlockNode>();
+        var visited = new HashSet<BlockNode> { header };
+        var stack = new Stack<(BlockNode Node, IEnumerator<BlockNode> Successors)>();
+
+        stack.Push((header, GetSuccessors(header).GetEnumerator()));
+
+        while (stack.Count > 0)
+        {
+            var (node, successors) = stack.Peek();
+
+            if (successors.MoveNext())
+            {
+                if (visited.Add(successors.Current))
+                {
+                    stack.Push((successors.Current, GetSuccessors(successors.Current).GetEnumerator()));
+                }
+            }
+            else
+            {
+                stack.Pop();
+                postOrder.Add(node);
+            }
+        }
+
+        for (var i = postOrder.Count - 1; i >= 0; i--)
+        {
+            var node = postOrder[i];
+
+            if (node != header && innerLoopHeaders.Contains(node))
+            {
+                LayOutRegion(graph, node, members[node].ToHashSet(), result, placed);
+            }
+            else if (placed.Add(node))
+            {
+                result.Add(node);
+            }
+        }
+    }
+}
@@ -0,0 +1,299 @@
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using LLVMSharp.Interop;
+
+namespace IR2IL.Analysis;
+
+internal static class ControlFlowGraph
+{
+    public static ControlFlowGraph<LLVMBasicBlockRef> Create(LLVMValueRef function)
+    {
+        return new ControlFlowGraph<LLVMBasicBlockRef>(
+            function.EntryBasicBlock,
+            function.BasicBlocks,
+            GetSuccessors);
+    }
+
+    public static IEnumerable<LLVMBasicBlockRef> GetSuccessors(LLVMBasicBlockRef basicBlock)
+    {
+        var terminator = basicBlock.Terminator;
+
+        for (var i = 0u; i < terminator.SuccessorsCount; i++)
+        {
+            yield return terminator.GetSuccessor(i);
+        }
+    }
+}
+
+/// <summary>
+/// Successors, predecessors, dominators and natural loops for the nodes of a control flow graph.
+/// Nodes that aren't reachable from the entry node are ignored.
+/// </summary>
+internal sealed class ControlFlowGraph<TNode>
+    where TNode : notnull
+{
+    private static readonly EqualityComparer<TNode> Comparer = EqualityComparer<TNode>.Default;
+
+    private readonly Dictionary<TNode, List<TNode>> _successors = [];
+    private readonly Dictionary<TNode, List<TNode>> _predecessors = [];
+    private readonly Dictionary<TNode, int> _reversePostOrderIndices = [];
+    private readonly Dictionary<TNode, TNode> _immediateDominators = [];
+    private readonly Dictionary<TNode, int> _loopDepths = [];
+
+    public ControlFlowGraph(TNode entry, IEnumerable<TNode> nodes, Func<TNode, IEnumerable<TNode>> getSuccessors)
+    {
+        Entry = entry;
+
+        foreach (var node in nodes)
+        {
+            _successors.Add(node, getSuccessors(node).Distinct().ToList());
+            _predecessors.Add(node, []);
+        }
+
+        foreach (var (node, successors) in _successors)
+        {
+            foreach (var successor in successors)
+            {
+                _predecessors[successor].Add(node);
+            }
+        }
+
+        ReversePostOrder = ComputeReversePostOrder();
+
+        for (var i = 0; i < ReversePostOrder.Count; i++)
+        {
+            _reversePostOrderIndices.Add(ReversePostOrder[i], i);
+        }
+
+        ComputeDominators();
+
+        Loops = ComputeLoops();
+
+        foreach (var loop in Loops)
+        {
+            foreach (var node in loop.Nodes)
+            {
+                _loopDepths[node] = _loopDepths.GetValueOrDefault(node) + 1;
+            }
+        }
+    }
+
+    public TNode Entry { get; }
+
+    /// <summary>
+    /// Reachable nodes, ordered so that every node comes before its successors,
+    /// ignoring back edges.
+    /// </summary>
+    public IReadOnlyList<TNode> ReversePostOrder { get; }
+
+    /// <summary>
+    /// Natural loops, outermost first. Loops that share a header are merged.
+    /// </summary>
+    public IReadOnlyList<NaturalLoop<TNode>> Loops { get; }
+
+    /// <summary>
+    /// The largest number of loops that any one node is in.
+    /// </summary>
+    public int MaxLoopDepth => _loopDepths.Count > 0 ? _loopDepths.Values.Max() : 0;
+
+    public IReadOnlyList<TNode> GetSuccessors(TNode node) => _successors[node];
+
+    public IReadOnlyList<TNode> GetPredecessors(TNode node) => _predecessors[node];
+
+    public bool IsReachable(TNode node) => _reversePostOrderIndices.ContainsKey(node);
+
+    public int GetReversePostOrderIndex(TNode node) => _reversePostOrderIndices[node];
+
+    public bool Dominates(TNode dominator, TNode node)
+    {
+        if (!IsReachable(dominator) || !IsReachable(node))
+        {
+            return false;
+        }
+
+        while (true)
+        {
+            if (Comparer.Equals(node, dominator))
+            {
+                return true;
+            }
+
+            if (Comparer.Equals(node, Entry))
+            {
+                return false;
+            }
+
+            node = _immediateDominators[node];
+        }
+    }
+
+    /// <summary>
+    /// A back edge goes from a node to one of its dominators.
+    /// </summary>
+    public bool IsBackEdge(TNode from, TNode to) => Dominates(to, from);
+
+    /// <summary>
+    /// Finds an edge that goes backwards in reverse postorder without being a back edge,
+    /// which means it enters a loop somewhere other than its header.
+    /// </summary>
+    public bool TryGetIrreducibleEdge(out TNode from, out TNode to)
+    {
+        foreach (var node in ReversePostOrder)
+        {
+            foreach (var successor in _successors[node])
+            {
+                if (_reversePostOrderIndices[successor] <= _reversePostOrderIndices[node]
+                    && !IsBackEdge(node, successor))
+                {
+                    from = node;
+                    to = successor;
+                    return true;
+                }
+            }
+        }
+
+        from = default!;
+        to = default!;
+        return false;
+    }
+
+    private List<TNode> ComputeReversePostOrder()
+    {
+        var result = new List<TNode>();
+        var visited = new HashSet<TNode> { Entry };
+        var stack = new Stack<(TNode Node, int NextSuccessor)>();
+
+        stack.Push((Entry, 0));
+
+        while (stack.Count > 0)
+        {
+            var (node, nextSuccessor) = stack.Pop();
+            var successors = _successors[node];
+
+            if (nextSuccessor < successors.Count)
+            {
+                stack.Push((node, nextSuccessor + 1));
+
+                var successor = successors[nextSuccessor];
+                if (visited.Add(successor))
+                {
+                    stack.Push((successor, 0));
+                }
+            }
+            else
+            {
+                result.Add(node);
+            }
+        }
+
+        result.Reverse();
+
+        return result;
+    }
+
+    private void ComputeDominators()
+    {
+        // "A Simple, Fast Dominance Algorithm" by Cooper, Harvey and Kennedy.
+        _immediateDominators[Entry] = Entry;
+
+        var changed = true;
+        while (changed)
+        {
+            changed = false;
+
+            foreach (var node in ReversePostOrder.Skip(1))
+            {
+                var hasNewDominator = false;
+                var newDominator = default(TNode)!;
+
+                foreach (var predecessor in _predecessors[node])
+                {
+                    if (!_immediateDominators.ContainsKey(predecessor))
+                    {
+                        continue;
+                    }
+
+                    newDominator = hasNewDominator
+                        ? Intersect(predecessor, newDominator)
+                        : predecessor;
+                    hasNewDominator = true;
+                }
+
+                if (!_immediateDominators.TryGetValue(node, out var oldDominator)
+                    || !Comparer.Equals(oldDominator, newDominator))
+                {
+                    _immediateDominators[node] = newDominator;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    private TNode Intersect(TNode a, TNode b)
+    {
+        while (!Comparer.Equals(a, b))
+        {
+            while (_reversePostOrderIndices[a] > _reversePostOrderIndices[b])
+            {
+                a = _immediateDominators[a];
+            }
+
+            while (_reversePostOrderIndices[b] > _reversePostOrderIndices[a])
+            {
+                b = _immediateDominators[b];
+            }
+        }
+
+        return a;
+    }
+
+    private List<NaturalLoop<TNode>> ComputeLoops()
+    {
+        var loopsByHeader = new Dictionary<TNode, HashSet<TNode>>();
+
+        foreach (var node in ReversePostOrder)
+        {
+            foreach (var successor in _successors[node])
+            {
+                if (!IsBackEdge(node, successor))
+                {
+                    continue;
+                }
+
+                if (!loopsByHeader.TryGetValue(successor, out var loopNodes))
+                {
+                    loopsByHeader.Add(successor, loopNodes = [successor]);
+                }
+
+                // Walk backwards from the latch to the header.
+                var worklist = new Stack<TNode>();
+                if (loopNodes.Add(node))
+                {
+                    worklist.Push(node);
+                }
+
+                while (worklist.Count > 0)
+                {
+                    foreach (var predecessor in _predecessors[worklist.Pop()])
+                    {
+                        if (IsReachable(predecessor) && loopNodes.Add(predecessor))
+                        {
+                            worklist.Push(predecessor);
+                        }
+                    }
+                }
+            }
+        }
+
+        return loopsByHeader
+            .Select(x => new NaturalLoop<TNode>(x.Key, x.Value))
+            .OrderByDescending(x => x.Nodes.Count)
+            .ToList();
+    }
+}
+
+internal sealed record NaturalLoop<TNode>(TNode Header, IReadOnlySet<TNode> Nodes)
+{
+    public bool Contains(TNode node) => Nodes.Contains(node);
+}
@@ -2,6 +2,7 @@ using System;
 using System.Collections.Generic;
 using System.Reflection;
 using System.Reflection.Emit;
+using IR2IL.Intrinsics;
 using LLVMSharp.Interop;
 
 namespace IR2IL;
@@ -19,6 +20,7 @@ internal sealed class CompiledModule
         ReadOnlySpan<CompiledFunction> functions)
     {
         _typeSystem = typeSystem;
+        Intrinsics = new IntrinsicResolver(typeSystem);
 
         foreach (var globalVariable in globalVariables)
         {
@@ -33,6 +35,8 @@ internal sealed class CompiledModule
 
     public TypeSystem TypeSystem => _typeSystem;
 
+    public IntrinsicResolver Intrinsics { get; }
+
     public MethodInfo GetFunction(LLVMValueRef function) => _functionLookup[function];
 
     public FieldInfo GetGlobal(LLVMValueRef global) => _globalLookup[global];
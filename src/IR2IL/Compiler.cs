@@ -1,4 +1,6 @@
+using System.Collections.Generic;
 using System.IO;
+using System.Linq;
 using System.Reflection;
 using System.Reflection.Emit;
 using System.Reflection.Metadata;
@@ -13,7 +15,12 @@ public sealed partial class Compiler
 {
     public static void Compile(string inputPath, string outputPath)
     {
-        var compiler = new Compiler(inputPath, outputPath);
+        Compile(inputPath, outputPath, CompilerOptions.Default);
+    }
+
+    public static void Compile(string inputPath, string outputPath, CompilerOptions options)
+    {
+        var compiler = new Compiler(inputPath, outputPath, options);
 
         compiler.Compile(out var mainMethod);
 
@@ -22,14 +29,16 @@ public sealed partial class Compiler
 
     private readonly string _inputPath;
     private readonly string _outputPath;
+    private readonly CompilerOptions _options;
 
     private readonly PersistedAssemblyBuilder _assemblyBuilder;
     private readonly ModuleBuilder _moduleBuilder;
 
-    private Compiler(string inputPath, string outputPath)
+    private Compiler(string inputPath, string outputPath, CompilerOptions options)
     {
         _inputPath = inputPath;
         _outputPath = outputPath;
+        _options = options;
 
         var outputName = Path.GetFileNameWithoutExtension(outputPath);
 
@@ -51,7 +60,7 @@ public sealed partial class Compiler
 
     private void Compile(out MethodInfo? mainMethod)
     {
-        using var moduleCompiler = new ModuleCompiler(_inputPath, _moduleBuilder);
+        using var moduleCompiler = new ModuleCompiler(_inputPath, _moduleBuilder, _options);
 
         moduleCompiler.CompileModule(out mainMethod);
     }
@@ -102,10 +111,14 @@ public sealed partial class Compiler
             peBlob.WriteContentTo(fileStream);
         }
 
+        var configProperties = string.Join(
+            ",\n      ",
+            GetConfigProperties().Select(x => $"\"{x.Key}\": {(x.Value ? "true" : "false")}"));
+
         // TODO: Make version dynamic.
         File.WriteAllText(
             Path.ChangeExtension(_outputPath, "runtimeconfig.json"),
-            """
+            $$"""
             {
               "runtimeOptions": {
                 "tfm": "net9.0",
@@ -114,7 +127,7 @@ public sealed partial class Compiler
                   "version": "9.0.0-rc.2.24473.5"
                 },
                 "configProperties": {
-                  "System.Runtime.Serialization.EnableUnsafeBinaryFormatterSerialization": false
+                  {{configProperties}}
                 }
               }
             }
@@ -126,4 +139,21 @@ public sealed partial class Compiler
             Path.Combine(Path.GetDirectoryName(_outputPath) ?? "", runtimeDll),
             true);
     }
+
+    private IEnumerable<KeyValuePair<string, bool>> GetConfigProperties()
+    {
+        yield return new("System.Runtime.Serialization.EnableUnsafeBinaryFormatterSerialization", false);
+
+        switch (_options.TieringPolicy)
+        {
+            case TieringPolicy.NoQuickJitForLoops:
+                yield return new("System.Runtime.TieredCompilation.QuickJitForLoops", false);
+                yield return new("System.Runtime.TieredPGO", false);
+                break;
+
+            case TieringPolicy.NoTieredCompilation:
+                yield return new("System.Runtime.TieredCompilation", false);
+                break;
+        }
+    }
 }
\ No newline at end of file
@@ -0,0 +1,44 @@
+using System;
+
+namespace IR2IL;
+
+public sealed class CompilerOptions
+{
+    public static readonly CompilerOptions Default = new();
+
+    public TieringPolicy TieringPolicy { get; init; } = TieringPolicy.Default;
+
+    /// <summary>
+    /// Called with each warning the compiler reports, such as a function that's marked alwaysinline
+    /// but that the JIT won't inline. Warnings are dropped if this is null.
+    /// </summary>
+    public Action<string>? WarningHandler { get; init; }
+}
+
+/// <summary>
+/// Controls how the emitted methods go through tiered compilation.
+/// </summary>
+public enum TieringPolicy
+{
+    /// <summary>
+    /// Use the runtime's defaults: tier-0 first, with on-stack replacement for loops.
+    /// </summary>
+    Default,
+
+    /// <summary>
+    /// Mark methods that contain loops as <c>AggressiveOptimization</c>,
+    /// so they skip tier-0 and are fully optimized the first time they're called.
+    /// </summary>
+    AggressiveOptimizationForLoops,
+
+    /// <summary>
+    /// Leave the methods alone, but emit a runtimeconfig that disables
+    /// <c>TC_QuickJitForLoops</c> and <c>TieredPGO</c>.
+    /// </summary>
+    NoQuickJitForLoops,
+
+    /// <summary>
+    /// Emit a runtimeconfig that disables tiered compilation altogether.
+    /// </summary>
+    NoTieredCompilation,
+}
@@ -0,0 +1,37 @@
+using System;
+
+namespace IR2IL;
+
+/// <summary>
+/// LLVM's fast-math flags, which floating-point instructions can have to relax IEEE semantics.
+/// The values are the same as LLVM-C's LLVMFastMathFlags.
+/// </summary>
+[Flags]
+internal enum FastMathFlags
+{
+    None = 0,
+
+    /// <summary>reassoc: the operands can be reassociated.</summary>
+    AllowReassociation = 1 << 0,
+
+    /// <summary>nnan: operands and results are assumed not to be NaN.</summary>
+    NoNaNs = 1 << 1,
+
+    /// <summary>ninf: operands and results are assumed not to be infinite.</summary>
+    NoInfinities = 1 << 2,
+
+    /// <summary>nsz: the sign of a zero operand or result doesn't matter.</summary>
+    NoSignedZeros = 1 << 3,
+
+    /// <summary>arcp: division can be done by multiplying by the reciprocal.</summary>
+    AllowReciprocal = 1 << 4,
+
+    /// <summary>contract: a multiply and an add can be fused, without rounding in between.</summary>
+    AllowContract = 1 << 5,
+
+    /// <summary>afn: functions such as sin and log can be approximated.</summary>
+    ApproximateFunctions = 1 << 6,
+
+    /// <summary>fast: all of the above.</summary>
+    Fast = AllowReassociation | NoNaNs | NoInfinities | NoSignedZeros | AllowReciprocal | AllowContract | ApproximateFunctions,
+}
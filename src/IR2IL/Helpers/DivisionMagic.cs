@@ -0,0 +1,124 @@
+using System;
+using System.Numerics;
+
+namespace IR2IL.Helpers;
+
+/// <summary>
+/// Computes the "magic numbers" that turn integer division by a constant into a multiply-high and shifts,
+/// as described in Hacker's Delight, chapter 10, and by Granlund and Montgomery.
+/// </summary>
+/// <remarks>
+/// These are used for vector division, which has no instruction, by constants known at compile time.
+/// See <see cref="Runtime.VectorUtility"/> for how they're applied.
+/// </remarks>
+internal static class DivisionMagic
+{
+    /// <summary>
+    /// For unsigned division of <paramref name="bitCount"/>-bit integers by <paramref name="divisor"/>,
+    /// the quotient is <c>mulhi(n, multiplier) &gt;&gt; shift</c>, or with <c>isAdd</c>,
+    /// <c>(((n - t) &gt;&gt; 1) + t) &gt;&gt; (shift - 1)</c> where <c>t = mulhi(n, multiplier)</c>.
+    /// Powers of two have a multiplier of zero, and the quotient is <c>n &gt;&gt; shift</c>.
+    /// </summary>
+    public static (ulong Multiplier, int Shift, bool IsAdd) GetUnsigned(ulong divisor, int bitCount)
+    {
+        if (divisor == 0)
+        {
+            throw new ArgumentOutOfRangeException(nameof(divisor));
+        }
+
+        if (BitOperations.IsPow2(divisor))
+        {
+            return (0, BitOperations.Log2(divisor), false);
+        }
+
+        // With m = floor(2^(N + l) / d) + 1, floor(n * m / 2^(N + l)) is the quotient for every N-bit n,
+        // provided that m * d - 2^(N + l) <= 2^l. We want the smallest l where m fits in N bits.
+        var d = new BigInteger(divisor);
+        var ceilingLog2 = BitOperations.Log2(divisor) + 1;
+        var limit = BigInteger.One << bitCount;
+
+        for (var shift = 0; shift <= ceilingLog2; shift++)
+        {
+            var power = BigInteger.One << (bitCount + shift);
+            var multiplier = power / d + 1;
+            if (multiplier < limit && multiplier * d - power <= BigInteger.One << shift)
+            {
+                return ((ulong)multiplier, shift, false);
+            }
+        }
+
+        // Otherwise, m has N + 1 bits when l = ceil(log2(d)). The top bit is added back as n,
+        // in a way that can't overflow.
+        var wideMultiplier = (BigInteger.One << (bitCount + ceilingLog2)) / d + 1;
+        return ((ulong)(wideMultiplier - limit), ceilingLog2, true);
+    }
+
+    /// <summary>
+    /// For signed division of <paramref name="bitCount"/>-bit integers by <paramref name="divisor"/>,
+    /// where |divisor| is at least 2, the quotient is <c>q = mulhs(n, multiplier)</c>, plus n if the divisor is positive
+    /// and the multiplier negative, or minus n if it's the other way round, then <c>q &gt;&gt; shift</c>, rounded towards zero
+    /// by adding one if it's negative. Divisors of 1 and -1 don't need a multiplier, and have zero.
+    /// </summary>
+    public static (long Multiplier, int Shift) GetSigned(long divisor, int bitCount)
+    {
+        if (divisor is 0)
+        {
+            throw new ArgumentOutOfRangeException(nameof(divisor));
+        }
+
+        if (divisor is 1 or -1)
+        {
+            return (0, 0);
+        }
+
+        // Hacker's Delight, figure 10-1, in N-bit unsigned arithmetic.
+        var mask = (BigInteger.One << bitCount) - 1;
+        var d = new BigInteger(divisor) & mask;
+        var two = BigInteger.One << (bitCount - 1);
+
+        var absoluteDivisor = BigInteger.Abs(new BigInteger(divisor));
+        var t = two + (d >> (bitCount - 1));
+        var absoluteNc = t - 1 - t % absoluteDivisor;
+        var p = bitCount - 1;
+        var q1 = two / absoluteNc;
+        var r1 = two - q1 * absoluteNc;
+        var q2 = two / absoluteDivisor;
+        var r2 = two - q2 * absoluteDivisor;
+        BigInteger delta;
+
+        do
+        {
+            p++;
+            q1 = (q1 * 2) & mask;
+            r1 = (r1 * 2) & mask;
+            if (r1 >= absoluteNc)
+            {
+                q1 = (q1 + 1) & mask;
+                r1 = (r1 - absoluteNc) & mask;
+            }
+            q2 = (q2 * 2) & mask;
+            r2 = (r2 * 2) & mask;
+            if (r2 >= absoluteDivisor)
+            {
+                q2 = (q2 + 1) & mask;
+                r2 = (r2 - absoluteDivisor) & mask;
+            }
+            delta = absoluteDivisor - r2;
+        }
+        while (q1 < delta || (q1 == delta && r1 == 0));
+
+        var multiplier = (q2 + 1) & mask;
+        if (divisor < 0)
+        {
+            multiplier = (-multiplier) & mask;
+        }
+
+        // Sign-extend the N-bit multiplier.
+        if (multiplier >= two)
+        {
+            multiplier -= BigInteger.One << bitCount;
+        }
+
+        return ((long)multiplier, p - bitCount);
+    }
+}
@@ -30,4 +30,60 @@ internal static class ReflectionHelper
     {
         return type.GetMethodStrict(methodName, BindingFlags.Public | BindingFlags.Static);
     }
+
+    /// <summary>
+    /// Conversion operators can't be found by parameter types alone, because they're overloaded on their return type.
+    /// </summary>
+    public static MethodInfo GetConversionOperatorStrict(this Type type, Type fromType, Type toType)
+    {
+        return type.GetMethods(BindingFlags.Public | BindingFlags.Static)
+            .SingleOrDefault(x => x.Name is "op_Explicit" or "op_Implicit"
+                && x.ReturnType == toType
+                && x.GetParameters() is [var parameter]
+                && parameter.ParameterType == fromType)
+            ?? throw new InvalidOperationException($"Conversion operator from {fromType} to {toType} not found in type {type}.");
+    }
+
+    /// <summary>
+    /// Finds a public static method with exactly this signature, or returns null.
+    /// Unlike <see cref="Type.GetMethod(string, Type[])"/>, this also finds generic methods such as
+    /// <c>Vector128.Max&lt;T&gt;</c>, by instantiating them with <paramref name="typeArgument"/>.
+    /// </summary>
+    public static MethodInfo? FindStaticMethod(this Type type, string methodName, Type returnType, Type[] parameterTypes, Type? typeArgument = null)
+    {
+        foreach (var method in type.GetMethods(BindingFlags.Public | BindingFlags.Static))
+        {
+            if (method.Name != methodName)
+            {
+                continue;
+            }
+
+            var candidate = method;
+            if (method.IsGenericMethodDefinition)
+            {
+                if (typeArgument == null || method.GetGenericArguments().Length != 1)
+                {
+                    continue;
+                }
+
+                try
+                {
+                    candidate = method.MakeGenericMethod(typeArgument);
+                }
+                catch (ArgumentException)
+                {
+                    // The type argument doesn't satisfy the method's constraints.
+                    continue;
+                }
+            }
+
+            if (candidate.ReturnType == returnType
+                && candidate.GetParameters().Select(x => x.ParameterType).SequenceEqual(parameterTypes))
+            {
+                return candidate;
+            }
+        }
+
+        return null;
+    }
 }
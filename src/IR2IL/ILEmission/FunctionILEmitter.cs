@@ -5,8 +5,8 @@ using System.Reflection;
 using System.Reflection.Emit;
 using System.Runtime.CompilerServices;
 using System.Runtime.Intrinsics;
-using System.Text;
 using System.Threading;
+using IR2IL.Analysis;
 using IR2IL.Helpers;
 using IR2IL.Intrinsics;
 using IR2IL.Runtime;
@@ -18,24 +18,50 @@ internal sealed class FunctionILEmitter : ILEmitter
 {
     private readonly MethodInfo _method;
     private readonly LLVMValueRef _function;
+    private readonly bool _isVarArg;
+    private readonly bool _hasDynamicAllocas;
+    private readonly BlockLayout _layout;
+
+    /// <summary>
+    /// If the function has dynamic allocas, this holds the <see cref="ShadowStack"/> mark from when it was entered,
+    /// which is restored when it returns.
+    /// </summary>
+    private LocalBuilder? _shadowStackMark;
+
+    private BlockNode _currentNode;
+    private BlockNode? _nextNode;
+
+    /// <summary>
+    /// If the emitted method contains something that prevents the JIT from inlining it,
+    /// this describes what it is.
+    /// </summary>
+    public string? InliningBlocker { get; private set; }
 
     private readonly Dictionary<LLVMValueRef, bool> CanPushToStackLookup = [];
 
     private readonly Dictionary<LLVMValueRef, ParameterBuilder> Parameters = [];
     private readonly Dictionary<LLVMValueRef, LocalBuilder> Locals = [];
-    private readonly Dictionary<LLVMBasicBlockRef, Label> Labels = [];
+    private readonly Dictionary<BlockNode, Label> Labels = [];
 
     public readonly Dictionary<LLVMValueRef, LocalBuilder> PhiLocals = [];
 
     private int _previousSequencePointOffset = -1;
 
-    public FunctionILEmitter(
+    public unsafe FunctionILEmitter(
         CompiledModule compiledModule,
         CompiledFunctionDefinition compiledFunction)
         : base(compiledModule, compiledFunction.MethodBuilder.GetILGenerator())
     {
         _method = compiledFunction.MethodBuilder;
         _function = compiledFunction.Function;
+        _isVarArg = ((LLVMTypeRef)LLVM.GlobalGetValueType(_function)).IsFunctionVarArg;
+        _layout = new BlockLayout(_function);
+        _currentNode = _layout.Entry;
+
+        if (_isVarArg)
+        {
+            InliningBlocker = "is variadic";
+        }
 
         // Figure out which instructions need their results stored in local variables,
         // and which can be pushed to the stack.
@@ -45,6 +71,12 @@ internal sealed class FunctionILEmitter : ILEmitter
             for (var i = 0; i < blockInstructions.Count; i++)
             {
                 CanPushToStackLookup.Add(blockInstructions[i], CanPushToStack(blockInstructions, i));
+
+                if (blockInstructions[i].InstructionOpcode == LLVMOpcode.LLVMAlloca
+                    && !blockInstructions[i].AllocaHasConstantNumElements())
+                {
+                    _hasDynamicAllocas = true;
+                }
             }
         }
 
@@ -99,6 +131,13 @@ internal sealed class FunctionILEmitter : ILEmitter
 
         if (instruction.InstructionOpcode == LLVMOpcode.LLVMLoad)
         {
+            // Atomic and volatile loads have to happen exactly where they are,
+            // so they can only be pushed if nothing comes between them and their user.
+            if (instruction.IsOrderedOrVolatile())
+            {
+                return false;
+            }
+
             // Make sure the result of this load instruction is used
             // before anything that might change its value.
             for (var j = index + 1; j < instructions.Count; j++)
@@ -138,12 +177,22 @@ internal sealed class FunctionILEmitter : ILEmitter
             }
         }
 
-        foreach (var basicBlock in _function.BasicBlocks)
+        // This comes before the entry block's label, so that self tail calls, which jump back to it, don't save it again.
+        if (_hasDynamicAllocas)
         {
-            var basicBlockLabel = GetOrCreateLabel(basicBlock);
-            ILGenerator.MarkLabel(basicBlockLabel);
+            _shadowStackMark = ILGenerator.DeclareLocal(typeof(void*));
+            ILGenerator.Emit(OpCodes.Call, typeof(ShadowStack).GetStaticMethodStrict(nameof(ShadowStack.Save)));
+            ILGenerator.Emit(OpCodes.Stloc, _shadowStackMark);
+        }
 
-            foreach (var instruction in basicBlock.GetInstructions())
+        for (var i = 0; i < _layout.Nodes.Count; i++)
+        {
+            _currentNode = _layout.Nodes[i];
+            _nextNode = i + 1 < _layout.Nodes.Count ? _layout.Nodes[i + 1] : null;
+
+            ILGenerator.MarkLabel(GetOrCreateLabel(_currentNode));
+
+            foreach (var instruction in _currentNode.Block.GetInstructions())
             {
                 if (!CanPushToStack(instruction) && instruction.InstructionOpcode != LLVMOpcode.LLVMPHI)
                 {
@@ -153,15 +202,22 @@ internal sealed class FunctionILEmitter : ILEmitter
         }
     }
 
-    private Label GetOrCreateLabel(LLVMBasicBlockRef basicBlock)
+    private Label GetOrCreateLabel(BlockNode node)
     {
-        if (!Labels.TryGetValue(basicBlock, out var result))
+        if (!Labels.TryGetValue(node, out var result))
         {
-            Labels.Add(basicBlock, result = ILGenerator.DefineLabel());
+            Labels.Add(node, result = ILGenerator.DefineLabel());
         }
         return result;
     }
 
+    /// <summary>
+    /// Gets the label for a block that the current block branches to.
+    /// </summary>
+    private Label GetOrCreateLabel(LLVMBasicBlockRef target) => GetOrCreateLabel(_layout.GetTarget(_currentNode, target));
+
+    private bool IsNextBlock(LLVMBasicBlockRef target) => _layout.GetTarget(_currentNode, target) == _nextNode;
+
     private bool CanPushToStack(LLVMValueRef valueRef)
     {
         return CanPushToStackLookup.TryGetValue(valueRef, out var value) && value;
@@ -218,10 +274,16 @@ internal sealed class FunctionILEmitter : ILEmitter
         switch (instruction.InstructionOpcode)
         {
             case LLVMOpcode.LLVMAdd:
-            case LLVMOpcode.LLVMFAdd:
                 EmitBinaryOperation(instruction, OpCodes.Add, nameof(Vector128.Add));
                 break;
 
+            case LLVMOpcode.LLVMFAdd:
+                if (!TryEmitFusedMultiplyAdd(instruction))
+                {
+                    EmitBinaryOperation(instruction, OpCodes.Add, nameof(Vector128.Add));
+                }
+                break;
+
             case LLVMOpcode.LLVMAnd:
                 EmitBinaryOperation(instruction, OpCodes.And, nameof(Vector128.BitwiseAnd));
                 break;
@@ -234,6 +296,10 @@ internal sealed class FunctionILEmitter : ILEmitter
                 EmitBinaryOperation(instruction, OpCodes.Shr, nameof(Vector128.ShiftRightArithmetic));
                 break;
 
+            case LLVMOpcode.LLVMAtomicCmpXchg:
+                EmitAtomicCmpXchg(instruction);
+                break;
+
             case LLVMOpcode.LLVMAtomicRMW:
                 EmitAtomicRMW(instruction);
                 break;
@@ -254,6 +320,14 @@ internal sealed class FunctionILEmitter : ILEmitter
                 EmitExtractElement(instruction);
                 break;
 
+            case LLVMOpcode.LLVMExtractValue:
+                EmitExtractValue(instruction);
+                break;
+
+            case LLVMOpcode.LLVMFence:
+                EmitFence(instruction);
+                break;
+
             case LLVMOpcode.LLVMFreeze:
                 EmitFreeze(instruction);
                 break;
@@ -279,7 +353,10 @@ internal sealed class FunctionILEmitter : ILEmitter
                 break;
 
             case LLVMOpcode.LLVMFDiv:
-                EmitBinaryOperation(instruction, OpCodes.Div, nameof(Vector128.Divide));
+                if (!TryEmitReciprocalMultiply(instruction))
+                {
+                    EmitBinaryOperation(instruction, OpCodes.Div, nameof(Vector128.Divide));
+                }
                 break;
 
             case LLVMOpcode.LLVMFNeg:
@@ -326,12 +403,13 @@ internal sealed class FunctionILEmitter : ILEmitter
                         var returnOperand = instruction.GetOperand(0);
                         EmitValue(returnOperand);
                     }
+                    EmitRestoreShadowStack();
                     ILGenerator.Emit(OpCodes.Ret);
                     break;
                 }
 
             case LLVMOpcode.LLVMSDiv:
-                EmitBinaryOperation(instruction, OpCodes.Div, nameof(Vector128.Divide));
+                EmitBinaryOperation(instruction, OpCodes.Div, nameof(VectorUtility.SignedDivide));
                 break;
 
             case LLVMOpcode.LLVMSelect:
@@ -359,12 +437,18 @@ internal sealed class FunctionILEmitter : ILEmitter
                 break;
 
             case LLVMOpcode.LLVMSub:
-            case LLVMOpcode.LLVMFSub:
                 EmitBinaryOperation(instruction, OpCodes.Sub, nameof(Vector128.Subtract));
                 break;
 
+            case LLVMOpcode.LLVMFSub:
+                if (!TryEmitFusedMultiplyAdd(instruction))
+                {
+                    EmitBinaryOperation(instruction, OpCodes.Sub, nameof(Vector128.Subtract));
+                }
+                break;
+
             case LLVMOpcode.LLVMSRem:
-                EmitBinaryOperation(instruction, OpCodes.Rem, "SignedRemainder");
+                EmitBinaryOperation(instruction, OpCodes.Rem, nameof(VectorUtility.SignedRemainder));
                 break;
 
             case LLVMOpcode.LLVMSwitch:
@@ -376,7 +460,7 @@ internal sealed class FunctionILEmitter : ILEmitter
                 break;
 
             case LLVMOpcode.LLVMUDiv:
-                EmitBinaryOperation(instruction, OpCodes.Div_Un, nameof(Vector128.Divide));
+                EmitBinaryOperation(instruction, OpCodes.Div_Un, nameof(VectorUtility.UnsignedDivide));
                 break;
 
             case LLVMOpcode.LLVMUIToFP:
@@ -390,7 +474,7 @@ internal sealed class FunctionILEmitter : ILEmitter
                 break;
 
             case LLVMOpcode.LLVMURem:
-                EmitBinaryOperation(instruction, OpCodes.Rem_Un, "UnsignedRemainder");
+                EmitBinaryOperation(instruction, OpCodes.Rem_Un, nameof(VectorUtility.UnsignedRemainder));
                 break;
 
             case LLVMOpcode.LLVMXor:
@@ -406,34 +490,160 @@ internal sealed class FunctionILEmitter : ILEmitter
         }
     }
 
+    private void EmitAtomicCmpXchg(LLVMValueRef instruction)
+    {
+        // cmpxchg [weak] ptr <pointer>, <ty> <cmp>, <ty> <new> <success ordering> <failure ordering>
+        //
+        // Interlocked.CompareExchange is a full barrier that never fails spuriously,
+        // so it covers every combination of orderings, and weak too.
+
+        var pointer = instruction.GetOperand(0);
+        var comparand = instruction.GetOperand(1);
+        var newValue = instruction.GetOperand(2);
+
+        var operandType = GetAtomicOperandType(comparand.TypeOf, Signedness.Signed);
+
+        var comparandLocal = ILGenerator.DeclareLocal(operandType);
+        EmitValue(comparand);
+        ILGenerator.Emit(OpCodes.Stloc, comparandLocal);
+
+        EmitValue(pointer);
+        EmitValue(newValue);
+        ILGenerator.Emit(OpCodes.Ldloc, comparandLocal);
+
+        var compareExchangeMethod = typeof(Atomics)
+            .GetStaticMethodStrict(nameof(Atomics.CompareExchange))
+            .MakeGenericMethod(operandType);
+        ILGenerator.Emit(OpCodes.Call, compareExchangeMethod);
+
+        var originalLocal = ILGenerator.DeclareLocal(operandType);
+        ILGenerator.Emit(OpCodes.Stloc, originalLocal);
+
+        // The result is { <ty> original, i1 success }.
+        var resultType = TypeSystem.GetMsilType(instruction.TypeOf);
+        var resultFields = resultType.GetFields();
+        var resultLocal = ILGenerator.DeclareLocal(resultType);
+
+        ILGenerator.Emit(OpCodes.Ldloca, resultLocal);
+        ILGenerator.Emit(OpCodes.Ldloc, originalLocal);
+        ILGenerator.Emit(OpCodes.Stfld, resultFields[0]);
+
+        ILGenerator.Emit(OpCodes.Ldloca, resultLocal);
+        ILGenerator.Emit(OpCodes.Ldloc, originalLocal);
+        ILGenerator.Emit(OpCodes.Ldloc, comparandLocal);
+        ILGenerator.Emit(OpCodes.Ceq);
+        ILGenerator.Emit(OpCodes.Stfld, resultFields[1]);
+
+        ILGenerator.Emit(OpCodes.Ldloc, resultLocal);
+    }
+
     private void EmitAtomicRMW(LLVMValueRef instruction)
     {
+        // Interlocked operations are full barriers, which satisfies every ordering.
+        // .NET has nothing weaker for read-modify-write operations.
+
         var pointer = instruction.GetOperand(0);
         var value = instruction.GetOperand(1);
 
-        switch (instruction.AtomicRMWBinOp)
+        if (TryEmitAtomicIncrementOrDecrement(instruction))
         {
-            case LLVMAtomicRMWBinOp.LLVMAtomicRMWBinOpAdd:
-                switch (value.TypeOf.Kind)
-                {
-                    case LLVMTypeKind.LLVMIntegerTypeKind:
-                        // TODO: When amount to add is constant 1 or -1, call Increment or Decrement.
+            return;
+        }
 
-                        EmitValue(pointer);
-                        EmitValue(value);
+        var (methodName, signedness) = instruction.AtomicRMWBinOp switch
+        {
+            LLVMAtomicRMWBinOp.LLVMAtomicRMWBinOpXchg => (nameof(Atomics.Exchange), Signedness.Signed),
+            LLVMAtomicRMWBinOp.LLVMAtomicRMWBinOpAdd => (nameof(Atomics.Add), Signedness.Signed),
+            LLVMAtomicRMWBinOp.LLVMAtomicRMWBinOpSub => (nameof(Atomics.Subtract), Signedness.Signed),
+            LLVMAtomicRMWBinOp.LLVMAtomicRMWBinOpAnd => (nameof(Atomics.And), Signedness.Signed),
+            LLVMAtomicRMWBinOp.LLVMAtomicRMWBinOpNand => (nameof(Atomics.Nand), Signedness.Signed),
+            LLVMAtomicRMWBinOp.LLVMAtomicRMWBinOpOr => (nameof(Atomics.Or), Signedness.Signed),
+            LLVMAtomicRMWBinOp.LLVMAtomicRMWBinOpXor => (nameof(Atomics.Xor), Signedness.Signed),
+            LLVMAtomicRMWBinOp.LLVMAtomicRMWBinOpMax => (nameof(Atomics.Max), Signedness.Signed),
+            LLVMAtomicRMWBinOp.LLVMAtomicRMWBinOpMin => (nameof(Atomics.Min), Signedness.Signed),
+            LLVMAtomicRMWBinOp.LLVMAtomicRMWBinOpUMax => (nameof(Atomics.Max), Signedness.Unsigned),
+            LLVMAtomicRMWBinOp.LLVMAtomicRMWBinOpUMin => (nameof(Atomics.Min), Signedness.Unsigned),
+            LLVMAtomicRMWBinOp.LLVMAtomicRMWBinOpFAdd => (nameof(Atomics.Add), Signedness.Signed),
+            LLVMAtomicRMWBinOp.LLVMAtomicRMWBinOpFSub => (nameof(Atomics.Subtract), Signedness.Signed),
+            LLVMAtomicRMWBinOp.LLVMAtomicRMWBinOpFMax => (nameof(Atomics.MaxNumber), Signedness.Signed),
+            LLVMAtomicRMWBinOp.LLVMAtomicRMWBinOpFMin => (nameof(Atomics.MinNumber), Signedness.Signed),
+            _ => throw new NotImplementedException($"Atomic RMW operation {instruction.AtomicRMWBinOp} not implemented: {instruction}"),
+        };
 
-                        var integerType = TypeSystem.GetMsilType(value.TypeOf);
-                        var addMethod = typeof(Interlocked).GetMethodStrict(nameof(Interlocked.Add), [integerType.MakeByRefType(), integerType]);
-                        ILGenerator.Emit(OpCodes.Call, addMethod);
-                        break;
+        EmitValue(pointer);
+        EmitValue(value);
 
-                    default:
-                        throw new NotImplementedException();
-                }
-                break;
+        var method = typeof(Atomics)
+            .GetStaticMethodStrict(methodName)
+            .MakeGenericMethod(GetAtomicOperandType(value.TypeOf, signedness));
+        ILGenerator.Emit(OpCodes.Call, method);
+    }
+
+    private bool TryEmitAtomicIncrementOrDecrement(LLVMValueRef instruction)
+    {
+        var value = instruction.GetOperand(1);
+
+        if (value.Kind != LLVMValueKind.LLVMConstantIntValueKind
+            || value.TypeOf.IntWidth is not (32 or 64))
+        {
+            return false;
+        }
+
+        var amount = instruction.AtomicRMWBinOp switch
+        {
+            LLVMAtomicRMWBinOp.LLVMAtomicRMWBinOpAdd => value.ConstIntSExt,
+            LLVMAtomicRMWBinOp.LLVMAtomicRMWBinOpSub => -value.ConstIntSExt,
+            _ => 0,
+        };
+
+        if (amount is not (1 or -1))
+        {
+            return false;
+        }
+
+        var integerType = TypeSystem.GetMsilType(value.TypeOf);
+
+        EmitValue(instruction.GetOperand(0));
+
+        var method = typeof(Interlocked).GetMethodStrict(
+            amount == 1 ? nameof(Interlocked.Increment) : nameof(Interlocked.Decrement),
+            [integerType.MakeByRefType()]);
+        ILGenerator.Emit(OpCodes.Call, method);
+
+        // Interlocked returns the new value, but atomicrmw returns the original value.
+        ILGenerator.Emit(OpCodes.Ldc_I4_1);
+        if (integerType == typeof(long))
+        {
+            ILGenerator.Emit(OpCodes.Conv_I8);
+        }
+        ILGenerator.Emit(amount == 1 ? OpCodes.Sub : OpCodes.Add);
+
+        return true;
+    }
+
+    private Type GetAtomicOperandType(LLVMTypeRef type, Signedness signedness)
+    {
+        switch (type.Kind)
+        {
+            case LLVMTypeKind.LLVMIntegerTypeKind:
+                return (type.IntWidth, signedness) switch
+                {
+                    (8, Signedness.Signed) => typeof(sbyte),
+                    (8, Signedness.Unsigned) => typeof(byte),
+                    (16, Signedness.Signed) => typeof(short),
+                    (16, Signedness.Unsigned) => typeof(ushort),
+                    (32, Signedness.Signed) => typeof(int),
+                    (32, Signedness.Unsigned) => typeof(uint),
+                    (64, Signedness.Signed) => typeof(long),
+                    (64, Signedness.Unsigned) => typeof(ulong),
+                    _ => throw new NotImplementedException($"Atomic operations on i{type.IntWidth} not implemented"),
+                };
+
+            case LLVMTypeKind.LLVMPointerTypeKind:
+                return typeof(nint);
 
             default:
-                throw new NotImplementedException($"Atomic RMW operation {instruction.AtomicRMWBinOp} not implemented: {instruction}");
+                return TypeSystem.GetMsilType(type);
         }
     }
 
@@ -490,14 +700,29 @@ internal sealed class FunctionILEmitter : ILEmitter
                 var localType = numElements.ConstIntSExt != 1
                     ? TypeSystem.GetArrayType(allocatedType, (int)numElements.ConstIntSExt)
                     : TypeSystem.GetMsilType(allocatedType);
-                var local = ILGenerator.DeclareLocal(localType);
-                Locals.Add(instruction, local);
+                // The block may be emitted more than once if it was split by the block layout.
+                if (!Locals.ContainsKey(instruction))
+                {
+                    Locals.Add(instruction, ILGenerator.DeclareLocal(localType));
+                }
                 break;
 
+            case LLVMValueKind.LLVMArgumentValueKind:
             case LLVMValueKind.LLVMInstructionValueKind:
+                // Dynamic allocas come from the shadow stack rather than localloc, so that they can be freed
+                // by llvm.stackrestore, and aren't zeroed.
+                var allocSize = TypeSystem.GetAllocSizeInBytes(instruction.GetAllocatedType());
                 EmitValue(numElements);
                 ILGenerator.Emit(OpCodes.Conv_U);
-                ILGenerator.Emit(OpCodes.Localloc);
+                if (allocSize != 1)
+                {
+                    ILGenerator.Emit(OpCodes.Ldc_I4, allocSize);
+                    ILGenerator.Emit(OpCodes.Conv_U);
+                    ILGenerator.Emit(OpCodes.Mul);
+                }
+                ILGenerator.Emit(OpCodes.Ldc_I4, (int)Math.Max(instruction.Alignment, 1));
+                ILGenerator.Emit(OpCodes.Conv_U);
+                ILGenerator.Emit(OpCodes.Call, typeof(ShadowStack).GetStaticMethodStrict(nameof(ShadowStack.Allocate)));
                 EmitStoreResult(instruction);
                 break;
 
@@ -506,6 +731,39 @@ internal sealed class FunctionILEmitter : ILEmitter
         }
     }
 
+    private void EmitExtractValue(LLVMValueRef instruction)
+    {
+        var aggregate = instruction.GetOperand(0);
+        EmitValue(aggregate);
+
+        var aggregateType = aggregate.TypeOf;
+        foreach (var index in instruction.GetIndices())
+        {
+            switch (aggregateType.Kind)
+            {
+                case LLVMTypeKind.LLVMStructTypeKind:
+                    var field = TypeSystem.GetMsilType(aggregateType).GetFields()[index];
+                    ILGenerator.Emit(OpCodes.Ldfld, field);
+                    aggregateType = aggregateType.StructElementTypes[index];
+                    break;
+
+                default:
+                    throw new NotImplementedException($"Extract value not implemented for type {aggregateType.Kind}: {instruction}");
+            }
+        }
+    }
+
+    private unsafe void EmitFence(LLVMValueRef instruction)
+    {
+        var methodName = LLVM.IsAtomicSingleThread(instruction) != 0
+            ? nameof(Atomics.SingleThreadFence)
+            : instruction.Ordering == LLVMAtomicOrdering.LLVMAtomicOrderingSequentiallyConsistent
+                ? nameof(Atomics.SequentiallyConsistentFence)
+                : nameof(Atomics.AcquireReleaseFence);
+
+        ILGenerator.Emit(OpCodes.Call, typeof(Atomics).GetStaticMethodStrict(methodName));
+    }
+
     private void EmitFreeze(LLVMValueRef instruction)
     {
         EmitValue(instruction.GetOperand(0));
@@ -516,7 +774,37 @@ internal sealed class FunctionILEmitter : ILEmitter
         var value = instruction.GetOperand(0);
         var ptr = instruction.GetOperand(1);
 
-        if (ptr.IsAAllocaInst != null && Locals.TryGetValue(ptr, out var local) && (local.LocalType.IsPrimitive || local.LocalType.IsPointer))
+        if (instruction.Ordering == LLVMAtomicOrdering.LLVMAtomicOrderingSequentiallyConsistent)
+        {
+            // A plain store followed by a full barrier would also work, but an exchange
+            // is what native compilers emit on x64, and it's cheaper than mfence.
+            EmitValue(ptr);
+            EmitValue(value);
+
+            var exchangeMethod = typeof(Atomics)
+                .GetStaticMethodStrict(nameof(Atomics.Exchange))
+                .MakeGenericMethod(GetAtomicOperandType(value.TypeOf, Signedness.Signed));
+            ILGenerator.Emit(OpCodes.Call, exchangeMethod);
+            ILGenerator.Emit(OpCodes.Pop);
+        }
+        else if (instruction.IsOrderedOrVolatile())
+        {
+            // The volatile. prefix gives release semantics, which covers monotonic and release.
+            // Padded vectors are stored with a call, which can't take the prefix, so they get a fence instead.
+            var isPadded = HasPaddedStorage(value.TypeOf);
+            if (isPadded)
+            {
+                ILGenerator.Emit(OpCodes.Call, typeof(Atomics).GetStaticMethodStrict(nameof(Atomics.AcquireReleaseFence)));
+            }
+            EmitValue(ptr);
+            EmitValue(value);
+            if (!isPadded)
+            {
+                ILGenerator.Emit(OpCodes.Volatile);
+            }
+            EmitStoreIndirect(value.TypeOf);
+        }
+        else if (ptr.IsAAllocaInst != null && Locals.TryGetValue(ptr, out var local) && (local.LocalType.IsPrimitive || local.LocalType.IsPointer))
         {
             EmitValue(value);
             ILGenerator.Emit(OpCodes.Stloc, local);
@@ -559,7 +847,7 @@ internal sealed class FunctionILEmitter : ILEmitter
             EmitValue(scalarValue);
 
             // Create vector from scalar value.
-            var scalarValueType = TypeSystem.GetMsilType(scalarValue.TypeOf);
+            var scalarValueType = TypeSystem.GetMsilVectorElementType(scalarValue.TypeOf);
             ILGenerator.Emit(
                 OpCodes.Call,
                 TypeSystem.GetNonGenericVectorType(instruction.TypeOf).GetMethodStrict("Create", [scalarValueType]));
@@ -576,7 +864,8 @@ internal sealed class FunctionILEmitter : ILEmitter
         // Vector256.Create(%15, %18)
 
         if (maskIndices.Length == sourceVector0.TypeOf.VectorSize * 2
-            && maskIndices.SequenceEqual(Enumerable.Range(0, maskIndices.Length)))
+            && maskIndices.SequenceEqual(Enumerable.Range(0, maskIndices.Length))
+            && !TypeSystem.IsPaddedVectorType(sourceVector0.TypeOf))
         {
             // Emit source vectors.
             EmitValue(sourceVector0);
@@ -591,7 +880,26 @@ internal sealed class FunctionILEmitter : ILEmitter
             return;
         }
 
-        // 3. A "true" shuffle where we select elements from two input vectors.
+        // 3. Keeping the first vector's lanes where they are, which is how LLVM narrows
+        //    a <4 x float> to a <3 x float>, or widens a <3 x float> to a <4 x float>.
+        //    Both are Vector128<float>, so there's nothing to do.
+        //
+        // LLVM:
+        // %3 = shufflevector <4 x float> %2, <4 x float> poison, <3 x i32> <i32 0, i32 1, i32 2>
+        //
+        // .NET:
+        // %2
+
+        if (TypeSystem.GetMsilType(instruction.TypeOf) == TypeSystem.GetMsilType(sourceVector0.TypeOf)
+            && instruction.GetShuffleVectorMaskValues(keepUndef: true)
+                .Select((maskIndex, i) => maskIndex == -1 || (maskIndex == i && i < sourceVector0.TypeOf.VectorSize))
+                .All(x => x))
+        {
+            EmitValue(sourceVector0);
+            return;
+        }
+
+        // 4. A "true" shuffle where we select elements from two input vectors.
         //    For smaller vectors, we could use .NET's shuffle vector APIs and do it in hardware,
         //    and this is a TODO. Although even then there aren't yet shuffle APIs that take two
         //    input vectors; that's is being discussed in https://github.com/dotnet/runtime/issues/63331
@@ -668,7 +976,7 @@ internal sealed class FunctionILEmitter : ILEmitter
 
         EmitVectorWithElement(
             TypeSystem.GetNonGenericVectorType(vectorOperand.TypeOf),
-            TypeSystem.GetMsilType(valueOperand.TypeOf));
+            TypeSystem.GetMsilVectorElementType(valueOperand.TypeOf));
     }
 
     private void EmitVectorWithElement(Type nonGenericVectorType, Type valueType)
@@ -683,8 +991,28 @@ internal sealed class FunctionILEmitter : ILEmitter
     {
         var operand0 = instruction.GetOperand(0);
 
-        EmitValue(operand0);
-        EmitValue(instruction.GetOperand(1));
+        if (IsInt128(operand0.TypeOf))
+        {
+            EmitValue(operand0);
+            EmitValue(instruction.GetOperand(1));
+            EmitCallIntegerUtility(instruction.ICmpPredicate switch
+            {
+                LLVMIntPredicate.LLVMIntEQ => nameof(IntegerUtility.CompareEQ),
+                LLVMIntPredicate.LLVMIntNE => nameof(IntegerUtility.CompareNE),
+                LLVMIntPredicate.LLVMIntSGT => nameof(IntegerUtility.CompareSGT),
+                LLVMIntPredicate.LLVMIntSGE => nameof(IntegerUtility.CompareSGE),
+                LLVMIntPredicate.LLVMIntSLT => nameof(IntegerUtility.CompareSLT),
+                LLVMIntPredicate.LLVMIntSLE => nameof(IntegerUtility.CompareSLE),
+                LLVMIntPredicate.LLVMIntUGT => nameof(IntegerUtility.CompareUGT),
+                LLVMIntPredicate.LLVMIntUGE => nameof(IntegerUtility.CompareUGE),
+                LLVMIntPredicate.LLVMIntULT => nameof(IntegerUtility.CompareULT),
+                LLVMIntPredicate.LLVMIntULE => nameof(IntegerUtility.CompareULE),
+                _ => throw new NotImplementedException($"Integer comparison predicate {instruction.ICmpPredicate} not implemented: {instruction}"),
+            });
+            return;
+        }
+
+        EmitICmpOperands(instruction);
 
         switch (operand0.TypeOf.Kind)
         {
@@ -754,18 +1082,76 @@ internal sealed class FunctionILEmitter : ILEmitter
         }
     }
 
-    private void EmitVectorComparison(LLVMValueRef instruction, string vectorComparisonMethodName)
+    private void EmitFCmpOperands(LLVMValueRef instruction)
     {
-        var operand0 = instruction.GetOperand(0);
+        for (var i = 0u; i < 2; i++)
+        {
+            var operand = instruction.GetOperand(i);
+
+            EmitValue(operand);
+
+            // Comparing in float gives the same answers.
+            if (IsReducedPrecisionFloat(operand.TypeOf))
+            {
+                EmitConvertFromReducedPrecision(operand.TypeOf);
+            }
+            else if (operand.TypeOf.Kind == LLVMTypeKind.LLVMVectorTypeKind
+                && IsReducedPrecisionFloat(operand.TypeOf.ElementType))
+            {
+                EmitVectorConversion(LLVMOpcode.LLVMFPExt, operand.TypeOf, GetFloatVectorType(operand.TypeOf));
+            }
+        }
+    }
+
+    private void EmitICmpOperands(LLVMValueRef instruction)
+    {
+        var isSigned = instruction.ICmpPredicate is LLVMIntPredicate.LLVMIntSGT or LLVMIntPredicate.LLVMIntSGE
+            or LLVMIntPredicate.LLVMIntSLT or LLVMIntPredicate.LLVMIntSLE;
+
+        for (var i = 0u; i < 2; i++)
+        {
+            var operand = instruction.GetOperand(i);
+
+            EmitValue(operand);
+
+            // Narrow integers might not have been extended the way this comparison needs.
+            if (operand.TypeOf.Kind == LLVMTypeKind.LLVMIntegerTypeKind)
+            {
+                if (isSigned)
+                {
+                    EmitSignExtendInPlace(operand.TypeOf.IntWidth);
+                }
+                else
+                {
+                    EmitZeroExtendInPlace(operand.TypeOf.IntWidth);
+                }
+            }
+        }
+    }
+
+    private void EmitVectorComparison(LLVMValueRef instruction, string vectorComparisonMethodName, bool complement = false)
+    {
+        var operandType = instruction.GetOperand(0).TypeOf;
 
-        var nonGenericVectorType = TypeSystem.GetNonGenericVectorType(operand0.TypeOf);
+        // Vectors of half and bfloat have been widened to vectors of float by EmitFCmpOperands.
+        if (IsReducedPrecisionFloat(operandType.ElementType))
+        {
+            operandType = GetFloatVectorType(operandType);
+        }
+
+        var nonGenericVectorType = TypeSystem.GetNonGenericVectorType(operandType);
         var genericVectorMethod = nonGenericVectorType.GetStaticMethodStrict(vectorComparisonMethodName);
-        var elementType = TypeSystem.GetMsilVectorElementType(operand0.TypeOf.ElementType);
+        var elementType = TypeSystem.GetMsilVectorElementType(operandType.ElementType);
         var vectorMethod = genericVectorMethod.MakeGenericMethod(elementType);
         ILGenerator.Emit(OpCodes.Call, vectorMethod);
 
+        if (complement)
+        {
+            ILGenerator.Emit(OpCodes.Call, nonGenericVectorType.GetStaticMethodStrict(nameof(Vector128.OnesComplement)).MakeGenericMethod(elementType));
+        }
+
         // If result is not an integer type, bitcast it to integer type.
-        switch (operand0.TypeOf.ElementType.Kind)
+        switch (operandType.ElementType.Kind)
         {
             case LLVMTypeKind.LLVMDoubleTypeKind:
                 ILGenerator.Emit(OpCodes.Call, nonGenericVectorType.GetMethodStrict(nameof(Vector128.AsInt64)).MakeGenericMethod(elementType));
@@ -780,11 +1166,11 @@ internal sealed class FunctionILEmitter : ILEmitter
                 break;
 
             default:
-                throw new NotImplementedException($"Vector comparison not implemented for element type {operand0.TypeOf.ElementType.Kind}: {instruction}");
+                throw new NotImplementedException($"Vector comparison not implemented for element type {operandType.ElementType.Kind}: {instruction}");
         }
 
         // Save intermediate result to local, since we'll need to reference it multiple times below.
-        var integerVectorType = TypeSystem.GetGenericVectorType(operand0.TypeOf).MakeGenericType(TypeSystem.GetIntegerType(TypeSystem.GetSizeOfTypeInBits(operand0.TypeOf.ElementType)));
+        var integerVectorType = TypeSystem.GetGenericVectorType(operandType).MakeGenericType(TypeSystem.GetIntegerType(TypeSystem.GetSizeOfTypeInBits(operandType.ElementType)));
         var intermediateLocal = ILGenerator.DeclareLocal(integerVectorType);
         ILGenerator.Emit(OpCodes.Stloc, intermediateLocal);
 
@@ -794,7 +1180,7 @@ internal sealed class FunctionILEmitter : ILEmitter
         var resultVectorType = TypeSystem.GetMsilVectorType(instruction.TypeOf);
         ILGenerator.Emit(OpCodes.Call, resultVectorType.GetMethodStrict("get_Zero"));
 
-        var inputVectorType = TypeSystem.GetMsilVectorType(operand0.TypeOf);
+        var inputVectorType = TypeSystem.GetMsilVectorType(operandType);
         for (var i = 0; i < instruction.TypeOf.VectorSize; i++)
         {
             ILGenerator.Emit(OpCodes.Ldc_I4, i);
@@ -814,22 +1200,33 @@ internal sealed class FunctionILEmitter : ILEmitter
     private void EmitFCmp(LLVMValueRef instruction)
     {
         var operand0 = instruction.GetOperand(0);
+        var predicate = GetFCmpPredicate(instruction);
 
-        EmitValue(operand0);
-        EmitValue(instruction.GetOperand(1));
+        EmitFCmpOperands(instruction);
 
         switch (operand0.TypeOf.Kind)
         {
             case LLVMTypeKind.LLVMFloatTypeKind:
             case LLVMTypeKind.LLVMDoubleTypeKind:
-                switch (instruction.FCmpPredicate)
+            case LLVMTypeKind.LLVMHalfTypeKind:
+            case LLVMTypeKind.LLVMBFloatTypeKind:
+                // clt, cgt and ceq are false if either operand is NaN, and clt.un and cgt.un are true,
+                // so each predicate is one of them, or the inverse of the opposite one.
+                switch (predicate)
                 {
+                    case LLVMRealPredicate.LLVMRealPredicateFalse:
+                    case LLVMRealPredicate.LLVMRealPredicateTrue:
+                        ILGenerator.Emit(OpCodes.Pop);
+                        ILGenerator.Emit(OpCodes.Pop);
+                        ILGenerator.Emit(predicate == LLVMRealPredicate.LLVMRealPredicateTrue ? OpCodes.Ldc_I4_1 : OpCodes.Ldc_I4_0);
+                        break;
+
                     case LLVMRealPredicate.LLVMRealOEQ:
                         ILGenerator.Emit(OpCodes.Ceq);
                         break;
 
                     case LLVMRealPredicate.LLVMRealOGE:
-                        ILGenerator.Emit(OpCodes.Clt);
+                        ILGenerator.Emit(OpCodes.Clt_Un);
                         ILGenerator.Emit(OpCodes.Ldc_I4_0);
                         ILGenerator.Emit(OpCodes.Ceq);
                         break;
@@ -839,7 +1236,7 @@ internal sealed class FunctionILEmitter : ILEmitter
                         break;
 
                     case LLVMRealPredicate.LLVMRealOLE:
-                        ILGenerator.Emit(OpCodes.Cgt);
+                        ILGenerator.Emit(OpCodes.Cgt_Un);
                         ILGenerator.Emit(OpCodes.Ldc_I4_0);
                         ILGenerator.Emit(OpCodes.Ceq);
                         break;
@@ -849,13 +1246,17 @@ internal sealed class FunctionILEmitter : ILEmitter
                         break;
 
                     case LLVMRealPredicate.LLVMRealUGE:
-                        ILGenerator.Emit(OpCodes.Clt_Un);
+                        ILGenerator.Emit(OpCodes.Clt);
                         ILGenerator.Emit(OpCodes.Ldc_I4_0);
                         ILGenerator.Emit(OpCodes.Ceq);
                         break;
 
-                    case LLVMRealPredicate.LLVMRealULE:
+                    case LLVMRealPredicate.LLVMRealUGT:
                         ILGenerator.Emit(OpCodes.Cgt_Un);
+                        break;
+
+                    case LLVMRealPredicate.LLVMRealULE:
+                        ILGenerator.Emit(OpCodes.Cgt);
                         ILGenerator.Emit(OpCodes.Ldc_I4_0);
                         ILGenerator.Emit(OpCodes.Ceq);
                         break;
@@ -870,28 +1271,113 @@ internal sealed class FunctionILEmitter : ILEmitter
                         ILGenerator.Emit(OpCodes.Ceq);
                         break;
 
+                    case LLVMRealPredicate.LLVMRealONE:
+                    case LLVMRealPredicate.LLVMRealUEQ:
+                    case LLVMRealPredicate.LLVMRealORD:
+                    case LLVMRealPredicate.LLVMRealUNO:
+                        EmitTwoPartFCmp(operand0.TypeOf, predicate);
+                        break;
+
                     default:
-                        throw new NotImplementedException($"Float comparison predicate {instruction.FCmpPredicate} not implemented: {instruction}");
+                        throw new NotImplementedException($"Float comparison predicate {predicate} not implemented: {instruction}");
                 }
                 break;
 
             case LLVMTypeKind.LLVMVectorTypeKind:
-                var vectorComparisonMethodName = instruction.FCmpPredicate switch
+                // The vector comparisons are all ordered. Unordered predicates are the complement
+                // of the opposite ordered one, so for instance UGE is the complement of OLT.
+                var isUnordered = predicate is LLVMRealPredicate.LLVMRealUGT or LLVMRealPredicate.LLVMRealUGE
+                    or LLVMRealPredicate.LLVMRealULT or LLVMRealPredicate.LLVMRealULE or LLVMRealPredicate.LLVMRealUNE;
+                var orderedPredicate = isUnordered
+                    ? (LLVMRealPredicate)(15 - (int)predicate)
+                    : predicate;
+                var vectorComparisonMethodName = orderedPredicate switch
                 {
                     LLVMRealPredicate.LLVMRealOEQ => nameof(Vector128.Equals),
                     LLVMRealPredicate.LLVMRealOGT => nameof(Vector128.GreaterThan),
+                    LLVMRealPredicate.LLVMRealOGE => nameof(Vector128.GreaterThanOrEqual),
                     LLVMRealPredicate.LLVMRealOLT => nameof(Vector128.LessThan),
-                    LLVMRealPredicate.LLVMRealUGE => nameof(Vector128.GreaterThanOrEqual),
-                    _ => throw new NotImplementedException($"Float comparison predicate {instruction.FCmpPredicate} not implemented for vectors: {instruction}"),
+                    LLVMRealPredicate.LLVMRealOLE => nameof(Vector128.LessThanOrEqual),
+                    _ => throw new NotImplementedException($"Float comparison predicate {predicate} not implemented for vectors: {instruction}"),
                 };
-                EmitVectorComparison(instruction, vectorComparisonMethodName);
+                EmitVectorComparison(instruction, vectorComparisonMethodName, complement: isUnordered);
                 break;
 
             default:
                 throw new NotImplementedException($"FCmp not implemented for type {operand0.TypeOf.Kind}: {instruction}");
         }
+    }
+
+    /// <summary>
+    /// Gets the predicate of an fcmp. With the nnan flag, neither operand can be NaN, so whether the predicate
+    /// is ordered or unordered doesn't matter, and this picks whichever is cheaper: ONE and UEQ are single
+    /// comparisons, ORD and UNO are constants, and vectors don't need complementing.
+    /// </summary>
+    private static LLVMRealPredicate GetFCmpPredicate(LLVMValueRef instruction, bool negate = false)
+    {
+        // LLVM encodes the predicates as bit flags for (unordered, less, greater, equal),
+        // so the inverse of a predicate is its complement.
+        var predicate = negate
+            ? (LLVMRealPredicate)(15 - (int)instruction.FCmpPredicate)
+            : instruction.FCmpPredicate;
+
+        // Only read the flags, which is slow, when they'd make a difference.
+        if (predicate is LLVMRealPredicate.LLVMRealPredicateFalse or LLVMRealPredicate.LLVMRealPredicateTrue
+            or LLVMRealPredicate.LLVMRealOEQ or LLVMRealPredicate.LLVMRealOGT or LLVMRealPredicate.LLVMRealOGE
+            or LLVMRealPredicate.LLVMRealOLT or LLVMRealPredicate.LLVMRealOLE
+            || !instruction.GetFastMathFlags().HasFlag(FastMathFlags.NoNaNs))
+        {
+            return predicate;
+        }
+
+        return (LLVMRealPredicate)((int)predicate & 7) switch
+        {
+            LLVMRealPredicate.LLVMRealPredicateFalse => LLVMRealPredicate.LLVMRealPredicateFalse,
+            LLVMRealPredicate.LLVMRealONE => LLVMRealPredicate.LLVMRealUNE,
+            LLVMRealPredicate.LLVMRealORD => LLVMRealPredicate.LLVMRealPredicateTrue,
+            var orderedPredicate => orderedPredicate,
+        };
+    }
+
+    /// <summary>
+    /// ONE, UEQ, ORD and UNO need two comparisons, so the operands are stored in locals.
+    /// ONE is (a &lt; b) | (a &gt; b), and ORD is (a == a) &amp; (b == b), since NaN isn't equal to itself.
+    /// UEQ and UNO are their inverses.
+    /// </summary>
+    private void EmitTwoPartFCmp(LLVMTypeRef operandType, LLVMRealPredicate predicate)
+    {
+        var localType = operandType.Kind == LLVMTypeKind.LLVMDoubleTypeKind ? typeof(double) : typeof(float);
+        var left = ILGenerator.DeclareLocal(localType);
+        var right = ILGenerator.DeclareLocal(localType);
+        ILGenerator.Emit(OpCodes.Stloc, right);
+        ILGenerator.Emit(OpCodes.Stloc, left);
+
+        if (predicate is LLVMRealPredicate.LLVMRealONE or LLVMRealPredicate.LLVMRealUEQ)
+        {
+            ILGenerator.Emit(OpCodes.Ldloc, left);
+            ILGenerator.Emit(OpCodes.Ldloc, right);
+            ILGenerator.Emit(OpCodes.Clt);
+            ILGenerator.Emit(OpCodes.Ldloc, left);
+            ILGenerator.Emit(OpCodes.Ldloc, right);
+            ILGenerator.Emit(OpCodes.Cgt);
+            ILGenerator.Emit(OpCodes.Or);
+        }
+        else
+        {
+            ILGenerator.Emit(OpCodes.Ldloc, left);
+            ILGenerator.Emit(OpCodes.Ldloc, left);
+            ILGenerator.Emit(OpCodes.Ceq);
+            ILGenerator.Emit(OpCodes.Ldloc, right);
+            ILGenerator.Emit(OpCodes.Ldloc, right);
+            ILGenerator.Emit(OpCodes.Ceq);
+            ILGenerator.Emit(OpCodes.And);
+        }
 
-        // TODO: Do the right thing for ordered / unordered equality comparisons.
+        if (predicate is LLVMRealPredicate.LLVMRealUEQ or LLVMRealPredicate.LLVMRealUNO)
+        {
+            ILGenerator.Emit(OpCodes.Ldc_I4_0);
+            ILGenerator.Emit(OpCodes.Ceq);
+        }
     }
 
     private enum Signedness
@@ -902,6 +1388,11 @@ internal sealed class FunctionILEmitter : ILEmitter
 
     private void EmitConversion(LLVMValueRef instruction, Signedness signedness)
     {
+        if (instruction.InstructionOpcode == LLVMOpcode.LLVMTrunc && TryEmitMultiplyHigh(instruction))
+        {
+            return;
+        }
+
         EmitConversion(
             instruction.InstructionOpcode,
             instruction.GetOperand(0),
@@ -914,55 +1405,127 @@ internal sealed class FunctionILEmitter : ILEmitter
         var fromType = operand.TypeOf;
         EmitValue(operand);
 
+        if (IsInt128(fromType) && toType.Kind != LLVMTypeKind.LLVMVectorTypeKind)
+        {
+            if (toType.Kind != LLVMTypeKind.LLVMIntegerTypeKind)
+            {
+                var isSigned = opcode == LLVMOpcode.LLVMSIToFP;
+                EmitCallIntegerUtility((toType.Kind, isSigned) switch
+                {
+                    (LLVMTypeKind.LLVMDoubleTypeKind, true) => nameof(IntegerUtility.ConvertSignedI128ToF64),
+                    (LLVMTypeKind.LLVMDoubleTypeKind, false) => nameof(IntegerUtility.ConvertUnsignedI128ToF64),
+                    (LLVMTypeKind.LLVMFloatTypeKind, true) => nameof(IntegerUtility.ConvertSignedI128ToF32),
+                    (LLVMTypeKind.LLVMFloatTypeKind, false) => nameof(IntegerUtility.ConvertUnsignedI128ToF32),
+                    _ => throw new NotImplementedException($"Conversion not implemented from i128 to {toType}: {opcode}"),
+                });
+                return;
+            }
+
+            // Truncate to i64 first, and then to the destination width below.
+            EmitCallIntegerUtility(nameof(IntegerUtility.TruncateI128ToI64));
+        }
+        else if (IsReducedPrecisionFloat(fromType))
+        {
+            // fpext, fptosi and fptoui all work the same from float.
+            EmitConvertFromReducedPrecision(fromType);
+        }
+        else if (fromType.Kind == LLVMTypeKind.LLVMIntegerTypeKind)
+        {
+            switch (opcode)
+            {
+                case LLVMOpcode.LLVMSExt:
+                case LLVMOpcode.LLVMSIToFP:
+                    // Ensure source type is treated as signed.
+                    EmitSignExtendInPlace(fromType.IntWidth);
+                    break;
+
+                case LLVMOpcode.LLVMZExt:
+                case LLVMOpcode.LLVMUIToFP:
+                    // Ensure source type is treated as unsigned.
+                    EmitZeroExtendInPlace(fromType.IntWidth);
+                    break;
+            }
+        }
+
         switch (toType.Kind)
         {
             case LLVMTypeKind.LLVMDoubleTypeKind:
+                if (opcode == LLVMOpcode.LLVMUIToFP)
+                {
+                    ILGenerator.Emit(OpCodes.Conv_R_Un);
+                }
                 ILGenerator.Emit(OpCodes.Conv_R8);
                 break;
 
             case LLVMTypeKind.LLVMFloatTypeKind:
+                if (opcode == LLVMOpcode.LLVMUIToFP)
+                {
+                    ILGenerator.Emit(OpCodes.Conv_R_Un);
+                }
                 ILGenerator.Emit(OpCodes.Conv_R4);
                 break;
 
-            case LLVMTypeKind.LLVMIntegerTypeKind:
+            case LLVMTypeKind.LLVMHalfTypeKind:
+            case LLVMTypeKind.LLVMBFloatTypeKind:
+                if (fromType.Kind == LLVMTypeKind.LLVMFloatTypeKind)
+                {
+                    EmitConvertToReducedPrecision(typeof(float), toType);
+                }
+                else
+                {
+                    // Integers go through double, which holds all but the largest exactly.
+                    if (opcode == LLVMOpcode.LLVMUIToFP)
+                    {
+                        ILGenerator.Emit(OpCodes.Conv_R_Un);
+                    }
+                    ILGenerator.Emit(OpCodes.Conv_R8);
+                    EmitConvertToReducedPrecision(typeof(double), toType);
+                }
+                break;
+
+            case LLVMTypeKind.LLVMIntegerTypeKind when toType.IntWidth == 128:
                 switch (opcode)
                 {
                     case LLVMOpcode.LLVMSExt:
-                        // Ensure source type is treated as signed.
-                        if (fromType.Kind == LLVMTypeKind.LLVMIntegerTypeKind)
-                        {
-                            switch (fromType.IntWidth)
-                            {
-                                case 8:
-                                    ILGenerator.Emit(OpCodes.Conv_I1);
-                                    break;
-
-                                case 16:
-                                    ILGenerator.Emit(OpCodes.Conv_I2);
-                                    break;
-                            }
-                        }
+                        ILGenerator.Emit(OpCodes.Conv_I8);
+                        EmitCallIntegerUtility(nameof(IntegerUtility.SignExtendI64ToI128));
                         break;
 
                     case LLVMOpcode.LLVMZExt:
-                        // Ensure source type is treated as unsigned.
-                        if (fromType.Kind == LLVMTypeKind.LLVMIntegerTypeKind)
-                        {
-                            switch (fromType.IntWidth)
-                            {
-                                case 8:
-                                    ILGenerator.Emit(OpCodes.Conv_U1);
-                                    break;
+                        ILGenerator.Emit(OpCodes.Conv_U8);
+                        EmitCallIntegerUtility(nameof(IntegerUtility.ZeroExtendI64ToI128));
+                        break;
 
-                                case 16:
-                                    ILGenerator.Emit(OpCodes.Conv_U2);
-                                    break;
-                            }
-                        }
+                    case LLVMOpcode.LLVMFPToSI:
+                        ILGenerator.Emit(OpCodes.Conv_R8);
+                        EmitCallIntegerUtility(nameof(IntegerUtility.ConvertF64ToSignedI128));
+                        break;
+
+                    case LLVMOpcode.LLVMFPToUI:
+                        ILGenerator.Emit(OpCodes.Conv_R8);
+                        EmitCallIntegerUtility(nameof(IntegerUtility.ConvertF64ToUnsignedI128));
                         break;
+
+                    default:
+                        throw new NotImplementedException($"Conversion not implemented to i128: {opcode}");
                 }
+                break;
 
-                switch (toType.IntWidth, signedness)
+            case LLVMTypeKind.LLVMIntegerTypeKind:
+                // Odd widths are converted to the width that holds them, and then have their upper bits cleared.
+                var nativeWidth = IsOddWidthInteger(toType)
+                    ? (toType.IntWidth < 32 ? 32u : 64u)
+                    : toType.IntWidth;
+
+                if (opcode is LLVMOpcode.LLVMFPToSI or LLVMOpcode.LLVMFPToUI)
+                {
+                    EmitConvertFloatToInteger(
+                        fromType.Kind == LLVMTypeKind.LLVMDoubleTypeKind ? typeof(double) : typeof(float),
+                        nativeWidth,
+                        signedness);
+                }
+
+                switch (nativeWidth, signedness)
                 {
                     case (8, Signedness.Signed):
                         ILGenerator.Emit(OpCodes.Conv_I1);
@@ -999,12 +1562,15 @@ internal sealed class FunctionILEmitter : ILEmitter
                     default:
                         throw new NotImplementedException($"Conversion not implemented to {toType.IntWidth}: {opcode}");
                 }
+
+                if (IsOddWidthInteger(toType))
+                {
+                    EmitZeroExtendInPlace(toType.IntWidth);
+                }
                 break;
 
             case LLVMTypeKind.LLVMVectorTypeKind:
-                var convertMethodName = $"Convert{GetIntrinsicMethodSuffix(fromType)}To{GetIntrinsicMethodSuffix(toType)}";
-                var convertMethod = typeof(VectorUtility).GetStaticMethodStrict(convertMethodName);
-                ILGenerator.Emit(OpCodes.Call, convertMethod);
+                EmitVectorConversion(opcode, fromType, toType);
                 break;
 
             default:
@@ -1012,6 +1578,127 @@ internal sealed class FunctionILEmitter : ILEmitter
         }
     }
 
+    /// <summary>
+    /// Converts the <paramref name="valueType"/> on top of the stack to an integer of <paramref name="nativeWidth"/> bits
+    /// without the saturation that .NET's conversions do, leaving an int32 or int64 for the conv.* that follows.
+    /// </summary>
+    private void EmitConvertFloatToInteger(Type valueType, uint nativeWidth, Signedness signedness)
+    {
+        var methodName = (nativeWidth, signedness) switch
+        {
+            (64, Signedness.Signed) => nameof(FloatingPointConversions.ConvertToInt64),
+            (64, Signedness.Unsigned) => nameof(FloatingPointConversions.ConvertToUInt64),
+            (32, Signedness.Unsigned) => nameof(FloatingPointConversions.ConvertToUInt32),
+            _ => nameof(FloatingPointConversions.ConvertToInt32),
+        };
+
+        ILGenerator.Emit(OpCodes.Call, typeof(FloatingPointConversions).GetMethodStrict(methodName, [valueType]));
+    }
+
+    /// <summary>
+    /// Calls the <see cref="VectorConversions"/> method for <paramref name="opcode"/>, whose type arguments
+    /// are the element types, which say what the lanes hold, and the .NET vector types.
+    /// </summary>
+    private void EmitVectorConversion(LLVMOpcode opcode, LLVMTypeRef fromType, LLVMTypeRef toType)
+    {
+        var methodName = opcode switch
+        {
+            LLVMOpcode.LLVMSExt => nameof(VectorConversions.SignExtend),
+            LLVMOpcode.LLVMZExt => nameof(VectorConversions.ZeroExtend),
+            LLVMOpcode.LLVMTrunc => nameof(VectorConversions.Truncate),
+            LLVMOpcode.LLVMSIToFP => nameof(VectorConversions.ConvertSignedToFloat),
+            LLVMOpcode.LLVMUIToFP => nameof(VectorConversions.ConvertUnsignedToFloat),
+            LLVMOpcode.LLVMFPToSI => nameof(VectorConversions.ConvertFloatToSigned),
+            LLVMOpcode.LLVMFPToUI => nameof(VectorConversions.ConvertFloatToUnsigned),
+            LLVMOpcode.LLVMFPExt => nameof(VectorConversions.FloatExtend),
+            LLVMOpcode.LLVMFPTrunc => nameof(VectorConversions.FloatTruncate),
+            _ => throw new NotImplementedException($"Vector conversion not implemented: {opcode}"),
+        };
+
+        var method = typeof(VectorConversions).GetStaticMethodStrict(methodName).MakeGenericMethod(
+            GetVectorConversionElementType(fromType.ElementType),
+            GetVectorConversionElementType(toType.ElementType),
+            TypeSystem.GetMsilType(fromType),
+            TypeSystem.GetMsilType(toType));
+        ILGenerator.Emit(OpCodes.Call, method);
+    }
+
+    private Type GetVectorConversionElementType(LLVMTypeRef elementType)
+    {
+        if (elementType.Kind == LLVMTypeKind.LLVMIntegerTypeKind && elementType.IntWidth is not (1 or 8 or 16 or 32 or 64))
+        {
+            throw new NotImplementedException($"Vector conversion not implemented for element type {elementType}");
+        }
+
+        // bool, Half and BFloat16 tell VectorConversions how to interpret lanes of sbyte and ushort.
+        return TypeSystem.GetMsilType(elementType);
+    }
+
+    private static bool IsInt128(LLVMTypeRef type) =>
+        type.Kind == LLVMTypeKind.LLVMIntegerTypeKind && type.IntWidth == 128;
+
+    private void EmitCallIntegerUtility(string methodName)
+    {
+        ILGenerator.Emit(OpCodes.Call, typeof(IntegerUtility).GetStaticMethodStrict(methodName));
+    }
+
+    /// <summary>
+    /// Clears the bits above <paramref name="width"/> in the integer on top of the stack.
+    /// </summary>
+    private void EmitZeroExtendInPlace(uint width)
+    {
+        switch (width)
+        {
+            case 8:
+                ILGenerator.Emit(OpCodes.Conv_U1);
+                break;
+
+            case 16:
+                ILGenerator.Emit(OpCodes.Conv_U2);
+                break;
+
+            case > 1 and < 32:
+                ILGenerator.Emit(OpCodes.Ldc_I4, (int)((1u << (int)width) - 1));
+                ILGenerator.Emit(OpCodes.And);
+                break;
+
+            case > 32 and < 64:
+                ILGenerator.Emit(OpCodes.Ldc_I8, (long)((1ul << (int)width) - 1));
+                ILGenerator.Emit(OpCodes.And);
+                break;
+        }
+    }
+
+    /// <summary>
+    /// Copies bit <paramref name="width"/> - 1 of the integer on top of the stack into all the bits above it.
+    /// </summary>
+    private void EmitSignExtendInPlace(uint width)
+    {
+        switch (width)
+        {
+            case 1:
+                ILGenerator.Emit(OpCodes.Neg);
+                break;
+
+            case 8:
+                ILGenerator.Emit(OpCodes.Conv_I1);
+                break;
+
+            case 16:
+                ILGenerator.Emit(OpCodes.Conv_I2);
+                break;
+
+            case < 32:
+            case > 32 and < 64:
+                var shiftAmount = (width < 32 ? 32 : 64) - (int)width;
+                ILGenerator.Emit(OpCodes.Ldc_I4, shiftAmount);
+                ILGenerator.Emit(OpCodes.Shl);
+                ILGenerator.Emit(OpCodes.Ldc_I4, shiftAmount);
+                ILGenerator.Emit(OpCodes.Shr);
+                break;
+        }
+    }
+
     private void EmitUnaryOrBinaryOperation(
         LLVMValueRef instruction,
         OpCode scalarOpCode,
@@ -1023,6 +1710,50 @@ internal sealed class FunctionILEmitter : ILEmitter
             throw new InvalidOperationException();
         }
 
+        if (IsInt128(instruction.TypeOf))
+        {
+            EmitInt128Operation(instruction);
+            return;
+        }
+
+        if (IsReducedPrecisionFloat(instruction.TypeOf))
+        {
+            // Like Half's own operators, we do the arithmetic in float. float has more than twice
+            // the precision of half and bfloat, so rounding the result back is still correctly rounded.
+            for (var i = 0u; i < operandCount; i++)
+            {
+                EmitValue(instruction.GetOperand(i));
+                EmitConvertFromReducedPrecision(instruction.TypeOf);
+            }
+            ILGenerator.Emit(scalarOpCode);
+            EmitConvertToReducedPrecision(typeof(float), instruction.TypeOf);
+            return;
+        }
+
+        if (instruction.TypeOf.Kind == LLVMTypeKind.LLVMVectorTypeKind
+            && IsReducedPrecisionFloat(instruction.TypeOf.ElementType))
+        {
+            // And the same for vectors of them, which are widened to vectors of float.
+            var floatVectorType = GetFloatVectorType(instruction.TypeOf);
+            for (var i = 0u; i < operandCount; i++)
+            {
+                EmitValue(instruction.GetOperand(i));
+                EmitVectorConversion(LLVMOpcode.LLVMFPExt, instruction.TypeOf, floatVectorType);
+            }
+            EmitVectorOperation(floatVectorType, vectorMethodName, operandCount);
+            EmitVectorConversion(LLVMOpcode.LLVMFPTrunc, floatVectorType, instruction.TypeOf);
+            return;
+        }
+
+        if (instruction.TypeOf.Kind == LLVMTypeKind.LLVMVectorTypeKind
+            && instruction.InstructionOpcode is LLVMOpcode.LLVMSDiv or LLVMOpcode.LLVMUDiv or LLVMOpcode.LLVMSRem or LLVMOpcode.LLVMURem)
+        {
+            EmitVectorIntegerDivision(instruction, vectorMethodName!);
+            return;
+        }
+
+        var hasVariableShiftAmount = false;
+
         for (var i = 0u; i < operandCount; i++)
         {
             var operand = instruction.GetOperand(i);
@@ -1036,30 +1767,16 @@ internal sealed class FunctionILEmitter : ILEmitter
                     case nameof(Vector128.ShiftRightLogical):
                         if (i == 1)
                         {
-                            // Amount to shift by. We currently only support constant values,
-                            // where all values in the vector are the same constant.
-                            switch (operand.Kind)
+                            // Amount to shift by. When every lane is shifted by the same constant,
+                            // that's a whole-vector shift by a scalar. Otherwise each lane has its own amount.
+                            if (operand.TryGetSplatConstInt(out var shiftCount))
+                            {
+                                ILGenerator.Emit(OpCodes.Ldc_I4, (int)shiftCount);
+                            }
+                            else
                             {
-                                case LLVMValueKind.LLVMConstantDataVectorValueKind:
-                                    var firstValue = operand.GetAggregateElement(0);
-                                    var firstValueConstant = firstValue.Kind switch
-                                    {
-                                        LLVMValueKind.LLVMConstantIntValueKind => (int)firstValue.ConstIntSExt,
-                                        _ => throw new NotImplementedException(),
-                                    };
-                                    for (var j = 1u; j < operand.TypeOf.VectorSize; j++)
-                                    {
-                                        var value = operand.GetAggregateElement(j);
-                                        if (firstValueConstant != (int)value.ConstIntSExt)
-                                        {
-                                            throw new NotImplementedException();
-                                        }
-                                    }
-                                    ILGenerator.Emit(OpCodes.Ldc_I4, firstValueConstant);
-                                    break;
-
-                                default:
-                                    throw new NotImplementedException();
+                                EmitValue(operand);
+                                hasVariableShiftAmount = true;
                             }
                         }
                         else
@@ -1075,13 +1792,18 @@ internal sealed class FunctionILEmitter : ILEmitter
             }
             else
             {
-                if (i == 0 && instruction.InstructionOpcode == LLVMOpcode.LLVMAShr)
+                EmitValue(operand);
+
+                // Signed operations need their operands sign-extended to the width that holds them.
+                var isSignedOperand = instruction.InstructionOpcode switch
                 {
-                    EmitConversion(LLVMOpcode.LLVMSExt, operand, instruction.TypeOf, Signedness.Signed);
-                }
-                else
+                    LLVMOpcode.LLVMAShr => i == 0,
+                    LLVMOpcode.LLVMSDiv or LLVMOpcode.LLVMSRem => true,
+                    _ => false,
+                };
+                if (isSignedOperand)
                 {
-                    EmitValue(operand);
+                    EmitSignExtendInPlace(operand.TypeOf.IntWidth);
                 }
             }
         }
@@ -1090,8 +1812,19 @@ internal sealed class FunctionILEmitter : ILEmitter
         {
             case LLVMTypeKind.LLVMDoubleTypeKind:
             case LLVMTypeKind.LLVMFloatTypeKind:
+                ILGenerator.Emit(scalarOpCode);
+                break;
+
             case LLVMTypeKind.LLVMIntegerTypeKind:
                 ILGenerator.Emit(scalarOpCode);
+
+                // Bitwise operations and unsigned division can't set bits above the width of their operands.
+                if (IsOddWidthInteger(instruction.TypeOf)
+                    && instruction.InstructionOpcode is not (LLVMOpcode.LLVMAnd or LLVMOpcode.LLVMOr or LLVMOpcode.LLVMXor
+                        or LLVMOpcode.LLVMLShr or LLVMOpcode.LLVMUDiv or LLVMOpcode.LLVMURem))
+                {
+                    EmitZeroExtendInPlace(instruction.TypeOf.IntWidth);
+                }
                 break;
 
             case LLVMTypeKind.LLVMVectorTypeKind:
@@ -1099,30 +1832,27 @@ internal sealed class FunctionILEmitter : ILEmitter
                 {
                     throw new NotImplementedException();
                 }
-                var nonGenericVectorType = TypeSystem.GetNonGenericVectorType(instruction.TypeOf);
-                MethodInfo vectorMethod;
                 switch (vectorMethodName)
                 {
                     case nameof(Vector128.ShiftLeft):
                     case nameof(Vector128.ShiftRightArithmetic):
                     case nameof(Vector128.ShiftRightLogical):
+                        // Arithmetic shifts of i8 vectors, which are vectors of byte, and shifts by a vector
+                        // of amounts are implemented by VectorShifts.
                         var vectorType = TypeSystem.GetMsilType(instruction.TypeOf);
-                        vectorMethod = nonGenericVectorType.GetMethodStrict(vectorMethodName, [vectorType, typeof(int)]);
-                        break;
-
-                    case "SignedRemainder":
-                    case "UnsignedRemainder":
-                        vectorMethod = typeof(VectorUtility).GetStaticMethodStrict($"{vectorMethodName}{GetIntrinsicMethodSuffix(instruction.TypeOf)}");
+                        var shiftElementType = TypeSystem.GetMsilVectorElementType(instruction.TypeOf.ElementType);
+                        var shiftMethod = (hasVariableShiftAmount
+                            ? typeof(VectorShifts).FindStaticMethod(vectorMethodName, vectorType, [vectorType, vectorType], shiftElementType)
+                            : TypeSystem.GetNonGenericVectorType(instruction.TypeOf).FindStaticMethod(vectorMethodName, vectorType, [vectorType, typeof(int)])
+                                ?? typeof(VectorShifts).FindStaticMethod(vectorMethodName, vectorType, [vectorType, typeof(int)], shiftElementType))
+                            ?? throw new NotImplementedException($"Vector shift of {instruction.TypeOf} not implemented: {instruction}");
+                        ILGenerator.EmitCall(OpCodes.Call, shiftMethod, null);
                         break;
 
                     default:
-                        var genericVectorType = TypeSystem.GetGenericVectorType(instruction.TypeOf).MakeGenericType(Type.MakeGenericMethodParameter(0));
-                        var genericVectorMethod = nonGenericVectorType.GetMethodStrict(vectorMethodName, Enumerable.Repeat(genericVectorType, operandCount).ToArray()); ;
-                        var elementType = TypeSystem.GetMsilVectorElementType(instruction.TypeOf.ElementType);
-                        vectorMethod = genericVectorMethod.MakeGenericMethod(elementType);
+                        EmitVectorOperation(instruction.TypeOf, vectorMethodName, operandCount);
                         break;
                 }
-                ILGenerator.EmitCall(OpCodes.Call, vectorMethod, null);
                 break;
 
             default:
@@ -1130,29 +1860,407 @@ internal sealed class FunctionILEmitter : ILEmitter
         }
     }
 
-    private static string GetIntrinsicMethodSuffix(LLVMTypeRef typeRef)
+    /// <summary>
+    /// Calls the method of the non-generic vector type, such as <see cref="Vector128.Add{T}"/>, that takes
+    /// <paramref name="operandCount"/> vectors of <paramref name="vectorType"/>.
+    /// </summary>
+    private void EmitVectorOperation(LLVMTypeRef vectorType, string vectorMethodName, int operandCount)
     {
-        var result = new StringBuilder();
+        var genericVectorType = TypeSystem.GetGenericVectorType(vectorType).MakeGenericType(Type.MakeGenericMethodParameter(0));
+        var genericVectorMethod = TypeSystem.GetNonGenericVectorType(vectorType).GetMethodStrict(vectorMethodName, Enumerable.Repeat(genericVectorType, operandCount).ToArray());
+        var elementType = TypeSystem.GetMsilVectorElementType(vectorType.ElementType);
+        ILGenerator.EmitCall(OpCodes.Call, genericVectorMethod.MakeGenericMethod(elementType), null);
+    }
+
+    /// <summary>
+    /// The vector of floats with as many lanes as <paramref name="vectorType"/>, which is a vector of half or bfloat.
+    /// </summary>
+    private static LLVMTypeRef GetFloatVectorType(LLVMTypeRef vectorType) =>
+        LLVMTypeRef.CreateVector(vectorType.Context.FloatType, vectorType.VectorSize);
+
+    /// <summary>
+    /// Emits sdiv, udiv, srem or urem of integer vectors, which .NET would otherwise do one lane at a time.
+    /// When every lane of the divisor is the same constant, the magic numbers that turn the division into
+    /// a multiply-high and shifts are worked out here, and passed to <see cref="VectorUtility"/> as constants.
+    /// </summary>
+    private void EmitVectorIntegerDivision(LLVMValueRef instruction, string methodName)
+    {
+        var bitCount = (int)instruction.TypeOf.ElementType.IntWidth;
+        if (bitCount is not (8 or 16 or 32 or 64))
+        {
+            throw new NotImplementedException($"Vector division of {instruction.TypeOf} not implemented: {instruction}");
+        }
+
+        var isSigned = instruction.InstructionOpcode is LLVMOpcode.LLVMSDiv or LLVMOpcode.LLVMSRem;
+        var vectorType = TypeSystem.GetMsilType(instruction.TypeOf);
+        var elementType = TypeSystem.GetMsilVectorElementType(instruction.TypeOf.ElementType);
+
+        EmitValue(instruction.GetOperand(0));
+
+        var divisorOperand = instruction.GetOperand(1);
+        MethodInfo? method;
+        if (divisorOperand.TryGetSplatConstInt(out var divisor) && divisor != 0)
+        {
+            if (isSigned)
+            {
+                var signedDivisor = (long)(divisor << (64 - bitCount)) >> (64 - bitCount);
+                var (multiplier, shift) = DivisionMagic.GetSigned(signedDivisor, bitCount);
+                EmitVectorElementConstant(elementType, signedDivisor);
+                EmitVectorElementConstant(elementType, multiplier);
+                ILGenerator.Emit(OpCodes.Ldc_I4, shift);
+                method = typeof(VectorUtility).FindStaticMethod(methodName, vectorType, [vectorType, elementType, elementType, typeof(int)], elementType);
+            }
+            else
+            {
+                var (multiplier, shift, isAdd) = DivisionMagic.GetUnsigned(divisor, bitCount);
+                EmitVectorElementConstant(elementType, (long)divisor);
+                EmitVectorElementConstant(elementType, (long)multiplier);
+                ILGenerator.Emit(OpCodes.Ldc_I4, shift);
+                ILGenerator.Emit(isAdd ? OpCodes.Ldc_I4_1 : OpCodes.Ldc_I4_0);
+                method = typeof(VectorUtility).FindStaticMethod(methodName, vectorType, [vectorType, elementType, elementType, typeof(int), typeof(bool)], elementType);
+            }
+        }
+        else
+        {
+            EmitValue(divisorOperand);
+
+            // The padding lanes of a divisor could be zero, and integer division by zero throws.
+            if (TypeSystem.IsPaddedVectorType(instruction.TypeOf))
+            {
+                EmitFillPaddingLanesWithOne(instruction.TypeOf);
+            }
+
+            method = typeof(VectorUtility).FindStaticMethod(methodName, vectorType, [vectorType, vectorType], elementType);
+        }
+
+        ILGenerator.EmitCall(
+            OpCodes.Call,
+            method ?? throw new NotImplementedException($"Vector division of {instruction.TypeOf} not implemented: {instruction}"),
+            null);
+    }
 
-        if (typeRef.Kind == LLVMTypeKind.LLVMVectorTypeKind)
+    /// <summary>
+    /// Pushes a constant of the element type of an integer vector, truncated to fit.
+    /// </summary>
+    private void EmitVectorElementConstant(Type elementType, long value)
+    {
+        if (elementType == typeof(long))
         {
-            result.Append('V');
-            result.Append(typeRef.VectorSize);
+            ILGenerator.Emit(OpCodes.Ldc_I8, value);
         }
+        else
+        {
+            ILGenerator.Emit(OpCodes.Ldc_I4, (int)value);
+        }
+    }
 
-        var elementType = typeRef.Kind == LLVMTypeKind.LLVMVectorTypeKind
-            ? typeRef.ElementType
-            : typeRef;
+    /// <summary>
+    /// Sets the padding lanes of the integer vector on top of the stack to 1.
+    /// </summary>
+    private void EmitFillPaddingLanesWithOne(LLVMTypeRef vectorType)
+    {
+        var elementType = TypeSystem.GetMsilVectorElementType(vectorType.ElementType);
+        var nonGenericVectorType = TypeSystem.GetNonGenericVectorType(vectorType);
 
-        result.Append(elementType.Kind switch
+        for (var i = (int)vectorType.VectorSize; i < TypeSystem.GetMsilVectorLength(vectorType); i++)
         {
-            LLVMTypeKind.LLVMIntegerTypeKind => $"I{elementType.IntWidth}",
-            LLVMTypeKind.LLVMDoubleTypeKind => "F64",
-            LLVMTypeKind.LLVMFloatTypeKind => "F32",
-            _ => throw new InvalidOperationException()
+            ILGenerator.Emit(OpCodes.Ldc_I4, i);
+            ILGenerator.Emit(OpCodes.Ldc_I4_1);
+            if (elementType == typeof(long))
+            {
+                ILGenerator.Emit(OpCodes.Conv_I8);
+            }
+            EmitVectorWithElement(nonGenericVectorType, elementType);
+        }
+    }
+
+    private void EmitInt128Operation(LLVMValueRef instruction)
+    {
+        if (instruction.InstructionOpcode == LLVMOpcode.LLVMMul
+            && TryGetWideningMultiplySignedness(instruction, out var signedness))
+        {
+            EmitWideningMultiplyOperand(instruction.GetOperand(0));
+            EmitWideningMultiplyOperand(instruction.GetOperand(1));
+            EmitCallIntegerUtility(signedness == Signedness.Signed
+                ? nameof(IntegerUtility.MultiplySigned)
+                : nameof(IntegerUtility.MultiplyUnsigned));
+            return;
+        }
+
+        EmitValue(instruction.GetOperand(0));
+        EmitValue(instruction.GetOperand(1));
+
+        EmitCallIntegerUtility(instruction.InstructionOpcode switch
+        {
+            LLVMOpcode.LLVMAdd => nameof(IntegerUtility.Add),
+            LLVMOpcode.LLVMSub => nameof(IntegerUtility.Subtract),
+            LLVMOpcode.LLVMMul => nameof(IntegerUtility.Multiply),
+            LLVMOpcode.LLVMSDiv => nameof(IntegerUtility.SignedDivide),
+            LLVMOpcode.LLVMUDiv => nameof(IntegerUtility.UnsignedDivide),
+            LLVMOpcode.LLVMSRem => nameof(IntegerUtility.SignedRemainder),
+            LLVMOpcode.LLVMURem => nameof(IntegerUtility.UnsignedRemainder),
+            LLVMOpcode.LLVMAnd => nameof(IntegerUtility.And),
+            LLVMOpcode.LLVMOr => nameof(IntegerUtility.Or),
+            LLVMOpcode.LLVMXor => nameof(IntegerUtility.Xor),
+            LLVMOpcode.LLVMShl => nameof(IntegerUtility.ShiftLeft),
+            LLVMOpcode.LLVMAShr => nameof(IntegerUtility.ShiftRightArithmetic),
+            LLVMOpcode.LLVMLShr => nameof(IntegerUtility.ShiftRightLogical),
+            _ => throw new NotImplementedException($"i128 operation not implemented: {instruction}"),
         });
+    }
+
+    /// <summary>
+    /// Checks for a mul of two i64s that have both been zero-extended or both sign-extended to i128,
+    /// which is how clang expresses a 64 x 64 -> 128-bit multiplication.
+    /// </summary>
+    private static bool TryGetWideningMultiplySignedness(LLVMValueRef instruction, out Signedness signedness)
+    {
+        foreach (var candidate in (ReadOnlySpan<Signedness>)[Signedness.Unsigned, Signedness.Signed])
+        {
+            if (IsWideningMultiplyOperand(instruction.GetOperand(0), candidate)
+                && IsWideningMultiplyOperand(instruction.GetOperand(1), candidate))
+            {
+                signedness = candidate;
+                return true;
+            }
+        }
+
+        signedness = default;
+        return false;
+    }
+
+    private static bool IsWideningMultiplyOperand(LLVMValueRef operand, Signedness signedness)
+    {
+        if (operand.Kind == LLVMValueKind.LLVMConstantIntValueKind)
+        {
+            var value = operand.GetConstInt128();
+            return signedness == Signedness.Signed
+                ? value >= long.MinValue && value <= long.MaxValue
+                : value >= 0 && value <= ulong.MaxValue;
+        }
+
+        return operand.Kind == LLVMValueKind.LLVMInstructionValueKind
+            && operand.InstructionOpcode == (signedness == Signedness.Signed ? LLVMOpcode.LLVMSExt : LLVMOpcode.LLVMZExt)
+            && operand.GetOperand(0).TypeOf.Kind == LLVMTypeKind.LLVMIntegerTypeKind
+            && operand.GetOperand(0).TypeOf.IntWidth == 64;
+    }
+
+    private void EmitWideningMultiplyOperand(LLVMValueRef operand)
+    {
+        if (operand.Kind == LLVMValueKind.LLVMConstantIntValueKind)
+        {
+            ILGenerator.Emit(OpCodes.Ldc_I8, (long)operand.GetConstInt128());
+        }
+        else if (CanPushToStack(operand))
+        {
+            // Skip the extension altogether.
+            EmitValue(operand.GetOperand(0));
+        }
+        else
+        {
+            // The extended value is in a local, and truncating it gets back the original.
+            EmitValue(operand);
+            EmitCallIntegerUtility(nameof(IntegerUtility.TruncateI128ToI64));
+        }
+    }
+
+    /// <summary>
+    /// trunc (lshr (mul (zext a), (zext b)), 64) to i64 is the high half of a 64 x 64-bit multiplication,
+    /// which we can get from <see cref="Math.BigMul(ulong, ulong, out ulong)"/> without building an <see cref="Int128"/>.
+    /// </summary>
+    private bool TryEmitMultiplyHigh(LLVMValueRef instruction)
+    {
+        var shift = instruction.GetOperand(0);
+
+        if (instruction.TypeOf.IntWidth != 64
+            || !IsInt128(shift.TypeOf)
+            || shift.Kind != LLVMValueKind.LLVMInstructionValueKind
+            || shift.InstructionOpcode is not (LLVMOpcode.LLVMLShr or LLVMOpcode.LLVMAShr)
+            || !CanPushToStack(shift)
+            || shift.GetOperand(1).Kind != LLVMValueKind.LLVMConstantIntValueKind
+            || shift.GetOperand(1).GetConstInt128() != 64)
+        {
+            return false;
+        }
+
+        var multiply = shift.GetOperand(0);
+
+        if (multiply.Kind != LLVMValueKind.LLVMInstructionValueKind
+            || multiply.InstructionOpcode != LLVMOpcode.LLVMMul
+            || !CanPushToStack(multiply)
+            || !TryGetWideningMultiplySignedness(multiply, out var signedness))
+        {
+            return false;
+        }
+
+        // Whether the shift was arithmetic or logical doesn't matter once we truncate.
+        var operandType = signedness == Signedness.Signed ? typeof(long) : typeof(ulong);
+        var lowLocal = ILGenerator.DeclareLocal(operandType);
+
+        EmitWideningMultiplyOperand(multiply.GetOperand(0));
+        EmitWideningMultiplyOperand(multiply.GetOperand(1));
+        ILGenerator.Emit(OpCodes.Ldloca, lowLocal);
+        ILGenerator.Emit(OpCodes.Call, typeof(Math).GetMethodStrict(nameof(Math.BigMul), [operandType, operandType, operandType.MakeByRefType()]));
+
+        return true;
+    }
+
+    /// <summary>
+    /// An fadd or fsub of an fmul, where both have the contract flag, can be done as a fused multiply-add,
+    /// which skips rounding the product. Without the flag, they're rounded separately, as IEEE requires.
+    /// </summary>
+    private bool TryEmitFusedMultiplyAdd(LLVMValueRef instruction)
+    {
+        var type = instruction.TypeOf;
+        var isVector = type.Kind == LLVMTypeKind.LLVMVectorTypeKind;
+        var elementType = isVector ? type.ElementType : type;
+
+        if (elementType.Kind is not (LLVMTypeKind.LLVMFloatTypeKind or LLVMTypeKind.LLVMDoubleTypeKind))
+        {
+            return false;
+        }
+
+        var multiplyIndex = IsContractibleMultiply(instruction.GetOperand(0)) ? 0u
+            : IsContractibleMultiply(instruction.GetOperand(1)) ? 1u
+            : (uint?)null;
+
+        if (multiplyIndex == null
+            || !instruction.GetFastMathFlags().HasFlag(FastMathFlags.AllowContract))
+        {
+            return false;
+        }
+
+        var msilType = TypeSystem.GetMsilType(type);
+        MethodInfo? fusedMultiplyAdd;
+        if (isVector)
+        {
+            fusedMultiplyAdd = TypeSystem.GetNonGenericVectorType(type).FindStaticMethod(
+                nameof(Vector128.FusedMultiplyAdd),
+                msilType,
+                [msilType, msilType, msilType],
+                TypeSystem.GetMsilVectorElementType(elementType));
 
-        return result.ToString();
+            if (fusedMultiplyAdd == null)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            fusedMultiplyAdd = (msilType == typeof(float) ? typeof(MathF) : typeof(Math))
+                .GetMethodStrict(nameof(Math.FusedMultiplyAdd), [msilType, msilType, msilType]);
+        }
+
+        var multiply = instruction.GetOperand(multiplyIndex.Value);
+        var addend = instruction.GetOperand(1 - multiplyIndex.Value);
+        var isSubtract = instruction.InstructionOpcode == LLVMOpcode.LLVMFSub;
+
+        // a * b - c is fma(a, b, -c), and c - a * b is fma(-a, b, c). Negation is exact, so these round the same way.
+        EmitValue(multiply.GetOperand(0));
+        if (isSubtract && multiplyIndex == 1)
+        {
+            EmitNegate(type);
+        }
+        EmitValue(multiply.GetOperand(1));
+        EmitValue(addend);
+        if (isSubtract && multiplyIndex == 0)
+        {
+            EmitNegate(type);
+        }
+
+        ILGenerator.Emit(OpCodes.Call, fusedMultiplyAdd);
+
+        return true;
+    }
+
+    /// <summary>
+    /// Whether this is an fmul with the contract flag whose only use is the instruction being emitted,
+    /// so that it doesn't need its own result.
+    /// </summary>
+    private bool IsContractibleMultiply(LLVMValueRef value) =>
+        value.Kind == LLVMValueKind.LLVMInstructionValueKind
+        && value.InstructionOpcode == LLVMOpcode.LLVMFMul
+        && CanPushToStack(value)
+        && value.GetFastMathFlags().HasFlag(FastMathFlags.AllowContract);
+
+    /// <summary>
+    /// With the arcp flag, division by a constant can be multiplication by its reciprocal, which is several times
+    /// faster. Divisors whose reciprocal would overflow or be subnormal are left alone, since those would lose too much.
+    /// </summary>
+    private bool TryEmitReciprocalMultiply(LLVMValueRef instruction)
+    {
+        var type = instruction.TypeOf;
+        var isVector = type.Kind == LLVMTypeKind.LLVMVectorTypeKind;
+        var elementType = isVector ? type.ElementType : type;
+
+        if (elementType.Kind is not (LLVMTypeKind.LLVMFloatTypeKind or LLVMTypeKind.LLVMDoubleTypeKind)
+            || !instruction.GetOperand(1).TryGetSplatConstReal(out var divisor))
+        {
+            return false;
+        }
+
+        var isFloat = elementType.Kind == LLVMTypeKind.LLVMFloatTypeKind;
+        var reciprocal = isFloat ? 1.0f / (float)divisor : 1.0 / divisor;
+
+        if ((isFloat ? !float.IsNormal((float)reciprocal) : !double.IsNormal(reciprocal))
+            || !instruction.GetFastMathFlags().HasFlag(FastMathFlags.AllowReciprocal))
+        {
+            return false;
+        }
+
+        MethodInfo? multiply = null;
+        if (isVector)
+        {
+            var msilType = TypeSystem.GetMsilType(type);
+            var msilElementType = TypeSystem.GetMsilVectorElementType(elementType);
+
+            multiply = TypeSystem.GetNonGenericVectorType(type).FindStaticMethod(
+                nameof(Vector128.Multiply),
+                msilType,
+                [msilType, msilElementType],
+                msilElementType);
+
+            if (multiply == null)
+            {
+                return false;
+            }
+        }
+
+        EmitValue(instruction.GetOperand(0));
+
+        if (isFloat)
+        {
+            ILGenerator.Emit(OpCodes.Ldc_R4, (float)reciprocal);
+        }
+        else
+        {
+            ILGenerator.Emit(OpCodes.Ldc_R8, reciprocal);
+        }
+
+        if (multiply != null)
+        {
+            ILGenerator.Emit(OpCodes.Call, multiply);
+        }
+        else
+        {
+            ILGenerator.Emit(OpCodes.Mul);
+        }
+
+        return true;
+    }
+
+    private void EmitNegate(LLVMTypeRef type)
+    {
+        if (type.Kind == LLVMTypeKind.LLVMVectorTypeKind)
+        {
+            var genericVectorType = TypeSystem.GetGenericVectorType(type).MakeGenericType(Type.MakeGenericMethodParameter(0));
+            var negate = TypeSystem.GetNonGenericVectorType(type).GetMethodStrict(nameof(Vector128.Negate), [genericVectorType]);
+            ILGenerator.Emit(OpCodes.Call, negate.MakeGenericMethod(TypeSystem.GetMsilVectorElementType(type.ElementType)));
+        }
+        else
+        {
+            ILGenerator.Emit(OpCodes.Neg);
+        }
     }
 
     private void EmitUnaryOperation(
@@ -1175,28 +2283,36 @@ internal sealed class FunctionILEmitter : ILEmitter
     {
         if (instruction.IsConditional)
         {
-            var branchOpcode = EmitBranchCondition(instruction.Condition);
-
             var trueBlock = instruction.GetSuccessor(0);
+            var falseBlock = instruction.GetSuccessor(1);
+
+            // If the true block comes next, branch on the inverse condition
+            // so that we can fall through to it.
+            var negate = IsNextBlock(trueBlock) && !trueBlock.ContainsPhiNodes();
+            var (takenBlock, notTakenBlock) = negate
+                ? (falseBlock, trueBlock)
+                : (trueBlock, falseBlock);
 
-            Label? trueBlockPhiLabel = null;
-            if (trueBlock.ContainsPhiNodes())
+            var branchOpcode = EmitBranchCondition(instruction.Condition, negate);
+
+            Label? takenBlockPhiLabel = null;
+            if (takenBlock.ContainsPhiNodes())
             {
-                trueBlockPhiLabel = ILGenerator.DefineLabel();
-                ILGenerator.Emit(branchOpcode, trueBlockPhiLabel.Value);
+                takenBlockPhiLabel = ILGenerator.DefineLabel();
+                ILGenerator.Emit(branchOpcode, takenBlockPhiLabel.Value);
             }
             else
             {
-                ILGenerator.Emit(branchOpcode, GetOrCreateLabel(trueBlock));
+                ILGenerator.Emit(branchOpcode, GetOrCreateLabel(takenBlock));
             }
 
-            EmitBranchUnconditional(instruction, instruction.GetSuccessor(1));
+            // We can't fall through to the next block if the phi values for the taken block are in the way.
+            EmitBranchUnconditional(instruction, notTakenBlock, canFallThrough: takenBlockPhiLabel == null);
 
-            if (trueBlockPhiLabel != null)
+            if (takenBlockPhiLabel != null)
             {
-                ILGenerator.MarkLabel(trueBlockPhiLabel.Value);
-                EmitPhiValues(instruction.InstructionParent, trueBlock);
-                ILGenerator.Emit(OpCodes.Br, GetOrCreateLabel(trueBlock));
+                ILGenerator.MarkLabel(takenBlockPhiLabel.Value);
+                EmitBranchUnconditional(instruction, takenBlock);
             }
         }
         else
@@ -1205,16 +2321,20 @@ internal sealed class FunctionILEmitter : ILEmitter
         }
     }
 
-    private OpCode EmitBranchCondition(LLVMValueRef condition)
+    private OpCode EmitBranchCondition(LLVMValueRef condition, bool negate)
     {
         if (CanPushToStack(condition)
             && condition.InstructionOpcode == LLVMOpcode.LLVMICmp
-            && condition.TypeOf.Kind == LLVMTypeKind.LLVMIntegerTypeKind)
+            && condition.TypeOf.Kind == LLVMTypeKind.LLVMIntegerTypeKind
+            && !IsInt128(condition.GetOperand(0).TypeOf))
         {
-            EmitValue(condition.GetOperand(0));
-            EmitValue(condition.GetOperand(1));
+            EmitICmpOperands(condition);
+
+            var predicate = negate
+                ? GetInversePredicate(condition.ICmpPredicate)
+                : condition.ICmpPredicate;
 
-            return condition.ICmpPredicate switch
+            return predicate switch
             {
                 LLVMIntPredicate.LLVMIntEQ => OpCodes.Beq,
                 LLVMIntPredicate.LLVMIntNE => OpCodes.Bne_Un,
@@ -1222,48 +2342,74 @@ internal sealed class FunctionILEmitter : ILEmitter
                 LLVMIntPredicate.LLVMIntSGT => OpCodes.Bgt,
                 LLVMIntPredicate.LLVMIntSLT => OpCodes.Blt,
                 LLVMIntPredicate.LLVMIntSLE => OpCodes.Ble,
+                LLVMIntPredicate.LLVMIntUGE => OpCodes.Bge_Un,
                 LLVMIntPredicate.LLVMIntUGT => OpCodes.Bgt_Un,
                 LLVMIntPredicate.LLVMIntULE => OpCodes.Ble_Un,
                 LLVMIntPredicate.LLVMIntULT => OpCodes.Blt_Un,
-                _ => throw new NotImplementedException($"Branch condition integer comparison {condition.ICmpPredicate} not implemented: {condition}"),
+                _ => throw new NotImplementedException($"Branch condition integer comparison {predicate} not implemented: {condition}"),
             };
         }
         else if (CanPushToStack(condition)
             && condition.InstructionOpcode == LLVMOpcode.LLVMFCmp
-            && condition.TypeOf.Kind == LLVMTypeKind.LLVMIntegerTypeKind)
+            && condition.TypeOf.Kind == LLVMTypeKind.LLVMIntegerTypeKind
+            && GetFCmpBranchOpCode(GetFCmpPredicate(condition, negate)) is OpCode fcmpBranchOpCode)
         {
-            EmitValue(condition.GetOperand(0));
-            EmitValue(condition.GetOperand(1));
+            EmitFCmpOperands(condition);
 
-            return condition.FCmpPredicate switch
-            {
-                LLVMRealPredicate.LLVMRealOEQ => OpCodes.Beq,
-                LLVMRealPredicate.LLVMRealOGE => OpCodes.Bge,
-                LLVMRealPredicate.LLVMRealOGT => OpCodes.Bgt,
-                LLVMRealPredicate.LLVMRealOLE => OpCodes.Ble,
-                LLVMRealPredicate.LLVMRealOLT => OpCodes.Blt,
-                LLVMRealPredicate.LLVMRealUGE => OpCodes.Bge_Un,
-                LLVMRealPredicate.LLVMRealULE => OpCodes.Ble_Un,
-                LLVMRealPredicate.LLVMRealULT => OpCodes.Blt_Un,
-                LLVMRealPredicate.LLVMRealUNE => OpCodes.Bne_Un,
-                _ => throw new NotImplementedException($"Branch condition float comparison {condition.FCmpPredicate} not implemented: {condition}"),
-            };
+            return fcmpBranchOpCode;
         }
         else
         {
             EmitValue(condition);
 
-            return OpCodes.Brtrue;
+            return negate ? OpCodes.Brfalse : OpCodes.Brtrue;
         }
     }
 
-    private void EmitBranchUnconditional(LLVMValueRef brInstruction, LLVMBasicBlockRef to)
+    /// <summary>
+    /// Gets the branch instruction for a float comparison, or null if there isn't one,
+    /// in which case the comparison result is computed and branched on.
+    /// </summary>
+    private static OpCode? GetFCmpBranchOpCode(LLVMRealPredicate predicate) => predicate switch
+    {
+        LLVMRealPredicate.LLVMRealOEQ => OpCodes.Beq,
+        LLVMRealPredicate.LLVMRealOGE => OpCodes.Bge,
+        LLVMRealPredicate.LLVMRealOGT => OpCodes.Bgt,
+        LLVMRealPredicate.LLVMRealOLE => OpCodes.Ble,
+        LLVMRealPredicate.LLVMRealOLT => OpCodes.Blt,
+        LLVMRealPredicate.LLVMRealUGE => OpCodes.Bge_Un,
+        LLVMRealPredicate.LLVMRealUGT => OpCodes.Bgt_Un,
+        LLVMRealPredicate.LLVMRealULE => OpCodes.Ble_Un,
+        LLVMRealPredicate.LLVMRealULT => OpCodes.Blt_Un,
+        LLVMRealPredicate.LLVMRealUNE => OpCodes.Bne_Un,
+        _ => null,
+    };
+
+    private static LLVMIntPredicate GetInversePredicate(LLVMIntPredicate predicate) => predicate switch
+    {
+        LLVMIntPredicate.LLVMIntEQ => LLVMIntPredicate.LLVMIntNE,
+        LLVMIntPredicate.LLVMIntNE => LLVMIntPredicate.LLVMIntEQ,
+        LLVMIntPredicate.LLVMIntUGT => LLVMIntPredicate.LLVMIntULE,
+        LLVMIntPredicate.LLVMIntUGE => LLVMIntPredicate.LLVMIntULT,
+        LLVMIntPredicate.LLVMIntULT => LLVMIntPredicate.LLVMIntUGE,
+        LLVMIntPredicate.LLVMIntULE => LLVMIntPredicate.LLVMIntUGT,
+        LLVMIntPredicate.LLVMIntSGT => LLVMIntPredicate.LLVMIntSLE,
+        LLVMIntPredicate.LLVMIntSGE => LLVMIntPredicate.LLVMIntSLT,
+        LLVMIntPredicate.LLVMIntSLT => LLVMIntPredicate.LLVMIntSGE,
+        LLVMIntPredicate.LLVMIntSLE => LLVMIntPredicate.LLVMIntSGT,
+        _ => throw new NotImplementedException($"Integer predicate {predicate} not implemented"),
+    };
+
+    private void EmitBranchUnconditional(LLVMValueRef brInstruction, LLVMBasicBlockRef to, bool canFallThrough = true)
     {
         if (to.ContainsPhiNodes())
         {
             EmitPhiValues(brInstruction.InstructionParent, to);
         }
-        ILGenerator.Emit(OpCodes.Br, GetOrCreateLabel(to));
+        if (!canFallThrough || !IsNextBlock(to))
+        {
+            ILGenerator.Emit(OpCodes.Br, GetOrCreateLabel(to));
+        }
     }
 
     private unsafe void EmitCall(LLVMValueRef instruction)
@@ -1274,22 +2420,16 @@ internal sealed class FunctionILEmitter : ILEmitter
 
         if (instruction.IsAIntrinsicInst != null)
         {
-            var functionName = functionToCall.Name;
-            if (IntrinsicFunctions.LLVMIntrinsics.TryGetValue(functionName, out var intrinsic))
-            {
-                var callContext = new IntrinsicFunctionCallContext(
-                    _method,
-                    Locals,
-                    ILGenerator,
-                    operands,
-                    EmitValue);
-                intrinsic.BuildCall(callContext);
-                return;
-            }
-            else
-            {
-                throw new NotImplementedException($"Unknown LLVM intrinsic: {functionName}");
-            }
+            var intrinsic = CompiledModule.Intrinsics.Resolve(functionToCall);
+            var callContext = new IntrinsicFunctionCallContext(
+                _method,
+                instruction,
+                Locals,
+                ILGenerator,
+                operands,
+                EmitValue);
+            intrinsic.BuildCall(callContext);
+            return;
         }
 
 
@@ -1314,6 +2454,13 @@ internal sealed class FunctionILEmitter : ILEmitter
 
         var numParameters = (int)functionType.ParamTypesCount;
 
+        // Neither the tail. prefix nor the loop transformation below
+        // can be used when the caller or callee needs an arglist.
+        var isTailCall = IsTailCallInTailPosition(instruction) && !isVarArg && !_isVarArg;
+
+        // The shadow stack is restored between the call and the ret, which the tail. prefix doesn't allow.
+        var canUseTailPrefix = isTailCall && !_hasDynamicAllocas;
+
         if (functionToCall.Kind != LLVMValueKind.LLVMFunctionValueKind)
         {
             // This is a function pointer invocation.
@@ -1337,6 +2484,23 @@ internal sealed class FunctionILEmitter : ILEmitter
                     parameterTypes,
                     varArgsParameterTypes);
             }
+            else if (IsCompiledFunction(functionToCall))
+            {
+                // The pointer is an ldftn of a compiled method, which is a managed entry point.
+                // Calling it as managed is also what lets the JIT honor tail.
+                if (canUseTailPrefix)
+                {
+                    ILGenerator.Emit(OpCodes.Tailcall);
+                    InliningBlocker ??= "contains an explicit tail call";
+                }
+
+                ILGenerator.EmitCalli(
+                    OpCodes.Calli,
+                    CallingConventions.Standard,
+                    returnType,
+                    parameterTypes,
+                    null);
+            }
             else
             {
                 ILGenerator.EmitCalli(
@@ -1349,14 +2513,89 @@ internal sealed class FunctionILEmitter : ILEmitter
             return;
         }
 
+        // A self-recursive tail call is turned into a jump back to the entry block,
+        // which doesn't rely on the JIT to honor the tail. prefix.
+        if (isTailCall && functionToCall == _function)
+        {
+            EmitSelfTailCallAsLoop();
+            return;
+        }
+
         var method = CompiledModule.GetFunction(functionToCall);
 
+        // Declarations are P/Invokes or BCL methods, which we leave to a normal call.
+        if (canUseTailPrefix && !functionToCall.IsDeclaration)
+        {
+            ILGenerator.Emit(OpCodes.Tailcall);
+            InliningBlocker ??= "contains an explicit tail call";
+        }
+
         ILGenerator.EmitCall(
             OpCodes.Call,
             method,
             varArgsParameterTypes);
     }
 
+    /// <summary>
+    /// Whether a function pointer is provably a function defined in this module, directly or through a bitcast.
+    /// Any other pointer, such as one loaded from memory or returned by GetProcAddress, may point to native code.
+    /// </summary>
+    private static bool IsCompiledFunction(LLVMValueRef functionPointer)
+    {
+        while ((functionPointer.Kind == LLVMValueKind.LLVMConstantExprValueKind && functionPointer.ConstOpcode == LLVMOpcode.LLVMBitCast)
+            || (functionPointer.Kind == LLVMValueKind.LLVMInstructionValueKind && functionPointer.InstructionOpcode == LLVMOpcode.LLVMBitCast))
+        {
+            functionPointer = functionPointer.GetOperand(0);
+        }
+
+        return functionPointer.Kind == LLVMValueKind.LLVMFunctionValueKind && !functionPointer.IsDeclaration;
+    }
+
+    private bool IsTailCallInTailPosition(LLVMValueRef instruction)
+    {
+        // Covers both `tail` and `musttail`.
+        if (!instruction.IsTailCall)
+        {
+            return false;
+        }
+
+        // The tail. prefix must be immediately followed by ret,
+        // and the call must return exactly what the caller returns.
+        var nextInstruction = instruction.NextInstruction;
+        if (nextInstruction.InstructionOpcode != LLVMOpcode.LLVMRet)
+        {
+            return false;
+        }
+
+        return nextInstruction.OperandCount == 0
+            ? instruction.TypeOf.Kind == LLVMTypeKind.LLVMVoidTypeKind
+            : nextInstruction.GetOperand(0) == instruction && CanPushToStack(instruction);
+    }
+
+    private void EmitSelfTailCallAsLoop()
+    {
+        // The arguments are already on the stack, so pop them into
+        // the parameters in reverse order. The ret that follows is unreachable.
+        for (var i = _function.Params.Length - 1; i >= 0; i--)
+        {
+            ILGenerator.Emit(OpCodes.Starg, (short)i);
+        }
+
+        // Tail calls can't be passed the caller's allocas, so they can be released before the next iteration.
+        EmitRestoreShadowStack();
+
+        ILGenerator.Emit(OpCodes.Br, GetOrCreateLabel(_layout.Entry));
+    }
+
+    private void EmitRestoreShadowStack()
+    {
+        if (_shadowStackMark != null)
+        {
+            ILGenerator.Emit(OpCodes.Ldloc, _shadowStackMark);
+            ILGenerator.Emit(OpCodes.Call, typeof(ShadowStack).GetStaticMethodStrict(nameof(ShadowStack.Restore)));
+        }
+    }
+
     private unsafe void HandleDebugDeclare(LLVMValueRef instruction)
     {
         var value = instruction.GetOperand(0).MDNodeOperands[0];
@@ -1399,6 +2638,12 @@ internal sealed class FunctionILEmitter : ILEmitter
     {
         // TODO: If every operand is const, call GetElementPtrConst
 
+        if (instruction.TypeOf.Kind == LLVMTypeKind.LLVMVectorTypeKind)
+        {
+            EmitVectorGetElementPtr(instruction);
+            return;
+        }
+
         var pointer = instruction.GetOperand(0);
         EmitValue(pointer);
 
@@ -1446,9 +2691,123 @@ internal sealed class FunctionILEmitter : ILEmitter
         }
     }
 
+    /// <summary>
+    /// A getelementptr that computes a vector of pointers, usually for llvm.masked.gather or llvm.masked.scatter.
+    /// Either the base pointer or the indices, or both, can be vectors; scalars apply to every lane.
+    /// Vectors of indices narrower than i64 are sign-extended first.
+    /// </summary>
+    /// <remarks>
+    /// LLVM:
+    /// %ptrs = getelementptr inbounds float, ptr %base, &lt;4 x i64&gt; %indices
+    ///
+    /// .NET:
+    /// Vector256.Add(Vector256.Create((nint)%base), Vector256.Multiply(%indices.As&lt;long, nint&gt;(), Vector256.Create((nint)4)))
+    /// </remarks>
+    private unsafe void EmitVectorGetElementPtr(LLVMValueRef instruction)
+    {
+        var vectorType = instruction.TypeOf;
+        var nonGenericVectorType = TypeSystem.GetNonGenericVectorType(vectorType);
+
+        EmitValue(instruction.GetOperand(0));
+        if (instruction.GetOperand(0).TypeOf.Kind != LLVMTypeKind.LLVMVectorTypeKind)
+        {
+            EmitSplatNativeInt(nonGenericVectorType);
+        }
+
+        var currentType = (LLVMTypeRef)LLVM.GetGEPSourceElementType(instruction);
+
+        for (var i = 1u; i < instruction.OperandCount; i++)
+        {
+            var index = instruction.GetOperand(i);
+
+            // The first index steps over the source element type, and the rest index into it.
+            if (i > 1)
+            {
+                switch (currentType.Kind)
+                {
+                    case LLVMTypeKind.LLVMArrayTypeKind:
+                    case LLVMTypeKind.LLVMVectorTypeKind:
+                        currentType = currentType.ElementType;
+                        break;
+
+                    case LLVMTypeKind.LLVMStructTypeKind:
+                        // Struct indices are constants, and splats if they're vectors.
+                        var fieldIndexValue = index.TypeOf.Kind == LLVMTypeKind.LLVMVectorTypeKind
+                            ? index.GetAggregateElement(0)
+                            : index;
+                        var fieldIndex = (uint)fieldIndexValue.ConstIntSExt;
+                        ILGenerator.Emit(OpCodes.Ldc_I4, TypeSystem.GetStructFieldOffset(currentType, fieldIndex));
+                        ILGenerator.Emit(OpCodes.Conv_I);
+                        EmitSplatNativeInt(nonGenericVectorType);
+                        EmitVectorNativeIntOperation(nonGenericVectorType, nameof(Vector128.Add));
+                        currentType = currentType.StructGetTypeAtIndex(fieldIndex);
+                        continue;
+
+                    default:
+                        throw new NotImplementedException($"getelementptr into {currentType} not implemented: {instruction}");
+                }
+            }
+
+            var sizeInBytes = TypeSystem.GetAllocSizeInBytes(currentType);
+
+            if (index.TypeOf.Kind == LLVMTypeKind.LLVMVectorTypeKind)
+            {
+                if (index.TypeOf.ElementType.IntWidth > 64)
+                {
+                    throw new NotImplementedException($"getelementptr with index type {index.TypeOf} not implemented: {instruction}");
+                }
+
+                EmitValue(index);
+
+                // Narrower indices, such as the <N x i32> ones that loops over int offsets gather with, are signed.
+                if (index.TypeOf.ElementType.IntWidth != 64)
+                {
+                    EmitVectorConversion(
+                        LLVMOpcode.LLVMSExt,
+                        index.TypeOf,
+                        LLVMTypeRef.CreateVector(index.TypeOf.Context.Int64Type, index.TypeOf.VectorSize));
+                }
+
+                ILGenerator.Emit(OpCodes.Call, nonGenericVectorType.GetStaticMethodStrict(nameof(Vector128.As)).MakeGenericMethod(typeof(long), typeof(nint)));
+            }
+            else
+            {
+                EmitValue(index);
+                ILGenerator.Emit(OpCodes.Conv_I);
+                EmitSplatNativeInt(nonGenericVectorType);
+            }
+
+            if (sizeInBytes != 1)
+            {
+                ILGenerator.Emit(OpCodes.Ldc_I4, sizeInBytes);
+                ILGenerator.Emit(OpCodes.Conv_I);
+                EmitSplatNativeInt(nonGenericVectorType);
+                EmitVectorNativeIntOperation(nonGenericVectorType, nameof(Vector128.Multiply));
+            }
+
+            EmitVectorNativeIntOperation(nonGenericVectorType, nameof(Vector128.Add));
+        }
+    }
+
+    private void EmitSplatNativeInt(Type nonGenericVectorType)
+    {
+        ILGenerator.Emit(OpCodes.Call, nonGenericVectorType.GetMethodStrict(nameof(Vector128.Create), [typeof(nint)]));
+    }
+
+    private void EmitVectorNativeIntOperation(Type nonGenericVectorType, string methodName)
+    {
+        var genericVectorType = nonGenericVectorType.GetMethodStrict(nameof(Vector128.Create), [typeof(nint)]).ReturnType
+            .GetGenericTypeDefinition()
+            .MakeGenericType(Type.MakeGenericMethodParameter(0));
+        var vectorMethod = nonGenericVectorType
+            .GetMethodStrict(methodName, [genericVectorType, genericVectorType])
+            .MakeGenericMethod(typeof(nint));
+        ILGenerator.Emit(OpCodes.Call, vectorMethod);
+    }
+
     private void EmitIndexedPtr(LLVMValueRef index, LLVMTypeRef currentType)
     {
-        var sizeInBytes = (long)TypeSystem.GetSizeOfTypeInBytes(currentType);
+        var sizeInBytes = (long)TypeSystem.GetAllocSizeInBytes(currentType);
 
         if (index.Kind == LLVMValueKind.LLVMConstantIntValueKind)
         {
@@ -1529,7 +2888,7 @@ internal sealed class FunctionILEmitter : ILEmitter
                 var trueLabel = ILGenerator.DefineLabel();
                 var endLabel = ILGenerator.DefineLabel();
 
-                var branchOpcode = EmitBranchCondition(operand0);
+                var branchOpcode = EmitBranchCondition(operand0, negate: false);
                 ILGenerator.Emit(branchOpcode, trueLabel);
 
                 EmitValue(instruction.GetOperand(2));
@@ -1558,11 +2917,20 @@ internal sealed class FunctionILEmitter : ILEmitter
 
                 var inputVectorType = TypeSystem.GetMsilVectorType(operand0.TypeOf);
                 var operand1ElementSizeInBits = TypeSystem.GetSizeOfTypeInBits(operand1.TypeOf.ElementType);
-                for (var i = 0; i < instruction.TypeOf.VectorSize; i++)
+                var msilVectorLength = TypeSystem.GetMsilVectorLength(operand1.TypeOf);
+                for (var i = 0; i < msilVectorLength; i++)
                 {
-                    ILGenerator.Emit(OpCodes.Ldloca, intermediateLocal);
-                    ILGenerator.Emit(OpCodes.Ldc_I4, i);
-                    ILGenerator.Emit(OpCodes.Call, inputVectorType.GetMethodStrict("get_Item"));
+                    // Padding lanes can select either operand, so we don't need to read them.
+                    if (i >= instruction.TypeOf.VectorSize)
+                    {
+                        ILGenerator.Emit(OpCodes.Ldc_I4_0);
+                    }
+                    else
+                    {
+                        ILGenerator.Emit(OpCodes.Ldloca, intermediateLocal);
+                        ILGenerator.Emit(OpCodes.Ldc_I4, i);
+                        ILGenerator.Emit(OpCodes.Call, inputVectorType.GetMethodStrict("get_Item"));
+                    }
 
                     // If integer bit width is larger than 32, we extend.
                     if (operand1ElementSizeInBits > 32)
@@ -1572,7 +2940,7 @@ internal sealed class FunctionILEmitter : ILEmitter
                 }
 
                 var nonGenericVectorType = TypeSystem.GetNonGenericVectorType(operand1.TypeOf);
-                var createMethodArgumentTypes = new Type[operand1.TypeOf.VectorSize];
+                var createMethodArgumentTypes = new Type[msilVectorLength];
                 // Integer type with same bitwidth as operand1 element type.
                 Array.Fill(createMethodArgumentTypes, TypeSystem.GetIntegerType(operand1ElementSizeInBits));
                 var createMethod = nonGenericVectorType.GetMethodStrict(nameof(Vector128.Create), createMethodArgumentTypes);
@@ -1702,7 +3070,10 @@ internal sealed class FunctionILEmitter : ILEmitter
             }
         }
 
-        ILGenerator.Emit(OpCodes.Br, GetOrCreateLabel(instruction.SwitchDefaultDest));
+        if (!IsNextBlock(instruction.SwitchDefaultDest))
+        {
+            ILGenerator.Emit(OpCodes.Br, GetOrCreateLabel(instruction.SwitchDefaultDest));
+        }
     }
 
     private void EmitValue(LLVMValueRef valueRef)
@@ -1760,9 +3131,25 @@ internal sealed class FunctionILEmitter : ILEmitter
         var valueRef = instruction.GetOperand(0);
 
         EmitValue(valueRef);
-        EmitLoadIndirect(instruction.TypeOf);
 
-        // TODO: Atomic load?
+        // Aligned loads up to the native word size are atomic in .NET, which is all that
+        // unordered needs. Anything stronger gets the volatile. prefix, which has acquire
+        // semantics and stops the JIT caching the value or hoisting the load out of a loop.
+        // That's enough for seq_cst too, because seq_cst stores are full barriers.
+        if (instruction.IsOrderedOrVolatile())
+        {
+            // Padded vectors are loaded with a call, which can't take the prefix, so they get a fence instead.
+            if (HasPaddedStorage(instruction.TypeOf))
+            {
+                EmitLoadIndirect(instruction.TypeOf);
+                ILGenerator.Emit(OpCodes.Call, typeof(Atomics).GetStaticMethodStrict(nameof(Atomics.AcquireReleaseFence)));
+                return;
+            }
+
+            ILGenerator.Emit(OpCodes.Volatile);
+        }
+
+        EmitLoadIndirect(instruction.TypeOf);
     }
 
     private void EmitLoadIndirect(LLVMTypeRef typeRef)
@@ -1777,6 +3164,28 @@ internal sealed class FunctionILEmitter : ILEmitter
                 ILGenerator.Emit(OpCodes.Ldind_R8);
                 break;
 
+            case LLVMTypeKind.LLVMHalfTypeKind:
+            case LLVMTypeKind.LLVMBFloatTypeKind:
+                ILGenerator.Emit(OpCodes.Ldobj, TypeSystem.GetMsilType(typeRef));
+                break;
+
+            case LLVMTypeKind.LLVMIntegerTypeKind when typeRef.IntWidth == 128:
+                ILGenerator.Emit(OpCodes.Ldobj, typeof(Int128));
+                break;
+
+            case LLVMTypeKind.LLVMIntegerTypeKind when IsOddWidthInteger(typeRef):
+                ILGenerator.Emit(OpCodes.Ldc_I4, GetStoreSizeInBytes(typeRef));
+                EmitCallIntegerUtility(nameof(IntegerUtility.Load));
+                if (typeRef.IntWidth < 32)
+                {
+                    ILGenerator.Emit(OpCodes.Conv_U4);
+                }
+                if (typeRef.IntWidth % 8 != 0)
+                {
+                    EmitZeroExtendInPlace(typeRef.IntWidth);
+                }
+                break;
+
             case LLVMTypeKind.LLVMIntegerTypeKind:
                 switch (typeRef.IntWidth)
                 {
@@ -1806,6 +3215,11 @@ internal sealed class FunctionILEmitter : ILEmitter
                 ILGenerator.Emit(OpCodes.Ldind_I);
                 break;
 
+            case LLVMTypeKind.LLVMVectorTypeKind when HasPaddedStorage(typeRef):
+                ILGenerator.Emit(OpCodes.Ldc_I4, TypeSystem.GetSizeOfTypeInBytes(typeRef));
+                ILGenerator.Emit(OpCodes.Call, typeof(VectorUtility).GetStaticMethodStrict(nameof(VectorUtility.LoadPadded)).MakeGenericMethod(TypeSystem.GetMsilType(typeRef)));
+                break;
+
             case LLVMTypeKind.LLVMVectorTypeKind:
                 ILGenerator.Emit(OpCodes.Ldobj, TypeSystem.GetMsilType(typeRef));
                 break;
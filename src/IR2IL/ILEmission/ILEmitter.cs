@@ -2,6 +2,7 @@ using System;
 using System.Reflection.Emit;
 using System.Runtime.Intrinsics;
 using IR2IL.Helpers;
+using IR2IL.Runtime;
 using LLVMSharp.Interop;
 
 namespace IR2IL.ILEmission;
@@ -72,6 +73,16 @@ internal abstract class ILEmitter
                         }
                         break;
 
+                    case LLVMTypeKind.LLVMHalfTypeKind:
+                    case LLVMTypeKind.LLVMBFloatTypeKind:
+                        ILGenerator.Emit(OpCodes.Ldc_R4, (float)valueRef.GetConstRealDouble(out var losesInfo3));
+                        if (losesInfo3)
+                        {
+                            throw new InvalidOperationException();
+                        }
+                        EmitConvertToReducedPrecision(typeof(float), valueTypeRef);
+                        break;
+
                     default:
                         throw new NotImplementedException();
                 }
@@ -80,15 +91,19 @@ internal abstract class ILEmitter
             case LLVMValueKind.LLVMConstantIntValueKind:
                 switch (valueTypeRef.IntWidth)
                 {
-                    case 1:
-                    case 8:
-                    case 16:
-                    case 32:
+                    case <= 32:
                         ILGenerator.Emit(OpCodes.Ldc_I4, (int)valueRef.ConstIntZExt);
                         break;
 
-                    case 64:
-                        ILGenerator.Emit(OpCodes.Ldc_I8, valueRef.ConstIntSExt);
+                    case <= 64:
+                        ILGenerator.Emit(OpCodes.Ldc_I8, (long)valueRef.ConstIntZExt);
+                        break;
+
+                    case 128:
+                        var int128Value = valueRef.GetConstInt128();
+                        ILGenerator.Emit(OpCodes.Ldc_I8, (long)(ulong)(int128Value >>> 64));
+                        ILGenerator.Emit(OpCodes.Ldc_I8, (long)(ulong)int128Value);
+                        ILGenerator.Emit(OpCodes.Newobj, typeof(Int128).GetConstructorStrict([typeof(ulong), typeof(ulong)]));
                         break;
 
                     default:
@@ -188,7 +203,7 @@ internal abstract class ILEmitter
             throw new NotImplementedException();
         }
 
-        var sizeInBytes = (long)TypeSystem.GetSizeOfTypeInBytes(currentType);
+        var sizeInBytes = (long)TypeSystem.GetAllocSizeInBytes(currentType);
         result += (int)(constExpr.GetOperand(1).ConstIntSExt * sizeInBytes);
 
         for (var i = 2u; i < constExpr.OperandCount; i++)
@@ -203,7 +218,7 @@ internal abstract class ILEmitter
             switch (currentType.Kind)
             {
                 case LLVMTypeKind.LLVMArrayTypeKind:
-                    result += (int)index.ConstIntSExt * TypeSystem.GetSizeOfTypeInBytes(currentType.ElementType);
+                    result += (int)index.ConstIntSExt * TypeSystem.GetAllocSizeInBytes(currentType.ElementType);
                     currentType = currentType.ElementType;
                     break;
 
@@ -319,10 +334,56 @@ internal abstract class ILEmitter
         ILGenerator.Emit(OpCodes.Ldloc, local);
     }
 
+    /// <summary>
+    /// Integers narrower than 64 bits that aren't i1, i8, i16 or i32 are held in the next
+    /// native width up, with the bits above their width clear.
+    /// </summary>
+    protected static bool IsOddWidthInteger(LLVMTypeRef type) =>
+        type.Kind == LLVMTypeKind.LLVMIntegerTypeKind
+        && type.IntWidth < 64
+        && type.IntWidth is not (1 or 8 or 16 or 32);
+
+    protected static int GetStoreSizeInBytes(LLVMTypeRef integerType) => (int)(integerType.IntWidth + 7) / 8;
+
+    /// <summary>
+    /// Whether a vector is padded to a larger .NET vector, so that loading or storing the whole
+    /// .NET vector would touch memory past its end. Vectors of i1 are excluded; their lanes are
+    /// held as whole bytes, so their store size doesn't line up with the .NET vector.
+    /// </summary>
+    protected bool HasPaddedStorage(LLVMTypeRef vectorType) =>
+        TypeSystem.IsPaddedVectorType(vectorType)
+        && vectorType.ElementType is not { Kind: LLVMTypeKind.LLVMIntegerTypeKind, IntWidth: 1 };
+
+    protected static bool IsReducedPrecisionFloat(LLVMTypeRef type) =>
+        type.Kind is LLVMTypeKind.LLVMHalfTypeKind or LLVMTypeKind.LLVMBFloatTypeKind;
+
+    /// <summary>
+    /// Converts the half or bfloat on top of the stack to float, which is exact.
+    /// </summary>
+    protected void EmitConvertFromReducedPrecision(LLVMTypeRef fromType)
+    {
+        var fromMsilType = TypeSystem.GetMsilType(fromType);
+        ILGenerator.Emit(OpCodes.Call, fromMsilType.GetConversionOperatorStrict(fromMsilType, typeof(float)));
+    }
+
+    /// <summary>
+    /// Rounds the float or double on top of the stack to half or bfloat.
+    /// </summary>
+    protected void EmitConvertToReducedPrecision(Type fromMsilType, LLVMTypeRef toType)
+    {
+        var toMsilType = TypeSystem.GetMsilType(toType);
+        ILGenerator.Emit(OpCodes.Call, toMsilType.GetConversionOperatorStrict(fromMsilType, toMsilType));
+    }
+
     protected void EmitStoreIndirect(LLVMTypeRef type)
     {
         switch (type.Kind)
         {
+            case LLVMTypeKind.LLVMVectorTypeKind when HasPaddedStorage(type):
+                ILGenerator.Emit(OpCodes.Ldc_I4, TypeSystem.GetSizeOfTypeInBytes(type));
+                ILGenerator.Emit(OpCodes.Call, typeof(VectorUtility).GetStaticMethodStrict(nameof(VectorUtility.StorePadded)).MakeGenericMethod(TypeSystem.GetMsilType(type)));
+                break;
+
             case LLVMTypeKind.LLVMArrayTypeKind:
             case LLVMTypeKind.LLVMStructTypeKind:
             case LLVMTypeKind.LLVMVectorTypeKind:
@@ -337,6 +398,24 @@ internal abstract class ILEmitter
                 ILGenerator.Emit(OpCodes.Stind_R4);
                 break;
 
+            case LLVMTypeKind.LLVMHalfTypeKind:
+            case LLVMTypeKind.LLVMBFloatTypeKind:
+                ILGenerator.Emit(OpCodes.Stobj, TypeSystem.GetMsilType(type));
+                break;
+
+            case LLVMTypeKind.LLVMIntegerTypeKind when type.IntWidth == 128:
+                ILGenerator.Emit(OpCodes.Stobj, typeof(Int128));
+                break;
+
+            case LLVMTypeKind.LLVMIntegerTypeKind when IsOddWidthInteger(type):
+                if (type.IntWidth <= 32)
+                {
+                    ILGenerator.Emit(OpCodes.Conv_U8);
+                }
+                ILGenerator.Emit(OpCodes.Ldc_I4, GetStoreSizeInBytes(type));
+                ILGenerator.Emit(OpCodes.Call, typeof(IntegerUtility).GetStaticMethodStrict(nameof(IntegerUtility.Store)));
+                break;
+
             case LLVMTypeKind.LLVMIntegerTypeKind:
                 ILGenerator.Emit(type.IntWidth switch
                 {
@@ -8,12 +8,14 @@ namespace IR2IL.Intrinsics;
 
 public readonly ref struct IntrinsicFunctionCallContext(
     MethodInfo callee,
+    LLVMValueRef instruction,
     IReadOnlyDictionary<LLVMValueRef, LocalBuilder> locals,
     ILGenerator ilGenerator,
     LLVMValueRef[] operands,
     Action<LLVMValueRef> emitValue)
 {
     public MethodInfo Callee { get; } = callee;
+    public LLVMValueRef Instruction { get; } = instruction;
     public IReadOnlyDictionary<LLVMValueRef, LocalBuilder> Locals { get; } = locals;
     public ILGenerator ILGenerator { get; } = ilGenerator;
     public LLVMValueRef[] Operands { get; } = operands;
@@ -1,53 +1,504 @@
 using System;
+using System.Buffers.Binary;
 using System.Collections.Generic;
-using System.Runtime.Intrinsics;
+using System.Linq;
+using System.Reflection;
+using System.Reflection.Emit;
+using IR2IL.Helpers;
 using IR2IL.Runtime;
+using LLVMSharp.Interop;
 
 namespace IR2IL.Intrinsics;
 
+/// <summary>
+/// Creates the implementation of an overloaded intrinsic for the function type it's called with,
+/// or returns null if that overload isn't supported.
+/// </summary>
+internal delegate IntrinsicFunction? IntrinsicFamily(TypeSystem typeSystem, LLVMTypeRef functionType);
+
 internal static class IntrinsicFunctions
 {
-    public static readonly Dictionary<string, IntrinsicFunction> LLVMIntrinsics = new()
-    {
-        // Standard intrinsics using Base Class Library methods.
-        { "llvm.ceil.f64", StandardIntrinsicFunction.Create(typeof(Math), nameof(Math.Ceiling), typeof(double)) },
-        { "llvm.copysign.f32", StandardIntrinsicFunction.Create(typeof(MathF), nameof(MathF.CopySign)) },
-        { "llvm.copysign.f64", StandardIntrinsicFunction.Create(typeof(Math), nameof(Math.CopySign)) },
-        { "llvm.fabs.f32", StandardIntrinsicFunction.Create(typeof(MathF), nameof(MathF.Abs)) },
-        { "llvm.fabs.f64", StandardIntrinsicFunction.Create(typeof(Math), nameof(Math.Abs), typeof(double)) },
-        { "llvm.fmuladd.f32", StandardIntrinsicFunction.Create(typeof(MathF), nameof(MathF.FusedMultiplyAdd)) },
-        { "llvm.fmuladd.f64", StandardIntrinsicFunction.Create(typeof(Math), nameof(Math.FusedMultiplyAdd)) },
-        { "llvm.fmuladd.v2f32", StandardIntrinsicFunction.Create(typeof(Vector64), nameof(Vector64.FusedMultiplyAdd), typeof(Vector64<float>), typeof(Vector64<float>), typeof(Vector64<float>)) },
-        { "llvm.fmuladd.v2f64", StandardIntrinsicFunction.Create(typeof(Vector128), nameof(Vector128.FusedMultiplyAdd), typeof(Vector128<double>), typeof(Vector128<double>), typeof(Vector128<double>)) },
-        { "llvm.fmuladd.v4f32", StandardIntrinsicFunction.Create(typeof(Vector128), nameof(Vector128.FusedMultiplyAdd), typeof(Vector128<float>), typeof(Vector128<float>), typeof(Vector128<float>)) },
-        { "llvm.fmuladd.v4f64", StandardIntrinsicFunction.Create(typeof(Vector256), nameof(Vector256.FusedMultiplyAdd), typeof(Vector256<double>), typeof(Vector256<double>), typeof(Vector256<double>)) },
-        { "llvm.smax.i32", StandardIntrinsicFunction.Create(typeof(Math), nameof(Math.Max), typeof(int), typeof(int)) },
-        { "llvm.smax.v4i32", StandardIntrinsicFunction.CreateGeneric(typeof(Vector128), nameof(Vector128.Max), typeof(int)) },
-        { "llvm.sqrt.f32", StandardIntrinsicFunction.Create(typeof(MathF), nameof(MathF.Sqrt)) },
-        { "llvm.sqrt.f64", StandardIntrinsicFunction.Create(typeof(Math), nameof(Math.Sqrt)) },
-        { "llvm.vector.reduce.add.v4i32", StandardIntrinsicFunction.CreateGeneric(typeof(Vector128), nameof(Vector128.Sum), typeof(int)) },
-
-        // Standard intrinsics using custom methods.
-        { "llvm.vector.reduce.mul.v4i32", StandardIntrinsicFunction.Create(typeof(LLVMIntrinsics), nameof(Runtime.LLVMIntrinsics.VectorReduceMulV4I32)) },
-        { "llvm.vector.reduce.smax.v4i32", StandardIntrinsicFunction.Create(typeof(LLVMIntrinsics), nameof(Runtime.LLVMIntrinsics.VectorReduceSMaxV4I32)) },
-
+    /// <summary>
+    /// Intrinsics that are implemented the same way whatever their overload, keyed by base name.
+    /// </summary>
+    public static readonly Dictionary<string, IntrinsicFunction> FixedIntrinsics = new()
+    {
         // Irregular intrinsics.
-        { "llvm.dbg.declare", new LLVMDbgDeclareIntrinsicFunction() },
-        { "llvm.memcpy.p0.p0.i64", new LLVMMemCpyI64IntrinsicFunction() },
-        { "llvm.memset.p0.i64", new LLVMMemSetI64IntrinsicFunction() },
-        { "llvm.stacksave", new LLVMStackSaveIntrinsicFunction() },
-        { "llvm.stacksave.p0", new LLVMStackSaveIntrinsicFunction() },
-        { "llvm.usub.sat.i32", new LLVMUSubSatI32IntrinsicFunction() },
-        { "llvm.va_start", new LLVMVaStartIntrinsicFunction() },
+        { "dbg.declare", new LLVMDbgDeclareIntrinsicFunction() },
+        { "memcpy", new LLVMMemCpyIntrinsicFunction(alwaysInline: false) },
+        { "memcpy.inline", new LLVMMemCpyIntrinsicFunction(alwaysInline: true) },
+        { "memmove", new LLVMMemMoveIntrinsicFunction() },
+        { "memset", new LLVMMemSetIntrinsicFunction(alwaysInline: false) },
+        { "memset.inline", new LLVMMemSetIntrinsicFunction(alwaysInline: true) },
+        { "va_start", new LLVMVaStartIntrinsicFunction() },
+
+        // Dynamic allocas come from the shadow stack, so these save and restore its mark.
+        { "stacksave", StandardIntrinsicFunction.Create(typeof(ShadowStack), nameof(ShadowStack.Save)) },
+        { "stackrestore", StandardIntrinsicFunction.Create(typeof(ShadowStack), nameof(ShadowStack.Restore)) },
 
         // No-op intrinsics.
-        { "llvm.assume", NoOpIntrinsicFunction.Instance },
-        { "llvm.dbg.label", NoOpIntrinsicFunction.Instance },
-        { "llvm.dbg.value", NoOpIntrinsicFunction.Instance },
-        { "llvm.experimental.noalias.scope.decl", NoOpIntrinsicFunction.Instance },
-        { "llvm.lifetime.start.p0", NoOpIntrinsicFunction.Instance },
-        { "llvm.lifetime.end.p0", NoOpIntrinsicFunction.Instance },
-        { "llvm.stackrestore", NoOpIntrinsicFunction.Instance },
-        { "llvm.stackrestore.p0", NoOpIntrinsicFunction.Instance }
+        { "assume", NoOpIntrinsicFunction.Instance },
+        { "dbg.label", NoOpIntrinsicFunction.Instance },
+        { "dbg.value", NoOpIntrinsicFunction.Instance },
+        { "experimental.noalias.scope.decl", NoOpIntrinsicFunction.Instance },
+        { "lifetime.start", NoOpIntrinsicFunction.Instance },
+        { "lifetime.end", NoOpIntrinsicFunction.Instance },
+    };
+
+    /// <summary>
+    /// Intrinsics whose implementation depends on the types they're overloaded on, keyed by base name.
+    /// </summary>
+    public static readonly Dictionary<string, IntrinsicFamily> OverloadedIntrinsics = new()
+    {
+        // Element-wise intrinsics, using Math, MathF or the VectorN classes.
+        { "ceil", Elementwise(nameof(Math.Ceiling)) },
+        { "copysign", Elementwise(nameof(Math.CopySign)) },
+        { "fabs", Elementwise(nameof(Math.Abs)) },
+        { "floor", Elementwise(nameof(Math.Floor)) },
+        { "fma", Elementwise(nameof(Math.FusedMultiplyAdd)) },
+        { "fmuladd", Elementwise(nameof(Math.FusedMultiplyAdd)) },
+        { "sqrt", Elementwise(nameof(Math.Sqrt)) },
+
+        // Rounding and min/max. Math.Round rounds halfway cases to even, which is llvm.roundeven, and what llvm.rint
+        // and llvm.nearbyint do in the default rounding mode. Math.Max and Math.Min are llvm.maximum and llvm.minimum,
+        // and the MaxNumber and MinNumber methods on the floating-point types are llvm.maxnum and llvm.minnum.
+        // FloatingPointMath has vector versions of these with the same semantics.
+        { "maximum", Elementwise(nameof(Math.Max), implementationTypes: [typeof(FloatingPointMath)]) },
+        { "maxnum", Elementwise(nameof(double.MaxNumber), implementationTypes: [typeof(FloatingPointMath)]) },
+        { "minimum", Elementwise(nameof(Math.Min), implementationTypes: [typeof(FloatingPointMath)]) },
+        { "minnum", Elementwise(nameof(double.MinNumber), implementationTypes: [typeof(FloatingPointMath)]) },
+        { "nearbyint", Elementwise(nameof(Math.Round), implementationTypes: [typeof(FloatingPointMath)]) },
+        { "rint", Elementwise(nameof(Math.Round), implementationTypes: [typeof(FloatingPointMath)]) },
+        { "round", Elementwise(nameof(FloatingPointMath.RoundAwayFromZero), implementationTypes: [typeof(FloatingPointMath)]) },
+        { "roundeven", Elementwise(nameof(Math.Round), implementationTypes: [typeof(FloatingPointMath)]) },
+        { "trunc", Elementwise(nameof(Math.Truncate), implementationTypes: [typeof(FloatingPointMath)]) },
+
+        // Transcendental functions. Vector loops that LLVM vectorizes still run some iterations with scalar code,
+        // so vectors use the scalar methods for each element to get the same results as those iterations.
+        { "cos", LaneWise(nameof(Math.Cos)) },
+        { "exp", LaneWise(nameof(Math.Exp)) },
+        { "exp2", LaneWise(nameof(double.Exp2)) },
+        { "log", LaneWise(nameof(Math.Log)) },
+        { "log10", LaneWise(nameof(Math.Log10)) },
+        { "log2", LaneWise(nameof(Math.Log2)) },
+        { "pow", LaneWise(nameof(Math.Pow)) },
+        { "powi", PowInteger },
+        { "sin", LaneWise(nameof(Math.Sin)) },
+
+        // Integer arithmetic. Math.Abs throws for the minimum value, so llvm.abs uses IntegerArithmetic.Abs
+        // for scalars and the VectorN.Abs methods, which wrap, for vectors.
+        { "abs", Elementwise(nameof(IntegerArithmetic.Abs), IntegerSignedness.Signed, [typeof(IntegerArithmetic)], operandCount: 1) },
+        { "sadd.sat", Elementwise(nameof(IntegerArithmetic.AddSaturate), IntegerSignedness.Signed, [typeof(IntegerArithmetic)]) },
+        { "sadd.with.overflow", ArithmeticWithOverflow(nameof(IntegerArithmetic.AddWithOverflow), IntegerSignedness.Signed) },
+        { "smax", Elementwise(nameof(Math.Max), IntegerSignedness.Signed) },
+        { "smin", Elementwise(nameof(Math.Min), IntegerSignedness.Signed) },
+        { "smul.with.overflow", ArithmeticWithOverflow(nameof(IntegerArithmetic.MultiplyWithOverflow), IntegerSignedness.Signed) },
+        { "ssub.sat", Elementwise(nameof(IntegerArithmetic.SubtractSaturate), IntegerSignedness.Signed, [typeof(IntegerArithmetic)]) },
+        { "ssub.with.overflow", ArithmeticWithOverflow(nameof(IntegerArithmetic.SubtractWithOverflow), IntegerSignedness.Signed) },
+        { "uadd.sat", Elementwise(nameof(IntegerArithmetic.AddSaturate), IntegerSignedness.Unsigned, [typeof(IntegerArithmetic)]) },
+        { "uadd.with.overflow", ArithmeticWithOverflow(nameof(IntegerArithmetic.AddWithOverflow), IntegerSignedness.Unsigned) },
+        { "umax", Elementwise(nameof(Math.Max), IntegerSignedness.Unsigned) },
+        { "umin", Elementwise(nameof(Math.Min), IntegerSignedness.Unsigned) },
+        { "umul.with.overflow", ArithmeticWithOverflow(nameof(IntegerArithmetic.MultiplyWithOverflow), IntegerSignedness.Unsigned) },
+        { "usub.sat", Elementwise(nameof(IntegerArithmetic.SubtractSaturate), IntegerSignedness.Unsigned, [typeof(IntegerArithmetic)]) },
+        { "usub.with.overflow", ArithmeticWithOverflow(nameof(IntegerArithmetic.SubtractWithOverflow), IntegerSignedness.Unsigned) },
+
+        // Bit manipulation. Scalar counts use the integer types' own methods, which the JIT turns into
+        // popcnt, lzcnt and tzcnt. ctlz and cttz have an is_zero_poison flag, which we don't need.
+        { "bitreverse", Elementwise(nameof(BitManipulation.BitReverse), IntegerSignedness.Unsigned, [typeof(BitManipulation)]) },
+        { "bswap", Elementwise(nameof(BinaryPrimitives.ReverseEndianness), IntegerSignedness.Unsigned, [typeof(BitManipulation), typeof(BinaryPrimitives)]) },
+        { "ctlz", Elementwise(nameof(BitManipulation.LeadingZeroCount), IntegerSignedness.Unsigned, [typeof(BitManipulation)], operandCount: 1) },
+        { "ctpop", Elementwise(nameof(BitManipulation.PopCount), IntegerSignedness.Unsigned, [typeof(BitManipulation)]) },
+        { "cttz", Elementwise(nameof(BitManipulation.TrailingZeroCount), IntegerSignedness.Unsigned, [typeof(BitManipulation)], operandCount: 1) },
+        { "fshl", FunnelShift(isLeft: true) },
+        { "fshr", FunnelShift(isLeft: false) },
+
+        // Conversions. fptosi and fptoui don't saturate, so these are the only ones that need to.
+        { "fptosi.sat", FloatToIntegerSaturating(isSigned: true) },
+        { "fptoui.sat", FloatToIntegerSaturating(isSigned: false) },
+
+        // Masked memory operations, which only access the lanes whose mask element is set.
+        { "masked.compressstore", MaskedMemoryOperation(nameof(MaskedMemory.CompressStore), dataParameterIndex: 0) },
+        { "masked.expandload", MaskedMemoryOperation(nameof(MaskedMemory.ExpandLoad), dataParameterIndex: null) },
+        { "masked.gather", MaskedMemoryOperation(nameof(MaskedMemory.Gather), dataParameterIndex: null) },
+        { "masked.load", MaskedMemoryOperation(nameof(MaskedMemory.Load), dataParameterIndex: null) },
+        { "masked.scatter", MaskedMemoryOperation(nameof(MaskedMemory.Scatter), dataParameterIndex: 0) },
+        { "masked.store", MaskedMemoryOperation(nameof(MaskedMemory.Store), dataParameterIndex: 0) },
+
+        // Vector reductions. On vectors of i1, where set elements are -1, smax and umin are the same as and,
+        // and smin and umax are the same as or.
+        { "vector.reduce.add", VectorReduction(nameof(VectorReductions.Add), OpCodes.Add, nameof(VectorReductions.Parity)) },
+        { "vector.reduce.and", VectorReduction(nameof(VectorReductions.And), OpCodes.And, nameof(VectorReductions.All)) },
+        { "vector.reduce.fadd", OrderedVectorReduction(nameof(VectorReductions.Add), OpCodes.Add) },
+        { "vector.reduce.fmax", VectorReduction(nameof(VectorReductions.MaxNumber), nameof(double.MaxNumber)) },
+        { "vector.reduce.fmaximum", VectorReduction(nameof(VectorReductions.Maximum), nameof(Math.Max)) },
+        { "vector.reduce.fmin", VectorReduction(nameof(VectorReductions.MinNumber), nameof(double.MinNumber)) },
+        { "vector.reduce.fminimum", VectorReduction(nameof(VectorReductions.Minimum), nameof(Math.Min)) },
+        { "vector.reduce.fmul", OrderedVectorReduction(nameof(VectorReductions.Multiply), OpCodes.Mul) },
+        { "vector.reduce.mul", VectorReduction(nameof(VectorReductions.Multiply), OpCodes.Mul, nameof(VectorReductions.All)) },
+        { "vector.reduce.or", VectorReduction(nameof(VectorReductions.Or), OpCodes.Or, nameof(VectorReductions.Any)) },
+        { "vector.reduce.smax", VectorReduction(nameof(VectorReductions.Max), nameof(Math.Max), nameof(VectorReductions.All), IntegerSignedness.Signed) },
+        { "vector.reduce.smin", VectorReduction(nameof(VectorReductions.Min), nameof(Math.Min), nameof(VectorReductions.Any), IntegerSignedness.Signed) },
+        { "vector.reduce.umax", VectorReduction(nameof(VectorReductions.Max), nameof(Math.Max), nameof(VectorReductions.Any), IntegerSignedness.Unsigned) },
+        { "vector.reduce.umin", VectorReduction(nameof(VectorReductions.Min), nameof(Math.Min), nameof(VectorReductions.All), IntegerSignedness.Unsigned) },
+        { "vector.reduce.xor", VectorReduction(nameof(VectorReductions.Xor), OpCodes.Xor, nameof(VectorReductions.Parity)) },
+    };
+
+    /// <summary>
+    /// The base names of the intrinsics whose calls only compute a result from their operands, and so can be
+    /// moved like arithmetic, and of the no-ops. Every other intrinsic is assumed to have side effects, such as
+    /// llvm.stacksave, which reads the shadow stack's mark, and the masked loads and stores.
+    /// </summary>
+    public static readonly HashSet<string> PureIntrinsics =
+    [
+        "assume", "dbg.declare", "dbg.label", "dbg.value", "experimental.noalias.scope.decl", "lifetime.start", "lifetime.end",
+        "ceil", "copysign", "fabs", "floor", "fma", "fmuladd", "sqrt",
+        "maximum", "maxnum", "minimum", "minnum", "nearbyint", "rint", "round", "roundeven", "trunc",
+        "cos", "exp", "exp2", "log", "log10", "log2", "pow", "powi", "sin",
+        "abs", "sadd.sat", "sadd.with.overflow", "smax", "smin", "smul.with.overflow", "ssub.sat", "ssub.with.overflow",
+        "uadd.sat", "uadd.with.overflow", "umax", "umin", "umul.with.overflow", "usub.sat", "usub.with.overflow",
+        "bitreverse", "bswap", "ctlz", "ctpop", "cttz", "fshl", "fshr",
+        "fptosi.sat", "fptoui.sat",
+        "vector.reduce.add", "vector.reduce.and", "vector.reduce.fadd", "vector.reduce.fmax", "vector.reduce.fmaximum",
+        "vector.reduce.fmin", "vector.reduce.fminimum", "vector.reduce.fmul", "vector.reduce.mul", "vector.reduce.or",
+        "vector.reduce.smax", "vector.reduce.smin", "vector.reduce.umax", "vector.reduce.umin", "vector.reduce.xor",
+    ];
+
+    /// <summary>
+    /// An intrinsic that applies the .NET method <paramref name="methodName"/> to each element,
+    /// and whose operands and result all have the same type. The method is looked for on
+    /// <paramref name="implementationTypes"/> first, and then on Math, MathF or the VectorN classes.
+    /// </summary>
+    /// <param name="operandCount">The number of operands to pass, if the last ones are flags that the method doesn't need.</param>
+    private static IntrinsicFamily Elementwise(
+        string methodName,
+        IntegerSignedness signedness = IntegerSignedness.Any,
+        Type[]? implementationTypes = null,
+        int? operandCount = null) => (typeSystem, functionType) =>
+    {
+        var type = new IntrinsicOperandType(typeSystem, functionType.ReturnType, signedness);
+        return CreateElementwise(
+            type,
+            functionType,
+            methodName,
+            implementationTypes ?? [],
+            operandCount ?? (int)functionType.ParamTypesCount);
+    };
+
+    /// <summary>
+    /// Like <see cref="Elementwise"/>, but vectors always call the scalar method for each element.
+    /// </summary>
+    private static IntrinsicFamily LaneWise(string methodName) => (typeSystem, functionType) =>
+    {
+        var type = new IntrinsicOperandType(typeSystem, functionType.ReturnType, IntegerSignedness.Any);
+        return CreateElementwise(
+            type,
+            functionType,
+            methodName,
+            [],
+            (int)functionType.ParamTypesCount,
+            useVectorMethods: false);
     };
+
+    private static IntrinsicFunction? CreateElementwise(
+        IntrinsicOperandType type,
+        LLVMTypeRef functionType,
+        string methodName,
+        Type[] implementationTypes,
+        int operandCount,
+        bool useVectorMethods = true)
+    {
+        if (type.IsOddWidthInteger || functionType.ParamTypes.Take(operandCount).Any(x => x != type.Type))
+        {
+            return null;
+        }
+
+        if (!type.IsVector)
+        {
+            var scalarMethod = FindScalarMethod(methodName, type.MethodElementType, operandCount, implementationTypes);
+            return scalarMethod != null
+                ? new OverloadedIntrinsicFunction(scalarMethod, type, type, operandCount)
+                : null;
+        }
+
+        if (!type.HasVectorMethods)
+        {
+            return null;
+        }
+
+        var vectorParameterTypes = Enumerable.Repeat(type.MethodType, operandCount).ToArray();
+
+        var vectorMethod = useVectorMethods
+            ? implementationTypes
+                .Append(type.NonGenericVectorType!)
+                .Select(x => x.FindStaticMethod(methodName, type.MethodType, vectorParameterTypes, type.MethodElementType))
+                .FirstOrDefault(x => x != null)
+            : null;
+
+        if (vectorMethod != null)
+        {
+            return new OverloadedIntrinsicFunction(vectorMethod, type, type, operandCount);
+        }
+
+        var laneMethod = FindScalarMethod(methodName, type.MethodElementType, operandCount, implementationTypes);
+        return laneMethod != null
+            ? new LaneWiseIntrinsicFunction(laneMethod, type, operandCount)
+            : null;
+    }
+
+    private static IntrinsicFamily ArithmeticWithOverflow(string methodName, IntegerSignedness signedness) => (typeSystem, functionType) =>
+    {
+        var type = new IntrinsicOperandType(typeSystem, functionType.ParamTypes[0], signedness);
+        var structType = typeSystem.GetMsilType(functionType.ReturnType);
+
+        var overflowType = type.IsVector
+            ? new IntrinsicOperandType(typeSystem, functionType.ReturnType.StructElementTypes[1], IntegerSignedness.Any)
+            : null;
+
+        if (type.IsOddWidthInteger
+            || (type.IsVector && (!type.HasVectorMethods || overflowType!.NonGenericVectorType == null)))
+        {
+            return null;
+        }
+
+        var scalarMethod = typeof(IntegerArithmetic).FindStaticMethod(
+            methodName,
+            type.MethodElementType,
+            [type.MethodElementType, type.MethodElementType, typeof(bool).MakeByRefType()],
+            type.MethodElementType);
+
+        return scalarMethod != null
+            ? new LLVMArithmeticWithOverflowIntrinsicFunction(scalarMethod, type, overflowType, structType)
+            : null;
+    };
+
+    /// <summary>
+    /// llvm.powi, which raises a floating-point value or vector to a scalar integer power.
+    /// </summary>
+    private static IntrinsicFunction? PowInteger(TypeSystem typeSystem, LLVMTypeRef functionType)
+    {
+        var type = new IntrinsicOperandType(typeSystem, functionType.ReturnType, IntegerSignedness.Any);
+
+        if (type.IsVector && !type.HasVectorMethods)
+        {
+            return null;
+        }
+
+        var method = typeof(FloatingPointMath).FindStaticMethod(
+            nameof(FloatingPointMath.PowInteger),
+            type.MethodType,
+            [type.MethodType, typeSystem.GetMsilType(functionType.ParamTypes[1])],
+            type.MethodElementType);
+
+        return method != null
+            ? new OverloadedIntrinsicFunction(method, type, type, 2)
+            : null;
+    }
+
+    private static IntrinsicFamily FunnelShift(bool isLeft) => (typeSystem, functionType) =>
+    {
+        var type = new IntrinsicOperandType(typeSystem, functionType.ReturnType, IntegerSignedness.Unsigned);
+
+        var generalCase = CreateElementwise(
+            type,
+            functionType,
+            isLeft ? nameof(BitManipulation.FunnelShiftLeft) : nameof(BitManipulation.FunnelShiftRight),
+            [typeof(BitManipulation)],
+            3);
+
+        return generalCase != null
+            ? new LLVMFunnelShiftIntrinsicFunction(type, isLeft, generalCase)
+            : null;
+    };
+
+    /// <summary>
+    /// llvm.fptosi.sat and llvm.fptoui.sat, from float or double to integers of up to 64 bits,
+    /// or on vectors, to elements of 8, 16, 32 or 64 bits.
+    /// </summary>
+    private static IntrinsicFamily FloatToIntegerSaturating(bool isSigned) => (typeSystem, functionType) =>
+    {
+        var operandType = new IntrinsicOperandType(typeSystem, functionType.ParamTypes[0], IntegerSignedness.Any);
+        var resultType = new IntrinsicOperandType(typeSystem, functionType.ReturnType, IntegerSignedness.Any);
+
+        if (operandType.MsilElementType != typeof(float) && operandType.MsilElementType != typeof(double))
+        {
+            return null;
+        }
+
+        if (!resultType.IsVector)
+        {
+            return resultType.Type.IntWidth <= 64
+                ? new LLVMFloatToIntegerSaturatingIntrinsicFunction(resultType, isSigned)
+                : null;
+        }
+
+        if (resultType.Type.ElementType.IntWidth is not (8 or 16 or 32 or 64)
+            || !operandType.MsilType.IsGenericType
+            || !resultType.MsilType.IsGenericType)
+        {
+            return null;
+        }
+
+        var method = typeof(FloatingPointConversions)
+            .GetMethodStrict(
+                isSigned ? nameof(FloatingPointConversions.ConvertToSignedSaturating) : nameof(FloatingPointConversions.ConvertToUnsignedSaturating),
+                [Type.MakeGenericMethodParameter(2)])
+            .MakeGenericMethod(operandType.MsilElementType, resultType.MsilElementType, operandType.MsilType, resultType.MsilType);
+
+        return new StandardIntrinsicFunction(method);
+    };
+
+    /// <summary>
+    /// A masked memory operation, implemented by <paramref name="methodName"/> on <see cref="MaskedMemory"/>.
+    /// Those methods are generic over the element type and then the type of each vector operand, in order.
+    /// </summary>
+    /// <param name="dataParameterIndex">The parameter that has the data vector, or null if it's the return type.</param>
+    private static IntrinsicFamily MaskedMemoryOperation(string methodName, int? dataParameterIndex) => (typeSystem, functionType) =>
+    {
+        var dataType = new IntrinsicOperandType(
+            typeSystem,
+            dataParameterIndex != null ? functionType.ParamTypes[dataParameterIndex.Value] : functionType.ReturnType,
+            IntegerSignedness.Any);
+
+        if (!dataType.IsVector
+            || dataType.IsOddWidthInteger
+            || dataType.Type.ElementType is { Kind: LLVMTypeKind.LLVMIntegerTypeKind, IntWidth: 1 }
+            || !dataType.MsilType.IsGenericType)
+        {
+            return null;
+        }
+
+        // The alignment is the only scalar i32 parameter, and the methods don't need it.
+        var parameterTypes = functionType.ParamTypes;
+        var operandIndices = Enumerable.Range(0, parameterTypes.Length)
+            .Where(i => parameterTypes[i] is not { Kind: LLVMTypeKind.LLVMIntegerTypeKind, IntWidth: 32 })
+            .ToArray();
+
+        var vectorTypes = operandIndices
+            .Select(i => parameterTypes[i])
+            .Where(x => x.Kind == LLVMTypeKind.LLVMVectorTypeKind)
+            .Select(x => typeSystem.GetMsilVectorType(x));
+
+        var method = typeof(MaskedMemory)
+            .GetStaticMethodStrict(methodName)
+            .MakeGenericMethod([dataType.MsilElementType, .. vectorTypes]);
+
+        return new LLVMMaskedMemoryIntrinsicFunction(method, operandIndices, dataType.VectorSize);
+    };
+
+    /// <summary>
+    /// A reduction that calls <paramref name="vectorMethodName"/> on <see cref="VectorReductions"/>, or on vector types
+    /// that it doesn't support, folds the vector's elements with <paramref name="combineOpCode"/>.
+    /// </summary>
+    /// <param name="maskMethodName">The method on <see cref="VectorReductions"/> that does the same reduction on vectors of i1.</param>
+    private static IntrinsicFamily VectorReduction(string vectorMethodName, OpCode combineOpCode, string maskMethodName) =>
+        VectorReduction(vectorMethodName, maskMethodName, IntegerSignedness.Any, type => ilGenerator =>
+        {
+            ilGenerator.Emit(combineOpCode);
+            IntrinsicOperandType.EmitNormalize(ilGenerator, type.MethodElementType);
+        });
+
+    /// <summary>
+    /// A reduction that calls <paramref name="vectorMethodName"/> on <see cref="VectorReductions"/>, or on vector types
+    /// that it doesn't support, folds the vector's elements with the scalar .NET method <paramref name="scalarMethodName"/>.
+    /// </summary>
+    private static IntrinsicFamily VectorReduction(
+        string vectorMethodName,
+        string scalarMethodName,
+        string? maskMethodName = null,
+        IntegerSignedness signedness = IntegerSignedness.Any) =>
+        VectorReduction(vectorMethodName, maskMethodName, signedness, type =>
+        {
+            var method = FindScalarMethod(scalarMethodName, type.MethodElementType, 2, []);
+            return method != null
+                ? ilGenerator => ilGenerator.Emit(OpCodes.Call, method)
+                : null;
+        });
+
+    private static IntrinsicFamily VectorReduction(
+        string vectorMethodName,
+        string? maskMethodName,
+        IntegerSignedness signedness,
+        Func<IntrinsicOperandType, Action<ILGenerator>?> getCombine) => (typeSystem, functionType) =>
+    {
+        var type = new IntrinsicOperandType(typeSystem, functionType.ParamTypes[0], signedness);
+        var resultType = new IntrinsicOperandType(typeSystem, functionType.ReturnType, signedness);
+
+        if (!type.HasVectorMethods || type.IsOddWidthInteger)
+        {
+            return null;
+        }
+
+        if (type.Type.ElementType is { Kind: LLVMTypeKind.LLVMIntegerTypeKind, IntWidth: 1 })
+        {
+            var maskMethod = maskMethodName != null
+                ? typeof(VectorReductions).FindStaticMethod(maskMethodName, typeof(bool), [type.MsilType])
+                : null;
+
+            // Padding lanes are set to true for All, and to false for Any and Parity, so they don't change the result.
+            return maskMethod != null
+                ? new OverloadedIntrinsicFunction(maskMethod, type, resultType, 1, maskMethodName == nameof(VectorReductions.All) ? -1 : 0)
+                : null;
+        }
+
+        // The whole-vector methods would include the padding lanes of a padded vector, so those are folded lane by lane.
+        var vectorMethod = !type.IsPadded
+            ? typeof(VectorReductions).FindStaticMethod(
+                vectorMethodName,
+                type.MethodElementType,
+                [type.MethodType],
+                type.MethodElementType)
+            : null;
+
+        if (vectorMethod != null)
+        {
+            return new OverloadedIntrinsicFunction(vectorMethod, type, resultType, 1);
+        }
+
+        var combine = getCombine(type);
+        return combine != null
+            ? new VectorReductionIntrinsicFunction(type, combine)
+            : null;
+    };
+
+    /// <summary>
+    /// llvm.vector.reduce.fadd and llvm.vector.reduce.fmul, which start from a scalar operand and, without the
+    /// reassoc flag, combine the elements in order. Calls with it use <paramref name="vectorMethodName"/> on
+    /// <see cref="VectorReductions"/> for float and double vectors that aren't padded.
+    /// </summary>
+    private static IntrinsicFamily OrderedVectorReduction(string vectorMethodName, OpCode combineOpCode) => (typeSystem, functionType) =>
+    {
+        var type = new IntrinsicOperandType(typeSystem, functionType.ParamTypes[1], IntegerSignedness.Any);
+
+        if (!type.HasVectorMethods)
+        {
+            return null;
+        }
+
+        var orderedCase = new VectorReductionIntrinsicFunction(type, ilGenerator => ilGenerator.Emit(combineOpCode), hasStartValue: true);
+
+        var reassociatedMethod = type.Type.ElementType.Kind is LLVMTypeKind.LLVMFloatTypeKind or LLVMTypeKind.LLVMDoubleTypeKind && !type.IsPadded
+            ? typeof(VectorReductions).FindStaticMethod(vectorMethodName, type.MethodElementType, [type.MethodType], type.MethodElementType)
+            : null;
+
+        return reassociatedMethod != null
+            ? new LLVMFloatingPointReductionIntrinsicFunction(type, reassociatedMethod, combineOpCode, orderedCase)
+            : orderedCase;
+    };
+
+    /// <summary>
+    /// Finds a scalar implementation on one of <paramref name="implementationTypes"/>, on <see cref="MathF"/>
+    /// for float, <see cref="Math"/> for other primitive types, or on the type itself, which is where
+    /// methods like <see cref="uint.PopCount"/> and types like <see cref="Int128"/> and <see cref="Half"/> have them.
+    /// </summary>
+    private static MethodInfo? FindScalarMethod(string methodName, Type type, int parameterCount, Type[] implementationTypes)
+    {
+        var parameterTypes = Enumerable.Repeat(type, parameterCount).ToArray();
+
+        return implementationTypes
+            .Append(type == typeof(float) ? typeof(MathF) : typeof(Math))
+            .Append(type)
+            .Select(x => x.FindStaticMethod(methodName, type, parameterTypes, type))
+            .FirstOrDefault(x => x != null);
+    }
 }
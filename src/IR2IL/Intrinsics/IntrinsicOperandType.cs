@@ -0,0 +1,207 @@
+using System;
+using System.Reflection;
+using System.Reflection.Emit;
+using System.Runtime.Intrinsics;
+using IR2IL.Helpers;
+using LLVMSharp.Interop;
+
+namespace IR2IL.Intrinsics;
+
+/// <summary>
+/// How an overloaded intrinsic interprets integer operands.
+/// LLVM integers don't have a sign, but .NET methods like <see cref="Math.Max(int, int)"/> do.
+/// </summary>
+internal enum IntegerSignedness
+{
+    Any,
+    Signed,
+    Unsigned,
+}
+
+/// <summary>
+/// The type that an overloaded intrinsic is instantiated for, such as i32 in llvm.smax.i32
+/// or &lt;8 x float&gt; in llvm.sqrt.v8f32, along with the .NET types used to implement it.
+/// </summary>
+/// <remarks>
+/// <see cref="MsilType"/> is how the compiler represents values of this type, and
+/// <see cref="MethodType"/> is the same type with its integer elements reinterpreted
+/// to have the right signedness, for example <c>Vector128&lt;byte&gt;</c> and <c>Vector128&lt;sbyte&gt;</c>
+/// for the operands of llvm.smax.v16i8.
+/// </remarks>
+internal sealed class IntrinsicOperandType
+{
+    public IntrinsicOperandType(TypeSystem typeSystem, LLVMTypeRef type, IntegerSignedness signedness)
+    {
+        Type = type;
+        IsVector = type.Kind == LLVMTypeKind.LLVMVectorTypeKind;
+
+        var elementType = IsVector ? type.ElementType : type;
+        IsOddWidthInteger = elementType.Kind == LLVMTypeKind.LLVMIntegerTypeKind
+            && elementType.IntWidth is not (1 or 8 or 16 or 32 or 64 or 128);
+        MsilElementType = IsVector ? typeSystem.GetMsilVectorElementType(elementType) : typeSystem.GetMsilType(elementType);
+        MethodElementType = GetSignedType(MsilElementType, signedness);
+
+        if (IsVector)
+        {
+            VectorSize = (int)type.VectorSize;
+            MsilVectorLength = typeSystem.GetMsilVectorLength(type);
+            MsilType = typeSystem.GetMsilVectorType(type);
+
+            // Vectors that don't fit a VectorN<T> are arrays, and have no methods.
+            if (MsilType.IsGenericType)
+            {
+                NonGenericVectorType = typeSystem.GetNonGenericVectorType(type);
+                MethodType = MsilType.GetGenericTypeDefinition().MakeGenericType(MethodElementType);
+            }
+            else
+            {
+                MethodType = MsilType;
+            }
+        }
+        else
+        {
+            MsilType = MsilElementType;
+            MethodType = MethodElementType;
+        }
+    }
+
+    public LLVMTypeRef Type { get; }
+
+    public bool IsVector { get; }
+
+    public int VectorSize { get; }
+
+    /// <summary>
+    /// The number of lanes in <see cref="MsilType"/>, which is more than <see cref="VectorSize"/>
+    /// for vectors padded to the next power of two, such as &lt;3 x float&gt;.
+    /// </summary>
+    public int MsilVectorLength { get; }
+
+    public bool IsPadded => MsilVectorLength != VectorSize;
+
+    public Type MsilType { get; }
+
+    public Type MsilElementType { get; }
+
+    public Type MethodType { get; }
+
+    public Type MethodElementType { get; }
+
+    /// <summary>
+    /// <see cref="Vector128"/> for <c>Vector128&lt;T&gt;</c>, and so on.
+    /// Null for scalars and for vectors that are represented as arrays.
+    /// </summary>
+    public Type? NonGenericVectorType { get; }
+
+    /// <summary>
+    /// Odd-width integers like i24 are kept zero-extended in the next native width up,
+    /// so methods for the wider type would see the wrong sign bit.
+    /// </summary>
+    public bool IsOddWidthInteger { get; }
+
+    /// <summary>
+    /// Whether this is a vector with elements that behave the same way in .NET as they do in LLVM.
+    /// Half and bfloat elements are stored as their bits, so .NET vector methods can't be used on them.
+    /// </summary>
+    public bool HasVectorMethods => NonGenericVectorType != null
+        && Type.ElementType.Kind is not (LLVMTypeKind.LLVMHalfTypeKind or LLVMTypeKind.LLVMBFloatTypeKind);
+
+    public MethodInfo GetElementMethod => NonGenericVectorType!
+        .GetStaticMethodStrict(nameof(Vector128.GetElement))
+        .MakeGenericMethod(MsilElementType);
+
+    public MethodInfo WithElementMethod => NonGenericVectorType!
+        .GetStaticMethodStrict(nameof(Vector128.WithElement))
+        .MakeGenericMethod(MsilElementType);
+
+    /// <summary>
+    /// Sets the padding lanes of the vector on top of the stack to <paramref name="value"/>.
+    /// </summary>
+    public void EmitFillPaddingLanes(ILGenerator ilGenerator, int value)
+    {
+        for (var lane = VectorSize; lane < MsilVectorLength; lane++)
+        {
+            ilGenerator.Emit(OpCodes.Ldc_I4, lane);
+            ilGenerator.Emit(OpCodes.Ldc_I4, value);
+            if (MsilElementType == typeof(long) || MsilElementType == typeof(ulong))
+            {
+                ilGenerator.Emit(OpCodes.Conv_I8);
+            }
+            ilGenerator.Emit(OpCodes.Call, WithElementMethod);
+        }
+    }
+
+    public void EmitToMethodType(ILGenerator ilGenerator) => EmitReinterpret(ilGenerator, MsilType, MethodType);
+
+    public void EmitFromMethodType(ILGenerator ilGenerator) => EmitReinterpret(ilGenerator, MethodType, MsilType);
+
+    public void EmitElementToMethodType(ILGenerator ilGenerator) => EmitReinterpret(ilGenerator, MsilElementType, MethodElementType);
+
+    public void EmitElementFromMethodType(ILGenerator ilGenerator) => EmitReinterpret(ilGenerator, MethodElementType, MsilElementType);
+
+    private void EmitReinterpret(ILGenerator ilGenerator, Type fromType, Type toType)
+    {
+        if (fromType == toType)
+        {
+            return;
+        }
+
+        if (fromType.IsGenericType)
+        {
+            var asMethod = NonGenericVectorType!
+                .GetStaticMethodStrict(nameof(Vector128.As))
+                .MakeGenericMethod(fromType.GetGenericArguments()[0], toType.GetGenericArguments()[0]);
+            ilGenerator.Emit(OpCodes.Call, asMethod);
+        }
+        else if (fromType == typeof(Int128) || fromType == typeof(UInt128))
+        {
+            ilGenerator.Emit(OpCodes.Call, fromType.GetConversionOperatorStrict(fromType, toType));
+        }
+        else
+        {
+            // Values on the evaluation stack are at least 32 bits, so only the
+            // small integer types need converting to keep the upper bits right.
+            EmitNormalize(ilGenerator, toType);
+        }
+    }
+
+    /// <summary>
+    /// Truncates and sign- or zero-extends a 32-bit value on the stack to a small integer type.
+    /// </summary>
+    public static void EmitNormalize(ILGenerator ilGenerator, Type type)
+    {
+        if (type == typeof(sbyte))
+        {
+            ilGenerator.Emit(OpCodes.Conv_I1);
+        }
+        else if (type == typeof(byte))
+        {
+            ilGenerator.Emit(OpCodes.Conv_U1);
+        }
+        else if (type == typeof(short))
+        {
+            ilGenerator.Emit(OpCodes.Conv_I2);
+        }
+        else if (type == typeof(ushort))
+        {
+            ilGenerator.Emit(OpCodes.Conv_U2);
+        }
+    }
+
+    private static Type GetSignedType(Type type, IntegerSignedness signedness) => signedness switch
+    {
+        IntegerSignedness.Signed when type == typeof(byte) => typeof(sbyte),
+        IntegerSignedness.Signed when type == typeof(ushort) => typeof(short),
+        IntegerSignedness.Signed when type == typeof(uint) => typeof(int),
+        IntegerSignedness.Signed when type == typeof(ulong) => typeof(long),
+        IntegerSignedness.Signed when type == typeof(UInt128) => typeof(Int128),
+
+        IntegerSignedness.Unsigned when type == typeof(sbyte) => typeof(byte),
+        IntegerSignedness.Unsigned when type == typeof(short) => typeof(ushort),
+        IntegerSignedness.Unsigned when type == typeof(int) => typeof(uint),
+        IntegerSignedness.Unsigned when type == typeof(long) => typeof(ulong),
+        IntegerSignedness.Unsigned when type == typeof(Int128) => typeof(UInt128),
+
+        _ => type,
+    };
+}
@@ -0,0 +1,93 @@
+using System;
+using System.Collections.Generic;
+using System.Text.RegularExpressions;
+using LLVMSharp.Interop;
+
+namespace IR2IL.Intrinsics;
+
+/// <summary>
+/// Finds the implementation of an LLVM intrinsic from its name and function type.
+/// </summary>
+/// <remarks>
+/// Overloaded intrinsics have their types mangled into their names, as in llvm.smax.v8i32
+/// and llvm.memcpy.p0.p0.i64. We strip those suffixes to get the base name, and then
+/// instantiate the implementation for the types in the function's signature.
+/// </remarks>
+internal sealed partial class IntrinsicResolver(TypeSystem typeSystem)
+{
+    private readonly Dictionary<string, IntrinsicFunction> _resolvedIntrinsics = [];
+
+    public unsafe IntrinsicFunction Resolve(LLVMValueRef function)
+    {
+        var name = function.Name;
+
+        if (!_resolvedIntrinsics.TryGetValue(name, out var result))
+        {
+            var functionType = (LLVMTypeRef)LLVM.GlobalGetValueType(function);
+
+            result = Resolve(name, functionType)
+                ?? throw new NotImplementedException($"Unknown LLVM intrinsic: {name}");
+
+            _resolvedIntrinsics.Add(name, result);
+        }
+
+        return result;
+    }
+
+    private IntrinsicFunction? Resolve(string name, LLVMTypeRef functionType)
+    {
+        var baseName = GetBaseName(name);
+
+        if (IntrinsicFunctions.FixedIntrinsics.TryGetValue(baseName, out var result))
+        {
+            return result;
+        }
+
+        if (IntrinsicFunctions.OverloadedIntrinsics.TryGetValue(baseName, out var family))
+        {
+            return family(typeSystem, functionType);
+        }
+
+        if (X86IntrinsicFunctions.Intrinsics.TryGetValue(baseName, out family))
+        {
+            return family(typeSystem, functionType);
+        }
+
+        if (X86IntrinsicFunctions.OrderingIntrinsics.TryGetValue(baseName, out family))
+        {
+            return family(typeSystem, functionType);
+        }
+
+        return null;
+    }
+
+    /// <summary>
+    /// Whether calls to the intrinsic <paramref name="name"/> have no side effects, which is only true of those that are
+    /// known to be pure. See <see cref="IntrinsicFunctions.PureIntrinsics"/> and <see cref="X86IntrinsicFunctions.Intrinsics"/>.
+    /// </summary>
+    public static bool IsPure(string name)
+    {
+        var baseName = GetBaseName(name);
+        return IntrinsicFunctions.PureIntrinsics.Contains(baseName) || X86IntrinsicFunctions.Intrinsics.ContainsKey(baseName);
+    }
+
+    /// <summary>
+    /// Strips the "llvm." prefix and any type suffixes, so that llvm.vector.reduce.add.v4i32 becomes vector.reduce.add.
+    /// </summary>
+    public static string GetBaseName(string name)
+    {
+        var parts = name.Split('.');
+
+        var count = parts.Length;
+        while (count > 2 && TypeSuffixRegex().IsMatch(parts[count - 1]))
+        {
+            count--;
+        }
+
+        return string.Join('.', parts, 1, count - 1);
+    }
+
+    // i32, f64, bf16, p0, v4i32, v8f32, v2p0 and so on.
+    [GeneratedRegex("^(v\\d+)?(i\\d+|f16|bf16|f32|f64|f80|f128|p\\d+)$")]
+    private static partial Regex TypeSuffixRegex();
+}
@@ -0,0 +1,104 @@
+using System;
+using System.Reflection;
+using System.Reflection.Emit;
+
+namespace IR2IL.Intrinsics;
+
+/// <summary>
+/// llvm.[su]{add,sub,mul}.with.overflow, which return a {result, overflow} struct.
+/// <paramref name="scalarMethod"/> returns the result and has an out parameter for the overflow flag.
+/// Vectors call it for each lane, and set the lanes of the overflow mask to all ones or zero.
+/// </summary>
+internal sealed class LLVMArithmeticWithOverflowIntrinsicFunction(
+    MethodInfo scalarMethod,
+    IntrinsicOperandType operandType,
+    IntrinsicOperandType? overflowType,
+    Type structType) : IntrinsicFunction
+{
+    public override void BuildCall(IntrinsicFunctionCallContext context)
+    {
+        var ilGenerator = context.ILGenerator;
+
+        var fields = structType.GetFields();
+        var structLocal = ilGenerator.DeclareLocal(structType);
+
+        if (!operandType.IsVector)
+        {
+            // result.Field0 = Method(left, right, out result.Field1);
+            ilGenerator.Emit(OpCodes.Ldloca, structLocal);
+
+            context.EmitValue(context.Operands[0]);
+            operandType.EmitToMethodType(ilGenerator);
+            context.EmitValue(context.Operands[1]);
+            operandType.EmitToMethodType(ilGenerator);
+
+            ilGenerator.Emit(OpCodes.Ldloca, structLocal);
+            ilGenerator.Emit(OpCodes.Ldflda, fields[1]);
+
+            ilGenerator.Emit(OpCodes.Call, scalarMethod);
+            operandType.EmitFromMethodType(ilGenerator);
+
+            ilGenerator.Emit(OpCodes.Stfld, fields[0]);
+            ilGenerator.Emit(OpCodes.Ldloc, structLocal);
+            return;
+        }
+
+        var leftLocal = ilGenerator.DeclareLocal(operandType.MsilType);
+        context.EmitValue(context.Operands[0]);
+        ilGenerator.Emit(OpCodes.Stloc, leftLocal);
+
+        var rightLocal = ilGenerator.DeclareLocal(operandType.MsilType);
+        context.EmitValue(context.Operands[1]);
+        ilGenerator.Emit(OpCodes.Stloc, rightLocal);
+
+        var resultLocal = ilGenerator.DeclareLocal(operandType.MsilType);
+        ilGenerator.Emit(OpCodes.Ldloca, resultLocal);
+        ilGenerator.Emit(OpCodes.Initobj, operandType.MsilType);
+
+        var overflowLocal = ilGenerator.DeclareLocal(overflowType!.MsilType);
+        ilGenerator.Emit(OpCodes.Ldloca, overflowLocal);
+        ilGenerator.Emit(OpCodes.Initobj, overflowType.MsilType);
+
+        var laneOverflowLocal = ilGenerator.DeclareLocal(typeof(bool));
+
+        for (var lane = 0; lane < operandType.VectorSize; lane++)
+        {
+            ilGenerator.Emit(OpCodes.Ldloc, resultLocal);
+            ilGenerator.Emit(OpCodes.Ldc_I4, lane);
+
+            foreach (var operandLocal in new[] { leftLocal, rightLocal })
+            {
+                ilGenerator.Emit(OpCodes.Ldloc, operandLocal);
+                ilGenerator.Emit(OpCodes.Ldc_I4, lane);
+                ilGenerator.Emit(OpCodes.Call, operandType.GetElementMethod);
+                operandType.EmitElementToMethodType(ilGenerator);
+            }
+
+            ilGenerator.Emit(OpCodes.Ldloca, laneOverflowLocal);
+            ilGenerator.Emit(OpCodes.Call, scalarMethod);
+            operandType.EmitElementFromMethodType(ilGenerator);
+
+            ilGenerator.Emit(OpCodes.Call, operandType.WithElementMethod);
+            ilGenerator.Emit(OpCodes.Stloc, resultLocal);
+
+            // Vectors of i1 hold 0 or -1 in each lane.
+            ilGenerator.Emit(OpCodes.Ldloc, overflowLocal);
+            ilGenerator.Emit(OpCodes.Ldc_I4, lane);
+            ilGenerator.Emit(OpCodes.Ldloc, laneOverflowLocal);
+            ilGenerator.Emit(OpCodes.Neg);
+            ilGenerator.Emit(OpCodes.Conv_I1);
+            ilGenerator.Emit(OpCodes.Call, overflowType.WithElementMethod);
+            ilGenerator.Emit(OpCodes.Stloc, overflowLocal);
+        }
+
+        ilGenerator.Emit(OpCodes.Ldloca, structLocal);
+        ilGenerator.Emit(OpCodes.Ldloc, resultLocal);
+        ilGenerator.Emit(OpCodes.Stfld, fields[0]);
+
+        ilGenerator.Emit(OpCodes.Ldloca, structLocal);
+        ilGenerator.Emit(OpCodes.Ldloc, overflowLocal);
+        ilGenerator.Emit(OpCodes.Stfld, fields[1]);
+
+        ilGenerator.Emit(OpCodes.Ldloc, structLocal);
+    }
+}
@@ -0,0 +1,39 @@
+using System.Reflection;
+using System.Reflection.Emit;
+
+namespace IR2IL.Intrinsics;
+
+/// <summary>
+/// llvm.vector.reduce.fadd and llvm.vector.reduce.fmul. Calls with the reassoc flag, which is what -ffast-math
+/// loops end with, don't have to combine the elements in order, so the vector is reduced with
+/// <paramref name="reassociatedMethod"/>, and the result is combined with the start value. Calls without
+/// it use <paramref name="orderedCase"/>.
+/// </summary>
+/// <param name="reassociatedMethod">
+/// The method on <see cref="Runtime.VectorReductions"/> that reduces the whole vector.
+/// </param>
+internal sealed class LLVMFloatingPointReductionIntrinsicFunction(
+    IntrinsicOperandType vectorType,
+    MethodInfo reassociatedMethod,
+    OpCode combineOpCode,
+    IntrinsicFunction orderedCase) : IntrinsicFunction
+{
+    public override void BuildCall(IntrinsicFunctionCallContext context)
+    {
+        if (!context.Instruction.GetFastMathFlags().HasFlag(FastMathFlags.AllowReassociation))
+        {
+            orderedCase.BuildCall(context);
+            return;
+        }
+
+        var ilGenerator = context.ILGenerator;
+
+        context.EmitValue(context.Operands[0]);
+        vectorType.EmitElementToMethodType(ilGenerator);
+        context.EmitValue(context.Operands[1]);
+        vectorType.EmitToMethodType(ilGenerator);
+        ilGenerator.Emit(OpCodes.Call, reassociatedMethod);
+        ilGenerator.Emit(combineOpCode);
+        vectorType.EmitElementFromMethodType(ilGenerator);
+    }
+}
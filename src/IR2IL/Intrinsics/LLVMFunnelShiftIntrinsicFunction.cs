@@ -0,0 +1,105 @@
+using System;
+using System.Diagnostics.CodeAnalysis;
+using System.Reflection;
+using System.Reflection.Emit;
+using System.Runtime.Intrinsics;
+using IR2IL.Helpers;
+using IR2IL.Runtime;
+using LLVMSharp.Interop;
+
+namespace IR2IL.Intrinsics;
+
+/// <summary>
+/// llvm.fshl and llvm.fshr. Compilers emit these for rotates, with the same value as both
+/// halves, so that case becomes a rotate instruction. Vectors shifted by a constant become a pair
+/// of whole-vector shifts, and vectors shifted by a vector of amounts use <see cref="VectorShifts"/>.
+/// Everything else uses <paramref name="generalCase"/>.
+/// </summary>
+internal sealed class LLVMFunnelShiftIntrinsicFunction(IntrinsicOperandType type, bool isLeft, IntrinsicFunction generalCase) : IntrinsicFunction
+{
+    public override void BuildCall(IntrinsicFunctionCallContext context)
+    {
+        var high = context.Operands[0];
+        var low = context.Operands[1];
+        var shiftAmount = context.Operands[2];
+
+        var bitCount = (int)(type.IsVector ? type.Type.ElementType : type.Type).IntWidth;
+
+        if (!type.IsVector)
+        {
+            var rotateMethod = type.MethodElementType.FindStaticMethod(
+                isLeft ? "RotateLeft" : "RotateRight",
+                type.MethodElementType,
+                [type.MethodElementType, typeof(int)]);
+
+            if (high == low && rotateMethod != null && bitCount <= 64)
+            {
+                context.EmitValue(high);
+                type.EmitToMethodType(context.ILGenerator);
+                context.EmitValue(shiftAmount);
+                if (bitCount == 64)
+                {
+                    context.ILGenerator.Emit(OpCodes.Conv_I4);
+                }
+                context.ILGenerator.Emit(OpCodes.Call, rotateMethod);
+                type.EmitFromMethodType(context.ILGenerator);
+                return;
+            }
+        }
+        else if (type.IsOddWidthInteger)
+        {
+            // The lanes are wider than the integers, so shifting them wouldn't wrap the bits around correctly.
+        }
+        else if (shiftAmount.TryGetSplatConstInt(out var constantShiftAmount)
+            && TryGetVectorMethod(nameof(Vector128.ShiftLeft), [type.MethodType, typeof(int)], out var shiftLeftMethod)
+            && TryGetVectorMethod(nameof(Vector128.ShiftRightLogical), [type.MethodType, typeof(int)], out var shiftRightMethod)
+            && TryGetVectorMethod(nameof(Vector128.BitwiseOr), [type.MethodType, type.MethodType], out var bitwiseOrMethod))
+        {
+            var shift = (int)(constantShiftAmount % (ulong)bitCount);
+            if (shift == 0)
+            {
+                context.EmitValue(isLeft ? high : low);
+                return;
+            }
+
+            // fshl: (high << shift) | (low >>> (bitCount - shift))
+            // fshr: (high << (bitCount - shift)) | (low >>> shift)
+            context.EmitValue(high);
+            type.EmitToMethodType(context.ILGenerator);
+            context.ILGenerator.Emit(OpCodes.Ldc_I4, isLeft ? shift : bitCount - shift);
+            context.ILGenerator.Emit(OpCodes.Call, shiftLeftMethod);
+
+            context.EmitValue(low);
+            type.EmitToMethodType(context.ILGenerator);
+            context.ILGenerator.Emit(OpCodes.Ldc_I4, isLeft ? bitCount - shift : shift);
+            context.ILGenerator.Emit(OpCodes.Call, shiftRightMethod);
+
+            context.ILGenerator.Emit(OpCodes.Call, bitwiseOrMethod);
+            type.EmitFromMethodType(context.ILGenerator);
+            return;
+        }
+        else if (typeof(VectorShifts).FindStaticMethod(
+            isLeft ? nameof(VectorShifts.FunnelShiftLeft) : nameof(VectorShifts.FunnelShiftRight),
+            type.MethodType,
+            [type.MethodType, type.MethodType, type.MethodType],
+            type.MethodElementType) is { } funnelShiftMethod)
+        {
+            foreach (var operand in context.Operands)
+            {
+                context.EmitValue(operand);
+                type.EmitToMethodType(context.ILGenerator);
+            }
+            context.ILGenerator.Emit(OpCodes.Call, funnelShiftMethod);
+            type.EmitFromMethodType(context.ILGenerator);
+            return;
+        }
+
+        generalCase.BuildCall(context);
+    }
+
+    private bool TryGetVectorMethod(string name, Type[] parameterTypes, [NotNullWhen(true)] out MethodInfo? method)
+    {
+        method = type.NonGenericVectorType?.FindStaticMethod(name, type.MethodType, parameterTypes, type.MethodElementType);
+        return method != null;
+    }
+}
@@ -0,0 +1,27 @@
+using System.Reflection;
+using System.Reflection.Emit;
+
+namespace IR2IL.Intrinsics;
+
+/// <summary>
+/// llvm.masked.load, llvm.masked.store, llvm.masked.gather, llvm.masked.scatter, llvm.masked.expandload
+/// and llvm.masked.compressstore, which call a method on <see cref="Runtime.MaskedMemory"/>.
+/// </summary>
+/// <param name="operandIndices">The operands the method takes, which are all of them except the alignment.</param>
+/// <param name="laneCount">The number of lanes in the LLVM vector, so padding lanes are never accessed.</param>
+internal sealed class LLVMMaskedMemoryIntrinsicFunction(MethodInfo method, int[] operandIndices, int laneCount) : IntrinsicFunction
+{
+    public override void BuildCall(IntrinsicFunctionCallContext context)
+    {
+        // declare <4 x float> @llvm.masked.load.v4f32.p0(ptr <ptr>, i32 <alignment>, <4 x i1> <mask>, <4 x float> <passthru>)
+        // public static TVector MaskedMemory.Load<T, TMask, TVector>(void* address, TMask mask, TVector passthru, int laneCount)
+
+        foreach (var operandIndex in operandIndices)
+        {
+            context.EmitValue(context.Operands[operandIndex]);
+        }
+
+        context.ILGenerator.Emit(OpCodes.Ldc_I4, laneCount);
+        context.ILGenerator.Emit(OpCodes.Call, method);
+    }
+}
@@ -0,0 +1,60 @@
+using System;
+using System.Reflection;
+using System.Reflection.Emit;
+using IR2IL.Helpers;
+using IR2IL.Runtime;
+
+namespace IR2IL.Intrinsics;
+
+internal sealed class LLVMMemCpyIntrinsicFunction(bool alwaysInline) : LLVMMemoryIntrinsicFunction
+{
+    private static readonly MethodInfo Method = typeof(LLVMIntrinsics).GetStaticMethodStrict(nameof(LLVMIntrinsics.MemCpy));
+
+    public override void BuildCall(IntrinsicFunctionCallContext context)
+    {
+        // declare void @llvm.memcpy.p0.p0.i64(ptr <dest>, ptr <src>, i64 <len>, i1 <isvolatile>)
+        // declare void @llvm.memcpy.inline.p0.p0.i64(ptr <dest>, ptr <src>, i64 immarg <len>, i1 immarg <isvolatile>)
+        // public static void LLVMIntrinsics.MemCpy(void* destination, void* source, nuint byteCount);
+
+        var isVolatile = IsVolatile(context.Operands[3]);
+
+        if (TryGetConstantLength(context.Operands[2], out var length)
+            && (length <= MaxInlineLength || alwaysInline))
+        {
+            if (length == 0)
+            {
+                return;
+            }
+
+            var alignment = Math.Min(
+                context.Instruction.GetCallSiteParameterAlignment(0),
+                context.Instruction.GetCallSiteParameterAlignment(1));
+
+            // destination
+            context.EmitValue(context.Operands[0]);
+
+            // source
+            context.EmitValue(context.Operands[1]);
+
+            // size
+            context.ILGenerator.Emit(OpCodes.Ldc_I4, (int)length);
+
+            EmitPrefixes(context.ILGenerator, isVolatile, alignment);
+            context.ILGenerator.Emit(OpCodes.Cpblk);
+        }
+        else
+        {
+            // destination
+            context.EmitValue(context.Operands[0]);
+
+            // source
+            context.EmitValue(context.Operands[1]);
+
+            // byteCount
+            context.EmitValue(context.Operands[2]);
+            context.ILGenerator.Emit(OpCodes.Conv_U);
+
+            context.ILGenerator.Emit(OpCodes.Call, Method);
+        }
+    }
+}
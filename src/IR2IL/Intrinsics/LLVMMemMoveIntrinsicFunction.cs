@@ -0,0 +1,135 @@
+using System;
+using System.Collections.Generic;
+using System.Reflection;
+using System.Reflection.Emit;
+using System.Runtime.Intrinsics;
+using IR2IL.Helpers;
+using IR2IL.Runtime;
+
+namespace IR2IL.Intrinsics;
+
+internal sealed class LLVMMemMoveIntrinsicFunction : LLVMMemoryIntrinsicFunction
+{
+    private static readonly MethodInfo Method = typeof(LLVMIntrinsics).GetStaticMethodStrict(nameof(LLVMIntrinsics.MemMove));
+
+    // Constant lengths up to this size are expanded into at most a handful of
+    // loads followed by the same number of stores.
+    private const uint MaxUnrolledLength = 64;
+
+    private static readonly (int Size, Type Type)[] ChunkTypes =
+    [
+        (32, typeof(Vector256<byte>)),
+        (16, typeof(Vector128<byte>)),
+        (8, typeof(long)),
+        (4, typeof(int)),
+        (2, typeof(short)),
+        (1, typeof(byte)),
+    ];
+
+    public override void BuildCall(IntrinsicFunctionCallContext context)
+    {
+        // declare void @llvm.memmove.p0.p0.i64(ptr <dest>, ptr <src>, i64 <len>, i1 <isvolatile>)
+        // public static void LLVMIntrinsics.MemMove(void* destination, void* source, nuint byteCount);
+
+        var isVolatile = IsVolatile(context.Operands[3]);
+
+        if (TryGetConstantLength(context.Operands[2], out var length)
+            && length <= MaxUnrolledLength)
+        {
+            if (length == 0)
+            {
+                return;
+            }
+
+            var alignment = Math.Min(
+                context.Instruction.GetCallSiteParameterAlignment(0),
+                context.Instruction.GetCallSiteParameterAlignment(1));
+
+            var ilGenerator = context.ILGenerator;
+
+            var destinationLocal = ilGenerator.DeclareLocal(typeof(void*));
+            context.EmitValue(context.Operands[0]);
+            ilGenerator.Emit(OpCodes.Stloc, destinationLocal);
+
+            var sourceLocal = ilGenerator.DeclareLocal(typeof(void*));
+            context.EmitValue(context.Operands[1]);
+            ilGenerator.Emit(OpCodes.Stloc, sourceLocal);
+
+            // The source and destination may overlap, so we read every chunk
+            // before writing any of them.
+            var chunks = GetChunks((int)length);
+            var chunkLocals = new LocalBuilder[chunks.Count];
+
+            for (var i = 0; i < chunks.Count; i++)
+            {
+                var (offset, chunkType) = chunks[i];
+
+                EmitAddress(ilGenerator, sourceLocal, offset);
+                EmitPrefixes(ilGenerator, isVolatile, alignment);
+                ilGenerator.Emit(OpCodes.Ldobj, chunkType);
+
+                chunkLocals[i] = ilGenerator.DeclareLocal(chunkType);
+                ilGenerator.Emit(OpCodes.Stloc, chunkLocals[i]);
+            }
+
+            for (var i = 0; i < chunks.Count; i++)
+            {
+                var (offset, chunkType) = chunks[i];
+
+                EmitAddress(ilGenerator, destinationLocal, offset);
+                ilGenerator.Emit(OpCodes.Ldloc, chunkLocals[i]);
+                EmitPrefixes(ilGenerator, isVolatile, alignment);
+                ilGenerator.Emit(OpCodes.Stobj, chunkType);
+            }
+        }
+        else
+        {
+            // destination
+            context.EmitValue(context.Operands[0]);
+
+            // source
+            context.EmitValue(context.Operands[1]);
+
+            // byteCount
+            context.EmitValue(context.Operands[2]);
+            context.ILGenerator.Emit(OpCodes.Conv_U);
+
+            context.ILGenerator.Emit(OpCodes.Call, Method);
+        }
+    }
+
+    private static List<(int Offset, Type Type)> GetChunks(int length)
+    {
+        // Cover the whole range with the widest chunk that fits. If the length
+        // isn't a multiple of the chunk size, the last chunk overlaps the one
+        // before it, which is fine because every load happens before any store.
+        var (chunkSize, chunkType) = Array.Find(ChunkTypes, x => x.Size <= length);
+
+        var result = new List<(int Offset, Type Type)>();
+
+        var offset = 0;
+        for (; offset + chunkSize <= length; offset += chunkSize)
+        {
+            result.Add((offset, chunkType));
+        }
+
+        if (offset < length)
+        {
+            result.Add((length - chunkSize, chunkType));
+        }
+
+        return result;
+    }
+
+    private static void EmitAddress(ILGenerator ilGenerator, LocalBuilder pointerLocal, int offset)
+    {
+        ilGenerator.Emit(OpCodes.Ldloc, pointerLocal);
+
+        if (offset > 0)
+        {
+            ilGenerator.Emit(OpCodes.Ldc_I4, offset);
+            ilGenerator.Emit(OpCodes.Conv_U);
+            ilGenerator.Emit(OpCodes.Add);
+        }
+    }
+}
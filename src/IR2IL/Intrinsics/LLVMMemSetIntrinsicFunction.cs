@@ -0,0 +1,55 @@
+using System.Reflection;
+using System.Reflection.Emit;
+using IR2IL.Helpers;
+using IR2IL.Runtime;
+
+namespace IR2IL.Intrinsics;
+
+internal sealed class LLVMMemSetIntrinsicFunction(bool alwaysInline) : LLVMMemoryIntrinsicFunction
+{
+    private static readonly MethodInfo Method = typeof(LLVMIntrinsics).GetStaticMethodStrict(nameof(LLVMIntrinsics.MemSet));
+
+    public override void BuildCall(IntrinsicFunctionCallContext context)
+    {
+        // declare void @llvm.memset.p0.i64(ptr <dest>, i8 <val>, i64 <len>, i1 <isvolatile>)
+        // declare void @llvm.memset.inline.p0.i64(ptr <dest>, i8 <val>, i64 immarg <len>, i1 immarg <isvolatile>)
+        // public static void LLVMIntrinsics.MemSet(void* destination, byte value, nuint byteCount);
+
+        var isVolatile = IsVolatile(context.Operands[3]);
+
+        if (TryGetConstantLength(context.Operands[2], out var length)
+            && (length <= MaxInlineLength || alwaysInline))
+        {
+            if (length == 0)
+            {
+                return;
+            }
+
+            // destination
+            context.EmitValue(context.Operands[0]);
+
+            // value
+            context.EmitValue(context.Operands[1]);
+
+            // size
+            context.ILGenerator.Emit(OpCodes.Ldc_I4, (int)length);
+
+            EmitPrefixes(context.ILGenerator, isVolatile, context.Instruction.GetCallSiteParameterAlignment(0));
+            context.ILGenerator.Emit(OpCodes.Initblk);
+        }
+        else
+        {
+            // destination
+            context.EmitValue(context.Operands[0]);
+
+            // value
+            context.EmitValue(context.Operands[1]);
+
+            // byteCount
+            context.EmitValue(context.Operands[2]);
+            context.ILGenerator.Emit(OpCodes.Conv_U);
+
+            context.ILGenerator.Emit(OpCodes.Call, Method);
+        }
+    }
+}
@@ -0,0 +1,48 @@
+using System.Reflection.Emit;
+using LLVMSharp.Interop;
+
+namespace IR2IL.Intrinsics;
+
+/// <summary>
+/// Shared helpers for the llvm.memcpy / llvm.memmove / llvm.memset family.
+/// </summary>
+internal abstract class LLVMMemoryIntrinsicFunction : IntrinsicFunction
+{
+    // Constant lengths up to this size are emitted as cpblk / initblk,
+    // which RyuJIT unrolls into scalar and SIMD moves.
+    protected const uint MaxInlineLength = 128;
+
+    protected static bool TryGetConstantLength(LLVMValueRef length, out uint result)
+    {
+        if (length.Kind == LLVMValueKind.LLVMConstantIntValueKind && length.ConstIntZExt <= uint.MaxValue)
+        {
+            result = (uint)length.ConstIntZExt;
+            return true;
+        }
+
+        result = 0;
+        return false;
+    }
+
+    protected static bool IsVolatile(LLVMValueRef isVolatile) => isVolatile.ConstIntZExt != 0;
+
+    protected static void EmitPrefixes(ILGenerator ilGenerator, bool isVolatile, uint alignment)
+    {
+        if (isVolatile)
+        {
+            ilGenerator.Emit(OpCodes.Volatile);
+        }
+
+        // Without the unaligned. prefix, cpblk / initblk / ldobj / stobj
+        // assume the address is aligned to the natural size of the machine.
+        if (alignment < 8)
+        {
+            ilGenerator.Emit(OpCodes.Unaligned, alignment switch
+            {
+                >= 4 => (byte)4,
+                >= 2 => (byte)2,
+                _ => (byte)1,
+            });
+        }
+    }
+}
@@ -0,0 +1,54 @@
+using System.Reflection;
+using System.Reflection.Emit;
+
+namespace IR2IL.Intrinsics;
+
+/// <summary>
+/// Implements an element-wise vector intrinsic by calling the scalar implementation for each lane.
+/// Used when the vector type has no method of its own, for example llvm.smax.v2i8 on a <c>Vector16&lt;byte&gt;</c>.
+/// </summary>
+internal sealed class LaneWiseIntrinsicFunction(MethodInfo scalarMethod, IntrinsicOperandType vectorType, int operandCount) : IntrinsicFunction
+{
+    public override void BuildCall(IntrinsicFunctionCallContext context)
+    {
+        var ilGenerator = context.ILGenerator;
+
+        var operandLocals = new LocalBuilder[operandCount];
+        for (var i = 0; i < operandLocals.Length; i++)
+        {
+            operandLocals[i] = ilGenerator.DeclareLocal(vectorType.MsilType);
+            context.EmitValue(context.Operands[i]);
+            ilGenerator.Emit(OpCodes.Stloc, operandLocals[i]);
+        }
+
+        var resultLocal = ilGenerator.DeclareLocal(vectorType.MsilType);
+        ilGenerator.Emit(OpCodes.Ldloca, resultLocal);
+        ilGenerator.Emit(OpCodes.Initobj, vectorType.MsilType);
+
+        var getElementMethod = vectorType.GetElementMethod;
+        var withElementMethod = vectorType.WithElementMethod;
+
+        // result = result.WithElement(i, Method(operand0.GetElement(i), operand1.GetElement(i), ...))
+        for (var lane = 0; lane < vectorType.VectorSize; lane++)
+        {
+            ilGenerator.Emit(OpCodes.Ldloc, resultLocal);
+            ilGenerator.Emit(OpCodes.Ldc_I4, lane);
+
+            foreach (var operandLocal in operandLocals)
+            {
+                ilGenerator.Emit(OpCodes.Ldloc, operandLocal);
+                ilGenerator.Emit(OpCodes.Ldc_I4, lane);
+                ilGenerator.Emit(OpCodes.Call, getElementMethod);
+                vectorType.EmitElementToMethodType(ilGenerator);
+            }
+
+            ilGenerator.Emit(OpCodes.Call, scalarMethod);
+            vectorType.EmitElementFromMethodType(ilGenerator);
+
+            ilGenerator.Emit(OpCodes.Call, withElementMethod);
+            ilGenerator.Emit(OpCodes.Stloc, resultLocal);
+        }
+
+        ilGenerator.Emit(OpCodes.Ldloc, resultLocal);
+    }
+}
@@ -0,0 +1,43 @@
+using System.Reflection;
+using System.Reflection.Emit;
+
+namespace IR2IL.Intrinsics;
+
+/// <summary>
+/// Calls a .NET method that implements an overloaded intrinsic, such as
+/// <c>Vector256.Max&lt;int&gt;</c> for llvm.smax.v8i32 or <c>Vector128.Sum&lt;short&gt;</c>
+/// for llvm.vector.reduce.add.v8i16, reinterpreting the operands and result
+/// to the signedness the method expects.
+/// </summary>
+/// <param name="operandCount">
+/// How many of the intrinsic's operands are passed to the method. Flags such as
+/// the is_zero_poison operand of llvm.ctlz aren't needed.
+/// </param>
+/// <param name="paddingLaneValue">
+/// For padded vectors, a value to put in the padding lanes of the operands, so that
+/// they don't change the result of a reduction.
+/// </param>
+internal sealed class OverloadedIntrinsicFunction(
+    MethodInfo method,
+    IntrinsicOperandType operandType,
+    IntrinsicOperandType resultType,
+    int operandCount,
+    int? paddingLaneValue = null) : IntrinsicFunction
+{
+    public override void BuildCall(IntrinsicFunctionCallContext context)
+    {
+        for (var i = 0; i < operandCount; i++)
+        {
+            context.EmitValue(context.Operands[i]);
+            if (paddingLaneValue != null)
+            {
+                operandType.EmitFillPaddingLanes(context.ILGenerator, paddingLaneValue.Value);
+            }
+            operandType.EmitToMethodType(context.ILGenerator);
+        }
+
+        context.ILGenerator.Emit(OpCodes.Call, method);
+
+        resultType.EmitFromMethodType(context.ILGenerator);
+    }
+}
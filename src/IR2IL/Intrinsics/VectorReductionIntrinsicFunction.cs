@@ -0,0 +1,54 @@
+using System;
+using System.Reflection.Emit;
+
+namespace IR2IL.Intrinsics;
+
+/// <summary>
+/// Implements llvm.vector.reduce.* by folding the lanes of the vector one at a time.
+/// Used when the vector type has no method that does the whole reduction, for padded vectors
+/// such as &lt;3 x float&gt;, whose padding lanes must be left out, and for
+/// llvm.vector.reduce.fadd and llvm.vector.reduce.fmul, which must combine the lanes in order.
+/// </summary>
+/// <param name="emitCombine">
+/// Emits IL that combines the two element values on top of the stack, as <see cref="IntrinsicOperandType.MethodElementType"/>.
+/// </param>
+/// <param name="hasStartValue">
+/// Whether the first operand is a scalar to start from, and the vector is the second.
+/// </param>
+internal sealed class VectorReductionIntrinsicFunction(
+    IntrinsicOperandType vectorType,
+    Action<ILGenerator> emitCombine,
+    bool hasStartValue = false) : IntrinsicFunction
+{
+    public override void BuildCall(IntrinsicFunctionCallContext context)
+    {
+        var ilGenerator = context.ILGenerator;
+
+        var vectorLocal = ilGenerator.DeclareLocal(vectorType.MsilType);
+        context.EmitValue(context.Operands[hasStartValue ? 1 : 0]);
+        ilGenerator.Emit(OpCodes.Stloc, vectorLocal);
+
+        if (hasStartValue)
+        {
+            context.EmitValue(context.Operands[0]);
+            vectorType.EmitElementToMethodType(ilGenerator);
+        }
+
+        var getElementMethod = vectorType.GetElementMethod;
+
+        for (var lane = 0; lane < vectorType.VectorSize; lane++)
+        {
+            ilGenerator.Emit(OpCodes.Ldloc, vectorLocal);
+            ilGenerator.Emit(OpCodes.Ldc_I4, lane);
+            ilGenerator.Emit(OpCodes.Call, getElementMethod);
+            vectorType.EmitElementToMethodType(ilGenerator);
+
+            if (lane > 0 || hasStartValue)
+            {
+                emitCombine(ilGenerator);
+            }
+        }
+
+        vectorType.EmitElementFromMethodType(ilGenerator);
+    }
+}
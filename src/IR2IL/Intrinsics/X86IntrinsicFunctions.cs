@@ -0,0 +1,234 @@
+using System.Collections.Generic;
+using System.Linq;
+using IR2IL.Helpers;
+using IR2IL.Runtime;
+
+namespace IR2IL.Intrinsics;
+
+/// <summary>
+/// The llvm.x86.* intrinsics, which clang uses for &lt;immintrin.h&gt; functions that don't have
+/// a target-independent equivalent.
+/// </summary>
+/// <remarks>
+/// Most are implemented by the <see cref="X86Intrinsics"/> overload whose signature matches the
+/// intrinsic's MSIL types, so one method name covers the 128-bit and 256-bit forms.
+/// </remarks>
+internal static class X86IntrinsicFunctions
+{
+    private static readonly IntrinsicFamily NoOp = (_, _) => NoOpIntrinsicFunction.Instance;
+
+    /// <summary>
+    /// Keyed by base name, such as x86.sse2.pmovmskb.128. These only compute a result from their operands.
+    /// </summary>
+    public static readonly Dictionary<string, IntrinsicFamily> Intrinsics = new()
+    {
+        // Masks and tests.
+        { "x86.sse.movmsk.ps", X86(nameof(X86Intrinsics.MoveMask)) },
+        { "x86.sse2.movmsk.pd", X86(nameof(X86Intrinsics.MoveMask)) },
+        { "x86.sse2.pmovmskb.128", X86(nameof(X86Intrinsics.MoveMask)) },
+        { "x86.avx.movmsk.ps.256", X86(nameof(X86Intrinsics.MoveMask)) },
+        { "x86.avx.movmsk.pd.256", X86(nameof(X86Intrinsics.MoveMask)) },
+        { "x86.avx2.pmovmskb", X86(nameof(X86Intrinsics.MoveMask)) },
+        { "x86.sse41.ptestz", X86(nameof(X86Intrinsics.TestZ)) },
+        { "x86.sse41.ptestc", X86(nameof(X86Intrinsics.TestC)) },
+        { "x86.sse41.ptestnzc", X86(nameof(X86Intrinsics.TestNotZAndNotC)) },
+        { "x86.avx.ptestz.256", X86(nameof(X86Intrinsics.TestZ)) },
+        { "x86.avx.ptestc.256", X86(nameof(X86Intrinsics.TestC)) },
+        { "x86.avx.ptestnzc.256", X86(nameof(X86Intrinsics.TestNotZAndNotC)) },
+
+        // Blends, shuffles and permutes.
+        { "x86.sse41.pblendvb", X86(nameof(X86Intrinsics.BlendVariable)) },
+        { "x86.sse41.blendvps", X86(nameof(X86Intrinsics.BlendVariable)) },
+        { "x86.sse41.blendvpd", X86(nameof(X86Intrinsics.BlendVariable)) },
+        { "x86.avx.blendv.ps.256", X86(nameof(X86Intrinsics.BlendVariable)) },
+        { "x86.avx.blendv.pd.256", X86(nameof(X86Intrinsics.BlendVariable)) },
+        { "x86.avx2.pblendvb", X86(nameof(X86Intrinsics.BlendVariable)) },
+        { "x86.ssse3.pshuf.b.128", X86(nameof(X86Intrinsics.Shuffle)) },
+        { "x86.avx2.pshuf.b", X86(nameof(X86Intrinsics.Shuffle)) },
+        { "x86.avx.vpermilvar.ps", X86(nameof(X86Intrinsics.PermuteVar)) },
+        { "x86.avx.vpermilvar.pd", X86(nameof(X86Intrinsics.PermuteVar)) },
+        { "x86.avx.vpermilvar.ps.256", X86(nameof(X86Intrinsics.PermuteVar)) },
+        { "x86.avx.vpermilvar.pd.256", X86(nameof(X86Intrinsics.PermuteVar)) },
+        { "x86.avx2.permd", X86(nameof(X86Intrinsics.PermuteVar8x32)) },
+        { "x86.avx2.permps", X86(nameof(X86Intrinsics.PermuteVar8x32)) },
+
+        // Packs.
+        { "x86.sse2.packsswb.128", X86(nameof(X86Intrinsics.PackSignedSaturate)) },
+        { "x86.sse2.packssdw.128", X86(nameof(X86Intrinsics.PackSignedSaturate)) },
+        { "x86.sse2.packuswb.128", X86(nameof(X86Intrinsics.PackUnsignedSaturate)) },
+        { "x86.sse41.packusdw", X86(nameof(X86Intrinsics.PackUnsignedSaturate)) },
+        { "x86.avx2.packsswb", X86(nameof(X86Intrinsics.PackSignedSaturate)) },
+        { "x86.avx2.packssdw", X86(nameof(X86Intrinsics.PackSignedSaturate)) },
+        { "x86.avx2.packuswb", X86(nameof(X86Intrinsics.PackUnsignedSaturate)) },
+        { "x86.avx2.packusdw", X86(nameof(X86Intrinsics.PackUnsignedSaturate)) },
+
+        // Integer arithmetic.
+        { "x86.sse2.pmadd.wd", X86(nameof(X86Intrinsics.MultiplyAddAdjacent)) },
+        { "x86.ssse3.pmadd.ub.sw.128", X86(nameof(X86Intrinsics.MultiplyAddAdjacent)) },
+        { "x86.avx2.pmadd.wd", X86(nameof(X86Intrinsics.MultiplyAddAdjacent)) },
+        { "x86.avx2.pmadd.ub.sw", X86(nameof(X86Intrinsics.MultiplyAddAdjacent)) },
+        { "x86.sse2.pmulh.w", X86(nameof(X86Intrinsics.MultiplyHigh)) },
+        { "x86.sse2.pmulhu.w", X86(nameof(X86Intrinsics.MultiplyHighUnsigned)) },
+        { "x86.ssse3.pmul.hr.sw.128", X86(nameof(X86Intrinsics.MultiplyHighRoundScale)) },
+        { "x86.avx2.pmulh.w", X86(nameof(X86Intrinsics.MultiplyHigh)) },
+        { "x86.avx2.pmulhu.w", X86(nameof(X86Intrinsics.MultiplyHighUnsigned)) },
+        { "x86.avx2.pmul.hr.sw", X86(nameof(X86Intrinsics.MultiplyHighRoundScale)) },
+        { "x86.sse2.pavg.b", X86(nameof(X86Intrinsics.Average)) },
+        { "x86.sse2.pavg.w", X86(nameof(X86Intrinsics.Average)) },
+        { "x86.avx2.pavg.b", X86(nameof(X86Intrinsics.Average)) },
+        { "x86.avx2.pavg.w", X86(nameof(X86Intrinsics.Average)) },
+        { "x86.sse2.psad.bw", X86(nameof(X86Intrinsics.SumAbsoluteDifferences)) },
+        { "x86.avx2.psad.bw", X86(nameof(X86Intrinsics.SumAbsoluteDifferences)) },
+        { "x86.ssse3.phadd.w.128", X86(nameof(X86Intrinsics.HorizontalAdd)) },
+        { "x86.ssse3.phadd.d.128", X86(nameof(X86Intrinsics.HorizontalAdd)) },
+        { "x86.ssse3.phadd.sw.128", X86(nameof(X86Intrinsics.HorizontalAddSaturate)) },
+        { "x86.ssse3.phsub.w.128", X86(nameof(X86Intrinsics.HorizontalSubtract)) },
+        { "x86.ssse3.phsub.d.128", X86(nameof(X86Intrinsics.HorizontalSubtract)) },
+        { "x86.ssse3.phsub.sw.128", X86(nameof(X86Intrinsics.HorizontalSubtractSaturate)) },
+        { "x86.avx2.phadd.w", X86(nameof(X86Intrinsics.HorizontalAdd)) },
+        { "x86.avx2.phadd.d", X86(nameof(X86Intrinsics.HorizontalAdd)) },
+        { "x86.avx2.phadd.sw", X86(nameof(X86Intrinsics.HorizontalAddSaturate)) },
+        { "x86.avx2.phsub.w", X86(nameof(X86Intrinsics.HorizontalSubtract)) },
+        { "x86.avx2.phsub.d", X86(nameof(X86Intrinsics.HorizontalSubtract)) },
+        { "x86.avx2.phsub.sw", X86(nameof(X86Intrinsics.HorizontalSubtractSaturate)) },
+        { "x86.sse41.phminposuw", X86(nameof(X86Intrinsics.MinHorizontal)) },
+        { "x86.ssse3.psign.b.128", X86(nameof(X86Intrinsics.Sign)) },
+        { "x86.ssse3.psign.w.128", X86(nameof(X86Intrinsics.Sign)) },
+        { "x86.ssse3.psign.d.128", X86(nameof(X86Intrinsics.Sign)) },
+        { "x86.avx2.psign.b", X86(nameof(X86Intrinsics.Sign)) },
+        { "x86.avx2.psign.w", X86(nameof(X86Intrinsics.Sign)) },
+        { "x86.avx2.psign.d", X86(nameof(X86Intrinsics.Sign)) },
+
+        // Shifts by an immediate, by the low element of a vector, and by a count for each element.
+        { "x86.sse2.pslli.w", X86(nameof(X86Intrinsics.ShiftLeftLogical)) },
+        { "x86.sse2.pslli.d", X86(nameof(X86Intrinsics.ShiftLeftLogical)) },
+        { "x86.sse2.pslli.q", X86(nameof(X86Intrinsics.ShiftLeftLogical)) },
+        { "x86.sse2.psrli.w", X86(nameof(X86Intrinsics.ShiftRightLogical)) },
+        { "x86.sse2.psrli.d", X86(nameof(X86Intrinsics.ShiftRightLogical)) },
+        { "x86.sse2.psrli.q", X86(nameof(X86Intrinsics.ShiftRightLogical)) },
+        { "x86.sse2.psrai.w", X86(nameof(X86Intrinsics.ShiftRightArithmetic)) },
+        { "x86.sse2.psrai.d", X86(nameof(X86Intrinsics.ShiftRightArithmetic)) },
+        { "x86.avx2.pslli.w", X86(nameof(X86Intrinsics.ShiftLeftLogical)) },
+        { "x86.avx2.pslli.d", X86(nameof(X86Intrinsics.ShiftLeftLogical)) },
+        { "x86.avx2.pslli.q", X86(nameof(X86Intrinsics.ShiftLeftLogical)) },
+        { "x86.avx2.psrli.w", X86(nameof(X86Intrinsics.ShiftRightLogical)) },
+        { "x86.avx2.psrli.d", X86(nameof(X86Intrinsics.ShiftRightLogical)) },
+        { "x86.avx2.psrli.q", X86(nameof(X86Intrinsics.ShiftRightLogical)) },
+        { "x86.avx2.psrai.w", X86(nameof(X86Intrinsics.ShiftRightArithmetic)) },
+        { "x86.avx2.psrai.d", X86(nameof(X86Intrinsics.ShiftRightArithmetic)) },
+        { "x86.sse2.psll.w", X86(nameof(X86Intrinsics.ShiftLeftLogical)) },
+        { "x86.sse2.psll.d", X86(nameof(X86Intrinsics.ShiftLeftLogical)) },
+        { "x86.sse2.psll.q", X86(nameof(X86Intrinsics.ShiftLeftLogical)) },
+        { "x86.sse2.psrl.w", X86(nameof(X86Intrinsics.ShiftRightLogical)) },
+        { "x86.sse2.psrl.d", X86(nameof(X86Intrinsics.ShiftRightLogical)) },
+        { "x86.sse2.psrl.q", X86(nameof(X86Intrinsics.ShiftRightLogical)) },
+        { "x86.sse2.psra.w", X86(nameof(X86Intrinsics.ShiftRightArithmetic)) },
+        { "x86.sse2.psra.d", X86(nameof(X86Intrinsics.ShiftRightArithmetic)) },
+        { "x86.avx2.psll.w", X86(nameof(X86Intrinsics.ShiftLeftLogical)) },
+        { "x86.avx2.psll.d", X86(nameof(X86Intrinsics.ShiftLeftLogical)) },
+        { "x86.avx2.psll.q", X86(nameof(X86Intrinsics.ShiftLeftLogical)) },
+        { "x86.avx2.psrl.w", X86(nameof(X86Intrinsics.ShiftRightLogical)) },
+        { "x86.avx2.psrl.d", X86(nameof(X86Intrinsics.ShiftRightLogical)) },
+        { "x86.avx2.psrl.q", X86(nameof(X86Intrinsics.ShiftRightLogical)) },
+        { "x86.avx2.psra.w", X86(nameof(X86Intrinsics.ShiftRightArithmetic)) },
+        { "x86.avx2.psra.d", X86(nameof(X86Intrinsics.ShiftRightArithmetic)) },
+        { "x86.avx2.psllv.d", X86(nameof(X86Intrinsics.ShiftLeftLogicalVariable)) },
+        { "x86.avx2.psllv.d.256", X86(nameof(X86Intrinsics.ShiftLeftLogicalVariable)) },
+        { "x86.avx2.psllv.q", X86(nameof(X86Intrinsics.ShiftLeftLogicalVariable)) },
+        { "x86.avx2.psllv.q.256", X86(nameof(X86Intrinsics.ShiftLeftLogicalVariable)) },
+        { "x86.avx2.psrlv.d", X86(nameof(X86Intrinsics.ShiftRightLogicalVariable)) },
+        { "x86.avx2.psrlv.d.256", X86(nameof(X86Intrinsics.ShiftRightLogicalVariable)) },
+        { "x86.avx2.psrlv.q", X86(nameof(X86Intrinsics.ShiftRightLogicalVariable)) },
+        { "x86.avx2.psrlv.q.256", X86(nameof(X86Intrinsics.ShiftRightLogicalVariable)) },
+        { "x86.avx2.psrav.d", X86(nameof(X86Intrinsics.ShiftRightArithmeticVariable)) },
+        { "x86.avx2.psrav.d.256", X86(nameof(X86Intrinsics.ShiftRightArithmeticVariable)) },
+
+        // Floating-point arithmetic and rounding.
+        { "x86.sse.max.ps", X86(nameof(X86Intrinsics.Max)) },
+        { "x86.sse.min.ps", X86(nameof(X86Intrinsics.Min)) },
+        { "x86.sse2.max.pd", X86(nameof(X86Intrinsics.Max)) },
+        { "x86.sse2.min.pd", X86(nameof(X86Intrinsics.Min)) },
+        { "x86.avx.max.ps.256", X86(nameof(X86Intrinsics.Max)) },
+        { "x86.avx.min.ps.256", X86(nameof(X86Intrinsics.Min)) },
+        { "x86.avx.max.pd.256", X86(nameof(X86Intrinsics.Max)) },
+        { "x86.avx.min.pd.256", X86(nameof(X86Intrinsics.Min)) },
+        { "x86.sse.rcp.ps", X86(nameof(X86Intrinsics.Reciprocal)) },
+        { "x86.sse.rsqrt.ps", X86(nameof(X86Intrinsics.ReciprocalSqrt)) },
+        { "x86.avx.rcp.ps.256", X86(nameof(X86Intrinsics.Reciprocal)) },
+        { "x86.avx.rsqrt.ps.256", X86(nameof(X86Intrinsics.ReciprocalSqrt)) },
+        { "x86.sse41.round.ps", X86(nameof(X86Intrinsics.Round)) },
+        { "x86.sse41.round.pd", X86(nameof(X86Intrinsics.Round)) },
+        { "x86.avx.round.ps.256", X86(nameof(X86Intrinsics.Round)) },
+        { "x86.avx.round.pd.256", X86(nameof(X86Intrinsics.Round)) },
+
+        // Conversions.
+        { "x86.sse.cvtss2si", X86(nameof(X86Intrinsics.ConvertToInt32)) },
+        { "x86.sse.cvttss2si", X86(nameof(X86Intrinsics.ConvertToInt32WithTruncation)) },
+        { "x86.sse.cvtss2si64", X86(nameof(X86Intrinsics.ConvertToInt64)) },
+        { "x86.sse.cvttss2si64", X86(nameof(X86Intrinsics.ConvertToInt64WithTruncation)) },
+        { "x86.sse2.cvtsd2si", X86(nameof(X86Intrinsics.ConvertToInt32)) },
+        { "x86.sse2.cvttsd2si", X86(nameof(X86Intrinsics.ConvertToInt32WithTruncation)) },
+        { "x86.sse2.cvtsd2si64", X86(nameof(X86Intrinsics.ConvertToInt64)) },
+        { "x86.sse2.cvttsd2si64", X86(nameof(X86Intrinsics.ConvertToInt64WithTruncation)) },
+        { "x86.sse2.cvtps2dq", X86(nameof(X86Intrinsics.ConvertToVector128Int32)) },
+        { "x86.sse2.cvttps2dq", X86(nameof(X86Intrinsics.ConvertToVector128Int32WithTruncation)) },
+        { "x86.sse2.cvtpd2dq", X86(nameof(X86Intrinsics.ConvertToVector128Int32)) },
+        { "x86.sse2.cvttpd2dq", X86(nameof(X86Intrinsics.ConvertToVector128Int32WithTruncation)) },
+        { "x86.avx.cvt.ps2dq.256", X86(nameof(X86Intrinsics.ConvertToVector256Int32)) },
+        { "x86.avx.cvtt.ps2dq.256", X86(nameof(X86Intrinsics.ConvertToVector256Int32WithTruncation)) },
+
+        // Bit manipulation.
+        { "x86.bmi.bextr.32", X86(nameof(X86Intrinsics.BitFieldExtract)) },
+        { "x86.bmi.bextr.64", X86(nameof(X86Intrinsics.BitFieldExtract)) },
+        { "x86.bmi.bzhi.32", X86(nameof(X86Intrinsics.ZeroHighBits)) },
+        { "x86.bmi.bzhi.64", X86(nameof(X86Intrinsics.ZeroHighBits)) },
+        { "x86.bmi.pdep.32", X86(nameof(X86Intrinsics.ParallelBitDeposit)) },
+        { "x86.bmi.pdep.64", X86(nameof(X86Intrinsics.ParallelBitDeposit)) },
+        { "x86.bmi.pext.32", X86(nameof(X86Intrinsics.ParallelBitExtract)) },
+        { "x86.bmi.pext.64", X86(nameof(X86Intrinsics.ParallelBitExtract)) },
+
+        // Checksums and cryptography.
+        { "x86.sse42.crc32.32.8", X86(nameof(X86Intrinsics.Crc32)) },
+        { "x86.sse42.crc32.32.16", X86(nameof(X86Intrinsics.Crc32)) },
+        { "x86.sse42.crc32.32.32", X86(nameof(X86Intrinsics.Crc32)) },
+        { "x86.sse42.crc32.64.64", X86(nameof(X86Intrinsics.Crc32)) },
+        { "x86.aesni.aesenc", X86(nameof(X86Intrinsics.AesEncrypt)) },
+        { "x86.aesni.aesenclast", X86(nameof(X86Intrinsics.AesEncryptLast)) },
+        { "x86.aesni.aesdec", X86(nameof(X86Intrinsics.AesDecrypt)) },
+        { "x86.aesni.aesdeclast", X86(nameof(X86Intrinsics.AesDecryptLast)) },
+        { "x86.aesni.aesimc", X86(nameof(X86Intrinsics.AesInverseMixColumns)) },
+        { "x86.aesni.aeskeygenassist", X86(nameof(X86Intrinsics.AesKeygenAssist)) },
+        { "x86.pclmulqdq", X86(nameof(X86Intrinsics.CarrylessMultiply)) },
+    };
+
+    /// <summary>
+    /// Memory ordering and hints, which unlike those in <see cref="Intrinsics"/> can't be moved past loads and stores.
+    /// The upper halves of the YMM registers, and cache lines, aren't visible in .NET.
+    /// </summary>
+    public static readonly Dictionary<string, IntrinsicFamily> OrderingIntrinsics = new()
+    {
+        { "x86.sse2.lfence", X86(nameof(X86Intrinsics.LoadFence)) },
+        { "x86.sse2.mfence", X86(nameof(X86Intrinsics.MemoryFence)) },
+        { "x86.sse.sfence", X86(nameof(X86Intrinsics.StoreFence)) },
+        { "x86.sse2.pause", X86(nameof(X86Intrinsics.Pause)) },
+        { "x86.avx.vzeroall", NoOp },
+        { "x86.avx.vzeroupper", NoOp },
+        { "x86.sse2.clflush", NoOp },
+    };
+
+    /// <summary>
+    /// An intrinsic implemented by the <see cref="X86Intrinsics"/> overload of <paramref name="methodName"/>
+    /// whose parameter and return types match the intrinsic's.
+    /// </summary>
+    private static IntrinsicFamily X86(string methodName) => (typeSystem, functionType) =>
+    {
+        var method = typeof(X86Intrinsics).FindStaticMethod(
+            methodName,
+            typeSystem.GetMsilType(functionType.ReturnType),
+            functionType.ParamTypes.Select(typeSystem.GetMsilType).ToArray());
+
+        return method != null
+            ? new StandardIntrinsicFunction(method)
+            : null;
+    };
+}
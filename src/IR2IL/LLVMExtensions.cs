@@ -1,7 +1,9 @@
 using System;
 using System.Collections.Generic;
+using System.Globalization;
 using System.Linq;
 using System.Text.RegularExpressions;
+using IR2IL.Intrinsics;
 using LLVMSharp.Interop;
 
 namespace IR2IL;
@@ -116,7 +118,55 @@ internal static partial class LLVMExtensions
         return instruction.GetOperand(0).Kind == LLVMValueKind.LLVMConstantIntValueKind;
     }
 
-    public static unsafe int[] GetShuffleVectorMaskValues(this LLVMValueRef instruction)
+    public static unsafe uint GetCallSiteParameterAlignment(this LLVMValueRef instruction, int parameterIndex)
+    {
+        if (instruction.Kind != LLVMValueKind.LLVMInstructionValueKind
+            || instruction.InstructionOpcode != LLVMOpcode.LLVMCall)
+        {
+            throw new ArgumentException("Not a call instruction", nameof(instruction));
+        }
+
+        using var marshaledName = new MarshaledString("align");
+        var kindID = LLVM.GetEnumAttributeKindForName(marshaledName.Value, (nuint)marshaledName.Length);
+
+        // Attribute index 0 is the return value, so parameter attributes start at index 1.
+        var attribute = LLVM.GetCallSiteEnumAttribute(instruction, (uint)parameterIndex + 1, kindID);
+
+        return attribute != null
+            ? (uint)LLVM.GetEnumAttributeValue(attribute)
+            : 1;
+    }
+
+    public static unsafe bool HasFunctionAttribute(this LLVMValueRef function, string name)
+    {
+        if (function.Kind != LLVMValueKind.LLVMFunctionValueKind)
+        {
+            throw new ArgumentException("Not a function", nameof(function));
+        }
+
+        using var marshaledName = new MarshaledString(name);
+        var kindID = LLVM.GetEnumAttributeKindForName(marshaledName.Value, (nuint)marshaledName.Length);
+
+        var attribute = LLVM.GetEnumAttributeAtIndex(function, unchecked((uint)LLVMAttributeIndex.LLVMAttributeFunctionIndex), kindID);
+
+        return attribute != null;
+    }
+
+    public static unsafe int[] GetIndices(this LLVMValueRef instruction)
+    {
+        var numIndices = LLVM.GetNumIndices(instruction);
+        var indices = LLVM.GetIndices(instruction);
+
+        var result = new int[numIndices];
+        for (var i = 0; i < numIndices; i++)
+        {
+            result[i] = (int)indices[i];
+        }
+
+        return result;
+    }
+
+    public static unsafe int[] GetShuffleVectorMaskValues(this LLVMValueRef instruction, bool keepUndef = false)
     {
         if (instruction.Kind != LLVMValueKind.LLVMInstructionValueKind
             || instruction.InstructionOpcode != LLVMOpcode.LLVMShuffleVector)
@@ -131,9 +181,9 @@ internal static partial class LLVMExtensions
             result[i] = LLVM.GetMaskValue(instruction, i);
 
             // An `undef` mask index is returned from `GetMaskValue` as -1.
-            // That creates problems with our indexing so we replace those
-            // values with 0.
-            if (result[i] == -1)
+            // That creates problems with our indexing so, unless the caller
+            // wants to know about them, we replace those values with 0.
+            if (result[i] == -1 && !keepUndef)
             {
                 result[i] = 0;
             }
@@ -191,14 +241,16 @@ internal static partial class LLVMExtensions
         {
             LLVMOpcode.LLVMAdd => value.GetOperand(0).HasNoSideEffects() && value.GetOperand(1).HasNoSideEffects(),
             LLVMOpcode.LLVMAlloca => true,
-            LLVMOpcode.LLVMCall => value.IsAIntrinsicInst != null, // TODO: Not every intrinsic has no side effects.
+            LLVMOpcode.LLVMCall => value.IsAIntrinsicInst != null
+                && IntrinsicResolver.IsPure(value.GetOperand((uint)value.OperandCount - 1).Name),
+            LLVMOpcode.LLVMExtractValue => value.GetOperand(0).HasNoSideEffects(),
             LLVMOpcode.LLVMFCmp => value.GetOperand(0).HasNoSideEffects() && value.GetOperand(1).HasNoSideEffects(),
             LLVMOpcode.LLVMFDiv => value.GetOperand(0).HasNoSideEffects() && value.GetOperand(1).HasNoSideEffects(),
             LLVMOpcode.LLVMFreeze => value.GetOperand(0).HasNoSideEffects(),
             LLVMOpcode.LLVMGetElementPtr => value.GetOperands().All(x => x.HasNoSideEffects()),
             LLVMOpcode.LLVMICmp => value.GetOperand(0).HasNoSideEffects() && value.GetOperand(1).HasNoSideEffects(),
             LLVMOpcode.LLVMInsertElement => value.GetOperands().All(x => x.HasNoSideEffects()),
-            LLVMOpcode.LLVMLoad => true, // TODO: Is this correct?
+            LLVMOpcode.LLVMLoad => !value.IsOrderedOrVolatile(), // Plain loads can be reordered with each other, but not with stores
             LLVMOpcode.LLVMPHI => true, // Because we load it from a local that is guaranteed not to change in the current block
             LLVMOpcode.LLVMSDiv => value.GetOperand(0).HasNoSideEffects() && value.GetOperand(1).HasNoSideEffects(),
             LLVMOpcode.LLVMSExt => value.GetOperand(0).HasNoSideEffects(),
@@ -209,6 +261,13 @@ internal static partial class LLVMExtensions
         };
     }
 
+    /// <summary>
+    /// Whether a load or store is volatile, or atomic with an ordering stronger than unordered,
+    /// which means it can't be reordered with other memory accesses.
+    /// </summary>
+    public static bool IsOrderedOrVolatile(this LLVMValueRef instruction) =>
+        instruction.Volatile || instruction.Ordering > LLVMAtomicOrdering.LLVMAtomicOrderingUnordered;
+
     public static unsafe LLVMMetadataRef AsMetadata(this LLVMValueRef value)
     {
         if (value.Kind != LLVMValueKind.LLVMMetadataAsValueValueKind)
@@ -326,6 +385,119 @@ internal static partial class LLVMExtensions
         return value.MDNodeOperands[1].GetMDString(out _);
     }
 
+    /// <summary>
+    /// Whether this is a constant integer vector with the same value in every element, such as a shift amount.
+    /// </summary>
+    public static bool TryGetSplatConstInt(this LLVMValueRef value, out ulong result)
+    {
+        result = 0;
+
+        if (value.Kind is not (LLVMValueKind.LLVMConstantDataVectorValueKind or LLVMValueKind.LLVMConstantVectorValueKind))
+        {
+            return false;
+        }
+
+        for (var i = 0u; i < value.TypeOf.VectorSize; i++)
+        {
+            var element = value.GetAggregateElement(i);
+            if (element.Kind != LLVMValueKind.LLVMConstantIntValueKind
+                || (i > 0 && element.ConstIntZExt != result))
+            {
+                return false;
+            }
+            result = element.ConstIntZExt;
+        }
+
+        return true;
+    }
+
+    /// <summary>
+    /// Whether this is a constant float or double, or a vector with the same such constant in every element.
+    /// </summary>
+    public static bool TryGetSplatConstReal(this LLVMValueRef value, out double result)
+    {
+        result = 0;
+
+        if (value.Kind == LLVMValueKind.LLVMConstantFPValueKind)
+        {
+            result = value.GetConstRealDouble(out _);
+            return true;
+        }
+
+        if (value.Kind is not (LLVMValueKind.LLVMConstantDataVectorValueKind or LLVMValueKind.LLVMConstantVectorValueKind))
+        {
+            return false;
+        }
+
+        for (var i = 0u; i < value.TypeOf.VectorSize; i++)
+        {
+            var element = value.GetAggregateElement(i);
+            if (element.Kind != LLVMValueKind.LLVMConstantFPValueKind)
+            {
+                return false;
+            }
+
+            var elementValue = element.GetConstRealDouble(out _);
+            if (i > 0 && elementValue.CompareTo(result) != 0)
+            {
+                return false;
+            }
+            result = elementValue;
+        }
+
+        return true;
+    }
+
+    [GeneratedRegex("^\\s*(?:%(?:\"[^\"]*\"|\\S+) = )?(?:fneg|fadd|fsub|fmul|fdiv|frem|fcmp|(?:(?:tail|musttail|notail) )?call)((?: (?:fast|reassoc|nnan|ninf|nsz|arcp|contract|afn))*) ")]
+    private static partial Regex FastMathFlagsRegex();
+
+    public static FastMathFlags GetFastMathFlags(this LLVMValueRef instruction)
+    {
+        // LLVMGetFastMathFlags is only in LLVM-C 18 and later, so we parse the printed instruction.
+
+        var match = FastMathFlagsRegex().Match(instruction.ToString());
+        if (!match.Success)
+        {
+            return FastMathFlags.None;
+        }
+
+        var result = FastMathFlags.None;
+        foreach (var flag in match.Groups[1].Value.Split(' ', StringSplitOptions.RemoveEmptyEntries))
+        {
+            result |= flag switch
+            {
+                "fast" => FastMathFlags.Fast,
+                "reassoc" => FastMathFlags.AllowReassociation,
+                "nnan" => FastMathFlags.NoNaNs,
+                "ninf" => FastMathFlags.NoInfinities,
+                "nsz" => FastMathFlags.NoSignedZeros,
+                "arcp" => FastMathFlags.AllowReciprocal,
+                "contract" => FastMathFlags.AllowContract,
+                "afn" => FastMathFlags.ApproximateFunctions,
+                _ => throw new InvalidOperationException($"Unexpected fast-math flag {flag}: {instruction}"),
+            };
+        }
+
+        return result;
+    }
+
+    [GeneratedRegex("^i128 (-?\\d+)$")]
+    private static partial Regex Int128ConstantRegex();
+
+    public static Int128 GetConstInt128(this LLVMValueRef value)
+    {
+        // LLVMConstIntGetZExtValue only works up to 64 bits, and there's no LLVM-C API
+        // for reading wider constants, so we parse the printed value.
+
+        var match = Int128ConstantRegex().Match(value.ToString().Trim());
+        if (!match.Success)
+        {
+            throw new InvalidOperationException($"Unexpected i128 constant: {value}");
+        }
+
+        return Int128.Parse(match.Groups[1].Value, CultureInfo.InvariantCulture);
+    }
+
     [GeneratedRegex("arg: (\\d+),")]
     private static partial Regex ArgRegex();
 
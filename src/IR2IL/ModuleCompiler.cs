@@ -5,6 +5,7 @@ using System.Reflection;
 using System.Reflection.Emit;
 using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
+using IR2IL.Analysis;
 using IR2IL.Helpers;
 using IR2IL.ILEmission;
 using LLVMSharp.Interop;
@@ -16,13 +17,17 @@ internal sealed class ModuleCompiler : IDisposable
     private readonly LLVMContextRef _context;
     private readonly LLVMModuleRef _module;
 
+    private readonly CompilerOptions _options;
+
     private readonly TypeSystem _typeSystem;
 
     private readonly ModuleBuilder _moduleBuilder;
     private readonly TypeBuilder _typeBuilder;
 
-    public ModuleCompiler(string inputPath, ModuleBuilder moduleBuilder)
+    public ModuleCompiler(string inputPath, ModuleBuilder moduleBuilder, CompilerOptions options)
     {
+        _options = options;
+
         _context = LLVMContextRef.Create();
 
         using var source = LLVMSourceCode.FromFile(inputPath);
@@ -58,6 +63,13 @@ internal sealed class ModuleCompiler : IDisposable
             {
                 var functionCompiler = new FunctionILEmitter(compiledModule, functionDefinition);
                 functionCompiler.Compile();
+
+                if (functionCompiler.InliningBlocker != null
+                    && functionDefinition.Function.HasFunctionAttribute("alwaysinline"))
+                {
+                    _options.WarningHandler?.Invoke(
+                        $"function '{functionDefinition.Function.Name}' is marked alwaysinline, but the JIT won't inline it because it {functionCompiler.InliningBlocker}");
+                }
             }
         }
 
@@ -195,6 +207,47 @@ internal sealed class ModuleCompiler : IDisposable
             []);
         result.SetCustomAttribute(skipLocalsInitAttribute);
 
+        result.SetImplementationFlags(GetMethodImplAttributes(function));
+
+        return result;
+    }
+
+    private MethodImplAttributes GetMethodImplAttributes(LLVMValueRef function)
+    {
+        var result = MethodImplAttributes.IL | MethodImplAttributes.Managed;
+
+        // Clang adds noinline to every function at -O0, purely so that optnone
+        // is respected, so we don't want to pass that on to the JIT.
+        var isOptNone = function.HasFunctionAttribute("optnone");
+
+        var isOptimizedForSize = function.HasFunctionAttribute("optsize")
+            || function.HasFunctionAttribute("minsize");
+
+        if (function.HasFunctionAttribute("alwaysinline")
+            || (function.HasFunctionAttribute("inlinehint") && !isOptimizedForSize))
+        {
+            result |= MethodImplAttributes.AggressiveInlining;
+        }
+        else if ((function.HasFunctionAttribute("noinline") && !isOptNone)
+            || function.HasFunctionAttribute("cold"))
+        {
+            result |= MethodImplAttributes.NoInlining;
+        }
+
+        if (function.HasFunctionAttribute("hot") && !isOptNone && !isOptimizedForSize)
+        {
+            result |= MethodImplAttributes.AggressiveOptimization;
+        }
+
+        // Skip tier-0 and OSR for functions with loops, which is where numeric kernels spend their time,
+        // including those that run a single long loop from main.
+        if (_options.TieringPolicy == TieringPolicy.AggressiveOptimizationForLoops
+            && !function.HasFunctionAttribute("cold")
+            && ControlFlowGraph.Create(function).MaxLoopDepth >= 1)
+        {
+            result |= MethodImplAttributes.AggressiveOptimization;
+        }
+
         return result;
     }
 
@@ -1,9 +1,32 @@
+using System;
+using System.Linq;
+
 namespace IR2IL;
 
 public static class Program
 {
     public static void Main(string[] args)
     {
-        Compiler.Compile(args[0], args[1]);
+        var tieringPolicy = TieringPolicy.Default;
+
+        foreach (var option in args.Skip(2))
+        {
+            if (option.StartsWith("--tiering-policy="))
+            {
+                tieringPolicy = Enum.Parse<TieringPolicy>(option["--tiering-policy=".Length..], ignoreCase: true);
+            }
+            else
+            {
+                throw new ArgumentException($"Unknown option: {option}");
+            }
+        }
+
+        var options = new CompilerOptions
+        {
+            TieringPolicy = tieringPolicy,
+            WarningHandler = message => Console.Error.WriteLine($"warning: {message}"),
+        };
+
+        Compiler.Compile(args[0], args[1], options);
     }
 }
\ No newline at end of file
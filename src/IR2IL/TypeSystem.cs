@@ -41,6 +41,12 @@ internal sealed class TypeSystem
             case LLVMTypeKind.LLVMFloatTypeKind:
                 return typeof(float);
 
+            case LLVMTypeKind.LLVMHalfTypeKind:
+                return typeof(Half);
+
+            case LLVMTypeKind.LLVMBFloatTypeKind:
+                return typeof(BFloat16);
+
             case LLVMTypeKind.LLVMIntegerTypeKind:
                 return GetIntegerType((int)typeRef.IntWidth);
 
@@ -68,6 +74,12 @@ internal sealed class TypeSystem
         8 => typeof(byte),
         16 => typeof(short),
         64 => typeof(long),
+        128 => typeof(Int128),
+
+        // Odd widths such as i24 and i48, which are kept zero-extended.
+        < 32 => typeof(int),
+        < 64 => typeof(long),
+
         _ => throw new NotImplementedException($"Integer width {intTypeWidth} not implemented"),
     };
 
@@ -83,19 +95,33 @@ internal sealed class TypeSystem
 
     public Type GetMsilVectorType(LLVMTypeRef elementTypeRef, int vectorSize)
     {
-        var vectorSizeInBits = vectorSize * RoundUpToTypeSize(GetSizeOfTypeInBits(elementTypeRef));
-        if (vectorSizeInBits > MaxVectorSize)
-        {
-            throw new NotImplementedException();
-        }
+        return GetGenericVectorType(elementTypeRef, vectorSize).MakeGenericType(GetMsilVectorElementType(elementTypeRef));
+    }
 
-        return vectorSizeInBits switch
-        {
-            16 or 32 or 64 or 128 or 256 or 512 or 1024 => GetGenericVectorType(elementTypeRef, vectorSize).MakeGenericType(GetMsilVectorElementType(elementTypeRef)),
-            _ => GetArrayType(elementTypeRef, vectorSize),
-        };
+    /// <summary>
+    /// The number of lanes in the .NET vector that represents <paramref name="vectorType"/>.
+    /// </summary>
+    /// <remarks>
+    /// Vectors with a size that isn't a power of two are padded to the next one up, so that
+    /// &lt;3 x float&gt; is a <see cref="Vector128{T}"/> and its operations are hardware-accelerated.
+    /// The extra lanes hold unspecified values. Loads and stores only touch the real lanes,
+    /// and operations where the extra lanes could matter, such as reductions and integer division,
+    /// take care not to let them.
+    /// </remarks>
+    public int GetMsilVectorLength(LLVMTypeRef vectorType)
+    {
+        var elementSizeInBits = RoundUpToTypeSize(GetSizeOfTypeInBits(vectorType.ElementType));
+        return GetVectorSizeInBits(vectorType.ElementType, (int)vectorType.VectorSize) / elementSizeInBits;
     }
 
+    /// <summary>
+    /// Whether <paramref name="vectorType"/> is represented by a .NET vector with more lanes,
+    /// such as &lt;3 x float&gt; by <see cref="Vector128{T}"/>.
+    /// </summary>
+    public bool IsPaddedVectorType(LLVMTypeRef vectorType) =>
+        vectorType.Kind == LLVMTypeKind.LLVMVectorTypeKind
+        && GetMsilVectorLength(vectorType) != vectorType.VectorSize;
+
     public Type GetMsilVectorElementType(LLVMTypeRef elementTypeRef)
     {
         var result = GetMsilType(elementTypeRef);
@@ -104,6 +130,16 @@ internal sealed class TypeSystem
         {
             result = typeof(sbyte);
         }
+        else if (result == typeof(Half) || result == typeof(BFloat16))
+        {
+            // Vector128<Half> isn't supported, so we use the bits.
+            result = typeof(ushort);
+        }
+        else if (result.IsPointer)
+        {
+            // Pointers can't be generic arguments, so vectors of pointers are vectors of nint.
+            result = typeof(nint);
+        }
 
         return result;
     }
@@ -217,11 +253,7 @@ internal sealed class TypeSystem
 
     public Type GetNonGenericVectorType(LLVMTypeRef vectorType)
     {
-        var vectorSizeInBits = vectorType.VectorSize * RoundUpToTypeSize(GetSizeOfTypeInBits(vectorType.ElementType));
-        if (vectorSizeInBits > MaxVectorSize)
-        {
-            throw new NotImplementedException();
-        }
+        var vectorSizeInBits = GetVectorSizeInBits(vectorType.ElementType, (int)vectorType.VectorSize);
 
         return vectorSizeInBits switch
         {
@@ -240,11 +272,7 @@ internal sealed class TypeSystem
 
     public Type GetGenericVectorType(LLVMTypeRef vectorElementType, int vectorSize)
     {
-        var vectorSizeInBits = vectorSize * RoundUpToTypeSize(GetSizeOfTypeInBits(vectorElementType));
-        if (vectorSizeInBits > MaxVectorSize)
-        {
-            throw new NotImplementedException();
-        }
+        var vectorSizeInBits = GetVectorSizeInBits(vectorElementType, vectorSize);
 
         return vectorSizeInBits switch
         {
@@ -261,6 +289,23 @@ internal sealed class TypeSystem
 
     private const int MaxVectorSize = 1024;
 
+    private const int MinVectorSize = 16;
+
+    /// <summary>
+    /// The size of the .NET vector that represents a vector of <paramref name="vectorSize"/> elements,
+    /// rounded up to a power of two.
+    /// </summary>
+    private int GetVectorSizeInBits(LLVMTypeRef vectorElementType, int vectorSize)
+    {
+        var vectorSizeInBits = vectorSize * RoundUpToTypeSize(GetSizeOfTypeInBits(vectorElementType));
+        if (vectorSizeInBits > MaxVectorSize)
+        {
+            throw new NotImplementedException($"Vector size {vectorSizeInBits} not implemented for element type: {vectorElementType}");
+        }
+
+        return Math.Max(RoundUpToTypeSize(vectorSizeInBits), MinVectorSize);
+    }
+
     private static int RoundUpToTypeSize(int sizeInBits)
     {
         if (sizeInBits > 1024)
@@ -306,6 +351,13 @@ internal sealed class TypeSystem
 
     public unsafe int GetSizeOfTypeInBytes(LLVMTypeRef type) => GetSizeOfTypeInBits(type) / 8;
 
+    /// <summary>
+    /// The distance between consecutive values of <paramref name="type"/> in memory, which is what getelementptr
+    /// steps by. This can be more than the size, for example 16 bytes for &lt;3 x float&gt; and 4 bytes for i24.
+    /// </summary>
+    public unsafe int GetAllocSizeInBytes(LLVMTypeRef type) => (int)LLVM.ABISizeOfType(
+        LLVM.GetModuleDataLayout(_module), type);
+
     public unsafe int GetStructFieldOffset(LLVMTypeRef structType, uint fieldIndex)
     {
         var targetData = LLVM.CreateTargetData(LLVM.GetDataLayout(_module));
@@ -0,0 +1,92 @@
+#include <stdatomic.h>
+#include <stdio.h>
+
+static _Atomic int ready;
+static _Atomic long long sequence;
+static _Atomic unsigned char byte_flag;
+static _Atomic double average;
+static int *_Atomic head;
+static volatile int volatile_counter;
+static volatile unsigned short volatile_values[8];
+static int data[4];
+
+static void publish(int value)
+{
+    data[0] = value;
+    data[1] = value * 2;
+    atomic_store_explicit(&ready, 1, memory_order_release);
+}
+
+static int consume(void)
+{
+    if (!atomic_load_explicit(&ready, memory_order_acquire))
+    {
+        return -1;
+    }
+    return data[0] + data[1];
+}
+
+static int spin_until_ready(int limit)
+{
+    int spins = 0;
+    while (!atomic_load_explicit(&ready, memory_order_relaxed) && spins < limit)
+    {
+        spins++;
+    }
+    return spins;
+}
+
+int main()
+{
+    int values[3] = { 7, 8, 9 };
+
+    printf("%d\n", consume());
+    printf("%d\n", spin_until_ready(1000));
+    publish(21);
+    printf("%d\n", consume());
+    printf("%d\n", spin_until_ready(1000));
+
+    atomic_store(&sequence, 1LL << 40);
+    atomic_store_explicit(&sequence, atomic_load(&sequence) + 3, memory_order_seq_cst);
+    printf("%lld\n", atomic_load_explicit(&sequence, memory_order_seq_cst));
+
+    atomic_store_explicit(&byte_flag, 200, memory_order_relaxed);
+    printf("%u\n", atomic_load_explicit(&byte_flag, memory_order_relaxed));
+    atomic_store_explicit(&byte_flag, 255, memory_order_seq_cst);
+    printf("%u\n", atomic_load_explicit(&byte_flag, memory_order_acquire));
+
+    atomic_store(&average, 2.5);
+    atomic_store_explicit(&average, atomic_load(&average) * 3.0, memory_order_release);
+    printf("%f\n", atomic_load_explicit(&average, memory_order_acquire));
+
+    atomic_store(&head, &values[0]);
+    atomic_store_explicit(&head, atomic_load(&head) + 2, memory_order_release);
+    printf("%d\n", *atomic_load_explicit(&head, memory_order_acquire));
+
+    // The load of the atomic has to happen before the store to the plain variable
+    // that follows it, even though the loaded value is only used afterwards.
+    data[2] = 5;
+    int before = atomic_load_explicit(&ready, memory_order_acquire);
+    atomic_store_explicit(&ready, 7, memory_order_relaxed);
+    data[3] = 6;
+    printf("%d %d %d\n", before, data[2] + data[3], atomic_load(&ready));
+
+    for (int i = 0; i < 1000; i++)
+    {
+        volatile_counter = volatile_counter + i;
+    }
+    printf("%d\n", volatile_counter);
+
+    for (int i = 0; i < 8; i++)
+    {
+        volatile_values[i] = (unsigned short)(i * 10000);
+    }
+    unsigned int sum = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        sum += volatile_values[i];
+    }
+    printf("%u\n", sum);
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include <stdatomic.h>
+#include <stdio.h>
+
+static _Atomic int counter;
+static _Atomic long long big_counter;
+static _Atomic short small_counter;
+static _Atomic unsigned char flags;
+static _Atomic float total;
+static int *_Atomic pointer;
+
+int main()
+{
+    int values[2] = { 10, 20 };
+
+    printf("%d\n", atomic_fetch_add(&counter, 5));
+    printf("%d\n", atomic_fetch_add(&counter, 1));
+    printf("%d\n", atomic_fetch_sub(&counter, 1));
+    printf("%d\n", atomic_fetch_sub(&counter, 2));
+    printf("%d\n", atomic_fetch_or(&counter, 0x30));
+    printf("%d\n", atomic_fetch_and(&counter, 0x1F));
+    printf("%d\n", atomic_fetch_xor(&counter, 0xFF));
+    printf("%d\n", atomic_exchange(&counter, -7));
+    printf("%d\n", atomic_load(&counter));
+
+    printf("%lld\n", atomic_fetch_add_explicit(&big_counter, 1LL << 40, memory_order_relaxed));
+    printf("%lld\n", atomic_fetch_sub_explicit(&big_counter, 1, memory_order_acq_rel));
+    printf("%lld\n", atomic_load_explicit(&big_counter, memory_order_acquire));
+
+    printf("%d\n", atomic_fetch_add(&small_counter, 30000));
+    printf("%d\n", atomic_fetch_add(&small_counter, 30000));
+    printf("%d\n", atomic_load(&small_counter));
+
+    printf("%d\n", atomic_fetch_or_explicit(&flags, 0x81, memory_order_release));
+    printf("%d\n", atomic_fetch_xor(&flags, 0xFF));
+    printf("%d\n", atomic_load(&flags));
+
+    int expected = -7;
+    int succeeded = atomic_compare_exchange_strong(&counter, &expected, 100);
+    printf("%d %d %d\n", succeeded, expected, atomic_load(&counter));
+
+    expected = 5;
+    succeeded = atomic_compare_exchange_strong(&counter, &expected, 200);
+    printf("%d %d %d\n", succeeded, expected, atomic_load(&counter));
+
+    expected = 100;
+    while (!atomic_compare_exchange_weak(&counter, &expected, expected + 1))
+    {
+    }
+    printf("%d\n", atomic_load(&counter));
+
+    atomic_store(&pointer, &values[0]);
+    int *old_pointer = atomic_exchange(&pointer, &values[1]);
+    printf("%d %d\n", *old_pointer, *atomic_load(&pointer));
+
+    int *expected_pointer = &values[1];
+    atomic_compare_exchange_strong(&pointer, &expected_pointer, &values[0]);
+    printf("%d\n", *atomic_load(&pointer));
+
+    for (int i = 0; i < 10; i++)
+    {
+        total += 0.5f;
+    }
+    printf("%.2f\n", atomic_load(&total));
+
+    // Clang lowers these to atomicrmw max/min/nand/umax/umin.
+    printf("%d\n", __atomic_fetch_max(&counter, 500, __ATOMIC_SEQ_CST));
+    printf("%d\n", __atomic_fetch_min(&counter, -500, __ATOMIC_SEQ_CST));
+    printf("%d\n", __atomic_fetch_nand(&counter, 0xFF, __ATOMIC_SEQ_CST));
+    unsigned int unsigned_value = 5;
+    printf("%u\n", __atomic_fetch_max(&unsigned_value, 0xFFFFFFF0u, __ATOMIC_RELAXED));
+    printf("%u\n", __atomic_fetch_min(&unsigned_value, 3u, __ATOMIC_RELAXED));
+    printf("%u\n", unsigned_value);
+
+    atomic_thread_fence(memory_order_acquire);
+    atomic_thread_fence(memory_order_release);
+    atomic_thread_fence(memory_order_seq_cst);
+    atomic_signal_fence(memory_order_seq_cst);
+
+    printf("%d\n", atomic_load(&counter));
+
+    return 0;
+}
@@ -0,0 +1,161 @@
+#include <stdio.h>
+#include <stdint.h>
+
+#if !defined(__has_builtin)
+#define __has_builtin(x) 0
+#endif
+
+#if !__has_builtin(__builtin_bitreverse32)
+static uint32_t __builtin_bitreverse32(uint32_t x)
+{
+    uint32_t result = 0;
+    for (int i = 0; i < 32; i++)
+    {
+        result |= ((x >> i) & 1) << (31 - i);
+    }
+    return result;
+}
+#endif
+
+#define N 64
+
+static uint32_t rotl32(uint32_t x, int k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+static uint64_t rotr64(uint64_t x, int k)
+{
+    return (x >> k) | (x << ((64 - k) & 63));
+}
+
+// Rotates and funnel shifts by a variable amount, which clang turns into llvm.fshl and llvm.fshr,
+// and vectorizes when they're in a loop.
+static uint32_t rotl32_variable(uint32_t x, uint32_t k)
+{
+    return (x << (k & 31)) | (x >> (-k & 31));
+}
+
+static uint16_t rotr16_variable(uint16_t x, uint16_t k)
+{
+    return (uint16_t)((x >> (k & 15)) | (x << (-k & 15)));
+}
+
+static uint64_t fshl64(uint64_t high, uint64_t low, uint64_t k)
+{
+    k &= 63;
+    return k == 0 ? high : (high << k) | (low >> (64 - k));
+}
+
+static uint32_t fshr32(uint32_t high, uint32_t low, uint32_t k)
+{
+    k &= 31;
+    return k == 0 ? low : (low >> k) | (high << (32 - k));
+}
+
+// xoshiro128** step, which clang turns into llvm.fshl.i32.
+static uint32_t state[4] = { 1, 2, 3, 4 };
+
+static uint32_t next(void)
+{
+    const uint32_t result = rotl32(state[1] * 5, 7) * 9;
+    const uint32_t t = state[1] << 9;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl32(state[3], 11);
+    return result;
+}
+
+__attribute__((noinline)) static void popcount_array(uint8_t* result, const uint32_t* values)
+{
+    for (int i = 0; i < N; i++)
+    {
+        result[i] = (uint8_t)__builtin_popcount(values[i]);
+    }
+}
+
+__attribute__((noinline)) static void bswap_array(uint32_t* result, const uint32_t* values)
+{
+    for (int i = 0; i < N; i++)
+    {
+        result[i] = __builtin_bswap32(values[i]);
+    }
+}
+
+__attribute__((noinline)) static void rotate_array(uint32_t* result, const uint32_t* values)
+{
+    for (int i = 0; i < N; i++)
+    {
+        result[i] = rotl32(values[i], 13) ^ values[i];
+    }
+}
+
+__attribute__((noinline)) static void rotate_by_array(uint32_t* result, uint16_t* result16, const uint32_t* values, const uint32_t* amounts)
+{
+    for (int i = 0; i < N; i++)
+    {
+        result[i] = rotl32_variable(values[i], amounts[i]);
+        result16[i] = rotr16_variable((uint16_t)values[i], (uint16_t)amounts[i]);
+    }
+}
+
+__attribute__((noinline)) static void funnel_shift_array(uint64_t* result, uint32_t* result32, const uint32_t* values, const uint32_t* amounts)
+{
+    for (int i = 0; i < N; i++)
+    {
+        result[i] = fshl64(((uint64_t)values[i] << 32) | values[(i + 1) % N], values[(i + 7) % N] * 0x9e3779b97f4a7c15ull, amounts[i]);
+        result32[i] = fshr32(values[i], values[(i + 3) % N], amounts[i] >> 3);
+    }
+}
+
+int main()
+{
+    uint32_t values[N];
+    uint8_t counts[N];
+    uint32_t swapped[N];
+    uint32_t rotated[N];
+    uint32_t amounts[N];
+    uint32_t rotated_by[N];
+    uint16_t rotated_by16[N];
+    uint64_t funnel_shifted[N];
+    uint32_t funnel_shifted32[N];
+
+    for (int i = 0; i < N; i++)
+    {
+        values[i] = next();
+    }
+
+    // Include amounts of zero and amounts of at least the bit width, which are taken modulo the width.
+    for (int i = 0; i < N; i++)
+    {
+        amounts[i] = i % 9 == 0 ? (uint32_t)i * 32 : values[(i + 5) % N] % 200;
+    }
+
+    popcount_array(counts, values);
+    bswap_array(swapped, values);
+    rotate_array(rotated, values);
+    rotate_by_array(rotated_by, rotated_by16, values, amounts);
+    funnel_shift_array(funnel_shifted, funnel_shifted32, values, amounts);
+
+    for (int i = 0; i < N; i += 5)
+    {
+        uint32_t v = values[i];
+        uint64_t w = ((uint64_t)v << 32) | swapped[i];
+        printf("%08x: pop=%d clz=%d ctz=%d bswap=%08x rot=%08x rev=%08x\n",
+            v, counts[i], __builtin_clz(v | 1), __builtin_ctz(v | 0x80000000u), swapped[i], rotated[i], __builtin_bitreverse32(v));
+        printf("  %016llx: pop=%d clz=%d ctz=%d rotr=%016llx bswap16=%04x\n",
+            (unsigned long long)w, __builtin_popcountll(w), __builtin_clzll(w), __builtin_ctzll(w),
+            (unsigned long long)rotr64(w, i % 64), __builtin_bswap16((uint16_t)v));
+    }
+
+    for (int i = 0; i < N; i += 3)
+    {
+        printf("%3u: rotl=%08x rotr16=%04x fshl=%016llx fshr=%08x\n",
+            amounts[i], rotated_by[i], rotated_by16[i], (unsigned long long)funnel_shifted[i], funnel_shifted32[i]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include <math.h>
+
+// Floating-point comparisons with and without NaN, which need the ordered and unordered predicates to be right,
+// and multiply-adds that are allowed to be fused. The products are exact, so fusing them doesn't change the results.
+typedef float float4 __attribute__((vector_size(16)));
+typedef double double2 __attribute__((vector_size(16)));
+typedef int int4 __attribute__((vector_size(16)));
+typedef long long long2 __attribute__((vector_size(16)));
+
+#define COUNT 5
+
+static volatile double values[COUNT] = { -1.5, 0.0, 2.0, INFINITY, NAN };
+
+__attribute__((noinline)) static int compare(double a, double b)
+{
+    return (a == b)
+        | (a != b) << 1
+        | (a < b) << 2
+        | (a <= b) << 3
+        | (a > b) << 4
+        | (a >= b) << 5
+        | !(a < b) << 6
+        | !(a >= b) << 7
+        | __builtin_isunordered(a, b) << 8
+        | !__builtin_isunordered(a, b) << 9
+        | __builtin_islessgreater(a, b) << 10
+        | !__builtin_islessgreater(a, b) << 11;
+}
+
+__attribute__((noinline)) static int compare_float(float a, float b)
+{
+    return (a == b) | (a != b) << 1 | (a < b) << 2 | (a >= b) << 3 | !(a > b) << 4 | __builtin_islessgreater(a, b) << 5;
+}
+
+// Counts how often each branch is taken, since comparisons that feed a branch are emitted differently.
+__attribute__((noinline)) static int branch_on(double a, double b)
+{
+    int result = 0;
+    if (a < b) result += 1;
+    if (!(a <= b)) result += 10;
+    if (a != b) result += 100;
+    if (__builtin_isunordered(a, b)) result += 1000;
+    if (__builtin_islessgreater(a, b)) result += 10000;
+    return result;
+}
+
+__attribute__((noinline)) static int compare_float4(float4 a, float4 b)
+{
+    int4 result = ((a == b) & 1) | ((a != b) & 2) | ((a < b) & 4) | ((a <= b) & 8) | ((a > b) & 16) | ((a >= b) & 32) | (~(a < b) & 64);
+    return result[0] | result[1] << 7 | result[2] << 14 | result[3] << 21;
+}
+
+__attribute__((noinline)) static long long compare_double2(double2 a, double2 b)
+{
+    long2 result = ((a != b) & 1) | ((a <= b) & 2) | (~(a > b) & 4);
+    return result[0] | result[1] << 3;
+}
+
+__attribute__((noinline)) static float dot3(const float* a, const float* b)
+{
+#pragma clang fp contract(fast)
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+__attribute__((noinline)) static double multiply_subtract(double a, double b, double c, double* reversed)
+{
+#pragma clang fp contract(fast)
+    *reversed = c - a * b;
+    return a * b - c;
+}
+
+__attribute__((noinline)) static float4 axpy(float4 a, float4 x, float4 y)
+{
+#pragma clang fp contract(fast)
+    return a * x + y;
+}
+
+__attribute__((noinline)) static double2 axmy(double2 a, double2 x, double2 y)
+{
+#pragma clang fp contract(fast)
+    return a * x - y;
+}
+
+int main(void)
+{
+    for (int i = 0; i < COUNT; i++)
+    {
+        for (int j = 0; j < COUNT; j++)
+        {
+            double a = values[i];
+            double b = values[j];
+            printf("%d %d: %03x %02x %d\n", i, j, compare(a, b), compare_float((float)a, (float)b), branch_on(a, b));
+        }
+    }
+
+    float4 a4 = { (float)values[0], (float)values[4], (float)values[2], (float)values[3] };
+    float4 b4 = { (float)values[1], (float)values[2], (float)values[4], (float)values[3] };
+    printf("float4: %07x %07x\n", compare_float4(a4, b4), compare_float4(b4, a4));
+
+    double2 a2 = { values[4], values[0] };
+    double2 b2 = { values[2], values[0] };
+    printf("double2: %02llx %02llx\n", compare_double2(a2, b2), compare_double2(b2, a2));
+
+    float x[3] = { 1.5f, -2.0f, 0.25f };
+    float y[3] = { 4.0f, 3.5f, -8.0f };
+    printf("dot3: %g\n", dot3(x, y));
+
+    double reversed;
+    double forward = multiply_subtract(values[0], values[2], 0.5, &reversed);
+    printf("multiply_subtract: %g %g\n", forward, reversed);
+
+    float4 scale = { 2.0f, -0.5f, 3.0f, 0.125f };
+    float4 axpy_result = axpy(scale, (float4){ 1.0f, 2.0f, 3.0f, 4.0f }, (float4){ 0.5f, 0.25f, -9.0f, 8.0f });
+    printf("axpy: %g %g %g %g\n", axpy_result[0], axpy_result[1], axpy_result[2], axpy_result[3]);
+
+    double2 axmy_result = axmy((double2){ 3.0, -1.25 }, (double2){ 0.5, 4.0 }, (double2){ 1.0, -2.0 });
+    printf("axmy: %g %g\n", axmy_result[0], axmy_result[1]);
+
+    return 0;
+}
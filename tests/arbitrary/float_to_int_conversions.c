@@ -0,0 +1,78 @@
+#include <stdio.h>
+#include <stdint.h>
+
+// Scalar conversions from float and double to every integer width, with values that are in range,
+// since C leaves the rest undefined. Unsigned values above the signed range, and negative values
+// above -1 converted to unsigned, are the cases that need more than one instruction.
+#define COUNT 10
+
+static volatile float floats[COUNT] = { 0.0f, -0.0f, 0.75f, -0.75f, 126.9f, -127.9f, 32767.5f, -32768.0f, 2147483520.0f, -2147483648.0f };
+static volatile double doubles[COUNT] = { 0.0, -0.999, 1.5, -1.5, 255.99, -128.5, 65535.9, 2147483647.9, -2147483648.9, 9007199254740993.0 };
+static volatile float unsigned_floats[COUNT] = { 0.0f, 0.5f, 255.5f, 65535.0f, 2147483648.0f, 4294967040.0f, 9223372036854775808.0f, 18446742974197923840.0f, -0.5f, 1e10f };
+static volatile double unsigned_doubles[COUNT] = { 0.0, 0.999, 200.7, 40000.1, 3000000000.5, 4294967295.9, 9223372036854775808.0, 18446744073709549568.0, -0.999, 12345678901234567.0 };
+
+__attribute__((noinline)) static int32_t to_i32(float value) { return (int32_t)value; }
+__attribute__((noinline)) static int64_t to_i64(float value) { return (int64_t)value; }
+__attribute__((noinline)) static int64_t double_to_i64(double value) { return (int64_t)value; }
+__attribute__((noinline)) static uint32_t to_u32(float value) { return (uint32_t)value; }
+__attribute__((noinline)) static uint64_t to_u64(float value) { return (uint64_t)value; }
+__attribute__((noinline)) static uint32_t double_to_u32(double value) { return (uint32_t)value; }
+__attribute__((noinline)) static uint64_t double_to_u64(double value) { return (uint64_t)value; }
+
+// Converts colour channels in [0, 1] to bytes, the way image writers do.
+__attribute__((noinline)) static uint32_t pack_pixels(const float* channels, uint8_t* pixels, int count)
+{
+    uint32_t checksum = 0;
+    for (int i = 0; i < count; i++)
+    {
+        float value = channels[i] < 0.0f ? 0.0f : (channels[i] > 1.0f ? 1.0f : channels[i]);
+        pixels[i] = (uint8_t)(value * 255.0f + 0.5f);
+        checksum = checksum * 31 + pixels[i];
+    }
+    return checksum;
+}
+
+// The conversions are guarded, so that only values in range are converted.
+#define TO_I8(x) ((x) > -129.0 && (x) < 128.0 ? (int8_t)(x) : 0)
+#define TO_I16(x) ((x) > -32769.0 && (x) < 32768.0 ? (int16_t)(x) : 0)
+#define TO_I32(x) ((x) > -2147483649.0 && (x) < 2147483648.0 ? (int32_t)(x) : 0)
+#define TO_U8(x) ((x) > -1.0 && (x) < 256.0 ? (uint8_t)(x) : 0)
+#define TO_U16(x) ((x) > -1.0 && (x) < 65536.0 ? (uint16_t)(x) : 0)
+
+int main(void)
+{
+    for (int i = 0; i < COUNT; i++)
+    {
+        float f = floats[i];
+        double d = doubles[i];
+        printf("%d: %d %d %d %lld | %d %d %d %lld\n", i,
+            TO_I8(f), TO_I16(f), to_i32(f), (long long)to_i64(f),
+            TO_I8(d), TO_I16(d), TO_I32(d), (long long)double_to_i64(d));
+    }
+
+    for (int i = 0; i < COUNT; i++)
+    {
+        float f = unsigned_floats[i];
+        double d = unsigned_doubles[i];
+        uint32_t f32 = f < 4294967296.0f ? to_u32(f) : 0;
+        uint32_t d32 = d < 4294967296.0 ? double_to_u32(d) : 0;
+        uint64_t f64 = f >= 0.0f ? to_u64(f) : 0;
+        uint64_t d64 = d >= 0.0 ? double_to_u64(d) : 0;
+        printf("%d: %u %u %u %llu | %u %u %u %llu\n", i,
+            TO_U8(f), TO_U16(f), f32, (unsigned long long)f64,
+            TO_U8(d), TO_U16(d), d32, (unsigned long long)d64);
+    }
+
+    float channels[67];
+    uint8_t pixels[67];
+    uint32_t seed = 99;
+    for (int i = 0; i < 67; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        channels[i] = (float)(int32_t)(seed >> 16 & 0x7FFF) / 30000.0f - 0.05f;
+    }
+    uint32_t checksum = pack_pixels(channels, pixels, 67);
+    printf("pixels: %08x %u %u %u\n", checksum, pixels[0], pixels[33], pixels[66]);
+
+    return 0;
+}
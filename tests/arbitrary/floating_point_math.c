@@ -0,0 +1,124 @@
+#include <stdio.h>
+#include <math.h>
+
+#if !defined(__has_builtin)
+#define __has_builtin(x) 0
+#endif
+
+#if !__has_builtin(__builtin_roundeven)
+static double __builtin_roundeven(double x)
+{
+    return rint(x);
+}
+#endif
+
+#define N 40
+
+static double values[N];
+static float values_f[N];
+
+// Loops that clang vectorizes at O3, using the vector forms of the rounding and min/max intrinsics.
+static double rounding_checksum(void)
+{
+    double floors[N], ceils[N], truncs[N], rounds[N], rints[N], nearbyints[N];
+    for (int i = 0; i < N; i++)
+    {
+        floors[i] = floor(values[i]);
+        ceils[i] = ceil(values[i]);
+        truncs[i] = trunc(values[i]);
+        rounds[i] = round(values[i]);
+        rints[i] = rint(values[i]);
+        nearbyints[i] = nearbyint(values[i]);
+    }
+
+    double result = 0;
+    for (int i = 0; i < N; i++)
+    {
+        result = result * 0.5 + floors[i] + 2 * ceils[i] + 3 * truncs[i] + 5 * rounds[i] + 7 * rints[i] + 11 * nearbyints[i];
+    }
+    return result;
+}
+
+static float rounding_checksum_f(void)
+{
+    float result = 0;
+    for (int i = 0; i < N; i++)
+    {
+        result += floorf(values_f[i]) + truncf(values_f[i]) * 2 + roundf(values_f[i]) * 3 + rintf(values_f[i]) * 4;
+    }
+    return result;
+}
+
+static void clamp(double* result, float* result_f, double low, double high)
+{
+    for (int i = 0; i < N; i++)
+    {
+        result[i] = fmin(fmax(values[i], low), high);
+        result_f[i] = fminf(fmaxf(values_f[i], (float)low), (float)high);
+    }
+}
+
+// Scalar transcendental functions, in the style of an n-body or ray tracing inner loop.
+static double orbit(int steps)
+{
+    double x = 1.0, y = 0.0, vx = 0.0, vy = 1.0;
+    const double dt = 0.01;
+    for (int i = 0; i < steps; i++)
+    {
+        double r = sqrt(x * x + y * y);
+        double inverse_cube = 1.0 / (r * r * r);
+        vx = fma(-x, inverse_cube * dt, vx);
+        vy = fma(-y, inverse_cube * dt, vy);
+        x += vx * dt;
+        y += vy * dt;
+    }
+    return x + y;
+}
+
+static double shade(double angle, double distance)
+{
+    double diffuse = fmax(0.0, cos(angle)) + 0.25 * sin(angle * 3);
+    double attenuation = exp(-distance * 0.1) + exp2(-distance) + 1.0 / (1.0 + log(1.0 + distance));
+    double specular = pow(fmax(0.0, cos(angle * 0.5)), 32.0);
+    return diffuse * attenuation + specular + log2(distance + 1) * 0.01 + log10(distance + 1) * 0.01;
+}
+
+int main()
+{
+    for (int i = 0; i < N; i++)
+    {
+        values[i] = (i - N / 2) * 0.75 + (i % 3) * 0.125;
+        values_f[i] = (float)values[i] * 1.5f;
+    }
+    values[5] = 2.5;
+    values[6] = -2.5;
+    values[7] = -0.25;
+    values[8] = 0.5;
+    values_f[9] = -3.5f;
+
+    printf("rounding: %.3f %.3f\n", rounding_checksum(), rounding_checksum_f());
+
+    double clamped[N];
+    float clamped_f[N];
+    clamp(clamped, clamped_f, -3.0, 4.5);
+    double clamp_sum = 0;
+    for (int i = 0; i < N; i++)
+    {
+        clamp_sum = clamp_sum * 0.9 + clamped[i] + clamped_f[i];
+    }
+    printf("clamp: %.6f\n", clamp_sum);
+
+    printf("min/max: %g %g %g %g\n", fmin(values[3], NAN), fmax(NAN, values[4]), fmin(-0.0, 0.0) + 1, fmaxf(values_f[1], values_f[2]));
+    printf("roundeven: %g %g %g\n", __builtin_roundeven(values[5]), __builtin_roundeven(values[6]), __builtin_roundeven(3.5));
+    printf("powi: %.6f %.6f %.6f\n", __builtin_powi(values[30], 3), __builtin_powi(1.5, -2), __builtin_powif(values_f[31], 4));
+    printf("orbit: %.6f\n", orbit(1000));
+
+    double shading = 0;
+    for (int i = 0; i < 16; i++)
+    {
+        shading += shade(i * 0.2, i * 1.5);
+    }
+    printf("shade: %.6f\n", shading);
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include <stdio.h>
+
+// The functions have external linkage so that they're still there at -O3 after they've been inlined,
+// because CompilerTests.FunctionAttributes checks the attributes of the methods they're compiled to.
+int square(int x);
+int cube(int x);
+
+inline __attribute__((always_inline)) int square(int x)
+{
+    return x * x;
+}
+
+inline int cube(int x)
+{
+    return x * square(x);
+}
+
+__attribute__((noinline)) int sum_of_squares(int n)
+{
+    int result = 0;
+    for (int i = 0; i < n; i++)
+    {
+        result += square(i);
+    }
+    return result;
+}
+
+__attribute__((cold)) void report_error(const char *message)
+{
+    printf("error: %s\n", message);
+}
+
+__attribute__((hot)) long long sum_of_cubes(int n)
+{
+    long long result = 0;
+    for (int i = 0; i < n; i++)
+    {
+        result += cube(i);
+    }
+    return result;
+}
+
+__attribute__((minsize)) int smallest(int a, int b)
+{
+    return a < b ? a : b;
+}
+
+int main()
+{
+    printf("%d\n", sum_of_squares(100));
+    printf("%lld\n", sum_of_cubes(1000));
+    printf("%d\n", smallest(3, -4));
+
+    if (sum_of_squares(10) != 285)
+    {
+        report_error("unexpected sum");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include <stdio.h>
+
+#define COUNT 1000
+
+static float input[COUNT];
+static _Float16 halves[COUNT];
+static float output[COUNT];
+
+static void to_half(const float *source, _Float16 *destination, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        destination[i] = (_Float16)source[i];
+    }
+}
+
+static void to_float(const _Float16 *source, float *destination, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        destination[i] = (float)source[i];
+    }
+}
+
+static void scale(_Float16 *values, float factor, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        values[i] = (_Float16)((float)values[i] * factor);
+    }
+}
+
+static _Float16 half_max(_Float16 a, _Float16 b)
+{
+    return a > b ? a : b;
+}
+
+// Vectors of half. Each operation is in a function of its own, so that at -O3 the float arithmetic that
+// clang promotes it to is narrowed back to half vector arithmetic.
+typedef _Float16 half8 __attribute__((vector_size(16)));
+typedef short short8 __attribute__((vector_size(16)));
+
+__attribute__((noinline)) static half8 half8_add(half8 a, half8 b) { return a + b; }
+__attribute__((noinline)) static half8 half8_subtract(half8 a, half8 b) { return a - b; }
+__attribute__((noinline)) static half8 half8_multiply(half8 a, half8 b) { return a * b; }
+__attribute__((noinline)) static half8 half8_divide(half8 a, half8 b) { return a / b; }
+__attribute__((noinline)) static half8 half8_negate(half8 a) { return -a; }
+
+__attribute__((noinline)) static unsigned int half8_compare(half8 a, half8 b)
+{
+    short8 result = ((a < b) & 1) | ((a == b) & 2) | ((a >= b) & 4) | ((a != b) & 8);
+    unsigned int packed = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        packed |= (unsigned int)result[i] << (i * 4);
+    }
+    return packed;
+}
+
+static void print_half8(const char *name, half8 value)
+{
+    printf("%s:", name);
+    for (int i = 0; i < 8; i++)
+    {
+        printf(" %.6f", (double)value[i]);
+    }
+    printf("\n");
+}
+
+int main()
+{
+    for (int i = 0; i < COUNT; i++)
+    {
+        input[i] = (i - 500) * 0.37f + (i % 7) * 0.001f;
+    }
+
+    to_half(input, halves, COUNT);
+    scale(halves, 1.5f, COUNT);
+    to_float(halves, output, COUNT);
+
+    double sum = 0;
+    for (int i = 0; i < COUNT; i++)
+    {
+        sum += output[i];
+    }
+    printf("%.6f %.6f %.6f %.6f\n", sum, output[0], output[501], output[COUNT - 1]);
+
+    _Float16 accumulator = 0;
+    for (int i = 0; i < 100; i++)
+    {
+        accumulator += (_Float16)0.1f;
+    }
+    printf("%.6f\n", (double)accumulator);
+
+    _Float16 a = (_Float16)3.140625f;
+    _Float16 b = (_Float16)-2.5f;
+    printf("%.6f %.6f %.6f %.6f\n", (double)(a + b), (double)(a * b), (double)(a / b), (double)-a);
+    printf("%d %d %d %d\n", a > b, a == b, a <= b, (double)half_max(a, b) == 3.140625);
+    printf("%d %d %u\n", (int)a, (int)b, (unsigned int)(a * (_Float16)10.0f));
+    printf("%.6f %.6f\n", (double)(_Float16)12345, (double)(_Float16)-7);
+
+    half8 x = { 1.5f16, -2.25f16, 1000.0f16, 0.099975586f16, -0.0f16, 65504.0f16, 3.0f16, 6.1035156e-05f16 };
+    half8 y = { 0.5f16, 4.0f16, -999.5f16, 0.099975586f16, 7.0f16, 2.0f16, -3.0f16, 0.5f16 };
+    print_half8("add", half8_add(x, y));
+    print_half8("subtract", half8_subtract(x, y));
+    print_half8("multiply", half8_multiply(x, y));
+    print_half8("divide", half8_divide(x, y));
+    print_half8("negate", half8_negate(x));
+    printf("compare: %08x %08x\n", half8_compare(x, y), half8_compare(y, x));
+
+    volatile float big = 70000.0f;
+    volatile float tiny = 1e-6f;
+    volatile double precise = 0.1;
+    printf("%.6f %.10f %.10f\n", (double)(_Float16)big, (double)(_Float16)tiny, (double)(_Float16)precise);
+
+    return 0;
+}
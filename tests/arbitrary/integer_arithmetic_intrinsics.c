@@ -0,0 +1,139 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define N 64
+
+static uint8_t pixels_a[N];
+static uint8_t pixels_b[N];
+static int16_t samples_a[N];
+static int16_t samples_b[N];
+static int32_t values[N];
+
+// Clamped adds and subtracts, which clang turns into llvm.[su]{add,sub}.sat and vectorizes.
+static void add_pixels(uint8_t* result)
+{
+    for (int i = 0; i < N; i++)
+    {
+        unsigned sum = pixels_a[i] + pixels_b[i];
+        result[i] = sum > 255 ? 255 : (uint8_t)sum;
+    }
+}
+
+static void subtract_pixels(uint8_t* result)
+{
+    for (int i = 0; i < N; i++)
+    {
+        result[i] = pixels_a[i] > pixels_b[i] ? pixels_a[i] - pixels_b[i] : 0;
+    }
+}
+
+static void add_samples(int16_t* result)
+{
+    for (int i = 0; i < N; i++)
+    {
+        int sum = samples_a[i] + samples_b[i];
+        result[i] = sum > INT16_MAX ? INT16_MAX : sum < INT16_MIN ? INT16_MIN : (int16_t)sum;
+    }
+}
+
+static uint32_t subtract_u32(uint32_t a, uint32_t b)
+{
+    return a > b ? a - b : 0;
+}
+
+// llvm.abs, llvm.smin, llvm.umin and llvm.umax.
+static int64_t sum_abs(void)
+{
+    int64_t result = 0;
+    for (int i = 0; i < N; i++)
+    {
+        result += abs(values[i]);
+    }
+    return result;
+}
+
+static void clamp_values(int32_t* result, int32_t low, int32_t high)
+{
+    for (int i = 0; i < N; i++)
+    {
+        int32_t value = values[i] < low ? low : values[i];
+        result[i] = value > high ? high : value;
+    }
+}
+
+static uint32_t min_max_unsigned(uint32_t* max)
+{
+    uint32_t min = UINT32_MAX;
+    *max = 0;
+    for (int i = 0; i < N; i++)
+    {
+        uint32_t value = (uint32_t)values[i];
+        min = value < min ? value : min;
+        *max = value > *max ? value : *max;
+    }
+    return min;
+}
+
+// llvm.[su]{add,sub,mul}.with.overflow.
+static void print_overflow(void)
+{
+    int8_t i8;
+    uint8_t u8;
+    int16_t i16;
+    int32_t i32;
+    uint32_t u32;
+    int64_t i64;
+    uint64_t u64;
+
+    int o1 = __builtin_add_overflow((int8_t)100, (int8_t)values[3], &i8);
+    int o2 = __builtin_sub_overflow((uint8_t)values[5], (uint8_t)200, &u8);
+    int o3 = __builtin_mul_overflow((int16_t)values[7], (int16_t)300, &i16);
+    int o4 = __builtin_add_overflow(INT32_MAX - 5, values[9], &i32);
+    int o5 = __builtin_mul_overflow((uint32_t)values[11], 0x10001u, &u32);
+    int o6 = __builtin_sub_overflow(INT64_MIN + 10, (int64_t)values[13], &i64);
+    int o7 = __builtin_mul_overflow((uint64_t)values[15], 0x100000001ull, &u64);
+    int o8 = __builtin_mul_overflow((int64_t)values[17], INT64_MIN, &i64);
+
+    printf("overflow: %d %d %d %d %d %d %d %d\n", o1, o2, o3, o4, o5, o6, o7, o8);
+    printf("results: %d %u %d %d %u %lld %llu\n", i8, u8, i16, i32, u32, (long long)i64, (unsigned long long)u64);
+}
+
+int main()
+{
+    for (int i = 0; i < N; i++)
+    {
+        pixels_a[i] = (uint8_t)(i * 37 + 11);
+        pixels_b[i] = (uint8_t)(i * 91 + 5);
+        samples_a[i] = (int16_t)(i * 4099 - 30000);
+        samples_b[i] = (int16_t)(i * -3001 + 25000);
+        values[i] = (int32_t)(((uint32_t)i * 1103515245u + 12345u) ^ ((uint32_t)i << 29));
+    }
+    values[0] = INT32_MIN + 1;
+
+    uint8_t pixel_result[N];
+    int16_t sample_result[N];
+    int32_t value_result[N];
+
+    unsigned checksum = 0;
+    add_pixels(pixel_result);
+    for (int i = 0; i < N; i++) checksum = checksum * 31 + pixel_result[i];
+    subtract_pixels(pixel_result);
+    for (int i = 0; i < N; i++) checksum = checksum * 31 + pixel_result[i];
+    add_samples(sample_result);
+    for (int i = 0; i < N; i++) checksum = checksum * 31 + (uint16_t)sample_result[i];
+    clamp_values(value_result, -1000000, 2000000);
+    for (int i = 0; i < N; i++) checksum = checksum * 31 + (uint32_t)value_result[i];
+    printf("checksum: %u\n", checksum);
+
+    printf("subtract: %u %u\n", subtract_u32((uint32_t)values[1], 7), subtract_u32(7, 0xFFFFFFFFu));
+    printf("abs: %lld\n", (long long)sum_abs());
+
+    uint32_t max;
+    uint32_t min = min_max_unsigned(&max);
+    printf("min/max: %u %u\n", min, max);
+
+    print_overflow();
+
+    return 0;
+}
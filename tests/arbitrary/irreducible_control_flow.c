@@ -0,0 +1,140 @@
+#include <stdio.h>
+
+// A loop with two entry points, which LLVM can't turn into a natural loop.
+static int two_entries(int start, int n)
+{
+    int total = 0;
+    int i = 0;
+
+    if (start & 1)
+    {
+        goto odd;
+    }
+
+even:
+    total += i * 2;
+    i++;
+    if (i >= n)
+    {
+        return total;
+    }
+
+odd:
+    total += i * 3;
+    i++;
+    if (i < n)
+    {
+        goto even;
+    }
+
+    return total;
+}
+
+// An irreducible loop nested inside a regular loop.
+static long long nested(int rows, int columns)
+{
+    long long total = 0;
+
+    for (int row = 0; row < rows; row++)
+    {
+        int column = 0;
+
+        if (row % 3 == 0)
+        {
+            goto second;
+        }
+
+    first:
+        total += row * column;
+        column++;
+
+    second:
+        total += column - row;
+        column++;
+        if (column < columns)
+        {
+            goto first;
+        }
+    }
+
+    return total;
+}
+
+// A state machine with three entry points.
+static int state_machine(const char *input)
+{
+    int count = 0;
+
+    switch (*input++)
+    {
+    case 'a':
+        goto state_a;
+    case 'b':
+        goto state_b;
+    default:
+        goto state_c;
+    }
+
+state_a:
+    count += 1;
+    if (*input == 0)
+    {
+        return count;
+    }
+    if (*input++ == 'b')
+    {
+        goto state_b;
+    }
+
+state_b:
+    count += 10;
+    if (*input == 0)
+    {
+        return count;
+    }
+    if (*input++ == 'a')
+    {
+        goto state_a;
+    }
+
+state_c:
+    count += 100;
+    if (*input == 0)
+    {
+        return count;
+    }
+    input++;
+    goto state_a;
+}
+
+int main()
+{
+    for (int start = 0; start < 2; start++)
+    {
+        printf("%d %d\n", two_entries(start, 10), two_entries(start, 1));
+    }
+
+    printf("%lld\n", nested(10, 7));
+
+    printf("%d\n", state_machine("abcabcbbaacc"));
+    printf("%d\n", state_machine("bababab"));
+    printf("%d\n", state_machine("cccccc"));
+
+    // Loops with the exit test at the top and at the bottom.
+    int sum = 0;
+    for (int i = 0; i < 100; i++)
+    {
+        sum += i;
+    }
+
+    int j = 0;
+    do
+    {
+        sum -= j;
+        j += 3;
+    } while (j < 50);
+
+    printf("%d\n", sum);
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include <stdio.h>
+#include <stdint.h>
+
+// Loops that clang vectorizes with llvm.masked.load, llvm.masked.store, llvm.masked.gather and
+// llvm.masked.scatter when AVX2 is available: conditional loads and stores, and indirect indexing
+// through a table, as in sparse matrix and histogram code.
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+#if defined(__clang__)
+#define VECTORIZE _Pragma("clang loop vectorize(enable) interleave(disable)")
+#else
+#define VECTORIZE
+#endif
+
+#define COUNT 67
+
+static float values[COUNT];
+static float weights[COUNT];
+static double doubles[COUNT];
+static int32_t ints[COUNT];
+static int32_t indices[COUNT];
+static int32_t flags[COUNT];
+
+// Elements whose flag is clear are never read, so they can be past the end of a mapped buffer.
+AVX2_TARGET __attribute__((noinline)) static void conditional_scale(float* output, const float* input, const int32_t* condition, int count)
+{
+    VECTORIZE
+    for (int i = 0; i < count; i++)
+    {
+        if (condition[i] != 0)
+        {
+            output[i] = input[i] * 2.0f + 1.0f;
+        }
+    }
+}
+
+AVX2_TARGET __attribute__((noinline)) static void conditional_copy_double(double* output, const double* input, const int32_t* condition, int count)
+{
+    VECTORIZE
+    for (int i = 0; i < count; i++)
+    {
+        if (condition[i] > 1)
+        {
+            output[i] = input[i] - 0.5;
+        }
+    }
+}
+
+AVX2_TARGET __attribute__((noinline)) static void gather_multiply(float* output, const float* table, const int32_t* index, const float* weight, int count)
+{
+    VECTORIZE
+    for (int i = 0; i < count; i++)
+    {
+        output[i] = table[index[i]] * weight[i];
+    }
+}
+
+AVX2_TARGET __attribute__((noinline)) static int64_t gather_int(const int32_t* table, const int32_t* index, int count)
+{
+    int64_t sum = 0;
+    VECTORIZE
+    for (int i = 0; i < count; i++)
+    {
+        sum += table[index[i]];
+    }
+    return sum;
+}
+
+AVX2_TARGET __attribute__((noinline)) static void conditional_gather(double* output, const double* table, const int32_t* index, const int32_t* condition, int count)
+{
+    VECTORIZE
+    for (int i = 0; i < count; i++)
+    {
+        if (condition[i] != 0)
+        {
+            output[i] = table[index[i]];
+        }
+    }
+}
+
+// Indices are a permutation, so no two lanes store to the same element.
+AVX2_TARGET __attribute__((noinline)) static void scatter(float* output, const int32_t* index, const float* input, int count)
+{
+    VECTORIZE
+    for (int i = 0; i < count; i++)
+    {
+        output[index[i]] = input[i];
+    }
+}
+
+int main(void)
+{
+    uint32_t seed = 4321;
+    for (int i = 0; i < COUNT; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        values[i] = (float)((int32_t)(seed >> 16) % 1000) / 16.0f;
+        weights[i] = (float)(i % 7) - 3.0f;
+        doubles[i] = (double)values[i] * 3.0;
+        ints[i] = (int32_t)(seed >> 8) % 100000;
+        indices[i] = (i * 29) % COUNT;
+        flags[i] = (int32_t)((seed >> 20) % 3);
+    }
+
+    float scaled[COUNT];
+    double copied[COUNT];
+    double gathered[COUNT];
+    float scattered[COUNT];
+    float multiplied[COUNT];
+    for (int i = 0; i < COUNT; i++)
+    {
+        scaled[i] = -1.0f;
+        copied[i] = -1.0;
+        gathered[i] = -1.0;
+        scattered[i] = -1.0f;
+    }
+
+    // Odd counts leave a tail that doesn't fill a whole vector.
+    conditional_scale(scaled, values, flags, COUNT);
+    conditional_copy_double(copied, doubles, flags, COUNT - 2);
+    conditional_gather(gathered, doubles, indices, flags, COUNT);
+    scatter(scattered, indices, values, COUNT);
+    gather_multiply(multiplied, values, indices, weights, COUNT);
+
+    float scaled_sum = 0, scattered_sum = 0, multiplied_sum = 0;
+    double copied_sum = 0, gathered_sum = 0;
+    for (int i = 0; i < COUNT; i++)
+    {
+        scaled_sum += scaled[i] * (float)(i + 1);
+        copied_sum += copied[i] * (double)(i + 1);
+        gathered_sum += gathered[i] * (double)(i + 1);
+        scattered_sum += scattered[i] * (float)(i + 1);
+        multiplied_sum += multiplied[i];
+    }
+
+    printf("conditional_scale: %.3f %.3f %.3f\n", scaled[0], scaled[COUNT - 1], scaled_sum);
+    printf("conditional_copy_double: %.3f %.3f %.3f\n", copied[1], copied[COUNT - 1], copied_sum);
+    printf("conditional_gather: %.3f %.3f\n", gathered[2], gathered_sum);
+    printf("scatter: %.3f %.3f\n", scattered[5], scattered_sum);
+    printf("gather_multiply: %.3f %.3f\n", multiplied[3], multiplied_sum);
+    printf("gather_int: %lld %lld\n", (long long)gather_int(ints, indices, COUNT), (long long)gather_int(ints, indices, 13));
+
+    return 0;
+}
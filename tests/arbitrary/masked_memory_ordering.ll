@@ -0,0 +1,98 @@
+; Masked loads and stores, with a store to the same memory between each load and the use of what it loaded.
+; None of them may be delayed until its result is used, nor a plain load moved past a masked store.
+; The results are printed in hex, with putchar, since printf isn't exported by the C runtime DLL.
+
+@data = internal global [8 x i32] [i32 1, i32 2, i32 3, i32 4, i32 5, i32 6, i32 7, i32 8], align 16
+
+declare i32 @putchar(i32)
+declare <4 x i32> @llvm.masked.load.v4i32.p0(ptr, i32, <4 x i1>, <4 x i32>)
+declare <4 x i32> @llvm.masked.gather.v4i32.v4p0(<4 x ptr>, i32, <4 x i1>, <4 x i32>)
+declare <4 x i32> @llvm.masked.expandload.v4i32(ptr, <4 x i1>, <4 x i32>)
+declare void @llvm.masked.store.v4i32.p0(<4 x i32>, ptr, i32, <4 x i1>)
+declare void @llvm.masked.scatter.v4i32.v4p0(<4 x i32>, <4 x ptr>, i32, <4 x i1>)
+declare void @llvm.masked.compressstore.v4i32(<4 x i32>, ptr, <4 x i1>)
+declare i32 @llvm.vector.reduce.add.v4i32(<4 x i32>)
+
+define internal void @print_hex(i32 %value) noinline {
+entry:
+  br label %loop
+
+loop:
+  %shift = phi i32 [ 28, %entry ], [ %next_shift, %loop ]
+  %shifted = lshr i32 %value, %shift
+  %nibble = and i32 %shifted, 15
+  %is_digit = icmp ult i32 %nibble, 10
+  %first_character = select i1 %is_digit, i32 48, i32 87
+  %character = add i32 %nibble, %first_character
+  %0 = call i32 @putchar(i32 %character)
+  %next_shift = sub i32 %shift, 4
+  %done = icmp eq i32 %shift, 0
+  br i1 %done, label %exit, label %loop
+
+exit:
+  %1 = call i32 @putchar(i32 10)
+  ret void
+}
+
+define internal i32 @load_then_store(ptr %p) noinline {
+entry:
+  %loaded = call <4 x i32> @llvm.masked.load.v4i32.p0(ptr %p, i32 4, <4 x i1> <i1 true, i1 false, i1 true, i1 true>, <4 x i32> <i32 16, i32 32, i32 64, i32 128>)
+  store <4 x i32> <i32 256, i32 512, i32 1024, i32 2048>, ptr %p, align 4
+  %sum = call i32 @llvm.vector.reduce.add.v4i32(<4 x i32> %loaded)
+  ret i32 %sum
+}
+
+define internal i32 @gather_then_store(ptr %p) noinline {
+entry:
+  %pointers = getelementptr inbounds i32, ptr %p, <4 x i64> <i64 3, i64 2, i64 1, i64 0>
+  %gathered = call <4 x i32> @llvm.masked.gather.v4i32.v4p0(<4 x ptr> %pointers, i32 4, <4 x i1> <i1 true, i1 true, i1 false, i1 true>, <4 x i32> zeroinitializer)
+  store i32 4096, ptr %p, align 4
+  %element = extractelement <4 x i32> %gathered, i64 3
+  %sum = call i32 @llvm.vector.reduce.add.v4i32(<4 x i32> %gathered)
+  %result = mul i32 %sum, %element
+  ret i32 %result
+}
+
+define internal i32 @expandload_then_store(ptr %p) noinline {
+entry:
+  %expanded = call <4 x i32> @llvm.masked.expandload.v4i32(ptr %p, <4 x i1> <i1 false, i1 true, i1 true, i1 false>, <4 x i32> <i32 1, i32 1, i32 1, i32 1>)
+  %next = getelementptr inbounds i32, ptr %p, i64 1
+  store i32 8192, ptr %next, align 4
+  %sum = call i32 @llvm.vector.reduce.add.v4i32(<4 x i32> %expanded)
+  ret i32 %sum
+}
+
+; Plain loads followed by masked stores to what they read.
+define internal i32 @load_then_masked_stores(ptr %p) noinline {
+entry:
+  %first = load i32, ptr %p, align 4
+  call void @llvm.masked.store.v4i32.p0(<4 x i32> <i32 -1, i32 -1, i32 -1, i32 -1>, ptr %p, i32 4, <4 x i1> <i1 true, i1 false, i1 false, i1 false>)
+  %second_pointer = getelementptr inbounds i32, ptr %p, i64 1
+  %second = load i32, ptr %second_pointer, align 4
+  %pointers = getelementptr inbounds i32, ptr %p, <4 x i64> <i64 0, i64 1, i64 2, i64 3>
+  call void @llvm.masked.scatter.v4i32.v4p0(<4 x i32> <i32 -2, i32 -2, i32 -2, i32 -2>, <4 x ptr> %pointers, i32 4, <4 x i1> <i1 false, i1 true, i1 false, i1 false>)
+  %third_pointer = getelementptr inbounds i32, ptr %p, i64 2
+  %third = load i32, ptr %third_pointer, align 4
+  call void @llvm.masked.compressstore.v4i32(<4 x i32> <i32 -3, i32 -4, i32 -5, i32 -6>, ptr %third_pointer, <4 x i1> <i1 false, i1 true, i1 false, i1 false>)
+  %scaled_second = mul i32 %second, 3
+  %scaled_third = mul i32 %third, 5
+  %first_and_second = add i32 %first, %scaled_second
+  %result = add i32 %first_and_second, %scaled_third
+  ret i32 %result
+}
+
+define i32 @main() {
+entry:
+  %0 = call i32 @load_then_store(ptr @data)
+  call void @print_hex(i32 %0)
+  %middle = getelementptr inbounds [8 x i32], ptr @data, i64 0, i64 4
+  %1 = call i32 @gather_then_store(ptr %middle)
+  call void @print_hex(i32 %1)
+  %2 = call i32 @expandload_then_store(ptr %middle)
+  call void @print_hex(i32 %2)
+  %3 = call i32 @load_then_masked_stores(ptr @data)
+  call void @print_hex(i32 %3)
+  %4 = load i32, ptr @data, align 4
+  call void @print_hex(i32 %4)
+  ret i32 0
+}
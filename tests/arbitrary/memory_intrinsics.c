@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    float x, y, z;
+} Vector;
+
+typedef struct {
+    char name[40];
+    int values[9];
+} Record;
+
+static void print_bytes(const char *label, const unsigned char *bytes, int count)
+{
+    printf("%s:", label);
+    for (int i = 0; i < count; i++)
+    {
+        printf(" %d", bytes[i]);
+    }
+    printf("\n");
+}
+
+static void fill(unsigned char *bytes, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        bytes[i] = (unsigned char)(i * 7 + 3);
+    }
+}
+
+int main()
+{
+    // Small constant-size struct copies.
+    Vector a = { 1.0f, 2.0f, 3.0f };
+    Vector b = a;
+    b.y += 10.0f;
+    printf("%.1f %.1f %.1f\n", b.x, b.y, b.z);
+
+    Record r1;
+    memset(&r1, 0, sizeof(r1));
+    strcpy(r1.name, "record");
+    for (int i = 0; i < 9; i++)
+    {
+        r1.values[i] = i * i;
+    }
+    Record r2 = r1;
+    printf("%s %d %d\n", r2.name, r2.values[0], r2.values[8]);
+
+    // Overlapping moves in both directions, for constant and variable lengths.
+    unsigned char buffer[200];
+    for (volatile int length = 1; length <= 100; length += 33)
+    {
+        fill(buffer, sizeof(buffer));
+        memmove(buffer + 3, buffer, length);
+        print_bytes("forward", buffer, 12);
+
+        fill(buffer, sizeof(buffer));
+        memmove(buffer, buffer + 5, length);
+        print_bytes("backward", buffer, 12);
+    }
+
+    fill(buffer, sizeof(buffer));
+    memmove(buffer + 1, buffer, 12);
+    print_bytes("constant forward", buffer, 16);
+
+    fill(buffer, sizeof(buffer));
+    memmove(buffer, buffer + 2, 60);
+    print_bytes("constant backward", buffer, 64);
+
+    // Variable-length and large copies and fills.
+    unsigned char source[300];
+    unsigned char destination[300];
+    fill(source, sizeof(source));
+    for (volatile int length = 0; length < 300; length += 37)
+    {
+        memset(destination, 0xAB, sizeof(destination));
+        memcpy(destination, source, length);
+        int sum = 0;
+        for (int i = 0; i < 300; i++)
+        {
+            sum += destination[i];
+        }
+        printf("copy %d: %d\n", length, sum);
+    }
+
+    for (volatile int length = 0; length < 300; length += 41)
+    {
+        memset(destination, 0, sizeof(destination));
+        memset(destination + 1, length & 0xFF, length);
+        int sum = 0;
+        for (int i = 0; i < 300; i++)
+        {
+            sum += destination[i];
+        }
+        printf("fill %d: %d\n", length, sum);
+    }
+
+    // Volatile copy.
+    volatile Vector v;
+    v = a;
+    printf("%.1f\n", v.z);
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+; The fast-math flags that clang has no pragma for: fdiv arcp by a constant, which is done by multiplying by the
+; reciprocal, and fcmp nnan, where unordered and ordered predicates are the same. The inputs are chosen so that
+; the quotients, scaled and truncated to integers, don't depend on how the division is rounded, and none are NaN.
+; The results are printed in hex, with putchar, since printf isn't exported by the C runtime DLL.
+
+; Not internal, so that the optimizer can't fold the divisions and comparisons into constants.
+@dividends = global [4 x double] [double 7.0, double -2.5, double 1.0e10, double 0.1], align 16
+@float_dividends = global <4 x float> <float 7.0, float -2.5, float 100.0, float 0x3FB99999A0000000>, align 16
+@left = global [6 x double] [double 1.0, double 2.0, double 2.0, double -0.0, double 0xFFF0000000000000, double 0x7FF0000000000000], align 16
+@right = global [6 x double] [double 2.0, double 1.0, double 2.0, double 0.0, double 5.0, double 0x7FF0000000000000], align 16
+
+declare i32 @putchar(i32)
+
+define internal void @print_hex(i32 %value) noinline {
+entry:
+  br label %loop
+
+loop:
+  %shift = phi i32 [ 28, %entry ], [ %next_shift, %loop ]
+  %shifted = lshr i32 %value, %shift
+  %nibble = and i32 %shifted, 15
+  %is_digit = icmp ult i32 %nibble, 10
+  %first_character = select i1 %is_digit, i32 48, i32 87
+  %character = add i32 %nibble, %first_character
+  %0 = call i32 @putchar(i32 %character)
+  %next_shift = sub i32 %shift, 4
+  %done = icmp eq i32 %shift, 0
+  br i1 %done, label %exit, label %loop
+
+exit:
+  %1 = call i32 @putchar(i32 10)
+  ret void
+}
+
+define internal i32 @scale(double %value) {
+entry:
+  %scaled = fmul double %value, 65536.0
+  %integer = fptosi double %scaled to i64
+  %truncated = trunc i64 %integer to i32
+  ret i32 %truncated
+}
+
+; A power of two, whose reciprocal is exact, and non-powers of two, whose reciprocals aren't.
+define internal void @divide(double %x) noinline {
+entry:
+  %by_four = fdiv arcp double %x, 4.0
+  %0 = call i32 @scale(double %by_four)
+  call void @print_hex(i32 %0)
+  %by_three = fdiv arcp double %x, 3.0
+  %1 = call i32 @scale(double %by_three)
+  call void @print_hex(i32 %1)
+  %by_ten = fdiv arcp double %x, 10.0
+  %2 = call i32 @scale(double %by_ten)
+  call void @print_hex(i32 %2)
+  ret void
+}
+
+define internal void @divide_vector(<4 x float> %x) noinline {
+entry:
+  %by_half = fdiv arcp <4 x float> %x, <float 0.5, float 0.5, float 0.5, float 0.5>
+  %by_three = fdiv arcp <4 x float> %x, <float 3.0, float 3.0, float 3.0, float 3.0>
+  %sum = fadd <4 x float> %by_half, %by_three
+  %scaled = fmul <4 x float> %sum, <float 4096.0, float 4096.0, float 4096.0, float 4096.0>
+  %integers = fptosi <4 x float> %scaled to <4 x i32>
+  %0 = extractelement <4 x i32> %integers, i64 0
+  call void @print_hex(i32 %0)
+  %1 = extractelement <4 x i32> %integers, i64 1
+  call void @print_hex(i32 %1)
+  %2 = extractelement <4 x i32> %integers, i64 2
+  call void @print_hex(i32 %2)
+  %3 = extractelement <4 x i32> %integers, i64 3
+  call void @print_hex(i32 %3)
+  ret void
+}
+
+; Returns a bit for each way of evaluating olt and ult: as a value, as a branch, and as a vector.
+define internal i32 @compare(double %a, double %b) noinline {
+entry:
+  %olt = fcmp nnan olt double %a, %b
+  %ult = fcmp nnan ult double %a, %b
+  %olt_bit = zext i1 %olt to i32
+  %ult_value = zext i1 %ult to i32
+  %ult_bit = shl i32 %ult_value, 1
+  %values = or i32 %olt_bit, %ult_bit
+  %branch_olt = fcmp nnan olt double %a, %b
+  br i1 %branch_olt, label %olt_true, label %olt_false
+
+olt_true:
+  br label %olt_done
+
+olt_false:
+  br label %olt_done
+
+olt_done:
+  %olt_branch_bit = phi i32 [ 4, %olt_true ], [ 0, %olt_false ]
+  %branch_ult = fcmp nnan ult double %a, %b
+  br i1 %branch_ult, label %ult_true, label %ult_false
+
+ult_true:
+  br label %ult_done
+
+ult_false:
+  br label %ult_done
+
+ult_done:
+  %ult_branch_bit = phi i32 [ 8, %ult_true ], [ 0, %ult_false ]
+  %a_vector = insertelement <2 x double> <double 0.0, double 3.0>, double %a, i64 0
+  %b_vector = insertelement <2 x double> <double 1.0, double 3.0>, double %b, i64 0
+  %olt_vector = fcmp nnan olt <2 x double> %a_vector, %b_vector
+  %ult_vector = fcmp nnan ult <2 x double> %a_vector, %b_vector
+  %olt_vector_bits = bitcast <2 x i1> %olt_vector to i2
+  %ult_vector_bits = bitcast <2 x i1> %ult_vector to i2
+  %olt_vector_value = zext i2 %olt_vector_bits to i32
+  %ult_vector_value = zext i2 %ult_vector_bits to i32
+  %olt_vector_shifted = shl i32 %olt_vector_value, 4
+  %ult_vector_shifted = shl i32 %ult_vector_value, 8
+  %branches = or i32 %olt_branch_bit, %ult_branch_bit
+  %scalars = or i32 %values, %branches
+  %vectors = or i32 %olt_vector_shifted, %ult_vector_shifted
+  %result = or i32 %scalars, %vectors
+  ret i32 %result
+}
+
+define i32 @main() {
+entry:
+  br label %divide_loop
+
+divide_loop:
+  %i = phi i64 [ 0, %entry ], [ %next_i, %divide_loop ]
+  %dividend_pointer = getelementptr inbounds [4 x double], ptr @dividends, i64 0, i64 %i
+  %dividend = load double, ptr %dividend_pointer, align 8
+  call void @divide(double %dividend)
+  %next_i = add i64 %i, 1
+  %divided = icmp eq i64 %next_i, 4
+  br i1 %divided, label %divide_vector, label %divide_loop
+
+divide_vector:
+  %float_dividends = load <4 x float>, ptr @float_dividends, align 16
+  call void @divide_vector(<4 x float> %float_dividends)
+  br label %compare_loop
+
+compare_loop:
+  %j = phi i64 [ 0, %divide_vector ], [ %next_j, %compare_loop ]
+  %left_pointer = getelementptr inbounds [6 x double], ptr @left, i64 0, i64 %j
+  %a = load double, ptr %left_pointer, align 8
+  %right_pointer = getelementptr inbounds [6 x double], ptr @right, i64 0, i64 %j
+  %b = load double, ptr %right_pointer, align 8
+  %comparison = call i32 @compare(double %a, double %b)
+  call void @print_hex(i32 %comparison)
+  %next_j = add i64 %j, 1
+  %compared = icmp eq i64 %next_j, 6
+  br i1 %compared, label %exit, label %compare_loop
+
+exit:
+  ret i32 0
+}
@@ -0,0 +1,120 @@
+; llvm.fptosi.sat and llvm.fptoui.sat, which clang doesn't emit from C, on scalars and on vectors of each
+; element width, with values that are in range, out of range on both sides, infinite and NaN.
+; The results are printed in hex, with putchar, since printf isn't exported by the C runtime DLL.
+
+; Not internal, so that the optimizer can't fold the conversions into constants.
+@floats = global <4 x float> <float 1.0e10, float -1.0e10, float 0x7FF8000000000000, float -3.75>, align 16
+@doubles = global <4 x double> <double 4.0e9, double -1.5, double 2.9, double 0x7FF0000000000000>, align 32
+@odd_floats = global <3 x float> <float 3.0e9, float -3.0e9, float 5.5>, align 16
+
+declare i32 @putchar(i32)
+declare i32 @llvm.fptosi.sat.i32.f32(float)
+declare i16 @llvm.fptoui.sat.i16.f64(double)
+declare <4 x i8> @llvm.fptosi.sat.v4i8.v4f32(<4 x float>)
+declare <4 x i8> @llvm.fptoui.sat.v4i8.v4f32(<4 x float>)
+declare <4 x i64> @llvm.fptosi.sat.v4i64.v4f32(<4 x float>)
+declare <4 x i16> @llvm.fptosi.sat.v4i16.v4f64(<4 x double>)
+declare <4 x i32> @llvm.fptoui.sat.v4i32.v4f64(<4 x double>)
+declare <4 x i64> @llvm.fptoui.sat.v4i64.v4f64(<4 x double>)
+declare <3 x i32> @llvm.fptosi.sat.v3i32.v3f32(<3 x float>)
+
+define internal void @print_hex(i64 %value) noinline {
+entry:
+  br label %loop
+
+loop:
+  %shift = phi i64 [ 60, %entry ], [ %next_shift, %loop ]
+  %shifted = lshr i64 %value, %shift
+  %nibble = and i64 %shifted, 15
+  %is_digit = icmp ult i64 %nibble, 10
+  %first_character = select i1 %is_digit, i64 48, i64 87
+  %character = add i64 %nibble, %first_character
+  %character32 = trunc i64 %character to i32
+  %0 = call i32 @putchar(i32 %character32)
+  %next_shift = sub i64 %shift, 4
+  %done = icmp eq i64 %shift, 0
+  br i1 %done, label %exit, label %loop
+
+exit:
+  %1 = call i32 @putchar(i32 32)
+  ret void
+}
+
+define internal void @print_newline() noinline {
+entry:
+  %0 = call i32 @putchar(i32 10)
+  ret void
+}
+
+; Prints each element of a vector, zero-extended to 64 bits.
+define internal void @print_i8s(<4 x i8> %vector) noinline {
+entry:
+  %wide = zext <4 x i8> %vector to <4 x i64>
+  call void @print_i64s(<4 x i64> %wide)
+  ret void
+}
+
+define internal void @print_i16s(<4 x i16> %vector) noinline {
+entry:
+  %wide = zext <4 x i16> %vector to <4 x i64>
+  call void @print_i64s(<4 x i64> %wide)
+  ret void
+}
+
+define internal void @print_i32s(<4 x i32> %vector) noinline {
+entry:
+  %wide = zext <4 x i32> %vector to <4 x i64>
+  call void @print_i64s(<4 x i64> %wide)
+  ret void
+}
+
+define internal void @print_i64s(<4 x i64> %vector) noinline {
+entry:
+  %0 = extractelement <4 x i64> %vector, i64 0
+  call void @print_hex(i64 %0)
+  %1 = extractelement <4 x i64> %vector, i64 1
+  call void @print_hex(i64 %1)
+  %2 = extractelement <4 x i64> %vector, i64 2
+  call void @print_hex(i64 %2)
+  %3 = extractelement <4 x i64> %vector, i64 3
+  call void @print_hex(i64 %3)
+  call void @print_newline()
+  ret void
+}
+
+define i32 @main() {
+entry:
+  %floats = load <4 x float>, ptr @floats, align 16
+  %doubles = load <4 x double>, ptr @doubles, align 32
+  %odd_floats = load <3 x float>, ptr @odd_floats, align 16
+
+  %float = extractelement <4 x float> %floats, i64 0
+  %scalar_i32 = call i32 @llvm.fptosi.sat.i32.f32(float %float)
+  %scalar_i32_wide = zext i32 %scalar_i32 to i64
+  call void @print_hex(i64 %scalar_i32_wide)
+  %double = extractelement <4 x double> %doubles, i64 1
+  %scalar_u16 = call i16 @llvm.fptoui.sat.i16.f64(double %double)
+  %scalar_u16_wide = zext i16 %scalar_u16 to i64
+  call void @print_hex(i64 %scalar_u16_wide)
+  call void @print_newline()
+
+  %s8 = call <4 x i8> @llvm.fptosi.sat.v4i8.v4f32(<4 x float> %floats)
+  call void @print_i8s(<4 x i8> %s8)
+  %u8 = call <4 x i8> @llvm.fptoui.sat.v4i8.v4f32(<4 x float> %floats)
+  call void @print_i8s(<4 x i8> %u8)
+  %s64 = call <4 x i64> @llvm.fptosi.sat.v4i64.v4f32(<4 x float> %floats)
+  call void @print_i64s(<4 x i64> %s64)
+  %s16 = call <4 x i16> @llvm.fptosi.sat.v4i16.v4f64(<4 x double> %doubles)
+  call void @print_i16s(<4 x i16> %s16)
+  %u32 = call <4 x i32> @llvm.fptoui.sat.v4i32.v4f64(<4 x double> %doubles)
+  call void @print_i32s(<4 x i32> %u32)
+  %u64 = call <4 x i64> @llvm.fptoui.sat.v4i64.v4f64(<4 x double> %doubles)
+  call void @print_i64s(<4 x i64> %u64)
+
+  ; A padded vector.
+  %s32 = call <3 x i32> @llvm.fptosi.sat.v3i32.v3f32(<3 x float> %odd_floats)
+  %s32_padded = shufflevector <3 x i32> %s32, <3 x i32> zeroinitializer, <4 x i32> <i32 0, i32 1, i32 2, i32 3>
+  call void @print_i32s(<4 x i32> %s32_padded)
+
+  ret i32 0
+}
@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include <stdint.h>
+
+// Vectors smaller than 64 bits, and the 1024-bit <32 x i32>.
+// Wrapping arithmetic is done on unsigned vectors, to avoid signed overflow.
+
+typedef uint8_t uchar2 __attribute__((vector_size(2)));
+typedef uint8_t uchar4 __attribute__((vector_size(4)));
+typedef int16_t short2 __attribute__((vector_size(4)));
+typedef uint16_t ushort2 __attribute__((vector_size(4)));
+typedef int32_t int2 __attribute__((vector_size(8)));
+typedef int64_t long2 __attribute__((vector_size(16)));
+typedef float float2 __attribute__((vector_size(8)));
+typedef uint32_t uint32x32 __attribute__((vector_size(128)));
+typedef int32_t int32x32 __attribute__((vector_size(128)));
+typedef float float32x32 __attribute__((vector_size(128)));
+
+static volatile uint8_t bytes[8];
+static volatile int16_t shorts[4];
+static volatile int32_t ints[64];
+
+__attribute__((noinline)) static uchar2 arithmetic_uchar2(uchar2 a, uchar2 b)
+{
+    return (a + b) * (a - b) ^ (a << 2) ^ (a / b) ^ (b >> 1) ^ (a & b);
+}
+
+__attribute__((noinline)) static uchar4 arithmetic_uchar4(uchar4 a, uchar4 b)
+{
+    return (a * b) | (a / b) | (uchar4)(a > b);
+}
+
+__attribute__((noinline)) static short2 arithmetic_short2(short2 a, short2 b)
+{
+    ushort2 ua = (ushort2)a, ub = (ushort2)b;
+    return (short2)((ua + ub) ^ (ua * ub)) ^ (a / b) ^ (a >> 3) ^ (a == b);
+}
+
+__attribute__((noinline)) static int32x32 arithmetic_int32x32(int32x32 a, int32x32 b)
+{
+    uint32x32 ua = (uint32x32)a, ub = (uint32x32)b;
+    uint32x32 result = ((ua + ub) * 3 - (uint32x32)(a / b)) ^ (ua << 4) ^ (uint32x32)(b >> 2);
+    return (int32x32)(result + (uint32x32)(a < b) + (uint32x32)(a >= b) * 2);
+}
+
+__attribute__((noinline)) static float32x32 arithmetic_float32x32(float32x32 a, float32x32 b)
+{
+    return a * b + a / b - b;
+}
+
+int main(void)
+{
+    for (int i = 0; i < 8; i++) bytes[i] = (uint8_t)(i * 37 + 100);
+    for (int i = 0; i < 4; i++) shorts[i] = (int16_t)(i * 12345 - 20000);
+    for (int i = 0; i < 64; i++) ints[i] = ((int32_t)(((uint32_t)i * 1103515245u + 12345u) >> 12) - 0x80000) | 1;
+
+    uchar2 a2 = { bytes[0], bytes[1] };
+    uchar2 b2 = { bytes[2], bytes[3] };
+    uchar2 c2 = arithmetic_uchar2(a2, b2);
+    printf("uchar2: %d %d\n", c2[0], c2[1]);
+
+    uchar4 a4 = { bytes[0], bytes[1], bytes[2], bytes[3] };
+    uchar4 b4 = { bytes[4], bytes[5], bytes[6], bytes[7] };
+    uchar4 c4 = arithmetic_uchar4(a4, b4);
+    printf("uchar4: %d %d %d %d\n", c4[0], c4[1], c4[2], c4[3]);
+
+    short2 as = { shorts[0], shorts[1] };
+    short2 bs = { shorts[2], shorts[3] };
+    short2 cs = arithmetic_short2(as, bs);
+    printf("short2: %d %d\n", cs[0], cs[1]);
+
+    uchar2 u2 = { bytes[0], bytes[5] };
+    float2 f2 = __builtin_convertvector(u2, float2);
+    int2 i2 = __builtin_convertvector(cs, int2);
+    long2 l2 = __builtin_convertvector(as, long2);
+    short2 s2 = __builtin_convertvector(l2 * 1000, short2);
+    printf("conversions: %g %g %d %d %lld %lld %d %d\n", f2[0], f2[1], i2[0], i2[1], (long long)l2[0], (long long)l2[1], s2[0], s2[1]);
+
+    int32x32 a32, b32;
+    float32x32 fa32, fb32;
+    for (int i = 0; i < 32; i++)
+    {
+        a32[i] = ints[i];
+        b32[i] = ints[i + 32];
+        fa32[i] = (float)ints[i] / 65536.0f;
+        fb32[i] = (float)(i + 1) * 0.25f;
+    }
+
+    int32x32 c32 = arithmetic_int32x32(a32, b32);
+    float32x32 fc32 = arithmetic_float32x32(fa32, fb32);
+    uint32_t checksum = 0;
+    float fsum = 0;
+    for (int i = 0; i < 32; i++)
+    {
+        checksum = checksum * 31 + (uint32_t)c32[i];
+        fsum += fc32[i];
+    }
+    printf("int32x32: %d %d %u\n", c32[0], c32[31], checksum);
+    printf("float32x32: %.3f %.3f\n", fc32[7], fsum);
+
+    return 0;
+}
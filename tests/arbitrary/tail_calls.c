@@ -0,0 +1,104 @@
+#include <stdio.h>
+
+#if defined(__clang__)
+#define MUSTTAIL __attribute__((musttail))
+#else
+#define MUSTTAIL
+#endif
+
+static int is_odd(unsigned int n);
+
+static int is_even(unsigned int n)
+{
+    if (n == 0)
+    {
+        return 1;
+    }
+    MUSTTAIL return is_odd(n - 1);
+}
+
+static int is_odd(unsigned int n)
+{
+    if (n == 0)
+    {
+        return 0;
+    }
+    MUSTTAIL return is_even(n - 1);
+}
+
+static long long sum_to(long long n, long long accumulator)
+{
+    if (n == 0)
+    {
+        return accumulator;
+    }
+    MUSTTAIL return sum_to(n - 1, accumulator + n);
+}
+
+static unsigned int collatz_steps(unsigned int n, unsigned int steps)
+{
+    if (n == 1)
+    {
+        return steps;
+    }
+    if (n % 2 == 0)
+    {
+        MUSTTAIL return collatz_steps(n / 2, steps + 1);
+    }
+    MUSTTAIL return collatz_steps(3 * n + 1, steps + 1);
+}
+
+typedef int (*state_fn)(const char *input, int count);
+
+static int state_a(const char *input, int count);
+static int state_b(const char *input, int count);
+
+static int dispatch(const char *input, int count)
+{
+    state_fn next = *input == 'a' ? state_a : state_b;
+    if (*input == 0)
+    {
+        return count;
+    }
+    MUSTTAIL return next(input, count);
+}
+
+static int state_a(const char *input, int count)
+{
+    MUSTTAIL return dispatch(input + 1, count + 1);
+}
+
+static int state_b(const char *input, int count)
+{
+    MUSTTAIL return dispatch(input + 1, count);
+}
+
+static int depth(int n)
+{
+    if (n == 0)
+    {
+        return 0;
+    }
+    return 1 + depth(n - 1);
+}
+
+int main()
+{
+    // Deep enough to overflow the stack without tail calls.
+    printf("%d %d\n", is_even(10000000), is_odd(10000001));
+    printf("%lld\n", sum_to(10000000, 0));
+    printf("%u\n", collatz_steps(837799, 0));
+
+    char input[100001];
+    for (int i = 0; i < 100000; i++)
+    {
+        input[i] = i % 3 == 0 ? 'a' : 'b';
+    }
+    input[100000] = 0;
+    printf("%d\n", dispatch(input, 0));
+
+    // Not a tail call.
+    printf("%d\n", depth(1000));
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <stdint.h>
+
+// Variable-length arrays, which are dynamic allocas. Those declared in a loop are freed at the end of each
+// iteration with llvm.stackrestore, so the loops below only need a few kilobytes at a time, although
+// they'd need hundreds of megabytes if nothing were freed until the function returned.
+typedef struct
+{
+    double weight;
+    int16_t id;
+} item;
+
+static volatile int sizes[4] = { 1000, 37, 1, 513 };
+
+__attribute__((noinline)) static uint32_t sum_of_squares(int count)
+{
+    uint32_t squares[count];
+    for (int i = 0; i < count; i++)
+    {
+        squares[i] = (uint32_t)(i * i);
+    }
+
+    uint32_t sum = 0;
+    for (int i = 0; i < count; i++)
+    {
+        sum += squares[i];
+    }
+    return sum;
+}
+
+__attribute__((noinline)) static uint64_t loop_with_vla(int iterations)
+{
+    uint64_t checksum = 0;
+    for (int i = 0; i < iterations; i++)
+    {
+        int count = sizes[i & 3];
+        double values[count];
+        item items[count];
+        for (int j = 0; j < count; j++)
+        {
+            values[j] = i + j * 0.5;
+            items[j].weight = values[j];
+            items[j].id = (int16_t)(j - i);
+        }
+
+        checksum = checksum * 31 + (uint64_t)(values[count - 1] * 2) + (uint16_t)items[count / 2].id;
+        checksum += ((uintptr_t)values & 7) + ((uintptr_t)items & 7);
+    }
+    return checksum;
+}
+
+__attribute__((noinline)) static void fill(unsigned char *bytes, int count, int seed)
+{
+    for (int i = 0; i < count; i++)
+    {
+        bytes[i] = (unsigned char)(seed + i * 7);
+    }
+}
+
+// The loop body has no inner loop, so the stack pointer is saved and restored in the same block, and saving it
+// mustn't be delayed until it's restored. A million 4 KB arrays would need 4 GB if they weren't freed.
+__attribute__((noinline)) static uint32_t loop_with_vla_without_inner_loop(int iterations)
+{
+    uint32_t checksum = 0;
+    for (int i = 0; i < iterations; i++)
+    {
+        unsigned char bytes[4000 + sizes[i & 3]];
+        fill(bytes, 4000, i);
+        checksum = checksum * 33 + bytes[i % 4000];
+    }
+    return checksum;
+}
+
+// Arrays that are still live when a nested one is allocated and freed.
+__attribute__((noinline)) static int nested(int outer_count, int inner_count)
+{
+    char outer[outer_count];
+    for (int i = 0; i < outer_count; i++)
+    {
+        outer[i] = (char)(i * 3);
+    }
+
+    int total = 0;
+    for (int round = 0; round < 1000; round++)
+    {
+        int inner[inner_count + round % 7];
+        for (int i = 0; i < inner_count + round % 7; i++)
+        {
+            inner[i] = outer[(round + i) % outer_count];
+        }
+        total += inner[round % inner_count];
+    }
+    return total + outer[outer_count - 1];
+}
+
+// Each call's array is freed when it returns, so the recursion doesn't leak.
+__attribute__((noinline)) static int recursive(int depth, int count)
+{
+    short values[count];
+    for (int i = 0; i < count; i++)
+    {
+        values[i] = (short)(depth + i);
+    }
+
+    if (depth == 0)
+    {
+        return values[count - 1];
+    }
+
+    return values[0] + recursive(depth - 1, count);
+}
+
+int main(void)
+{
+    printf("sum_of_squares: %u %u\n", sum_of_squares(sizes[0]), sum_of_squares(sizes[1]));
+    printf("loop_with_vla: %llu\n", (unsigned long long)loop_with_vla(200000));
+    printf("loop_with_vla_without_inner_loop: %u\n", loop_with_vla_without_inner_loop(1000000));
+    printf("nested: %d\n", nested(sizes[3], sizes[1]));
+
+    int total = 0;
+    for (int i = 0; i < 2000; i++)
+    {
+        total += recursive(20, sizes[i & 3]);
+    }
+    printf("recursive: %d\n", total);
+
+    return 0;
+}
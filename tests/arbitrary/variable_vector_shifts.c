@@ -0,0 +1,156 @@
+#include <stdio.h>
+#include <stdint.h>
+
+// Vector shifts where each lane has its own shift amount, as in bit unpacking, varint decoding and hash mixing.
+typedef int8_t char16 __attribute__((vector_size(16)));
+typedef uint8_t uchar16 __attribute__((vector_size(16)));
+typedef int16_t short8 __attribute__((vector_size(16)));
+typedef uint16_t ushort8 __attribute__((vector_size(16)));
+typedef int32_t int4 __attribute__((vector_size(16)));
+typedef uint32_t uint4 __attribute__((vector_size(16)));
+typedef uint32_t uint8 __attribute__((vector_size(32)));
+typedef int64_t long2 __attribute__((vector_size(16)));
+typedef uint64_t ulong2 __attribute__((vector_size(16)));
+typedef uint64_t ulong4 __attribute__((vector_size(32)));
+
+static volatile uint8_t bytes[64];
+
+// Unpacks eight 4-bit fields from each of two 32-bit words.
+__attribute__((noinline)) static uint8 unpack_nibbles(uint32_t low, uint32_t high)
+{
+    uint8 words = { low, low, low, low, high, high, high, high };
+    uint8 shifts = { 0, 4, 8, 12, 16, 20, 24, 28 };
+    return (words >> shifts) & 0xF;
+}
+
+// Sign-extends fields of different widths, by shifting each one to the top of its lane and back.
+__attribute__((noinline)) static int4 sign_extend_fields(int4 fields, int4 widths)
+{
+    int4 shifts = 32 - widths;
+    return (int4)((uint4)fields << (uint4)shifts) >> shifts;
+}
+
+// Combines the 7-bit groups of a varint, each of which is in its own lane.
+__attribute__((noinline)) static uint64_t combine_varint(ulong4 groups)
+{
+    ulong4 shifts = { 0, 7, 14, 21 };
+    ulong4 shifted = (groups & 0x7F) << shifts;
+    return shifted[0] | shifted[1] | shifted[2] | shifted[3];
+}
+
+// A hash step with a different rotation in each lane, in the style of xxHash and SipHash.
+__attribute__((noinline)) static uint4 mix(uint4 state, uint4 input, uint4 rotations)
+{
+    state ^= input * 0x9E3779B1u;
+    return (state << rotations) | (state >> ((32 - rotations) & 31));
+}
+
+__attribute__((noinline)) static long2 shift_long2(long2 value, long2 amount, long2* logical)
+{
+    *logical = (long2)((ulong2)value >> (ulong2)amount);
+    return (value >> amount) ^ (long2)((ulong2)value << (ulong2)amount);
+}
+
+__attribute__((noinline)) static short8 shift_short8(short8 value, short8 amount)
+{
+    return (value >> amount) ^ (short8)((ushort8)value << (ushort8)amount) ^ (short8)((ushort8)value >> (ushort8)amount);
+}
+
+__attribute__((noinline)) static char16 shift_char16(char16 value, char16 amount)
+{
+    return (value >> amount) ^ (char16)((uchar16)value << (uchar16)amount);
+}
+
+__attribute__((noinline)) static uchar16 shift_uchar16(uchar16 value, uchar16 amount)
+{
+    return value >> amount;
+}
+
+// Every lane shifted by the same amount, which isn't known at compile time.
+__attribute__((noinline)) static char16 shift_char16_uniform(char16 value, int amount)
+{
+    return value >> amount;
+}
+
+int main(void)
+{
+    uint32_t seed = 2024;
+    for (int i = 0; i < 64; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        bytes[i] = (uint8_t)(seed >> 16);
+    }
+
+    uint32_t words[2];
+    for (int i = 0; i < 8; i++)
+    {
+        ((uint8_t*)words)[i] = bytes[i];
+    }
+    uint8 nibbles = unpack_nibbles(words[0], words[1]);
+    printf("nibbles:");
+    for (int i = 0; i < 8; i++)
+    {
+        printf(" %u", nibbles[i]);
+    }
+    printf("\n");
+
+    int4 fields = { 0x5, 0x1F0, 0x7FFF, 0x3 };
+    int4 widths = { 3, 9, 15, 2 };
+    int4 extended = sign_extend_fields(fields, widths);
+    printf("sign_extend: %d %d %d %d\n", extended[0], extended[1], extended[2], extended[3]);
+
+    ulong4 groups = { bytes[8], bytes[9], bytes[10], bytes[11] };
+    printf("varint: %llu\n", (unsigned long long)combine_varint(groups));
+
+    uint4 state = { 1, 2, 3, 4 };
+    uint4 rotations = { 1, 7, 13, 31 };
+    for (int i = 0; i < 16; i += 4)
+    {
+        uint4 input = { bytes[i], bytes[i + 1], bytes[i + 2], bytes[i + 3] };
+        state = mix(state, input, rotations);
+        rotations = (rotations + 5) & 31;
+    }
+    printf("mix: %08x %08x %08x %08x\n", state[0], state[1], state[2], state[3]);
+
+    long2 value64 = { -123456789012345LL, 987654321098765LL };
+    long2 amount64 = { bytes[12] & 63, bytes[13] & 63 };
+    long2 logical64;
+    long2 shifted64 = shift_long2(value64, amount64, &logical64);
+    printf("long2: %lld %lld %lld %lld\n", (long long)shifted64[0], (long long)shifted64[1], (long long)logical64[0], (long long)logical64[1]);
+
+    short8 value16, amount16;
+    char16 value8, amount8;
+    uchar16 uvalue8, uamount8;
+    for (int i = 0; i < 8; i++)
+    {
+        value16[i] = (int16_t)(bytes[16 + i * 2] | (bytes[17 + i * 2] << 8));
+        amount16[i] = bytes[32 + i] & 15;
+    }
+    for (int i = 0; i < 16; i++)
+    {
+        value8[i] = (int8_t)bytes[40 + i % 24];
+        amount8[i] = bytes[i * 3 % 64] & 7;
+        uvalue8[i] = bytes[48 + i];
+        uamount8[i] = (uint8_t)(i & 7);
+    }
+
+    short8 shifted16 = shift_short8(value16, amount16);
+    printf("short8:");
+    for (int i = 0; i < 8; i++)
+    {
+        printf(" %d", shifted16[i]);
+    }
+    printf("\n");
+
+    char16 shifted8 = shift_char16(value8, amount8);
+    uchar16 ushifted8 = shift_uchar16(uvalue8, uamount8);
+    char16 uniform8 = shift_char16_uniform(value8, bytes[5] & 7);
+    printf("char16:");
+    for (int i = 0; i < 16; i++)
+    {
+        printf(" %d/%u/%d", shifted8[i], ushifted8[i], uniform8[i]);
+    }
+    printf("\n");
+
+    return 0;
+}
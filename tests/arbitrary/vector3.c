@@ -0,0 +1,135 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+// Three-lane vectors, as used for positions, directions and colours in graphics code.
+// LLVM has <3 x float> and <3 x i32>; GCC only has power-of-two vectors, so there the fourth lane is unused.
+#if defined(__clang__)
+typedef float float3 __attribute__((ext_vector_type(3)));
+typedef int32_t int3 __attribute__((ext_vector_type(3)));
+#define REDUCE_ADD(v) __builtin_reduce_add(v)
+#define REDUCE_MAX(v) __builtin_reduce_max(v)
+#define REDUCE_AND(v) __builtin_reduce_and(v)
+#else
+typedef float float3 __attribute__((vector_size(16)));
+typedef int32_t int3 __attribute__((vector_size(16)));
+#define REDUCE_ADD(v) ((v)[0] + (v)[1] + (v)[2])
+#define REDUCE_MAX(v) ((v)[0] > (v)[1] ? ((v)[0] > (v)[2] ? (v)[0] : (v)[2]) : ((v)[1] > (v)[2] ? (v)[1] : (v)[2]))
+#define REDUCE_AND(v) ((v)[0] & (v)[1] & (v)[2])
+#endif
+
+#define COUNT 8
+
+// Tightly packed, so the vectors' padding overlaps the next element.
+static float positions[COUNT * 3];
+static int32_t cells[COUNT * 3];
+
+static float3 load_float3(const float* p)
+{
+    float3 v = { 0, 0, 0 };
+    memcpy(&v, p, 3 * sizeof(float));
+    return v;
+}
+
+static void store_float3(float* p, float3 v)
+{
+    memcpy(p, &v, 3 * sizeof(float));
+}
+
+static int3 load_int3(const int32_t* p)
+{
+    // Ones in every lane, so that GCC's unused fourth lane is never a divisor of zero.
+    int3 v = (int3){ 0 } + 1;
+    memcpy(&v, p, 3 * sizeof(int32_t));
+    return v;
+}
+
+__attribute__((noinline)) static float dot(float3 a, float3 b)
+{
+    float3 product = a * b;
+    return product[0] + product[1] + product[2];
+}
+
+__attribute__((noinline)) static float3 cross(float3 a, float3 b)
+{
+    float3 result = { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+    return result;
+}
+
+__attribute__((noinline)) static float3 normalize(float3 v)
+{
+    return v / sqrtf(dot(v, v));
+}
+
+__attribute__((noinline)) static float3 reflect(float3 direction, float3 normal)
+{
+    return direction - normal * (2.0f * dot(direction, normal));
+}
+
+__attribute__((noinline)) static float3 lerp(float3 a, float3 b, float t)
+{
+    return a + (b - a) * t;
+}
+
+__attribute__((noinline)) static int3 divide(int3 a, int3 b)
+{
+    return a / b + a % b;
+}
+
+__attribute__((noinline)) static int3 clamp_mask(int3 a, int3 b)
+{
+    // Lanes where a > b are all ones.
+    int3 mask = (int3)(a > b);
+    return (a & mask) | (b & ~mask);
+}
+
+int main(void)
+{
+    for (int i = 0; i < COUNT * 3; i++)
+    {
+        positions[i] = (float)((i * 7) % 11) - 4.5f;
+        cells[i] = (i * 37) % 101 - 50;
+        if (cells[i] == 0)
+        {
+            cells[i] = 1;
+        }
+    }
+
+    float3 light = normalize((float3){ 1.0f, -2.0f, 0.5f });
+    float total = 0;
+    for (int i = 0; i + 1 < COUNT; i++)
+    {
+        float3 a = load_float3(&positions[i * 3]);
+        float3 b = load_float3(&positions[(i + 1) * 3]);
+        float3 normal = normalize(cross(a, b));
+        float3 reflected = reflect(light, normal);
+        total += dot(reflected, a);
+
+        // Storing the padding lane too would overwrite the next position's first component.
+        store_float3(&positions[i * 3], lerp(a, b, 0.25f));
+    }
+
+    printf("total: %.4f\n", total);
+    for (int i = 0; i < COUNT * 3; i += 3)
+    {
+        printf("position: %.4f %.4f %.4f\n", positions[i], positions[i + 1], positions[i + 2]);
+    }
+
+    int32_t sum = 0, max = INT32_MIN, all = -1;
+    for (int i = 0; i + 1 < COUNT; i++)
+    {
+        int3 a = load_int3(&cells[i * 3]);
+        int3 b = load_int3(&cells[(i + 1) * 3]);
+        int3 quotient = divide(a * 100, b);
+        int3 clamped = clamp_mask(a, b);
+        sum += REDUCE_ADD(quotient);
+        max = REDUCE_MAX(clamped) > max ? REDUCE_MAX(clamped) : max;
+        all &= REDUCE_AND((int3)(a != b));
+        printf("int3: %d %d %d\n", quotient[0], quotient[1], quotient[2]);
+    }
+
+    printf("sum: %d max: %d all: %d\n", sum, max, all);
+
+    return 0;
+}
@@ -0,0 +1,188 @@
+#include <stdio.h>
+#include <stdint.h>
+
+// Conversions between vectors of every element type, as in image processing (bytes to floats and back),
+// audio (shorts to floats), and mask handling (comparison results widened to integers).
+typedef int8_t char16 __attribute__((vector_size(16)));
+typedef uint8_t uchar8 __attribute__((vector_size(8)));
+typedef uint8_t uchar16 __attribute__((vector_size(16)));
+typedef int16_t short4 __attribute__((vector_size(8)));
+typedef int16_t short8 __attribute__((vector_size(16)));
+typedef uint16_t ushort8 __attribute__((vector_size(16)));
+typedef int32_t int4 __attribute__((vector_size(16)));
+typedef int32_t int8 __attribute__((vector_size(32)));
+typedef int32_t int16 __attribute__((vector_size(64)));
+typedef uint32_t uint4 __attribute__((vector_size(16)));
+typedef int64_t long4 __attribute__((vector_size(32)));
+typedef uint64_t ulong2 __attribute__((vector_size(16)));
+typedef float float4 __attribute__((vector_size(16)));
+typedef float float8 __attribute__((vector_size(32)));
+typedef double double2 __attribute__((vector_size(16)));
+typedef double double4 __attribute__((vector_size(32)));
+typedef double double8 __attribute__((vector_size(64)));
+typedef _Float16 half8 __attribute__((vector_size(16)));
+
+// LLVM has <3 x i32>; GCC only has power-of-two vectors, so there the fourth lane is unused.
+#if defined(__clang__)
+typedef int32_t int3 __attribute__((ext_vector_type(3)));
+typedef float float3 __attribute__((ext_vector_type(3)));
+#else
+typedef int32_t int3 __attribute__((vector_size(16)));
+typedef float float3 __attribute__((vector_size(16)));
+#endif
+
+#define COUNT 37
+
+static volatile uint8_t bytes[64];
+static float samples[COUNT];
+static int32_t thresholds[COUNT];
+
+__attribute__((noinline)) static int16 widen_char16(char16 value) { return __builtin_convertvector(value, int16); }
+__attribute__((noinline)) static double8 widen_uchar8(uchar8 value) { return __builtin_convertvector(value, double8); }
+__attribute__((noinline)) static uchar8 narrow_short8(short8 value) { return __builtin_convertvector(value, uchar8); }
+__attribute__((noinline)) static short4 narrow_long4(long4 value) { return __builtin_convertvector(value, short4); }
+__attribute__((noinline)) static float8 int8_to_float8(int8 value) { return __builtin_convertvector(value, float8); }
+__attribute__((noinline)) static float4 uint4_to_float4(uint4 value) { return __builtin_convertvector(value, float4); }
+__attribute__((noinline)) static double4 uint4_to_double4(uint4 value) { return __builtin_convertvector(value, double4); }
+__attribute__((noinline)) static double2 ulong2_to_double2(ulong2 value) { return __builtin_convertvector(value, double2); }
+__attribute__((noinline)) static float4 long4_to_float4(long4 value) { return __builtin_convertvector(value, float4); }
+__attribute__((noinline)) static short8 float8_to_short8(float8 value) { return __builtin_convertvector(value, short8); }
+__attribute__((noinline)) static uint4 float4_to_uint4(float4 value) { return __builtin_convertvector(value, uint4); }
+__attribute__((noinline)) static int4 double4_to_int4(double4 value) { return __builtin_convertvector(value, int4); }
+__attribute__((noinline)) static ulong2 double2_to_ulong2(double2 value) { return __builtin_convertvector(value, ulong2); }
+__attribute__((noinline)) static double4 float4_to_double4(float4 value) { return __builtin_convertvector(value, double4); }
+__attribute__((noinline)) static float8 double8_to_float8(double8 value) { return __builtin_convertvector(value, float8); }
+__attribute__((noinline)) static float8 half8_to_float8(half8 value) { return __builtin_convertvector(value, float8); }
+__attribute__((noinline)) static half8 ushort8_to_half8(ushort8 value) { return __builtin_convertvector(value, half8); }
+__attribute__((noinline)) static float3 int3_to_float3(int3 value) { return __builtin_convertvector(value, float3); }
+
+// Loops that clang vectorizes with zext and sext of comparison results, and with float to byte conversion.
+__attribute__((noinline)) static int32_t count_above(const float* values, float threshold, int count)
+{
+    int32_t result = 0;
+    for (int i = 0; i < count; i++)
+    {
+        result += values[i] > threshold;
+    }
+    return result;
+}
+
+__attribute__((noinline)) static void quantize(uint8_t* output, const float* values, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        float clamped = values[i] < 0.0f ? 0.0f : values[i] > 255.0f ? 255.0f : values[i];
+        output[i] = (uint8_t)clamped;
+    }
+}
+
+__attribute__((noinline)) static void select_mask(int64_t* output, const int32_t* values, int32_t limit, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        output[i] = -(int64_t)(values[i] < limit);
+    }
+}
+
+int main(void)
+{
+    uint32_t seed = 777;
+    for (int i = 0; i < 64; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        bytes[i] = (uint8_t)(seed >> 16);
+    }
+    for (int i = 0; i < COUNT; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        samples[i] = (float)((int32_t)(seed >> 12) % 70000) / 128.0f - 100.0f;
+        thresholds[i] = (int32_t)(seed >> 8) % 1000 - 500;
+    }
+
+    char16 c16;
+    uchar8 uc8;
+    short8 s8;
+    ushort8 us8;
+    int8 i8;
+    for (int i = 0; i < 16; i++)
+    {
+        c16[i] = (int8_t)bytes[i];
+    }
+    for (int i = 0; i < 8; i++)
+    {
+        uc8[i] = bytes[16 + i];
+        s8[i] = (int16_t)(bytes[24 + i] << 8 | bytes[32 + i]);
+        us8[i] = (uint16_t)(bytes[40 + i] * 9);
+        i8[i] = (int32_t)((uint32_t)bytes[48 + i] << 24 | bytes[i] << 12 | bytes[i + 1]);
+    }
+
+    int16 wide = widen_char16(c16);
+    int64_t wide_sum = 0;
+    for (int i = 0; i < 16; i++)
+    {
+        wide_sum += wide[i] * (i + 1);
+    }
+    double8 doubles = widen_uchar8(uc8);
+    uchar8 narrowed = narrow_short8(s8);
+    long4 l4 = { -1234567890123LL, 65537, -2, (int64_t)bytes[3] << 40 | bytes[4] };
+    short4 narrowed4 = narrow_long4(l4);
+    printf("integers: %lld %g %g %u %u %d %d %d %d\n", (long long)wide_sum, doubles[0], doubles[7],
+        narrowed[0], narrowed[7], narrowed4[0], narrowed4[1], narrowed4[2], narrowed4[3]);
+
+    float8 f8 = int8_to_float8(i8);
+    uint4 u4 = { 0xFFFFFFFFu, 0x80000001u, 16777217u, bytes[5] };
+    float4 uf4 = uint4_to_float4(u4);
+    double4 ud4 = uint4_to_double4(u4);
+    ulong2 ul2 = { 0xFFFFFFFFFFFFF801ull, (uint64_t)bytes[6] << 56 | 0x401 };
+    double2 ud2 = ulong2_to_double2(ul2);
+    float4 lf4 = long4_to_float4(l4);
+    printf("to float: %.1f %.1f %.1f %.1f %.1f %.1f %.1f %.1f %.1f %.1f %.1f %.1f\n", f8[0], f8[7], uf4[0], uf4[1], uf4[2],
+        ud4[0], ud4[1], ud2[0], ud2[1], lf4[0], lf4[1], lf4[3]);
+
+    float8 fs8;
+    for (int i = 0; i < 8; i++)
+    {
+        fs8[i] = samples[i] * 3.0f;
+    }
+    short8 fs = float8_to_short8(fs8);
+    float4 big = { 4000000000.0f, 3.99f, 0.5f, 2147483904.0f };
+    uint4 fu = float4_to_uint4(big);
+    double4 d4 = { -2147483648.0, 2147483647.9, -0.99, samples[9] };
+    int4 di = double4_to_int4(d4);
+    double2 d2 = { 18446744073709549568.0, 9007199254740993.0 };
+    ulong2 du = double2_to_ulong2(d2);
+    printf("from float: %d %d %u %u %u %u %d %d %d %d %llu %llu\n", fs[0], fs[7], fu[0], fu[1], fu[2], fu[3],
+        di[0], di[1], di[2], di[3], (unsigned long long)du[0], (unsigned long long)du[1]);
+
+    float4 f4 = { samples[0], samples[1], 1e-40f, -0.0f };
+    double4 extended = float4_to_double4(f4);
+    double8 d8;
+    for (int i = 0; i < 8; i++)
+    {
+        d8[i] = (double)samples[i] / 7.0;
+    }
+    float8 truncated = double8_to_float8(d8);
+    half8 h8 = ushort8_to_half8(us8);
+    float8 from_half = half8_to_float8(h8);
+    printf("floats: %.9g %.9g %g %g %.9g %.9g %g %g\n", extended[0], extended[1], extended[2], extended[3],
+        truncated[0], truncated[7], from_half[0], from_half[7]);
+
+    int3 i3 = { -5, 16777217, bytes[7] };
+    float3 f3 = int3_to_float3(i3);
+    printf("int3: %.1f %.1f %.1f\n", f3[0], f3[1], f3[2]);
+
+    uint8_t quantized[COUNT];
+    int64_t masks[COUNT];
+    quantize(quantized, samples, COUNT);
+    select_mask(masks, thresholds, 100, COUNT);
+    uint32_t quantized_sum = 0;
+    int64_t mask_sum = 0;
+    for (int i = 0; i < COUNT; i++)
+    {
+        quantized_sum += quantized[i] * (uint32_t)(i + 1);
+        mask_sum += masks[i] * (i + 1);
+    }
+    printf("loops: %d %u %lld\n", count_above(samples, 50.0f, COUNT), quantized_sum, (long long)mask_sum);
+
+    return 0;
+}
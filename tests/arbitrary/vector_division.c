@@ -0,0 +1,207 @@
+#include <stdio.h>
+#include <stdint.h>
+
+// Integer division and remainder of vectors, by constants and by values that are only known at run time,
+// as in bucketing, digit extraction and fixed-point scaling.
+typedef int8_t char16 __attribute__((vector_size(16)));
+typedef uint8_t uchar16 __attribute__((vector_size(16)));
+typedef int16_t short8 __attribute__((vector_size(16)));
+typedef uint16_t ushort8 __attribute__((vector_size(16)));
+typedef int32_t int4 __attribute__((vector_size(16)));
+typedef uint32_t uint4 __attribute__((vector_size(16)));
+typedef int32_t int8 __attribute__((vector_size(32)));
+typedef int64_t long2 __attribute__((vector_size(16)));
+typedef uint64_t ulong2 __attribute__((vector_size(16)));
+
+// LLVM has <3 x i32>; GCC only has power-of-two vectors, so there the fourth lane is unused.
+#if defined(__clang__)
+typedef int32_t int3 __attribute__((ext_vector_type(3)));
+#else
+typedef int32_t int3 __attribute__((vector_size(16)));
+#endif
+
+#define COUNT 61
+
+static int32_t values[COUNT];
+static uint32_t hashes[COUNT];
+static volatile uint8_t bytes[64];
+
+// Loops that clang vectorizes into divisions of whole vectors by a splat constant.
+__attribute__((noinline)) static void bucket(uint32_t* output, const uint32_t* input, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        output[i] = input[i] % 1009u + input[i] / 7u;
+    }
+}
+
+__attribute__((noinline)) static void scale(int32_t* output, const int32_t* input, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        output[i] = input[i] / -100 + input[i] % 3;
+    }
+}
+
+// Every lane divided by the same value, which isn't known at compile time.
+__attribute__((noinline)) static void divide_by(int32_t* output, const int32_t* input, int32_t divisor, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        output[i] = input[i] / divisor;
+    }
+}
+
+__attribute__((noinline)) static uchar16 digits(uchar16 value)
+{
+    return value / 10 + value % 10;
+}
+
+__attribute__((noinline)) static char16 divide_char16(char16 value, char16 divisor)
+{
+    return (value / divisor) ^ (value % 7) ^ (value / -3);
+}
+
+__attribute__((noinline)) static short8 divide_short8(short8 value, short8 divisor)
+{
+    return (value / divisor) + (value % divisor) + (value / 1000);
+}
+
+__attribute__((noinline)) static ushort8 divide_ushort8(ushort8 value, ushort8 divisor)
+{
+    return (value / divisor) ^ (value % 60) ^ (value / 65535);
+}
+
+__attribute__((noinline)) static uint4 divide_uint4(uint4 value, uint4 divisor)
+{
+    return (value / divisor) + (value % divisor) + (value / 0x80000001u);
+}
+
+__attribute__((noinline)) static int8 divide_int8(int8 value, int8 divisor)
+{
+    return (value / divisor) ^ (value % divisor) ^ (value / 16) ^ (value % -16);
+}
+
+__attribute__((noinline)) static long2 divide_long2(long2 value, long2 divisor)
+{
+    return (value / divisor) + (value % 1000000007) + (value / -6);
+}
+
+__attribute__((noinline)) static ulong2 divide_ulong2(ulong2 value, ulong2 divisor)
+{
+    return (value / divisor) ^ (value % 10) ^ (value / 0xFFFFFFFFFFull);
+}
+
+// A vector with a lane of padding, which must not be divided by zero.
+__attribute__((noinline)) static int3 divide_int3(int3 value, int3 divisor)
+{
+#if !defined(__clang__)
+    divisor[3] = 1;
+#endif
+    return value / divisor + value % divisor;
+}
+
+int main(void)
+{
+    uint32_t seed = 99;
+    for (int i = 0; i < 64; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        bytes[i] = (uint8_t)(seed >> 16);
+    }
+    for (int i = 0; i < COUNT; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        hashes[i] = seed;
+        values[i] = (int32_t)seed >> (i % 12);
+    }
+
+    uint32_t bucketed[COUNT];
+    int32_t scaled[COUNT], divided[COUNT];
+    bucket(bucketed, hashes, COUNT);
+    scale(scaled, values, COUNT);
+    divide_by(divided, values, -(int32_t)bytes[0] - 1, COUNT);
+
+    uint64_t bucket_sum = 0;
+    int64_t scaled_sum = 0, divided_sum = 0;
+    for (int i = 0; i < COUNT; i++)
+    {
+        bucket_sum += bucketed[i] * (uint64_t)(i + 1);
+        scaled_sum += scaled[i] * (int64_t)(i + 1);
+        divided_sum += divided[i] * (int64_t)(i + 1);
+    }
+    printf("bucket: %u %llu\n", bucketed[COUNT - 1], (unsigned long long)bucket_sum);
+    printf("scale: %d %lld\n", scaled[3], (long long)scaled_sum);
+    printf("divide_by: %d %lld\n", divided[5], (long long)divided_sum);
+
+    uchar16 uvalue8;
+    char16 value8, divisor8;
+    short8 value16, divisor16;
+    ushort8 uvalue16, udivisor16;
+    for (int i = 0; i < 16; i++)
+    {
+        uvalue8[i] = bytes[i];
+        value8[i] = (int8_t)bytes[16 + i];
+        divisor8[i] = (int8_t)(bytes[32 + i] | 1);
+        if (divisor8[i] == -1)
+        {
+            divisor8[i] = 3;
+        }
+    }
+    for (int i = 0; i < 8; i++)
+    {
+        value16[i] = (int16_t)(bytes[i * 2] | (bytes[i * 2 + 1] << 8));
+        divisor16[i] = (int16_t)((bytes[48 + i] << 4) | 5) - 2048;
+        uvalue16[i] = (uint16_t)(bytes[i * 3] << 8 | bytes[i]);
+        udivisor16[i] = (uint16_t)(bytes[56 + i] * 37 + 1);
+    }
+
+    uchar16 digits8 = digits(uvalue8);
+    char16 divided8 = divide_char16(value8, divisor8);
+    printf("char16:");
+    for (int i = 0; i < 16; i++)
+    {
+        printf(" %u/%d", digits8[i], divided8[i]);
+    }
+    printf("\n");
+
+    short8 divided16 = divide_short8(value16, divisor16);
+    ushort8 udivided16 = divide_ushort8(uvalue16, udivisor16);
+    printf("short8:");
+    for (int i = 0; i < 8; i++)
+    {
+        printf(" %d/%u", divided16[i], udivided16[i]);
+    }
+    printf("\n");
+
+    uint4 value32 = { hashes[0], hashes[1], 0xFFFFFFFFu, 0x80000000u };
+    uint4 divisor32 = { hashes[2] >> 20, 3, 0x80000000u, 0xFFFFFFFFu };
+    uint4 udivided32 = divide_uint4(value32, divisor32);
+    printf("uint4: %u %u %u %u\n", udivided32[0], udivided32[1], udivided32[2], udivided32[3]);
+
+    int8 value8x32 = { values[0], values[1], values[2], INT32_MIN, INT32_MAX, -7, 7, 0 };
+    int8 divisor8x32 = { values[3] >> 16, -values[4] >> 20, 9, 2, -2, 7, -7, 5 };
+    int8 divided8x32 = divide_int8(value8x32, divisor8x32);
+    printf("int8:");
+    for (int i = 0; i < 8; i++)
+    {
+        printf(" %d", divided8x32[i]);
+    }
+    printf("\n");
+
+    long2 value64 = { -123456789012345LL, INT64_MAX };
+    long2 divisor64 = { (int64_t)hashes[5] + 1, -(int64_t)hashes[6] - 1 };
+    long2 divided64 = divide_long2(value64, divisor64);
+    ulong2 uvalue64 = { UINT64_MAX, 987654321098765ULL };
+    ulong2 udivisor64 = { (uint64_t)hashes[7] << 20 | 1, 3 };
+    ulong2 udivided64 = divide_ulong2(uvalue64, udivisor64);
+    printf("long2: %lld %lld %llu %llu\n", (long long)divided64[0], (long long)divided64[1],
+        (unsigned long long)udivided64[0], (unsigned long long)udivided64[1]);
+
+    int3 value3 = { values[7], -values[8], 1000 };
+    int3 divisor3 = { 17, -(int32_t)bytes[9] - 1, 33 };
+    int3 divided3 = divide_int3(value3, divisor3);
+    printf("int3: %d %d %d\n", divided3[0], divided3[1], divided3[2]);
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+; Vector getelementptrs whose vectors of indices are narrower than i64, which have to be sign-extended.
+; Clang's optimizer widens every index to i64, so these only come from hand-written IR and other front ends,
+; and only the O0 build keeps them narrow. The offsets of the resulting pointers are printed in hex, with putchar,
+; since printf isn't exported by the C runtime DLL.
+
+@table = internal global [16 x i32] [i32 0, i32 1, i32 4, i32 9, i32 16, i32 25, i32 36, i32 49, i32 64, i32 81, i32 100, i32 121, i32 144, i32 169, i32 196, i32 225], align 16
+@records = internal global [4 x { i16, i64 }] [{ i16, i64 } { i16 1, i64 1000 }, { i16, i64 } { i16 2, i64 2000 }, { i16, i64 } { i16 3, i64 3000 }, { i16, i64 } { i16 4, i64 4000 }], align 16
+
+; Not internal, so that the optimizer can't fold the indices into constants.
+@i32_indices = global <4 x i32> <i32 -8, i32 -1, i32 0, i32 7>, align 16
+@i16_indices = global <2 x i16> <i16 3, i16 1>, align 4
+@i8_indices = global <8 x i8> <i8 -3, i8 -2, i8 -1, i8 0, i8 1, i8 2, i8 3, i8 -128>, align 8
+
+declare i32 @putchar(i32)
+
+define internal void @print_hex(i64 %value, i32 %terminator) noinline {
+entry:
+  br label %loop
+
+loop:
+  %shift = phi i64 [ 60, %entry ], [ %next_shift, %loop ]
+  %shifted = lshr i64 %value, %shift
+  %nibble = and i64 %shifted, 15
+  %is_digit = icmp ult i64 %nibble, 10
+  %first_character = select i1 %is_digit, i64 48, i64 87
+  %character = add i64 %nibble, %first_character
+  %character32 = trunc i64 %character to i32
+  %0 = call i32 @putchar(i32 %character32)
+  %next_shift = sub i64 %shift, 4
+  %done = icmp eq i64 %shift, 0
+  br i1 %done, label %exit, label %loop
+
+exit:
+  %1 = call i32 @putchar(i32 %terminator)
+  ret void
+}
+
+; Prints how far each of the first %count pointers in %pointers is from %origin.
+define internal void @print_offsets(ptr %origin, ptr %pointers, i32 %count) noinline {
+entry:
+  %origin_address = ptrtoint ptr %origin to i64
+  br label %loop
+
+loop:
+  %i = phi i32 [ 0, %entry ], [ %next, %loop ]
+  %slot = getelementptr inbounds ptr, ptr %pointers, i32 %i
+  %pointer = load ptr, ptr %slot, align 8
+  %address = ptrtoint ptr %pointer to i64
+  %offset = sub i64 %address, %origin_address
+  call void @print_hex(i64 %offset, i32 32)
+  %next = add i32 %i, 1
+  %done = icmp eq i32 %next, %count
+  br i1 %done, label %exit, label %loop
+
+exit:
+  %0 = call i32 @putchar(i32 10)
+  ret void
+}
+
+define i32 @main() {
+entry:
+  %buffer = alloca [8 x ptr], align 16
+  %middle = getelementptr inbounds [16 x i32], ptr @table, i64 0, i64 8
+
+  ; <4 x i32> indices from a scalar base, including negative ones.
+  %i32_indices = load <4 x i32>, ptr @i32_indices, align 16
+  %int_pointers = getelementptr inbounds i32, ptr %middle, <4 x i32> %i32_indices
+  store <4 x ptr> %int_pointers, ptr %buffer, align 16
+  call void @print_offsets(ptr @table, ptr %buffer, i32 4)
+
+  ; <2 x i16> indices into an array of structs, followed by a field.
+  %i16_indices = load <2 x i16>, ptr @i16_indices, align 4
+  %field_pointers = getelementptr inbounds [4 x { i16, i64 }], ptr @records, i64 0, <2 x i16> %i16_indices, i32 1
+  store <2 x ptr> %field_pointers, ptr %buffer, align 16
+  call void @print_offsets(ptr @records, ptr %buffer, i32 2)
+
+  ; <8 x i8> indices from a vector of bases.
+  %bases = getelementptr inbounds i8, ptr %middle, <8 x i64> <i64 0, i64 2, i64 4, i64 6, i64 8, i64 10, i64 12, i64 14>
+  %i8_indices = load <8 x i8>, ptr @i8_indices, align 8
+  %short_pointers = getelementptr i16, <8 x ptr> %bases, <8 x i8> %i8_indices
+  store <8 x ptr> %short_pointers, ptr %buffer, align 16
+  call void @print_offsets(ptr @table, ptr %buffer, i32 8)
+
+  ret i32 0
+}
@@ -0,0 +1,106 @@
+#include <stdio.h>
+#include <math.h>
+
+// At O3, each of these loops is vectorized into an overloaded intrinsic
+// at a shape other than <4 x i32>, such as llvm.smax.v16i8 or llvm.vector.reduce.add.v8i16.
+
+#define N 64
+
+__attribute__((noinline)) static void max_i8(signed char* result, const signed char* a, const signed char* b)
+{
+    for (int i = 0; i < N; i++)
+    {
+        result[i] = a[i] > b[i] ? a[i] : b[i];
+    }
+}
+
+__attribute__((noinline)) static void max_i16(short* result, const short* a, const short* b)
+{
+    for (int i = 0; i < N; i++)
+    {
+        result[i] = a[i] > b[i] ? a[i] : b[i];
+    }
+}
+
+__attribute__((noinline)) static void max_i64(long long* result, const long long* a, const long long* b)
+{
+    for (int i = 0; i < N; i++)
+    {
+        result[i] = a[i] > b[i] ? a[i] : b[i];
+    }
+}
+
+__attribute__((noinline)) static void abs_sqrt_f32(float* result, const float* a)
+{
+    for (int i = 0; i < N; i++)
+    {
+        result[i] = sqrtf(fabsf(a[i]));
+    }
+}
+
+__attribute__((noinline)) static short sum_i16(const short* a)
+{
+    short sum = 0;
+    for (int i = 0; i < N; i++)
+    {
+        sum += a[i];
+    }
+    return sum;
+}
+
+__attribute__((noinline)) static unsigned char product_u8(const unsigned char* a)
+{
+    unsigned char product = 1;
+    for (int i = 0; i < N; i++)
+    {
+        product *= a[i];
+    }
+    return product;
+}
+
+__attribute__((noinline)) static signed char max_reduce_i8(const signed char* a)
+{
+    signed char max = -128;
+    for (int i = 0; i < N; i++)
+    {
+        max = a[i] > max ? a[i] : max;
+    }
+    return max;
+}
+
+int main()
+{
+    signed char a8[N], b8[N], r8[N];
+    short a16[N], b16[N], r16[N];
+    long long a64[N], b64[N], r64[N];
+    float af[N], rf[N];
+    unsigned char u8[N];
+
+    for (int i = 0; i < N; i++)
+    {
+        a8[i] = (signed char)(i * 37 - 100);
+        b8[i] = (signed char)(50 - i * 13);
+        a16[i] = (short)(i * 1000 - 30000);
+        b16[i] = (short)(20000 - i * 700);
+        a64[i] = (long long)i * 123456789012LL - 4000000000000LL;
+        b64[i] = 3000000000000LL - (long long)i * 98765432109LL;
+        af[i] = (float)(i - 32) * 1.5f;
+        u8[i] = (unsigned char)(i * 2 + 1);
+    }
+
+    max_i8(r8, a8, b8);
+    max_i16(r16, a16, b16);
+    max_i64(r64, a64, b64);
+    abs_sqrt_f32(rf, af);
+
+    for (int i = 0; i < N; i += 7)
+    {
+        printf("%d %d %lld %.4f\n", r8[i], r16[i], r64[i], rf[i]);
+    }
+
+    printf("sum_i16: %d\n", sum_i16(a16));
+    printf("product_u8: %d\n", product_u8(u8));
+    printf("max_reduce_i8: %d\n", max_reduce_i8(a8));
+
+    return 0;
+}
@@ -0,0 +1,211 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <float.h>
+
+#define N 100
+
+static int8_t bytes[N];
+static uint16_t shorts[N];
+static int32_t ints[N];
+static uint64_t longs[N];
+static float floats[N];
+static double doubles[N];
+static float quarters[N];
+static double powers_of_two[N];
+
+// Loops that clang vectorizes at O3, ending in llvm.vector.reduce.* on the partial results.
+static int32_t sum_bytes(void)
+{
+    int8_t sum = 0;
+    for (int i = 0; i < N; i++) sum += bytes[i];
+    return sum;
+}
+
+static uint32_t bitwise_shorts(void)
+{
+    uint16_t all = 0xFFFF, any = 0, odd = 0;
+    for (int i = 0; i < N; i++)
+    {
+        all &= shorts[i];
+        any |= shorts[i];
+        odd ^= shorts[i];
+    }
+    return ((uint32_t)all << 16) ^ ((uint32_t)any << 8) ^ odd;
+}
+
+static int32_t product_ints(void)
+{
+    uint32_t product = 1;
+    for (int i = 0; i < 32; i++) product *= (uint32_t)ints[i] | 1;
+    return (int32_t)product;
+}
+
+static void min_max_ints(int32_t* min, int32_t* max, uint32_t* umin, uint32_t* umax)
+{
+    int32_t smallest = INT32_MAX, largest = INT32_MIN;
+    uint32_t usmallest = UINT32_MAX, ulargest = 0;
+    for (int i = 0; i < N; i++)
+    {
+        smallest = ints[i] < smallest ? ints[i] : smallest;
+        largest = ints[i] > largest ? ints[i] : largest;
+        usmallest = (uint32_t)ints[i] < usmallest ? (uint32_t)ints[i] : usmallest;
+        ulargest = (uint32_t)ints[i] > ulargest ? (uint32_t)ints[i] : ulargest;
+    }
+    *min = smallest;
+    *max = largest;
+    *umin = usmallest;
+    *umax = ulargest;
+}
+
+static void min_max_bytes(int8_t* min, int8_t* max)
+{
+    int8_t smallest = INT8_MAX, largest = INT8_MIN;
+    for (int i = 0; i < N; i++)
+    {
+        smallest = bytes[i] < smallest ? bytes[i] : smallest;
+        largest = bytes[i] > largest ? bytes[i] : largest;
+    }
+    *min = smallest;
+    *max = largest;
+}
+
+static uint64_t sum_longs(void)
+{
+    uint64_t sum = 0;
+    for (int i = 0; i < N; i++) sum += longs[i];
+    return sum;
+}
+
+// Mask reductions: any and all of a comparison.
+static int any_negative(const int32_t* values, int count)
+{
+    int found = 0;
+    for (int i = 0; i < count; i++) found |= values[i] < 0;
+    return found;
+}
+
+static int all_below(const int8_t* values, int count, int8_t limit)
+{
+    int result = 1;
+    for (int i = 0; i < count; i++) result &= values[i] < limit;
+    return result;
+}
+
+static double sum_doubles(void)
+{
+    double sum = 0;
+    for (int i = 0; i < N; i++) sum += doubles[i];
+    return sum;
+}
+
+static float max_floats(void)
+{
+    float max = -FLT_MAX;
+    for (int i = 0; i < N; i++) max = floats[i] > max ? floats[i] : max;
+    return max;
+}
+
+// With reassociation allowed, as with -ffast-math, float sums and products are vectorized too, and end in
+// llvm.vector.reduce.fadd and llvm.vector.reduce.fmul with the reassoc flag. The values are chosen so that
+// every order of combining them gives the same result.
+#pragma clang fp reassociate(on)
+static float sum_quarters_fast(void)
+{
+    float sum = 0;
+    for (int i = 0; i < N; i++) sum += quarters[i];
+    return sum;
+}
+
+static double product_powers_of_two_fast(void)
+{
+    double product = 1;
+    for (int i = 0; i < N; i++) product *= powers_of_two[i];
+    return product;
+}
+
+static float product_floats_fast(float start)
+{
+    float product = start;
+    for (int i = 0; i < N; i++) product *= (float)powers_of_two[i] * (i % 5 == 0 ? 4.0f : 1.0f);
+    return product;
+}
+#pragma clang fp reassociate(off)
+
+// Vector widths that aren't the usual 128 or 256 bits: 1024-bit vectors of i32 and float, and 16 and
+// 32-bit vectors of i8.
+static uint32_t sum_ints_wide(void)
+{
+    uint32_t sum = 0;
+#pragma clang loop vectorize_width(32) interleave_count(1)
+    for (int i = 0; i < N; i++) sum += (uint32_t)ints[i];
+    return sum;
+}
+
+#pragma clang fp reassociate(on)
+static float sum_quarters_wide_fast(void)
+{
+    float sum = 0;
+#pragma clang loop vectorize_width(32) interleave_count(1)
+    for (int i = 0; i < N; i++) sum += quarters[i];
+    return sum;
+}
+#pragma clang fp reassociate(off)
+
+static int32_t sum_bytes_narrow(void)
+{
+    int8_t sum = 0;
+#pragma clang loop vectorize_width(2) interleave_count(1)
+    for (int i = 0; i < N; i++) sum += bytes[i];
+    return sum;
+}
+
+static int32_t max_bytes_narrow(void)
+{
+    int8_t largest = INT8_MIN;
+#pragma clang loop vectorize_width(4) interleave_count(1)
+    for (int i = 0; i < N; i++) largest = bytes[i] > largest ? bytes[i] : largest;
+    return largest;
+}
+
+int main()
+{
+    for (int i = 0; i < N; i++)
+    {
+        bytes[i] = (int8_t)(i * 37 - 50);
+        shorts[i] = (uint16_t)(0xF0F0 | (i * 4099));
+        ints[i] = (int32_t)((uint32_t)i * 2654435761u);
+        longs[i] = (uint64_t)i * 0x9E3779B97F4A7C15ull;
+        floats[i] = (float)((i * 7919) % 1000) * 0.37f - 100.0f;
+        doubles[i] = 1.0 / (i + 1);
+        quarters[i] = (float)((i * 13) % 41 - 20) * 0.25f;
+        powers_of_two[i] = i % 4 == 0 ? 0.5 : i % 4 == 1 ? 2.0 : i % 7 == 0 ? -1.0 : 1.0;
+    }
+
+    printf("sum_bytes: %d\n", sum_bytes());
+    printf("bitwise_shorts: %u\n", bitwise_shorts());
+    printf("product_ints: %d\n", product_ints());
+
+    int32_t min, max;
+    uint32_t umin, umax;
+    min_max_ints(&min, &max, &umin, &umax);
+    printf("min_max_ints: %d %d %u %u\n", min, max, umin, umax);
+
+    int8_t bmin, bmax;
+    min_max_bytes(&bmin, &bmax);
+    printf("min_max_bytes: %d %d\n", bmin, bmax);
+
+    printf("sum_longs: %llu\n", (unsigned long long)sum_longs());
+    printf("any_negative: %d %d\n", any_negative(ints, N), any_negative(ints, 1));
+    printf("all_below: %d %d\n", all_below(bytes, N, 127), all_below(bytes, N, 100));
+    printf("sum_doubles: %.15f\n", sum_doubles());
+    printf("max_floats: %f\n", max_floats());
+    printf("sum_quarters_fast: %f\n", sum_quarters_fast());
+    printf("product_powers_of_two_fast: %f\n", product_powers_of_two_fast());
+    printf("product_floats_fast: %g\n", product_floats_fast(-3.0f));
+    printf("sum_ints_wide: %u\n", sum_ints_wide());
+    printf("sum_quarters_wide_fast: %f\n", sum_quarters_wide_fast());
+    printf("sum_bytes_narrow: %d\n", sum_bytes_narrow());
+    printf("max_bytes_narrow: %d\n", max_bytes_narrow());
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include <stdio.h>
+#include <string.h>
+
+typedef unsigned long long u64;
+typedef long long i64;
+typedef unsigned __int128 u128;
+typedef __int128 i128;
+
+static u64 multiply_high(u64 a, u64 b)
+{
+    return (u64)(((u128)a * b) >> 64);
+}
+
+static i64 multiply_high_signed(i64 a, i64 b)
+{
+    return (i64)(((i128)a * b) >> 64);
+}
+
+// Folds a 128-bit product into 64 bits, as hash functions like wyhash do.
+static u64 mix(u64 a, u64 b)
+{
+    u128 product = (u128)a * b;
+    return (u64)product ^ (u64)(product >> 64);
+}
+
+static void print_u128(u128 value)
+{
+    printf("%016llx%016llx\n", (u64)(value >> 64), (u64)value);
+}
+
+struct rgb
+{
+    unsigned char r, g, b;
+};
+
+struct __attribute__((packed)) five_bytes
+{
+    unsigned int low;
+    unsigned char high;
+};
+
+struct __attribute__((packed)) six_bytes
+{
+    unsigned short a, b, c;
+};
+
+struct bitfields
+{
+    u64 a : 24;
+    u64 b : 40;
+};
+
+static struct rgb swap_channels(struct rgb value)
+{
+    struct rgb result = { value.b, value.r, value.g };
+    return result;
+}
+
+int main()
+{
+    printf("%llu\n", multiply_high(0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL));
+    printf("%llu\n", multiply_high(0x9E3779B97F4A7C15ULL, 12345678901234567ULL));
+    printf("%lld\n", multiply_high_signed(-5000000000000LL, 7000000000000LL));
+
+    u64 hash = 0x243F6A8885A308D3ULL;
+    for (int i = 0; i < 1000; i++)
+    {
+        hash = mix(hash ^ (u64)i, 0xA0761D6478BD642FULL);
+    }
+    printf("%llu\n", hash);
+
+    u128 big = ((u128)0x0123456789ABCDEFULL << 64) | 0xFEDCBA9876543210ULL;
+    print_u128(big);
+    print_u128(big + big);
+    print_u128(big * 3);
+    print_u128(big / 7);
+    print_u128(big % 1000000007);
+    print_u128(big << 12);
+    print_u128(big >> 70);
+    print_u128(~big);
+
+    i128 negative = -(i128)big;
+    print_u128((u128)(negative / 3));
+    print_u128((u128)(negative % 1000));
+    print_u128((u128)(negative >> 100));
+    printf("%d %d %d %d\n", negative < 0, big > (u128)negative, negative == -(i128)big, big != 0);
+    printf("%.6g %.6g %.6g\n", (double)big, (double)negative, (float)big);
+    print_u128((u128)1e30);
+    print_u128((u128)(i128)-1e20);
+
+    struct rgb pixels[4] = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 250, 251, 252 } };
+    for (int i = 0; i < 4; i++)
+    {
+        pixels[i] = swap_channels(pixels[i]);
+        printf("%d %d %d\n", pixels[i].r, pixels[i].g, pixels[i].b);
+    }
+
+    struct five_bytes five[2] = { { 0x12345678, 0x9A }, { 0, 0 } };
+    memcpy(&five[1], &five[0], sizeof(five[0]));
+    five[1].high++;
+    printf("%x %x %x %x\n", five[0].low, five[0].high, five[1].low, five[1].high);
+
+    struct six_bytes six[2] = { { 1, 2, 3 }, { 0, 0, 0 } };
+    six[1] = six[0];
+    six[1].c = 60000;
+    printf("%d %d %d %d\n", six[0].c, six[1].a, six[1].b, six[1].c);
+
+    struct bitfields fields = { 0xABCDEF, 0x123456789AULL };
+    for (int i = 0; i < 10; i++)
+    {
+        fields.a += 0x100001;
+        fields.b -= 0x1000000001ULL;
+    }
+    printf("%llx %llx\n", (u64)fields.a, (u64)fields.b);
+
+    return 0;
+}
@@ -0,0 +1,205 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+// The kinds of <immintrin.h> code found in SIMD string search, hashing and checksum libraries,
+// which clang compiles to llvm.x86.* intrinsics rather than generic vector operations.
+#define X86_TARGET __attribute__((target("sse4.2,aes,pclmul")))
+
+static uint8_t bytes[64];
+static int16_t shorts[32];
+static float floats[16];
+
+// A memchr-style search, using pcmpeqb and pmovmskb.
+static int find_byte(const uint8_t* data, int length, uint8_t value)
+{
+    __m128i needle = _mm_set1_epi8((char)value);
+    for (int i = 0; i + 16 <= length; i += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i*)(data + i));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        if (mask != 0)
+        {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return -1;
+}
+
+// A nibble lookup, as used for hex encoding and character class tables.
+X86_TARGET static void hex_encode(const uint8_t* data, char* output)
+{
+    const __m128i digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    __m128i block = _mm_loadu_si128((const __m128i*)data);
+    __m128i low = _mm_and_si128(block, _mm_set1_epi8(0x0F));
+    __m128i high = _mm_and_si128(_mm_srli_epi16(block, 4), _mm_set1_epi8(0x0F));
+    __m128i low_chars = _mm_shuffle_epi8(digits, low);
+    __m128i high_chars = _mm_shuffle_epi8(digits, high);
+    _mm_storeu_si128((__m128i*)output, _mm_unpacklo_epi8(high_chars, low_chars));
+    _mm_storeu_si128((__m128i*)(output + 16), _mm_unpackhi_epi8(high_chars, low_chars));
+    output[32] = 0;
+}
+
+X86_TARGET static uint32_t crc32c(const uint8_t* data, int length)
+{
+    uint64_t crc = 0xFFFFFFFF;
+    int i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        uint64_t word;
+        memcpy(&word, data + i, 8);
+        crc = _mm_crc32_u64(crc, word);
+    }
+    uint32_t crc32 = (uint32_t)crc;
+    for (; i + 2 <= length; i += 2)
+    {
+        uint16_t half;
+        memcpy(&half, data + i, 2);
+        crc32 = _mm_crc32_u16(crc32, half);
+    }
+    for (; i < length; i++)
+    {
+        crc32 = _mm_crc32_u8(crc32, data[i]);
+    }
+    return _mm_crc32_u32(crc32, 0x12345678) ^ 0xFFFFFFFF;
+}
+
+static void print_vector(const char* name, __m128i vector)
+{
+    uint32_t elements[4];
+    _mm_storeu_si128((__m128i*)elements, vector);
+    printf("%s: %08x %08x %08x %08x\n", name, elements[0], elements[1], elements[2], elements[3]);
+}
+
+X86_TARGET static void integer_arithmetic(void)
+{
+    __m128i a = _mm_loadu_si128((const __m128i*)shorts);
+    __m128i b = _mm_loadu_si128((const __m128i*)(shorts + 8));
+    __m128i c = _mm_loadu_si128((const __m128i*)bytes);
+    __m128i d = _mm_loadu_si128((const __m128i*)(bytes + 16));
+
+    print_vector("madd", _mm_madd_epi16(a, b));
+    print_vector("maddubs", _mm_maddubs_epi16(c, d));
+    print_vector("mulhi", _mm_mulhi_epi16(a, b));
+    print_vector("mulhi_epu16", _mm_mulhi_epu16(a, b));
+    print_vector("mulhrs", _mm_mulhrs_epi16(a, b));
+    print_vector("avg", _mm_avg_epu8(c, d));
+    print_vector("sad", _mm_sad_epu8(c, d));
+    print_vector("packs_epi16", _mm_packs_epi16(_mm_srai_epi16(a, 7), b));
+    print_vector("packus_epi16", _mm_packus_epi16(_mm_srai_epi16(a, 6), b));
+    print_vector("packs_epi32", _mm_packs_epi32(_mm_madd_epi16(a, a), _mm_madd_epi16(b, b)));
+    print_vector("packus_epi32", _mm_packus_epi32(_mm_madd_epi16(a, b), _mm_madd_epi16(b, b)));
+    print_vector("hadd", _mm_hadd_epi32(a, b));
+    print_vector("hadds", _mm_hadds_epi16(a, b));
+    print_vector("hsub", _mm_hsub_epi16(a, b));
+    print_vector("sign", _mm_sign_epi8(c, _mm_sub_epi8(d, _mm_set1_epi8(-128))));
+    print_vector("minpos", _mm_minpos_epu16(a));
+    print_vector("blendv", _mm_blendv_epi8(c, d, a));
+
+    for (int count = 0; count < 70; count += 13)
+    {
+        print_vector("slli", _mm_slli_epi32(a, count));
+        print_vector("srai", _mm_srai_epi16(a, count));
+        print_vector("srl", _mm_srl_epi64(a, _mm_cvtsi32_si128(count)));
+    }
+
+    printf("testz: %d %d\n", _mm_testz_si128(a, b), _mm_testz_si128(a, _mm_setzero_si128()));
+    printf("testc: %d %d\n", _mm_testc_si128(a, b), _mm_testc_si128(a, a));
+}
+
+X86_TARGET static void floating_point(void)
+{
+    __m128 a = _mm_loadu_ps(floats);
+    __m128 b = _mm_loadu_ps(floats + 4);
+    __m128 c = _mm_loadu_ps(floats + 8);
+
+    printf("movemask: %d %d\n", _mm_movemask_ps(a), _mm_movemask_pd(_mm_castps_pd(b)));
+    print_vector("max", _mm_castps_si128(_mm_max_ps(a, b)));
+    print_vector("min", _mm_castps_si128(_mm_min_ps(a, c)));
+    print_vector("floor", _mm_castps_si128(_mm_round_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)));
+    print_vector("nearest", _mm_castps_si128(_mm_round_ps(c, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)));
+    print_vector("cvtps", _mm_cvtps_epi32(c));
+    print_vector("cvttps", _mm_cvttps_epi32(c));
+    print_vector("blendv_ps", _mm_castps_si128(_mm_blendv_ps(a, b, c)));
+    printf("cvtss: %d %d\n", _mm_cvtss_si32(c), _mm_cvttss_si32(c));
+    printf("cvtsd: %lld %lld\n", (long long)_mm_cvtsd_si64(_mm_set_sd(-2.5)), (long long)_mm_cvttsd_si64(_mm_set_sd(floats[11] * 1e20)));
+}
+
+X86_TARGET static void cryptography(void)
+{
+    __m128i state = _mm_loadu_si128((const __m128i*)bytes);
+    __m128i key = _mm_loadu_si128((const __m128i*)(bytes + 32));
+
+    __m128i encrypted = _mm_aesenc_si128(state, key);
+    encrypted = _mm_aesenclast_si128(encrypted, key);
+    print_vector("aesenc", encrypted);
+
+    __m128i decrypted = _mm_aesdeclast_si128(encrypted, key);
+    decrypted = _mm_aesdec_si128(decrypted, _mm_aesimc_si128(key));
+    print_vector("aesdec", decrypted);
+    print_vector("aesimc", _mm_aesimc_si128(state));
+    print_vector("keygen", _mm_aeskeygenassist_si128(key, 0x1B));
+
+    print_vector("clmul00", _mm_clmulepi64_si128(state, key, 0x00));
+    print_vector("clmul11", _mm_clmulepi64_si128(state, key, 0x11));
+    print_vector("clmul01", _mm_clmulepi64_si128(state, key, 0x01));
+}
+
+// A value read before a fence has to be read before the store that follows the fence,
+// although it isn't used until later.
+X86_TARGET __attribute__((noinline)) static int exchange_with_fences(int* slot, int value)
+{
+    int old = *slot;
+    _mm_lfence();
+    *slot = value;
+    _mm_sfence();
+    int stored = *slot;
+    _mm_mfence();
+    *slot = old + value;
+    _mm_clflush(slot);
+    _mm_pause();
+    return old * 1000 + stored;
+}
+
+int main(void)
+{
+    uint32_t seed = 12345;
+    for (int i = 0; i < 64; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        bytes[i] = (uint8_t)(seed >> 16);
+    }
+    for (int i = 0; i < 32; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        shorts[i] = (int16_t)(seed >> 12);
+    }
+    for (int i = 0; i < 16; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        floats[i] = (float)(int32_t)(seed >> 8) / 65536.0f - 64.0f;
+    }
+    floats[9] = 2.5f;
+    floats[10] = -3.5f;
+    floats[11] = 3e9f;
+
+    printf("find: %d %d %d\n", find_byte(bytes, 64, bytes[37]), find_byte(bytes, 64, bytes[3]), find_byte(bytes, 48, 0xFF));
+
+    char hex[33];
+    hex_encode(bytes, hex);
+    printf("hex: %s\n", hex);
+
+    printf("crc32c: %08x %08x\n", crc32c(bytes, 64), crc32c(bytes, 13));
+
+    integer_arithmetic();
+    floating_point();
+    cryptography();
+
+    int slot = 7;
+    int first = exchange_with_fences(&slot, 5);
+    int second = exchange_with_fences(&slot, 9);
+    printf("fences: %d %d %d\n", first, second, slot);
+
+    return 0;
+}
@@ -2,10 +2,23 @@
 #include <stdint.h>
 #include <math.h>
 #include <stdio.h>
+#include <time.h>
 
 #define MALLOC(size, alignment) malloc(size)
 #define FREE(pointer) free(pointer)
 
+// Runs the statement BENCHMARK_ROUNDS times, and writes how long each round took to stderr so that stdout
+// still only has the result. The first round includes JIT compilation and tier-0 code, so comparing it with
+// the later rounds shows how long each tiering policy takes to reach steady state.
+#define BENCHMARK_ROUNDS 3
+
+#define BENCHMARK(statement) \
+	for (int benchmarkRound = 0; benchmarkRound < BENCHMARK_ROUNDS; benchmarkRound++) { \
+		clock_t benchmarkStart = clock(); \
+		statement; \
+		fprintf(stderr, "round %d: %ld ms\n", benchmarkRound, (long)((clock() - benchmarkStart) * 1000 / CLOCKS_PER_SEC)); \
+	}
+
 #ifdef __cplusplus
 #define STRUCT_INIT(x) x
 #else
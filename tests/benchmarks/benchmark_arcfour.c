@@ -76,6 +76,8 @@ int benchmark_arcfour(uint32_t iterations) {
 
 int main()
 {
-	printf("%u", benchmark_arcfour(1000000));
+	int result = 0;
+	BENCHMARK(result = benchmark_arcfour(1000000));
+	printf("%u", result);
     return 0;
 }
\ No newline at end of file
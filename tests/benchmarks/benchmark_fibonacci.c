@@ -9,6 +9,8 @@ uint32_t benchmark_fibonacci(uint32_t number) {
 
 int main()
 {
-	printf("%u", benchmark_fibonacci(35));
+	uint32_t result = 0;
+	BENCHMARK(result = benchmark_fibonacci(35));
+	printf("%u", result);
     return 0;
 }
\ No newline at end of file
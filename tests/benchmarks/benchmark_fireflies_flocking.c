@@ -166,6 +166,8 @@ float benchmark_fireflies_flocking(uint32_t boids, uint32_t lifetime) {
 
 int main()
 {
-	printf("%f", benchmark_fireflies_flocking(1000, 100));
+	float result = 0;
+	BENCHMARK(result = benchmark_fireflies_flocking(1000, 100));
+	printf("%f", result);
     return 0;
 }
\ No newline at end of file
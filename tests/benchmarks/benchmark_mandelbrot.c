@@ -43,6 +43,8 @@ float benchmark_mandelbrot(uint32_t width, uint32_t height, uint32_t iterations)
 
 int main()
 {
-	printf("%f", benchmark_mandelbrot(1920, 1080, 7));
+	float result = 0;
+	BENCHMARK(result = benchmark_mandelbrot(1920, 1080, 7));
+	printf("%f", result);
     return 0;
 }
\ No newline at end of file
@@ -156,6 +156,8 @@ double benchmark_nbody(uint32_t advancements) {
 
 int main()
 {
-	printf("%f", benchmark_nbody(1000000));
+	double result = 0;
+	BENCHMARK(result = benchmark_nbody(1000000));
+	printf("%f", result);
     return 0;
 }
\ No newline at end of file
@@ -35,6 +35,8 @@ float benchmark_particle_kinematics(uint32_t quantity, uint32_t iterations) {
 
 int main()
 {
-	printf("%f", benchmark_particle_kinematics(1000, 1000000));
+	float result = 0;
+	BENCHMARK(result = benchmark_particle_kinematics(1000, 1000000));
+	printf("%f", result);
     return 0;
 }
\ No newline at end of file
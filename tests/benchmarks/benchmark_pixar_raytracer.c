@@ -273,6 +273,8 @@ float benchmark_pixar_raytracer(uint32_t width, uint32_t height, uint32_t sample
 
 int main()
 {
-	printf("%f", benchmark_pixar_raytracer(90, 60, 4));
+	float result = 0;
+	BENCHMARK(result = benchmark_pixar_raytracer(90, 60, 4));
+	printf("%f", result);
     return 0;
 }
\ No newline at end of file
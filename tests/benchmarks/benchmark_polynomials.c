@@ -29,6 +29,8 @@ float benchmark_polynomials(uint32_t iterations) {
 
 int main()
 {
-	printf("%f", benchmark_polynomials(1000000));
+	float result = 0;
+	BENCHMARK(result = benchmark_polynomials(1000000));
+	printf("%f", result);
     return 0;
 }
\ No newline at end of file
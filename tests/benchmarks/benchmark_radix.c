@@ -73,6 +73,8 @@ int benchmark_radix(uint32_t iterations) {
 
 int main()
 {
-	printf("%d", benchmark_radix(100000));
+	int result = 0;
+	BENCHMARK(result = benchmark_radix(100000));
+	printf("%d", result);
     return 0;
 }
\ No newline at end of file
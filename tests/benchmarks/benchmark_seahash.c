@@ -85,6 +85,8 @@ uint64_t benchmark_seahash(uint32_t iterations) {
 
 int main()
 {
-	printf("%lu", benchmark_seahash(10000));
+	uint64_t result = 0;
+	BENCHMARK(result = benchmark_seahash(10000));
+	printf("%lu", result);
     return 0;
 }
\ No newline at end of file
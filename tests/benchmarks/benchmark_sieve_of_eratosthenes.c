@@ -33,6 +33,8 @@ uint32_t benchmark_sieve_of_eratosthenes(uint32_t iterations) {
 
 int main()
 {
-	printf("%u", benchmark_sieve_of_eratosthenes(1000000));
+	uint32_t result = 0;
+	BENCHMARK(result = benchmark_sieve_of_eratosthenes(1000000));
+	printf("%u", result);
     return 0;
 }
\ No newline at end of file